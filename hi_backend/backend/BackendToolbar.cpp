@@ -514,6 +514,9 @@ void ImporterBase::createProjectData()
 		data.partProgress = &(getLogData()->progress);
 		data.totalProgress = &getLogData()->progress;
 
+		SharedResourcePointer<SharedWorkerPool> workerPool;
+		data.threadPool = &workerPool->getThreadPool();
+
 		hlac::HlacArchiver decompressor(getThreadToUse());
 
 		decompressor.setListener(this);
@@ -843,13 +843,15 @@ void MainTopBar::ClickablePeakMeter::PopupComponent::paintBackground(Graphics& g
 	}
 }
 
-void MainTopBar::ClickablePeakMeter::PopupComponent::refresh(bool isPost, const AudioSampleBuffer& b)
+void MainTopBar::ClickablePeakMeter::PopupComponent::refresh(bool isPost, const AudioSampleBuffer& b, int numNewSamples)
 {
 	auto i = infos[(int)isPost][(int)currentMode];
 
 	if(i->freeze)
 		return;
 
+	i->numNewSamples = numNewSamples;
+
 	i->calculate(b, getContentArea());
 }
 
@@ -895,6 +897,8 @@ void MainTopBar::ClickablePeakMeter::PopupComponent::run()
 			AudioSampleBuffer* b1;
 
 			int numSamples = 0;
+			int numNewSamples0 = 0;
+			int numNewSamples1 = 0;
 
 			{
 				ScopedLock sl(lock);
@@ -903,8 +907,8 @@ void MainTopBar::ClickablePeakMeter::PopupComponent::run()
 				b0 = const_cast<AudioSampleBuffer*>(&analyserBuffer0->getReadBuffer());
 				b1 = const_cast<AudioSampleBuffer*>(&analyserBuffer1->getReadBuffer());
 				numSamples = analyserBuffer0->getMaxLengthInSamples();
-				analyserBuffer0->read(*b0);
-				analyserBuffer1->read(*b1);
+				numNewSamples0 = analyserBuffer0->read(*b0);
+				numNewSamples1 = analyserBuffer1->read(*b1);
 			}
 			
 			if(threadShouldExit())
@@ -941,12 +945,12 @@ void MainTopBar::ClickablePeakMeter::PopupComponent::run()
 			if(threadShouldExit())
 				return;
 
-			refresh(false, *b0);
+			refresh(false, *b0, numNewSamples0);
 
 			if(threadShouldExit())
 				return;
 
-			refresh(true, *b1);
+			refresh(true, *b1, numNewSamples1);
 		}
 		
 
@@ -1337,28 +1341,43 @@ void MainTopBar::ClickablePeakMeter::PopupComponent::Spec2DInfo::draw(Graphics&
 void MainTopBar::ClickablePeakMeter::PopupComponent::Spec2DInfo::calculate(const AudioSampleBuffer& b,
 	Rectangle<int> ca)
 {
-#if JUCE_DEBUG
-	if(counter++ % 3 != 0)
-		return;
-#endif
-
 	contentArea = ca;
-	Spectrum2D spectrum(this, b);
-	spectrum.parameters = parameters;
 
 	auto l = (int)rbo->getProperty("FFTSize");
-	auto logl = std::log2(l);
 
-	parameters->order = logl;
+	parameters->order = roundToInt(std::log2(l));
 	parameters->gammaPercent = roundToInt((double)rbo->getProperty("Gamma") * 100.0);
 	parameters->Spectrum2DSize = l;
 	parameters->currentWindowType = (FFTHelpers::WindowType)FFTHelpers::getAvailableWindowTypeNames().indexOf(rbo->getProperty("WindowType"));
 	parameters->oversamplingFactor = rbo->getProperty("Oversampling");
 
-	spectrum.useAlphaChannel = true;
-	auto sb = spectrum.createSpectrumBuffer();
-	
-	auto newImage = spectrum.createSpectrumImage(sb);
+	auto numColumns = b.getNumSamples() / l * parameters->oversamplingFactor - 1;
+
+	if(numColumns <= 0)
+		return;
+
+	auto numToPush = jmin(numNewSamples, b.getNumSamples());
+
+	// Only the columns of the new samples are calculated unless the settings have changed
+	auto hash = String(l) + ":" + String(parameters->gammaPercent) + ":" + String((int)parameters->currentWindowType) + ":" +
+	            String(parameters->oversamplingFactor) + ":" + String(numColumns);
+
+	if(renderer == nullptr || hash != rendererHash)
+	{
+		Spectrum2D spectrum(this, b);
+		spectrum.parameters = parameters;
+		spectrum.useAlphaChannel = true;
+
+		renderer = nullptr;
+		renderer = new Spectrum2D::IncrementalRenderer(spectrum, numColumns);
+		rendererHash = hash;
+		numToPush = b.getNumSamples();
+	}
+
+	if(numToPush > 0)
+		renderer->pushSamples(b.getReadPointer(0, b.getNumSamples() - numToPush), numToPush);
+
+	auto newImage = renderer->getImage();
 
 	MessageManagerLock mm(Thread::getCurrentThread());
 
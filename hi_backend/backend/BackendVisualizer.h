@@ -137,7 +137,7 @@ struct MainTopBar::ClickablePeakMeter::PopupComponent: public Component,
 
 	void paintBackground(Graphics& g) const;
 	
-	void refresh(bool isPost, const AudioSampleBuffer& b);
+	void refresh(bool isPost, const AudioSampleBuffer& b, int numNewSamples);
 	void buttonClicked(Button* b) override;
 	void rebuildPeakMeters();
 
@@ -291,6 +291,7 @@ struct MainTopBar::ClickablePeakMeter::PopupComponent: public Component,
 
 		AnalyserInfo::Ptr info;
 		bool freeze = false;
+		int numNewSamples = 0;
 		BackendProcessor* bp;
 		Colour c;
 		const bool isPost;
@@ -309,16 +310,14 @@ struct MainTopBar::ClickablePeakMeter::PopupComponent: public Component,
 
 		Spectrum2D::Parameters::Ptr getParameters() const override;
 
-#if JUCE_DEBUG
-		int counter = 0;
-#endif
-		
 		float getYPosition(float input) const override
 		{
 			return 1.0f - std::pow(input, 0.125f);
 		}
 
 		Spectrum2D::Parameters::Ptr parameters;
+		ScopedPointer<Spectrum2D::IncrementalRenderer> renderer;
+		String rendererHash;
 		Image img;
 		Rectangle<int> contentArea;
 	};
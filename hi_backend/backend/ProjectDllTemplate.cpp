@@ -8,11 +8,12 @@ static const unsigned char projectDllTemplate_jucer_lines[] =
 "    <GROUP id=\"{35679809-0FA5-3027-50B5-CF866453D7B2}\" name=\"Source\">\r\n"
 "      <FILE id=\"Sbp8Ar\" name=\"includes.h\" compile=\"0\" resource=\"0\" file=\"Source/includes.h\"/>\r\n"
 "      <FILE id=\"LviiT0\" name=\"Main.cpp\" compile=\"1\" resource=\"0\" file=\"Source/Main.cpp\"/>\r\n"
+"%NETWORK_FILES%"
 "      <FILE id=\"HrkhQ5\" name=\"RNBO.cpp\" compile=\"1\" resource=\"0\" file=\"Source/RNBO.cpp\"\r\n/>"
 "    </GROUP>\r\n"
 "  </MAINGROUP>\r\n"
 "  <EXPORTFORMATS>\r\n"
-"    <%VS_VERSION% targetFolder=\"Builds/%TARGET_FOLDER%\" IPP1ALibrary=\"%IPP_1A%\" extraCompilerFlags=\"/bigobj /cgthreads8 %MSVC_WARNINGS%\" extraDefs=\"NOMINMAX=1&#10;%EXTRA_DEFINES_WIN%&#10;WIN32_LEAN_AND_MEAN=1\" >\r\n"
+"    <%VS_VERSION% targetFolder=\"Builds/%TARGET_FOLDER%\" IPP1ALibrary=\"%IPP_1A%\" extraCompilerFlags=\"/bigobj /cgthreads8 /MP %MSVC_WARNINGS%\" extraDefs=\"NOMINMAX=1&#10;%EXTRA_DEFINES_WIN%&#10;WIN32_LEAN_AND_MEAN=1\" >\r\n"
 "      <CONFIGURATIONS>\r\n"
 "        <CONFIGURATION isDebug=\"1\" name=\"Debug\" binaryPath=\"dll\" targetName=\"%DEBUG_DLL_NAME%\" headerPath =\"%FAUST_HEADER_PATH%\" useRuntimeLibDLL=\"0\"/>\r\n"
 "		 <CONFIGURATION isDebug = \"0\" name = \"CI\" targetName=\"%CI_DLL_NAME%\" headerPath =\"%FAUST_HEADER_PATH%\" binaryPath = \"dll\"\r\n"
@@ -300,13 +300,15 @@ void DspNetworkCompileExporter::run()
 		return;
 	}
 
-	getSourceDirectory(false).deleteRecursively();
+	// The source directories are not cleared so that the files of unchanged
+	// networks keep their modification date and will not be recompiled
+	writtenFiles.clear();
+	projectNodeIds.clear();
+	networksWithExternalSamples.clear();
+
 	getSourceDirectory(false).createDirectory();
-	getSourceDirectory(true).deleteRecursively();
 	getSourceDirectory(true).createDirectory();
 
-	
-
 	showStatusMessage("Unload DLL");
 
 	
@@ -426,11 +428,15 @@ void DspNetworkCompileExporter::run()
 
 			faustClassIds.insert(r.faustClassIds->begin(), r.faustClassIds->end());
 
+			if (!b.getExternalSampleList().isEmpty())
+				networksWithExternalSamples.add(id);
+
 			externalSamples.addArray(b.getExternalSampleList());
 			
+			projectNodeIds[id] = getProjectNodeIds(v);
 
 			if (r.r.wasOk())
-				f.replaceWithText(r.code);
+				writeIfChanged(f, r.code);
 			else
             {
                 ok = ErrorCodes::ProjectXmlInvalid;
@@ -532,9 +538,8 @@ void DspNetworkCompileExporter::run()
         showStatusMessage("Writing embedded audio data file");
         
 		auto eadFile = getSourceDirectory(true).getChildFile("embedded_audiodata.h");
-		eadFile.deleteFile();
 
-		FileOutputStream fos(eadFile);
+		MemoryOutputStream fos;
 
 		fos << "// Embedded audiodata" << "\n";
 
@@ -555,9 +560,11 @@ void DspNetworkCompileExporter::run()
 		}
 
 		fos << "}\n";
-		fos.flush();
 
-		eadFile.copyFileTo(getSourceDirectory(false).getChildFile("embedded_audiodata.h"));
+		auto content = fos.toString();
+
+		writeIfChanged(eadFile, content);
+		writeIfChanged(getSourceDirectory(false).getChildFile("embedded_audiodata.h"), content);
 	}
 
 	for (auto u : unsortedListU)
@@ -614,7 +621,7 @@ void DspNetworkCompileExporter::run()
 			s.flushIfNot();
 			n.flushIfNot();
 			
-			f.replaceWithText(c.toString());
+			writeIfChanged(f, c.toString());
 
 			includedFiles.add(f);
 		}
@@ -624,18 +631,26 @@ void DspNetworkCompileExporter::run()
 
 	createProjucerFile();
 
-	for (auto l : getSourceDirectory(true).findChildFiles(File::findFiles, true, "*.h"))
+	auto filesToCopy = writtenFiles;
+
+	for (auto l : filesToCopy)
 	{
+		if (!l.isAChildOf(getSourceDirectory(true)) || !l.hasFileExtension(".h"))
+			continue;
+
 		auto target = getSourceDirectory(false).getChildFile(l.getFileName());
 
+		writeIfChanged(target, l.loadFileAsString());
+
 		if (isInterpretedDataFile(target))
-			l.moveFileTo(target);
-		else
-			l.copyFileTo(target);
+		{
+			l.deleteFile();
+			writtenFiles.removeAllInstancesOf(l);
+		}
 	}
 
-	createIncludeFile(getSourceDirectory(true));
-	createIncludeFile(getSourceDirectory(false));
+	createIncludeFile(getSourceDirectory(true), false);
+	createIncludeFile(getSourceDirectory(false), true);
 
 
 	try
@@ -657,6 +672,10 @@ void DspNetworkCompileExporter::run()
 	}
 
 	createMainCppFile(true);
+	createNetworkCppFiles();
+
+	removeStaleFiles(getSourceDirectory(true));
+	removeStaleFiles(getSourceDirectory(false));
 
     silentMode = true;
     
@@ -756,7 +775,7 @@ bool DspNetworkCompileExporter::isInterpretedDataFile(const File& f)
 	return f.getFileNameWithoutExtension().endsWith("_networkdata");
 }
 
-void DspNetworkCompileExporter::createIncludeFile(const File& sourceDir)
+void DspNetworkCompileExporter::createIncludeFile(const File& sourceDir, bool includeAllNetworkFiles)
 {
 	File includeFile = sourceDir.getChildFile("includes.h");
 
@@ -775,7 +794,14 @@ void DspNetworkCompileExporter::createIncludeFile(const File& sourceDir)
     i.addEmptyLine();
     
 
-    auto fileList = sourceDir.findChildFiles(File::findFiles, false, "*.h");
+	Array<File> fileList;
+
+	// Skip the leftovers from previous exports
+	for (auto& f : writtenFiles)
+	{
+		if (f.getParentDirectory() == sourceDir && f.hasFileExtension(".h"))
+			fileList.add(f);
+	}
 
 	auto thirdPartyFiles = getFolder(BackendDllManager::FolderSubType::ThirdParty).findChildFiles(File::findFiles, false, "*.h");
 
@@ -810,7 +836,7 @@ void DspNetworkCompileExporter::createIncludeFile(const File& sourceDir)
 			}
 			
 			auto fInDir = sourceDir.getChildFile(f.getFileName());
-			fInDir.replaceWithText(dummyInclude.toString());
+			writeIfChanged(fInDir, dummyInclude.toString());
 			cppgen::Include m2(i, sourceDir, fInDir);
 		}
 	}
@@ -820,9 +846,27 @@ void DspNetworkCompileExporter::createIncludeFile(const File& sourceDir)
 
 	somethingFound = false;
 
+	StringArray mainUnitNetworks;
+
+	if (!includeAllNetworkFiles)
+	{
+		for (auto& nf : includedFiles)
+		{
+			auto id = nf.getFileNameWithoutExtension();
+
+			if (!isInterpretedDataFile(nf) && isCompiledInMainUnit(id))
+			{
+				mainUnitNetworks.addArray(getNetworkDependencies(id));
+				mainUnitNetworks.add(id);
+			}
+		}
+	}
+
 	for (auto& f : fileList)
 	{
-		if (getLocationType(f) == CompiledNetworkFile)
+		auto isIncluded = includeAllNetworkFiles || mainUnitNetworks.contains(f.getFileNameWithoutExtension());
+
+		if (isIncluded && getLocationType(f) == CompiledNetworkFile)
 		{
 			if (!somethingFound)
 			{
@@ -842,7 +886,7 @@ void DspNetworkCompileExporter::createIncludeFile(const File& sourceDir)
     i << "#pragma clang diagnostic pop";
 	i << "#endif";
     
-	includeFile.replaceWithText(i.toString());
+	writeIfChanged(includeFile, i.toString());
 }
 
 void DspNetworkCompileExporter::createProjucerFile()
@@ -891,6 +935,21 @@ void DspNetworkCompileExporter::createProjucerFile()
 	REPLACE_WILDCARD_WITH_STRING("%HISE_PATH%", hisePath.getFullPathName());
 	REPLACE_WILDCARD_WITH_STRING("%JUCE_PATH%", jucePath.getFullPathName());
 
+	String networkFiles;
+
+	for (auto& f : includedFiles)
+	{
+		if (isInterpretedDataFile(f) || isCompiledInMainUnit(f.getFileNameWithoutExtension()))
+			continue;
+
+		auto fileName = f.withFileExtension(".cpp").getFileName();
+
+		networkFiles << "      <FILE id=\"N" << String::toHexString(fileName.hashCode()) << "\" name=\"" << fileName;
+		networkFiles << "\" compile=\"1\" resource=\"0\" file=\"Source/" << fileName << "\"/>\r\n";
+	}
+
+	REPLACE_WILDCARD_WITH_STRING("%NETWORK_FILES%", networkFiles);
+
 	String s = GET_HISE_SETTING(getMainController()->getMainSynthChain(), HiseSettings::Project::ExtraDefinitionsNetworkDll).toString();
 
 	REPLACE_WILDCARD_WITH_STRING("%EXTRA_DEFINES_LINUX%", s);
@@ -924,7 +983,7 @@ void DspNetworkCompileExporter::createProjucerFile()
 
 	auto targetFile = getFolder(BackendDllManager::FolderSubType::Binaries).getChildFile("AutogeneratedProject.jucer");
 
-	targetFile.replaceWithText(templateProject);
+	writeIfChanged(targetFile, templateProject);
 }
 
 juce::File DspNetworkCompileExporter::getSourceDirectory(bool isDllMainFile) const
@@ -974,6 +1033,23 @@ void DspNetworkCompileExporter::createMainCppFile(bool isDllMainFile)
     
 	b.addEmptyLine();
 
+	if (isDllMainFile && !includedFiles.isEmpty())
+	{
+		b.addComment("Compiled network registrations", snex::cppgen::Base::CommentType::FillTo80);
+
+		Namespace n(b, "project", false);
+
+		for (auto& nf : includedFiles)
+		{
+			if (isCompiledInMainUnit(nf.getFileNameWithoutExtension()))
+				continue;
+
+			String def;
+			def << "void " << getRegisterFunctionName(nf.getFileNameWithoutExtension()) << "(scriptnode::dll::StaticLibraryHostFactory& f);";
+			b << def;
+		}
+	}
+
 	{
 		b.addComment("Project Factory", snex::cppgen::Base::CommentType::FillTo80);
 
@@ -1076,34 +1152,17 @@ void DspNetworkCompileExporter::createMainCppFile(bool isDllMainFile)
 
 			for (int i = 0; i < includedFiles.size(); i++)
 			{
-				auto networkFile = getFolder(BackendDllManager::FolderSubType::Networks).getChildFile(includedFiles[i].getFileNameWithoutExtension()).withFileExtension("xml");
-
-				auto isPolyNode = includedFiles[i].loadFileAsString().contains("polyphonic template declaration");
-				auto illegalPoly = isPolyNode && !BackendDllManager::allowPolyphonic(networkFile);
-				
-				String classId = "project::" + includedFiles[i].getFileNameWithoutExtension();
-
-				String def;
+				auto id = includedFiles[i].getFileNameWithoutExtension();
 
-				String methodPrefix = "register";
-
-				if (isInterpretedDataFile(includedFiles[i]))
-					methodPrefix << "Data";
-
-				if (!isPolyNode)
-					def << methodPrefix << "Node<" << classId << ">();";
-				else
+				if (isDllMainFile && !isInterpretedDataFile(includedFiles[i]) && !isCompiledInMainUnit(id))
 				{
-					def << methodPrefix << "PolyNode<" << classId << "<1>, ";
-					
-					if (illegalPoly)
-						def << "wrap::illegal_poly<" << classId << "<1>>>();";
-					else
-						def << classId << "<NUM_POLYPHONIC_VOICES>>();";
+					// The compiled networks are registered in their own translation unit
+					String def;
+					def << getRegisterFunctionName(id) << "(*this);";
+					b << def;
 				}
-					
-
-				b << def;
+				else
+					b << getNetworkRegistration(includedFiles[i]);
 			}
 		}
 	}
@@ -1251,7 +1310,7 @@ void DspNetworkCompileExporter::createMainCppFile(bool isDllMainFile)
 	b << "#endif";
     b.addEmptyLine();
     
-	f.replaceWithText(b.toString());
+	writeIfChanged(f, b.toString());
     
     auto rnboSibling = f.getSiblingFile("RNBO.cpp");
     
@@ -1270,12 +1329,208 @@ void DspNetworkCompileExporter::createMainCppFile(bool isDllMainFile)
         
         Include(r, sourceDirectory, rroot.getChildFile("RNBO.cpp"));
         
-        rnboSibling.replaceWithText(r.toString());
+        writeIfChanged(rnboSibling, r.toString());
     }
     else
     {
-        rnboSibling.replaceWithText("");
+        writeIfChanged(rnboSibling, "");
     }
 }
 
+juce::String DspNetworkCompileExporter::getNetworkRegistration(const File& includedFile) const
+{
+	auto networkFile = getFolder(BackendDllManager::FolderSubType::Networks).getChildFile(includedFile.getFileNameWithoutExtension()).withFileExtension("xml");
+
+	auto isPolyNode = includedFile.loadFileAsString().contains("polyphonic template declaration");
+	auto illegalPoly = isPolyNode && !BackendDllManager::allowPolyphonic(networkFile);
+	
+	String classId = "project::" + includedFile.getFileNameWithoutExtension();
+
+	String def;
+
+	String methodPrefix = "register";
+
+	if (isInterpretedDataFile(includedFile))
+		methodPrefix << "Data";
+
+	if (!isPolyNode)
+		def << methodPrefix << "Node<" << classId << ">();";
+	else
+	{
+		def << methodPrefix << "PolyNode<" << classId << "<1>, ";
+		
+		if (illegalPoly)
+			def << "wrap::illegal_poly<" << classId << "<1>>>();";
+		else
+			def << classId << "<NUM_POLYPHONIC_VOICES>>();";
+	}
+
+	return def;
+}
+
+juce::String DspNetworkCompileExporter::getRegisterFunctionName(const String& networkId)
+{
+	return "register_" + networkId;
+}
+
+juce::StringArray DspNetworkCompileExporter::getProjectNodeIds(const ValueTree& v)
+{
+	StringArray ids;
+
+	valuetree::Helpers::forEach(v, [&ids](const ValueTree& c)
+	{
+		auto p = c[scriptnode::PropertyIds::FactoryPath].toString();
+
+		if (p.startsWith("project."))
+			ids.addIfNotAlreadyThere(p.fromFirstOccurrenceOf("project.", false, false));
+
+		// Faust nodes reference their third party class with this property
+		if (c.getType() == scriptnode::PropertyIds::Property && c[scriptnode::PropertyIds::ID].toString() == "ClassId")
+			ids.addIfNotAlreadyThere(c[scriptnode::PropertyIds::Value].toString());
+
+		return false;
+	});
+
+	return ids;
+}
+
+juce::StringArray DspNetworkCompileExporter::getNetworkDependencies(const String& networkId) const
+{
+	StringArray dependencies, visited;
+
+	std::function<void(const String&)> addRecursive = [&](const String& id)
+	{
+		visited.add(id);
+
+		auto it = projectNodeIds.find(id);
+
+		if (it == projectNodeIds.end())
+			return;
+
+		for (auto& d : it->second)
+		{
+			// Only other compiled networks are dependencies, the third party nodes are included anyways
+			if (visited.contains(d) || projectNodeIds.find(d) == projectNodeIds.end())
+				continue;
+
+			addRecursive(d);
+			dependencies.add(d);
+		}
+	};
+
+	addRecursive(networkId);
+
+	return dependencies;
+}
+
+bool DspNetworkCompileExporter::isCompiledInMainUnit(const String& networkId) const
+{
+	auto ids = getNetworkDependencies(networkId);
+	ids.insert(0, networkId);
+
+	for (auto& id : ids)
+	{
+		if (networksWithExternalSamples.contains(id))
+			return true;
+
+		auto it = projectNodeIds.find(id);
+
+		if (it == projectNodeIds.end())
+			continue;
+
+		for (auto& tpf : includedThirdPartyFiles)
+		{
+			if (it->second.contains(tpf.getFileNameWithoutExtension()))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+void DspNetworkCompileExporter::createNetworkCppFiles()
+{
+	using namespace cppgen;
+
+	auto sourceDirectory = getSourceDirectory(true);
+
+	for (auto& nf : includedFiles)
+	{
+		jassert(!isInterpretedDataFile(nf));
+
+		auto id = nf.getFileNameWithoutExtension();
+
+		if (isCompiledInMainUnit(id))
+			continue;
+
+		auto dependencies = getNetworkDependencies(id);
+
+		Base b(Base::OutputType::AddTabs);
+
+		b.setHeader([id]() { return "/** Autogenerated translation unit for the network " + id + ". */"; });
+
+		b.addEmptyLine();
+
+		// The networks in this unit don't use third party nodes, so we don't need to include hi_faust or the third party headers
+		Include(b, "AppConfig.h");
+		Include(b, "hi_dsp_library/hi_dsp_library.h");
+
+		b << "#if (defined (_WIN32) || defined (_WIN64))";
+		b << "#pragma warning( push )";
+		b << "#pragma warning( disable : 4189 4373)";
+		b << "#else";
+		b << "#pragma clang diagnostic push";
+		b << "#pragma clang diagnostic ignored \"-Wunused-variable\"";
+		b << "#endif";
+
+		for (auto& d : dependencies)
+			Include(b, sourceDirectory, sourceDirectory.getChildFile(d).withFileExtension(".h"));
+
+		Include(b, sourceDirectory, nf);
+
+		b << "#if (defined (_WIN32) || defined (_WIN64))";
+		b << "#pragma warning( pop )";
+		b << "#else";
+		b << "#pragma clang diagnostic pop";
+		b << "#endif";
+
+		b.addEmptyLine();
+
+		{
+			Namespace n(b, "project", false);
+
+			String def;
+			def << "void " << getRegisterFunctionName(id) << "(scriptnode::dll::StaticLibraryHostFactory& f)";
+			b << def;
+
+			{
+				StatementBlock sb(b);
+				b << "f." + getNetworkRegistration(nf);
+			}
+		}
+
+		writeIfChanged(nf.withFileExtension(".cpp"), b.toString());
+	}
+}
+
+void DspNetworkCompileExporter::writeIfChanged(const File& f, const String& content)
+{
+	writtenFiles.addIfNotAlreadyThere(f);
+
+	// replaceWithText() removes the carriage returns, so we need to do the same before comparing the hashes
+	if (f.existsAsFile() && f.loadFileAsString().hashCode64() == content.removeCharacters("\r").hashCode64())
+		return;
+
+	f.replaceWithText(content);
+}
+
+void DspNetworkCompileExporter::removeStaleFiles(const File& sourceDir)
+{
+	for (auto& f : sourceDir.findChildFiles(File::findFiles, true))
+	{
+		if (!writtenFiles.contains(f))
+			f.deleteFile();
+	}
+}
+
 }
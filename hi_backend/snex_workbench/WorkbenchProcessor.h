@@ -147,7 +147,8 @@ private:
 
 	static bool isInterpretedDataFile(const File& f);
 
-	void createIncludeFile(const File& sourceDir);
+	/** Creates the includes.h file. If includeAllNetworkFiles is false, it only includes the networks that are compiled in Main.cpp (and their dependencies). */
+	void createIncludeFile(const File& sourceDir, bool includeAllNetworkFiles);
 
 	void createProjucerFile();
 
@@ -161,6 +162,35 @@ private:
 
 	void createMainCppFile(bool isDllMainFile);
 
+	/** Creates a translation unit for each compiled network so that the build system can compile them in parallel. */
+	void createNetworkCppFiles();
+
+	String getNetworkRegistration(const File& includedFile) const;
+
+	static String getRegisterFunctionName(const String& networkId);
+
+	static StringArray getProjectNodeIds(const ValueTree& v);
+
+	/** Returns all compiled networks that are used by the given network (sorted so that they can be included in this order). */
+	StringArray getNetworkDependencies(const String& networkId) const;
+
+	/** Checks whether the network (or one of its dependencies) uses a third party node or embedded audio data.
+	
+		These networks are compiled in Main.cpp, which already includes the third party headers and the audio
+		data. Otherwise every unit would get its own copy of their non-inline functions and static data.
+	*/
+	bool isCompiledInMainUnit(const String& networkId) const;
+
+	/** Writes the file only if the content has changed so that it keeps its modification date. */
+	void writeIfChanged(const File& f, const String& content);
+
+	/** Removes all files from previous exports that were not written by this export. */
+	void removeStaleFiles(const File& sourceDir);
+
+	Array<File> writtenFiles;
+	std::map<String, StringArray> projectNodeIds;
+	StringArray networksWithExternalSamples;
+
 	snex::cppgen::CustomNodeProperties nodeProperties;
 };
 
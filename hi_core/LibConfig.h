@@ -139,6 +139,11 @@
 #define USE_MOD2_WAVETABLESIZE 1
 #endif
 
+// Enable this to render the wavetable synth with band limited mipmap tables for higher pitches
+#ifndef HISE_USE_WAVETABLE_MIPMAPS
+#define HISE_USE_WAVETABLE_MIPMAPS 0
+#endif
+
 // Enable this if you want to use the old event notification system for HISE modules (aka hise::Processor)
 #define HISE_OLD_PROCESSOR_DISPATCH 0
 // Enable this if you want to use the new event notification system using the hise::dispatch::library::Processor class
@@ -135,6 +135,18 @@ but will not modify or delete user-created user presets (with the exception of a
 #define HISE_OVERWRITE_OLD_USER_PRESETS 0
 #endif
 
+/** Config: HISE_SKIP_UNCHANGED_STATE_RESTORE
+
+If true, then the plugin will skip restoring the parts of the plugin state that are identical to the current state. Every section
+(MIDI automation, modules, interface values, MPE data) is compared against a fresh export of the current state, so a section that was
+changed since the last export will still be restored. This is disabled by default because the control callbacks and module restore
+functions will not be executed for the skipped parts (also in a freshly created instance), so only enable it if your project doesn't
+rely on them being called on every state restore.
+*/
+#ifndef HISE_SKIP_UNCHANGED_STATE_RESTORE
+#define HISE_SKIP_UNCHANGED_STATE_RESTORE 0
+#endif
+
 /** Config: HISE_BACKEND_AS_FX
  
  Set this to 1 in order to use HISE as a effect plugin. This will simulate the processing setup of an FX plugin (so child sound generators will not be processed etc).
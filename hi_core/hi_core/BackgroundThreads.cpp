@@ -1286,6 +1286,9 @@ void SampleDataImporter::run()
 	data.partProgress = &partProgress;
 	data.totalProgress = &totalProgress;
 
+	SharedResourcePointer<SharedWorkerPool> workerPool;
+	data.threadPool = &workerPool->getThreadPool();
+
 #if USE_BACKEND
 	data.debugLogMode = getComboBoxComponent("verify")->getSelectedItemIndex() == 1;
 #endif
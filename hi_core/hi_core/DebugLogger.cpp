@@ -696,6 +696,12 @@ void DebugLogger::startLogging()
 
 	fos << getHeader();
 	fos << getSystemSpecs();
+
+	// Record the audio callback input next to the log file so that CPU spikes can be reproduced
+	auto r = getMainController()->getRenderInputRecorder().startRecording(currentLogFile.withFileExtension("hiserec"));
+
+	if (r.failed())
+		logMessage(r.getErrorMessage());
 	
 
 	pendingFailures.ensureStorageAllocated(200);
@@ -867,6 +873,8 @@ void DebugLogger::stopLogging()
 	currentlyLogging = false;
 	stopTimer();
 
+	getMainController()->getRenderInputRecorder().stopRecording();
+
 	for (int i = 0; i < listeners.size(); i++)
 	{
 		if (listeners[i].get() != nullptr)
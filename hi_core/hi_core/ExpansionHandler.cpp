@@ -446,6 +446,9 @@ bool ExpansionHandler::installFromResourceFile(const File& resourceFile, const F
 			data.partProgress = &unused;
 			data.sourceFile = resourceFile;
 
+			SharedResourcePointer<SharedWorkerPool> workerPool;
+			data.threadPool = &workerPool->getThreadPool();
+
 			auto currentThread = Thread::getCurrentThread();
 
 			if (currentThread == nullptr)
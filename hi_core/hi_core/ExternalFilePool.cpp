@@ -831,10 +831,16 @@ juce::Result PoolBase::DataProvider::restorePool(InputStream* ownedInputStream)
 	jassert(metadata.getType() == Identifier("PoolData"));
 
 	static const Identifier hc("HashCode");
+	static const Identifier id("ID");
 
-	for (const auto& item : metadata)
+	hashCodes.clear();
+	itemIndexes.clear();
+
+	for (int i = 0; i < metadata.getNumChildren(); i++)
 	{
-		hashCodes.add(item.getProperty(hc));
+		auto item = metadata.getChild(i);
+		hashCodes.set((int64)item.getProperty(hc), i);
+		itemIndexes.set(item.getProperty(id).toString(), i);
 	}
 
 	metadataOffset = input->getPosition();
@@ -848,7 +854,7 @@ juce::MemoryInputStream* PoolBase::DataProvider::createInputStream(const String&
 {
 	if (metadata.isValid())
 	{
-		auto item = metadata.getChildWithProperty("ID", referenceString);
+		auto item = getMetadataItem(referenceString);
 
 		if (item.isValid())
 		{
@@ -888,6 +894,7 @@ juce::Result PoolBase::DataProvider::writePool(OutputStream* ownedOutputStream,
 	MemoryOutputStream dataOutputStream;
 
 	metadata = ValueTree("PoolData");
+	itemIndexes.clear();
 
 	for (int i = 0; i < pool->getNumLoadedFiles(); i++)
 	{
@@ -923,6 +930,7 @@ juce::Result PoolBase::DataProvider::writePool(OutputStream* ownedOutputStream,
 		dataOutputStream.write(itemData.getData(), itemData.getDataSize());
 		child.setProperty("ChunkEnd", dataOutputStream.getPosition(), nullptr);
 
+		itemIndexes.set(ref.getReferenceString(), metadata.getNumChildren());
 		metadata.addChild(child, -1, nullptr);
 	}
 
@@ -962,7 +970,7 @@ juce::Result PoolBase::DataProvider::writePool(OutputStream* ownedOutputStream,
 
 var PoolBase::DataProvider::createAdditionalData(PoolReference r)
 {
-	auto item = metadata.getChildWithProperty("ID", r.getReferenceString());
+	auto item = getMetadataItem(r.getReferenceString());
 
 	if (item.isValid())
 	{
@@ -980,6 +988,14 @@ var PoolBase::DataProvider::createAdditionalData(PoolReference r)
 	return var();
 }
 
+juce::ValueTree PoolBase::DataProvider::getMetadataItem(const String& referenceString) const
+{
+	if (itemIndexes.contains(referenceString))
+		return metadata.getChild(itemIndexes[referenceString]);
+
+	return {};
+}
+
 Array<hise::PoolReference> PoolBase::DataProvider::getListOfAllEmbeddedReferences() const
 {
 	Array<PoolReference> references;
@@ -377,12 +377,19 @@ public:
         
     private:
         
+        /** Returns the metadata child for the given ID using the item index. */
+        ValueTree getMetadataItem(const String& referenceString) const;
+        
         ValueTree metadata;
         int64 metadataOffset;
         
         PoolBase* pool = nullptr;
         ScopedPointer<InputStream> input;
-        Array<int64> hashCodes;
+        
+        // the hash codes of all embedded references and the index of their metadata child
+        HashMap<int64, int> hashCodes;
+        HashMap<String, int> itemIndexes;
+        
         size_t embeddedSize = 0;
         
         ScopedPointer<Compressor> compressor;
@@ -534,22 +541,13 @@ public:
     
     bool contains(int64 hashCode)
     {
-        for (const auto& i : sharedItems)
-        {
-            if (i->ref.getHashCode() == hashCode)
-                return true;
-        }
-        
-        return false;
+        return sharedItems.contains(hashCode);
     }
     
     PoolEntry<DataType>* getSharedData(int64 hashCode)
     {
-        for (const auto& i: sharedItems)
-        {
-            if (i->ref.getHashCode() == hashCode)
-                return i;
-        }
+        if (auto i = sharedItems[hashCode])
+            return i.get();
         
         jassertfalse;
         return {};
@@ -557,10 +555,12 @@ public:
     
     void store(PoolEntry<DataType>* newEntry)
     {
-        if (contains(newEntry->ref.getHashCode()))
+        auto hashCode = newEntry->ref.getHashCode();
+        
+        if (contains(hashCode))
             return;
         
-        sharedItems.add(newEntry);
+        sharedItems.set(hashCode, newEntry);
     }
     
     ~SharedCache()
@@ -573,7 +573,7 @@ private:
     
     
     
-    ReferenceCountedArray<PoolEntry<DataType>> sharedItems;
+    HashMap<int64, ReferenceCountedObjectPtr<PoolEntry<DataType>>> sharedItems;
 };
 
 
@@ -644,7 +644,7 @@ public:
     
     Identifier getFileTypeName() const override;
     
-    /** Returns the number of loaded files. */
+    /** Returns the number of files in the pool. This includes the embedded references that haven't been decompressed yet. */
     int getNumLoadedFiles() const override;
     
     /** Clears the pool. */
@@ -668,6 +668,7 @@ public:
     
     StringArray getTextDataForId(int index) const override;
     
+    /** Adds all embedded references to the pool. The data is decompressed when it's used for the first time. */
     void loadAllFilesFromDataProvider();
     
     void loadAllFilesFromProjectFolder();
@@ -695,6 +696,26 @@ public:
     
 private:
     
+    /** Returns the first item with the given hash code using the hash index. */
+    PoolItem* getItem(int64 hashCode) const;
+    
+    void addToIndex(PoolItem* item);
+    
+    void clearIndex();
+    
+    /** Checks whether the item is still in the pool (and not only in the shared cache). */
+    bool isInPool(const PoolItem* item) const;
+    
+    void removePendingReference(int64 hashCode);
+    
+    /** Decompresses the pending reference and puts the item at the index the reference had before. */
+    void loadPendingReference(PoolReference r);
+    
+    int getPendingIndex(int64 hashCode) const;
+    
+    /** Converts the pool index to the index in the weak pool or the pending list. */
+    int getListIndex(int index, bool& isPending) const;
+    
     bool allFilesLoaded = false;
     
     SharedResourcePointer<SharedCache<DataType>> sharedCache;
@@ -704,6 +725,25 @@ private:
     Array<ManagedPtr> weakPool;
     Array<ManagedPtr> refCountedPool;
     
+    // getItem() repairs the index from const methods, so it needs its own lock
+    CriticalSection itemIndexLock;
+    mutable HashMap<int64, WeakReference<PoolItem>> itemIndex;
+    
+    /** An embedded reference that will be decompressed when it's used for the first time.
+        It stores the number of loaded items that come before it so that the index based
+        access keeps the order of the embedded data.
+    */
+    struct PendingReference
+    {
+        PoolReference ref;
+        int numLoadedBefore = 0;
+    };
+    
+    // guards the pending references and keeps two threads from decompressing the same reference
+    CriticalSection pendingLock;
+    HashMap<int64, PoolReference> pendingReferences;
+    Array<PendingReference> pendingList;
+    
     
     ProjectHandler::SubDirectories type;
     
@@ -187,7 +187,8 @@ Identifier SharedPoolBase<DataType>::getFileTypeName() const
 template <class DataType>
 int SharedPoolBase<DataType>::getNumLoadedFiles() const
 {
-    return weakPool.size();
+    ScopedLock sl(pendingLock);
+    return weakPool.size() + pendingList.size();
 }
 
 template <class DataType>
@@ -198,6 +199,14 @@ void SharedPoolBase<DataType>::clearData()
     refCountedPool.clear();
 
     weakPool.clear();
+    clearIndex();
+
+    {
+        ScopedLock sl(pendingLock);
+        pendingReferences.clear();
+        pendingList.clear();
+    }
+
     allFilesLoaded = false;
     sendPoolChangeMessage(Removed);
 }
@@ -221,20 +230,68 @@ void SharedPoolBase<DataType>::refreshPoolAfterUpdate(PoolReference r)
 template <class DataType>
 bool SharedPoolBase<DataType>::contains(int64 hashCode) const
 {
-    for (int i = 0; i < getNumLoadedFiles(); i++)
     {
-        if (weakPool.getReference(i).getRef().getHashCode() == hashCode)
+        ScopedLock sl(pendingLock);
+
+        if (pendingReferences.contains(hashCode))
             return true;
     }
 
-    return false;
+    return getItem(hashCode) != nullptr;
+}
+
+template <class DataType>
+int SharedPoolBase<DataType>::getListIndex(int index, bool& isPending) const
+{
+    // The pending reference i sits at numLoadedBefore + i, the
+    // loaded items fill the gaps between the pending references.
+    int numPendingBefore = 0;
+
+    for (int i = 0; i < pendingList.size(); i++)
+    {
+        auto pendingPosition = pendingList.getReference(i).numLoadedBefore + i;
+
+        if (pendingPosition == index)
+        {
+            isPending = true;
+            return i;
+        }
+
+        if (pendingPosition > index)
+            break;
+
+        numPendingBefore++;
+    }
+
+    isPending = false;
+    return index - numPendingBefore;
+}
+
+template <class DataType>
+int SharedPoolBase<DataType>::getPendingIndex(int64 hashCode) const
+{
+    for (int i = 0; i < pendingList.size(); i++)
+    {
+        if (pendingList.getReference(i).ref.getHashCode() == hashCode)
+            return i;
+    }
+
+    return -1;
 }
 
 template <class DataType>
 PoolReference SharedPoolBase<DataType>::getReference(int index) const
 {
-    if (index >= 0 && index < getNumLoadedFiles())
-        return weakPool.getReference(index).getRef();
+    ScopedLock sl(pendingLock);
+
+    bool isPending;
+    auto listIndex = getListIndex(index, isPending);
+
+    if (isPending)
+        return pendingList.getReference(listIndex).ref;
+
+    if (isPositiveAndBelow(listIndex, weakPool.size()))
+        return weakPool.getReference(listIndex).getRef();
 
     return PoolReference();
 }
@@ -242,22 +299,146 @@ PoolReference SharedPoolBase<DataType>::getReference(int index) const
 template <class DataType>
 int SharedPoolBase<DataType>::indexOf(PoolReference ref) const
 {
-    for (int i = 0; i < getNumLoadedFiles(); i++)
+    if (!contains(ref.getHashCode()))
+        return -1;
+
+    ScopedLock sl(pendingLock);
+
+    for (int i = 0; i < pendingList.size(); i++)
+    {
+        const auto& p = pendingList.getReference(i);
+
+        if (p.ref == ref)
+            return p.numLoadedBefore + i;
+    }
+
+    for (int i = 0; i < weakPool.size(); i++)
     {
         if (weakPool.getReference(i).getRef() == ref)
-            return i;
+        {
+            int numPendingBefore = 0;
+
+            for (const auto& p : pendingList)
+            {
+                if (p.numLoadedBefore <= i)
+                    numPendingBefore++;
+            }
+
+            return i + numPendingBefore;
+        }
     }
 
     return -1;
 }
 
 template <class DataType>
-var SharedPoolBase<DataType>::getAdditionalData(PoolReference r) const
+typename SharedPoolBase<DataType>::PoolItem* SharedPoolBase<DataType>::getItem(int64 hashCode) const
 {
-    auto i = indexOf(r);
+    ScopedLock sl(itemIndexLock);
+
+    if (!itemIndex.contains(hashCode))
+        return nullptr;
 
-    if (i >= 0)
-        return weakPool.getReference(i).getAdditionalData();
+    if (auto item = itemIndex[hashCode].get())
+        return item;
+
+    // The indexed item was deleted, so we need to look for another
+    // item with the same hash code (or remove it from the index)
+    for (const auto& p : weakPool)
+    {
+        if (p && p.getRef().getHashCode() == hashCode)
+        {
+            itemIndex.set(hashCode, const_cast<PoolItem*>(p.get()));
+            return const_cast<PoolItem*>(p.get());
+        }
+    }
+
+    itemIndex.remove(hashCode);
+    return nullptr;
+}
+
+template <class DataType>
+void SharedPoolBase<DataType>::addToIndex(PoolItem* item)
+{
+    auto hashCode = item->ref.getHashCode();
+
+    ScopedLock sl(itemIndexLock);
+
+    if (getItem(hashCode) == nullptr)
+        itemIndex.set(hashCode, item);
+}
+
+template <class DataType>
+void SharedPoolBase<DataType>::clearIndex()
+{
+    ScopedLock sl(itemIndexLock);
+    itemIndex.clear();
+}
+
+template <class DataType>
+bool SharedPoolBase<DataType>::isInPool(const PoolItem* item) const
+{
+    if (getItem(item->ref.getHashCode()) == item)
+        return true;
+
+    // another item with the same hash code is indexed
+    for (const auto& p : weakPool)
+    {
+        if (p.get() == item)
+            return true;
+    }
+
+    return false;
+}
+
+template <class DataType>
+void SharedPoolBase<DataType>::removePendingReference(int64 hashCode)
+{
+    ScopedLock sl(pendingLock);
+
+    pendingReferences.remove(hashCode);
+
+    for (int i = 0; i < pendingList.size(); i++)
+    {
+        if (pendingList.getReference(i).ref.getHashCode() == hashCode)
+            pendingList.remove(i--);
+    }
+}
+
+template <class DataType>
+void SharedPoolBase<DataType>::loadPendingReference(PoolReference r)
+{
+    // The caller holds the lock from the pending check until the item is
+    // in the pool so that the reference is only decompressed once
+    ScopedLock sl(pendingLock);
+
+    auto pendingIndex = getPendingIndex(r.getHashCode());
+
+    if (pendingIndex == -1)
+        return;
+
+    auto insertIndex = pendingList.getReference(pendingIndex).numLoadedBefore;
+    auto numBefore = weakPool.size();
+
+    removePendingReference(r.getHashCode());
+    loadFromReference(r, PoolHelpers::LoadAndCacheStrong);
+
+    if (weakPool.size() > numBefore)
+    {
+        // Move the new item to the position of the pending reference
+        // so that getReference(i) still returns the same reference
+        weakPool.move(weakPool.size() - 1, insertIndex);
+
+        for (int i = pendingIndex; i < pendingList.size(); i++)
+            pendingList.getReference(i).numLoadedBefore++;
+    }
+}
+
+template <class DataType>
+var SharedPoolBase<DataType>::getAdditionalData(PoolReference r) const
+{
+    if (auto item = getItem(r.getHashCode()))
+        return item->additionalData;
 
     return {};
 }
@@ -267,8 +448,8 @@ Array<PoolReference> SharedPoolBase<DataType>::getListOfAllReferences(bool inclu
 {
     Array<PoolReference> references;
 
-    for (int i = 0; i < getNumLoadedFiles(); i++)
-        references.add(getReference(i));
+    for (const auto& p : weakPool)
+        references.add(p.getRef());
 
     if (includeEmbeddedButUnloadedReferences)
     {
@@ -277,6 +458,16 @@ Array<PoolReference> SharedPoolBase<DataType>::getListOfAllReferences(bool inclu
         for (const auto& r : additionalRefs)
             references.addIfNotAlreadyThere(r);
     }
+    else
+    {
+        ScopedLock sl(pendingLock);
+
+        for (int i = 0; i < pendingList.size(); i++)
+        {
+            const auto& p = pendingList.getReference(i);
+            references.insert(p.numLoadedBefore + i, p.ref);
+        }
+    }
 
     return references;
 }
@@ -284,8 +475,16 @@ Array<PoolReference> SharedPoolBase<DataType>::getListOfAllReferences(bool inclu
 template <class DataType>
 StringArray SharedPoolBase<DataType>::getTextDataForId(int index) const
 {
-    if (index >= 0 && index < getNumLoadedFiles())
-        return weakPool.getReference(index).getTextData();
+    ScopedLock sl(pendingLock);
+
+    bool isPending;
+    auto listIndex = getListIndex(index, isPending);
+
+    if (isPending)
+        return { pendingList.getReference(listIndex).ref.getReferenceString(), "not loaded", "0" };
+
+    if (isPositiveAndBelow(listIndex, weakPool.size()))
+        return weakPool.getReference(listIndex).getTextData();
 
     return {};
 }
@@ -298,8 +497,16 @@ void SharedPoolBase<DataType>::loadAllFilesFromDataProvider()
 
     auto refList = getDataProvider()->getListOfAllEmbeddedReferences();
 
+    ScopedLock sl(pendingLock);
+
     for (auto r : refList)
-        loadFromReference(r, PoolHelpers::LoadAndCacheStrong);
+    {
+        if (!contains(r.getHashCode()))
+        {
+            pendingReferences.set(r.getHashCode(), r);
+            pendingList.add(PendingReference{ r, weakPool.size() });
+        }
+    }
 }
 
 template <class DataType>
@@ -307,6 +514,13 @@ void SharedPoolBase<DataType>::loadAllFilesFromProjectFolder()
 {
     refCountedPool.clear();
     weakPool.clear();
+    clearIndex();
+
+    {
+        ScopedLock sl(pendingLock);
+        pendingReferences.clear();
+        pendingList.clear();
+    }
 
     ScopedNotificationDelayer snd(*this, EventType::Added);
 
@@ -333,8 +547,13 @@ String SharedPoolBase<DataType>::getStatistics() const
 {
     String s;
 
+    ScopedLock sl(pendingLock);
+
     s << "Size: " << weakPool.size();
 
+    if (pendingList.size() > 0)
+        s << " + " << pendingList.size() << " not loaded";
+
     size_t dataSize = 0;
 
     for (const auto& d : weakPool)
@@ -356,6 +575,14 @@ StringArray SharedPoolBase<DataType>::getIdList() const
     for (const auto& d : weakPool)
         sa.add(d.getRef().getReferenceString());
 
+    ScopedLock sl(pendingLock);
+
+    for (int i = 0; i < pendingList.size(); i++)
+    {
+        const auto& p = pendingList.getReference(i);
+        sa.insert(p.numLoadedBefore + i, p.ref.getReferenceString());
+    }
+
     return sa;
 }
 
@@ -367,23 +594,42 @@ void SharedPoolBase<DataType>::releaseIfUnused(ManagedPtr& mptr)
 
     PoolReference r(mptr.getRef());
 
-    for (int i = 0; i < weakPool.size(); i++)
+    // Use the item of the pointer: there might be multiple items with the same hash code
+    WeakReference<PoolItem> item = mptr.get();
+
+    if (item == nullptr || !isInPool(item.get()))
+        return;
+
+    mptr.clearStrongReference();
+
+    if (item.get() == nullptr)
     {
-        if (weakPool.getReference(i) == mptr)
-        {
-            mptr.clearStrongReference();
+        ScopedLock sl(pendingLock);
 
+        for (int i = 0; i < weakPool.size(); i++)
+        {
             if (weakPool.getReference(i).get() == nullptr)
             {
-                weakPool.remove(i--);
-                sendPoolChangeMessage(PoolBase::EventType::Removed, sendNotificationAsync, r);
-            }
-            else
-                sendPoolChangeMessage(PoolBase::EventType::Changed, sendNotificationAsync, r);
+                weakPool.remove(i);
 
-            return;
+                // the pending references after the removed item move up by one
+                for (auto& p : pendingList)
+                {
+                    if (p.numLoadedBefore > i)
+                        p.numLoadedBefore--;
+                }
+
+                i--;
+            }
         }
+
+        // this will update or remove the index entry
+        getItem(r.getHashCode());
+
+        sendPoolChangeMessage(PoolBase::EventType::Removed, sendNotificationAsync, r);
     }
+    else
+        sendPoolChangeMessage(PoolBase::EventType::Changed, sendNotificationAsync, r);
 }
 
 template <class DataType>
@@ -408,10 +654,15 @@ void SharedPoolBase<DataType>::writeItemToOutput(OutputStream& output, PoolRefer
 template <class DataType>
 typename SharedPoolBase<DataType>::ManagedPtr SharedPoolBase<DataType>::getWeakReferenceToItem(PoolReference r)
 {
-    auto index = indexOf(r);
+    {
+        ScopedLock sl(pendingLock);
 
-    if (index != -1)
-        return ManagedPtr(this, weakPool.getReference(index).get(), false);
+        if (pendingReferences.contains(r.getHashCode()))
+            loadPendingReference(r);
+    }
+
+    if (auto item = getItem(r.getHashCode()))
+        return ManagedPtr(this, item, false);
 
     jassertfalse;
     return ManagedPtr();
@@ -429,6 +680,7 @@ typename SharedPoolBase<DataType>::ManagedPtr SharedPoolBase<DataType>::createAs
 
     refCountedPool.add(ManagedPtr(this, ne.get(), true));
     weakPool.add(ManagedPtr(this, ne.get(), false));
+    addToIndex(ne.get());
 
     return ManagedPtr(this, ne.get(), true);
 }
@@ -445,13 +697,22 @@ typename SharedPoolBase<DataType>::ManagedPtr SharedPoolBase<DataType>::loadFrom
         return ManagedPtr(this, sharedCache->getSharedData(r.getHashCode()), true);
     }
 
-    if (PoolHelpers::shouldSearchInPool(loadingType))
     {
-        int index = indexOf(r);
+        ScopedLock sl(pendingLock);
 
-        if (index != -1)
+        if (pendingReferences.contains(r.getHashCode()))
+        {
+            // This was skipped by loadAllFilesFromDataProvider(), so we
+            // decompress it now and cache it like it would have been there
+            loadPendingReference(r);
+        }
+    }
+
+    if (PoolHelpers::shouldSearchInPool(loadingType))
+    {
+        if (auto item = getItem(r.getHashCode()))
         {
-            auto& d = weakPool.getReference(index);
+            ManagedPtr d(this, item, false);
 
             jassert(d);
 
@@ -512,6 +773,7 @@ typename SharedPoolBase<DataType>::ManagedPtr SharedPoolBase<DataType>::loadFrom
                 {
                     weakPool.add(ManagedPtr(this, ne.get(), false));
                     refCountedPool.add(ManagedPtr(this, ne.get(), true));
+                    addToIndex(ne.get());
                 }
             }
 
@@ -545,6 +807,7 @@ typename SharedPoolBase<DataType>::ManagedPtr SharedPoolBase<DataType>::loadFrom
             else
             {
                 weakPool.add(ManagedPtr(this, ne.get(), false));
+                addToIndex(ne.get());
 
                 if (PoolHelpers::isStrong(loadingType))
                     refCountedPool.add(ManagedPtr(this, ne.get(), true));
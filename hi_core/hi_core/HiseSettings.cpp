@@ -163,6 +163,7 @@ Array<juce::Identifier> HiseSettings::Scripting::getAllIds()
 
 	ids.add(EnableCallstack);
 	ids.add(EnableOptimizations);
+	ids.add(ShowCompileTimings);
 	ids.add(GlobalScriptPath);
 	ids.add(CompileTimeout);
 	ids.add(CodeFontSize);
@@ -587,6 +588,11 @@ Array<juce::Identifier> HiseSettings::SnexWorkbench::getAllIds()
 		D("> This setting is baked into a plugin when you compile it");
 		P_();
 
+		P(HiseSettings::Scripting::ShowCompileTimings);
+		D("Prints the time spent for preprocessing, parsing every included file, running the onInit callback and each optimization pass to the console after a script was compiled.");
+		D("> The included files are tokenised in the background and cached until their content changes, so the first compilation will be slower than the subsequent ones.");
+		P_();
+
 		P(HiseSettings::Scripting::EnableMousePositioning);
 		D("Sets the default value of whether the interface designer should allow dragging UI components with the mouse");
 		D("> This was always enabled, but on larger projects it's easy to accidentally drag UI elements when you really just wanted to select them so this gives you the option to remove the dragging.");
@@ -934,6 +940,7 @@ juce::StringArray HiseSettings::Data::getOptionsFor(const Identifier& id)
 		id == Other::EnableAutosave ||
 		id == Scripting::EnableDebugMode ||
 		id == Scripting::EnableOptimizations ||
+		id == Scripting::ShowCompileTimings ||
 		id == Other::AudioThreadGuardEnabled ||
 		id == Other::UseOpenGL ||
         id == Other::AutoShowWorkspace ||
@@ -1203,6 +1210,7 @@ var HiseSettings::Data::getDefaultSetting(const Identifier& id) const
 	else if (id == Scripting::CodeFontSize)			return 17.0;
 	else if (id == Scripting::EnableCallstack)		return "No";
 	else if (id == Scripting::EnableOptimizations)	return "No";
+	else if (id == Scripting::ShowCompileTimings)	return "No";
 	else if (id == Scripting::EnableMousePositioning) return "Yes";
 	else if (id == Scripting::CompileTimeout)		return 5.0;
 	else if (id == Scripting::SaveConnectedFilesOnCompile) return "No";
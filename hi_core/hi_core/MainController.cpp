@@ -110,6 +110,8 @@ bool MainController::unitTestMode = false;
 	shownComponents(0),
 	plotter(nullptr),
 	usagePercent(0),
+	renderBudgetGovernor(this),
+	renderInputRecorder(this),
 	scriptWatchTable(nullptr),
 	globalPitchFactor(1.0),
 	midiInputFlag(false),
@@ -586,7 +588,12 @@ void MainController::allNotesOff(bool resetSoftBypassState/*=false*/)
 
 void MainController::stopCpuBenchmark()
 {
-	const float thisUsage = 100.0f * (float)((Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()) - temp_usage) * getOriginalSamplerate() / cpuBufferSize.get());
+	const auto renderTime = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()) - temp_usage;
+	const float thisUsage = 100.0f * (float)(renderTime * getOriginalSamplerate() / cpuBufferSize.get());
+
+	// there's no deadline when rendering offline
+	if (!thisAsProcessor->isNonRealtime() && !getKillStateHandler().isCurrentlyExporting())
+		renderBudgetGovernor.processBlockFinished(renderTime, numSamplesThisBlock, getOriginalSamplerate());
 	
 	const float lastUsage = usagePercent.load();
 	
@@ -946,6 +953,12 @@ hise::RLottieManager::Ptr MainController::getRLottieManager()
 
 	return rLottieManager.get();
 }
+
+void MainController::releaseRLottieFrameCache()
+{
+	if (rLottieManager != nullptr)
+		rLottieManager->releaseFrameCacheMemory();
+}
 #endif
 
 void MainController::connectToRuntimeTargets(scriptnode::OpaqueNode& on, bool shouldAdd)
@@ -977,6 +990,9 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 	AudioThreadGuard audioThreadGuard(&getKillStateHandler());
 
+	// the ramps can't be added or removed while the processors read them
+	AutomationRampHandler::ScopedProcessingLock rampLock(automationRampHandler);
+
 	getSampleManager().handleNonRealtimeState();
 
 	ADD_GLITCH_DETECTOR(getMainSynthChain(), DebugLogger::Location::MainRenderCallback);
@@ -1075,6 +1091,8 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
     
 	keyboardState.processNextMidiBuffer(midiMessages, 0, numSamplesThisBlock, true);
 
+	renderInputRecorder.recordBlock(numSamplesThisBlock, midiMessages, thisAsProcessor->getPlayHead());
+
 	getMacroManager().getMidiControlAutomationHandler()->handleParameterData(midiMessages); // TODO_BUFFER: Move this after the next line...
 
 	masterEventBuffer.addEvents(midiMessages);
@@ -1101,6 +1119,8 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 	getDebugLogger().logEvents(masterEventBuffer);
 
 #else
+	renderInputRecorder.recordBlock(numSamplesThisBlock, {}, thisAsProcessor->getPlayHead());
+
 	ignoreUnused(midiMessages);
 
 	masterEventBuffer.clear();
@@ -1114,7 +1134,8 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 	bool useTime = false;
 
-    auto insideInternalExport = getKillStateHandler().isCurrentlyExporting();
+    // the render input player uses the export thread but wants to use the recorded playhead
+    auto insideInternalExport = getKillStateHandler().isCurrentlyExporting() && !renderInputRecorder.isReplaying();
     
 	if (getMasterClock().allowExternalSync() && thisAsProcessor->getPlayHead() != nullptr)
 	{
@@ -1229,6 +1250,8 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 	if (oversampler != nullptr)
 		masterEventBuffer.multiplyTimestamps(getOversampleFactor());
+
+	automationRampHandler.processBlock(numSamplesThisBlock * getOversampleFactor(), getOversampleFactor());
 	
 #if FRONTEND_IS_PLUGIN
 
@@ -1615,6 +1638,8 @@ void MainController::prepareToPlay(double sampleRate_, int samplesPerBlock)
 
 	getSpecBroadcaster().sendMessage(sendNotificationAsync, processingSampleRate, processingBufferSize.get());
 
+	automationRampHandler.prepareToPlay(processingSampleRate, processingBufferSize.get());
+
 	getMainSynthChain()->prepareToPlay(processingSampleRate, processingBufferSize.get());
 
 	AudioThreadGuard guard(&getKillStateHandler());
@@ -2245,6 +2270,25 @@ bool MainController::UserPresetHandler::saveStateManager(ValueTree& newPreset, c
 	return processStateManager(true, newPreset, id);
 }
 
+bool MainController::UserPresetHandler::restoreStateManagerIfChanged(const ValueTree& newPreset, const Identifier& id)
+{
+	ValueTree currentState(newPreset.getType());
+	saveStateManager(currentState, id);
+
+	if (isStateSectionUnchanged(newPreset.getChildWithName(id), currentState.getChildWithName(id)))
+		return false;
+
+	return restoreStateManager(newPreset, id);
+}
+
+bool MainController::UserPresetHandler::isStateSectionUnchanged(const ValueTree& newData, const ValueTree& currentData)
+{
+	if (newData.isValid() != currentData.isValid())
+		return false;
+
+	return !newData.isValid() || newData.isEquivalentTo(currentData);
+}
+
 double MainController::UserPresetHandler::getSecondsSinceLastPresetLoad() const
 {
 	auto now = Time::getMillisecondCounter();
@@ -969,6 +969,12 @@ public:
 		bool restoreStateManager(const ValueTree& presetRoot, const Identifier& stateId);
 		bool saveStateManager(ValueTree& preset, const Identifier& stateId);
 
+		/** Restores the state manager only if its state in the preset differs from the current state. Returns true if it was restored. */
+		bool restoreStateManagerIfChanged(const ValueTree& presetRoot, const Identifier& stateId);
+
+		/** Returns true if the section of the restored state is the same as the section of the current state (or if both are missing). */
+		static bool isStateSectionUnchanged(const ValueTree& newData, const ValueTree& currentData);
+
 		
 
 		UserPresetStateManager::List stateManagers;
@@ -1512,6 +1518,10 @@ public:
 	PooledUIUpdater* getGlobalUIUpdater() { return &globalUIUpdater; }
 	const PooledUIUpdater* getGlobalUIUpdater() const { return &globalUIUpdater; }
 
+	/** Returns the timing wheel that drives the script timers. */
+	TimingWheel& getTimingWheel() { return timingWheel; }
+	const TimingWheel& getTimingWheel() const { return timingWheel; }
+
 	dispatch::RootObject& getRootDispatcher() { return rootDispatcher; }
 	const dispatch::RootObject& getRootDispatcher() const { return rootDispatcher; }
 
@@ -1797,6 +1807,15 @@ public:
 	/** Returns the time that the plugin spends in its processBlock method. */
 	float getCpuUsage() const {return usagePercent.load();};
 
+	RenderBudgetGovernor& getRenderBudgetGovernor() noexcept { return renderBudgetGovernor; }
+	const RenderBudgetGovernor& getRenderBudgetGovernor() const noexcept { return renderBudgetGovernor; }
+
+	AutomationRampHandler& getAutomationRampHandler() noexcept { return automationRampHandler; }
+	const AutomationRampHandler& getAutomationRampHandler() const noexcept { return automationRampHandler; }
+
+	RenderInputRecorder& getRenderInputRecorder() noexcept { return renderInputRecorder; }
+	const RenderInputRecorder& getRenderInputRecorder() const noexcept { return renderInputRecorder; }
+
 	/** Returns the amount of playing voices. */
 	int getNumActiveVoices() const;;
 
@@ -1990,6 +2009,9 @@ public:
 
 #if HISE_INCLUDE_RLOTTIE
 	RLottieManager::Ptr getRLottieManager();
+
+	/** Releases the cached frames of all Lottie animations (eg. when the interface is closed). This will not create the manager if it wasn't used. */
+	void releaseRLottieFrameCache();
 #endif
 
 #if HISE_INCLUDE_LORIS
@@ -2006,6 +2028,7 @@ private: // Never call this directly, but wrap it through DelayedRenderer...
 	// except for the audio rendererbase as this does not need to use the outer interface
 	// (in order to avoid messing with the leftover sample logic from misbehFL!avinStudio!!1!g hosts...)
 	friend class AudioRendererBase;
+	friend class RenderInputPlayer;
 
 	/** This is the main processing loop that is shared among all subclasses. */
 	void processBlockCommon(AudioSampleBuffer &b, MidiBuffer &mb);
@@ -2120,6 +2143,7 @@ private:
 	bool embedAllResources = false;
 
 	PooledUIUpdater globalUIUpdater;
+	TimingWheel timingWheel;
 	dispatch::RootObject rootDispatcher;
 	dispatch::library::ProcessorHandler processorHandler;
 	dispatch::library::CustomAutomationSourceManager customAutomationSourceManager;
@@ -2302,6 +2326,10 @@ private:
 
     std::atomic<float> usagePercent;
 
+	RenderBudgetGovernor renderBudgetGovernor;
+	AutomationRampHandler automationRampHandler;
+	RenderInputRecorder renderInputRecorder;
+
 	bool enablePluginParameterUpdate = true;
 
     double globalPitchFactor;
@@ -891,6 +891,7 @@ void MidiControllerAutomationHandler::handleParameterData(MidiBuffer &b)
 			}
 
 			HiseEvent he(m);
+			he.setTimeStamp(samplePos);
 
 			consumed = handleControllerMessage(he);
 		}
@@ -908,6 +909,9 @@ bool MidiControllerAutomationHandler::handleControllerMessage(const HiseEvent& e
 	auto number = e.getControllerNumber();
 
     bool thisConsumed = false;
+
+	// Ramped attributes will start the ramp at the position of the CC message
+	AutomationRampHandler::ScopedSampleOffset sso(mc->getAutomationRampHandler(), (int)e.getTimeStamp());
     
 	for (auto& a : automationData[number])
 	{
@@ -1883,4 +1887,1412 @@ ScopedSoftBypassDisabler::~ScopedSoftBypassDisabler()
 	getMainController()->setAllowSoftBypassRamps(previousState);
 }
 
+RenderBudgetGovernor::RenderBudgetGovernor(MainController* mc) :
+	ControlledObject(mc),
+	SimpleTimer(mc->getGlobalUIUpdater(), false)
+{
+	optionalEffects.ensureStorageAllocated(16);
+}
+
+RenderBudgetGovernor::~RenderBudgetGovernor()
+{
+	stop();
+}
+
+String RenderBudgetGovernor::getPolicyName(Policy p)
+{
+	switch (p)
+	{
+	case Policy::KillReleasingVoices:		 return "KillReleasingVoices";
+	case Policy::ReduceInterpolationQuality: return "ReduceInterpolationQuality";
+	case Policy::BypassOptionalEffects:		 return "BypassOptionalEffects";
+	default:								 return {};
+	}
+}
+
+RenderBudgetGovernor::Policy RenderBudgetGovernor::getPolicyFromName(const String& name)
+{
+	for (int i = 0; i < NumLevels; i++)
+	{
+		if (getPolicyName((Policy)i) == name)
+			return (Policy)i;
+	}
+
+	return Policy::numPolicies;
+}
+
+void RenderBudgetGovernor::setEnabled(bool shouldBeEnabled)
+{
+	if (shouldBeEnabled == isEnabled())
+		return;
+
+	enabled.store(shouldBeEnabled);
+
+	if (shouldBeEnabled)
+		start();
+	else
+	{
+		// the audio thread will not call processBlockFinished anymore so we reset the state here
+		LockHelpers::SafeLock sl(getMainController(), LockHelpers::Type::AudioLock);
+		setLevel(0, true);
+		smoothedLoad.store(0.0f);
+		peakLoad.store(0.0f);
+		secondsBelowThreshold = 0.0;
+		secondsAboveThreshold = 0.0;
+		secondsInPeakWindow = 0.0;
+		currentWindowPeak = 0.0f;
+		lastWindowPeak = 0.0f;
+
+		stop();
+		timerCallback();
+	}
+}
+
+void RenderBudgetGovernor::setLevelThresholds(const Array<float>& newThresholds)
+{
+	for (int i = 0; i < jmin(NumLevels, newThresholds.size()); i++)
+		thresholds[i] = jlimit(0.0f, 2.0f, newThresholds[i]);
+
+	// make sure that the thresholds are ascending
+	for (int i = 1; i < NumLevels; i++)
+		thresholds[i] = jmax(thresholds[i - 1], thresholds[i]);
+}
+
+void RenderBudgetGovernor::setPolicyOrder(const Array<Policy>& newOrder)
+{
+	LockHelpers::SafeLock sl(getMainController(), LockHelpers::Type::AudioLock);
+
+	auto level = getCurrentLevel();
+	setLevel(0, true);
+
+	for (int i = 0; i < jmin(NumLevels, newOrder.size()); i++)
+		policyOrder[i] = newOrder[i];
+
+	setLevel(level, true);
+}
+
+void RenderBudgetGovernor::setReleaseBehaviour(float hysteresis, double holdTimeSeconds)
+{
+	releaseHysteresis = jlimit(0.0f, 1.0f, hysteresis);
+	releaseHoldTime = jmax(0.0, holdTimeSeconds);
+}
+
+void RenderBudgetGovernor::setEscalationHoldTime(double holdTimeSeconds)
+{
+	escalationHoldTime = jmax(0.0, holdTimeSeconds);
+}
+
+void RenderBudgetGovernor::setOptionalEffect(Processor* p, bool isOptional)
+{
+	auto fx = dynamic_cast<MasterEffectProcessor*>(p);
+
+	if (fx == nullptr)
+		return;
+
+	bool wasOptional;
+
+	{
+		SimpleReadWriteLock::ScopedWriteLock sl(optionalEffectLock);
+
+		wasOptional = optionalEffects.contains(p);
+
+		if (isOptional)
+			optionalEffects.addIfNotAlreadyThere(p);
+		else
+			optionalEffects.removeAllInstancesOf(p);
+	}
+
+	// restore the effect if it was bypassed by the governor
+	if (wasOptional && !isOptional && isPolicyActive(Policy::BypassOptionalEffects) && !p->isBypassed())
+	{
+		LockHelpers::SafeLock sl(getMainController(), LockHelpers::Type::AudioLock);
+		fx->setSoftBypass(false, true);
+	}
+}
+
+void RenderBudgetGovernor::processBlockFinished(double renderTimeSeconds, int numSamples, double sampleRate)
+{
+	if (!isEnabled() || numSamples <= 0 || sampleRate <= 0.0)
+		return;
+
+	auto blockDuration = (double)numSamples / sampleRate;
+	auto load = (float)(renderTimeSeconds / blockDuration);
+
+	// The peak is measured in windows so that a single spike doesn't stick forever
+	currentWindowPeak = jmax(currentWindowPeak, load);
+	secondsInPeakWindow += blockDuration;
+
+	if (secondsInPeakWindow >= PeakWindowSeconds)
+	{
+		lastWindowPeak = currentWindowPeak;
+		currentWindowPeak = 0.0f;
+		secondsInPeakWindow = 0.0;
+	}
+
+	peakLoad.store(jmax(lastWindowPeak, currentWindowPeak));
+
+	// rise immediately but fall smoothly so that a single fast block doesn't reset the governor
+	auto lastLoad = smoothedLoad.load();
+	auto releaseCoefficient = (float)std::exp(-blockDuration / 0.25);
+	auto thisLoad = load > lastLoad ? load : (lastLoad * releaseCoefficient + load * (1.0f - releaseCoefficient));
+
+	smoothedLoad.store(thisLoad);
+
+	TRACE_COUNTER("dsp", perfetto::CounterTrack("Render Budget Load", "%").set_is_incremental(false), 100.0f * thisLoad);
+
+	auto level = getCurrentLevel();
+
+	// If the level change fails because the optional effects are locked, the timers are not
+	// reset so that it will be tried again with the next block.
+
+	if (level < NumLevels && thisLoad > thresholds[level])
+	{
+		secondsBelowThreshold = 0.0;
+		secondsAboveThreshold += blockDuration;
+
+		if (secondsAboveThreshold >= escalationHoldTime && setLevel(level + 1))
+			secondsAboveThreshold = 0.0;
+
+		return;
+	}
+
+	secondsAboveThreshold = 0.0;
+
+	if (level > 0 && thisLoad < (thresholds[level - 1] - releaseHysteresis))
+	{
+		secondsBelowThreshold += blockDuration;
+
+		if (secondsBelowThreshold >= releaseHoldTime && setLevel(level - 1))
+			secondsBelowThreshold = 0.0;
+	}
+	else
+		secondsBelowThreshold = 0.0;
+}
+
+var RenderBudgetGovernor::getStateObject() const
+{
+	auto obj = new DynamicObject();
+
+	obj->setProperty("Enabled", isEnabled());
+	obj->setProperty("Level", getCurrentLevel());
+	obj->setProperty("Load", getCurrentLoad());
+	obj->setProperty("PeakLoad", getPeakLoad());
+	obj->setProperty("NumKilledVoices", getNumKilledVoices());
+	obj->setProperty("NumLevelChanges", getNumLevelChanges());
+
+	Array<var> policies;
+
+	for (int i = 0; i < NumLevels; i++)
+	{
+		if (isPolicyActive((Policy)i))
+			policies.add(getPolicyName((Policy)i));
+	}
+
+	obj->setProperty("ActivePolicies", var(policies));
+
+	return var(obj);
+}
+
+void RenderBudgetGovernor::timerCallback()
+{
+	auto level = getCurrentLevel();
+
+	if (level != lastNotifiedLevel)
+	{
+		lastNotifiedLevel = level;
+		levelBroadcaster.sendMessage(sendNotificationSync, level);
+	}
+}
+
+bool RenderBudgetGovernor::setLevel(int newLevel, bool waitForEffectLock)
+{
+	newLevel = jlimit(0, NumLevels, newLevel);
+
+	if (newLevel == currentLevel.load())
+		return true;
+
+	int newPolicies = 0;
+
+	for (int i = 0; i < newLevel; i++)
+		newPolicies |= (1 << (int)policyOrder[i]);
+
+	constexpr int fxMask = 1 << (int)Policy::BypassOptionalEffects;
+
+	auto fxChanged = ((newPolicies ^ activePolicies.load()) & fxMask) != 0;
+
+	if (fxChanged && !updateOptionalEffects((newPolicies & fxMask) != 0, waitForEffectLock))
+		return false;
+
+	activePolicies.store(newPolicies);
+	currentLevel.store(newLevel);
+	numLevelChanges++;
+
+	TRACE_COUNTER("dsp", perfetto::CounterTrack("Render Budget Level").set_is_incremental(false), newLevel);
+
+	return true;
+}
+
+bool RenderBudgetGovernor::updateOptionalEffects(bool shouldBeBypassed, bool waitForEffectLock)
+{
+	auto update = [&]()
+	{
+		for (auto p : optionalEffects)
+		{
+			if (auto fx = dynamic_cast<MasterEffectProcessor*>(p.get()))
+			{
+				// Don't touch effects that are bypassed by the user
+				if (!fx->isBypassed())
+					fx->setSoftBypass(shouldBeBypassed, true);
+			}
+		}
+	};
+
+	if (waitForEffectLock)
+	{
+		SimpleReadWriteLock::ScopedReadLock sl(optionalEffectLock);
+		update();
+		return true;
+	}
+
+	// The audio thread must not wait for setOptionalEffect()
+	if (auto sl = SimpleReadWriteLock::ScopedTryReadLock(optionalEffectLock))
+	{
+		update();
+		return true;
+	}
+
+	return false;
+}
+
+AutomationRampHandler::ScopedSampleOffset::ScopedSampleOffset(AutomationRampHandler& h, int sampleOffset) :
+	handler(h)
+{
+	handler.currentSampleOffset.store(jmax(0, sampleOffset));
+	handler.sampleOffsetThread.store(std::this_thread::get_id());
+}
+
+AutomationRampHandler::ScopedSampleOffset::~ScopedSampleOffset()
+{
+	handler.sampleOffsetThread.store(std::thread::id());
+	handler.currentSampleOffset.store(0);
+}
+
+AutomationRampHandler::AutomationRampHandler()
+{
+	pendingChanges.calloc(MaxNumPendingChanges);
+	blockChanges.calloc(MaxNumPendingChanges);
+}
+
+void AutomationRampHandler::addRamp(Processor* p, int attributeIndex, float currentValue, double rampTimeMilliseconds, RampMode m)
+{
+	SimpleReadWriteLock::ScopedMultiWriteLock sl(rampLock);
+
+	jassert(getRampIndex(p, attributeIndex) == -1);
+
+	Ramp r;
+	r.processor = p;
+	r.attributeIndex = attributeIndex;
+	r.mode = m;
+	r.rampTimeMilliseconds = rampTimeMilliseconds;
+	r.rampLength = roundToInt(sampleRate * rampTimeMilliseconds * 0.001);
+	r.currentValue = r.convert(currentValue);
+	r.targetValue = r.currentValue;
+
+	ramps.add(r);
+
+	if (rampBuffer.getNumSamples() > 0)
+		rampBuffer.setSize(ramps.size(), rampBuffer.getNumSamples(), true, false, true);
+}
+
+void AutomationRampHandler::removeRamps(Processor* p)
+{
+	SimpleReadWriteLock::ScopedMultiWriteLock sl(rampLock);
+
+	for (int i = ramps.size() - 1; i >= 0; i--)
+	{
+		if (ramps[i].processor != p)
+			continue;
+
+		ramps.remove(i);
+	}
+
+	// the buffer is rendered in every block, so we don't need to keep the data
+	if (rampBuffer.getNumSamples() > 0)
+		rampBuffer.setSize(ramps.size(), rampBuffer.getNumSamples(), true, false, true);
+
+	// Remove the queued changes so that they can't be applied to another processor at the same address
+	SpinLock::ScopedLockType pl(pendingLock);
+
+	int numRemaining = 0;
+
+	for (int j = 0; j < numPendingChanges; j++)
+	{
+		if (pendingChanges[j].processor != p)
+			pendingChanges[numRemaining++] = pendingChanges[j];
+	}
+
+	numPendingChanges = numRemaining;
+}
+
+void AutomationRampHandler::addValueChange(Processor* p, int attributeIndex, float newValue)
+{
+	// The sample offset only applies to changes from the thread that set it
+	auto offset = sampleOffsetThread.load() == std::this_thread::get_id() ? currentSampleOffset.load() : 0;
+
+	addPendingChange({ p, attributeIndex, -1, offset, newValue, false });
+}
+
+void AutomationRampHandler::setValueWithoutRamp(Processor* p, int attributeIndex, float newValue)
+{
+	addPendingChange({ p, attributeIndex, -1, 0, newValue, true });
+}
+
+void AutomationRampHandler::addPendingChange(const PendingChange& c)
+{
+	SpinLock::ScopedLockType sl(pendingLock);
+
+	if (numPendingChanges < MaxNumPendingChanges)
+	{
+		pendingChanges[numPendingChanges++] = c;
+		return;
+	}
+
+	// The queue is full, so we just update the last change of this attribute
+	// to make sure that it ends up at the correct value.
+	for (int i = numPendingChanges - 1; i >= 0; i--)
+	{
+		auto& existing = pendingChanges[i];
+
+		if (existing.processor == c.processor && existing.attributeIndex == c.attributeIndex)
+		{
+			existing.value = c.value;
+			existing.jump |= c.jump;
+			return;
+		}
+	}
+
+	jassertfalse;
+}
+
+void AutomationRampHandler::prepareToPlay(double newSampleRate, int maxBlockSize)
+{
+	SimpleReadWriteLock::ScopedMultiWriteLock sl(rampLock);
+
+	sampleRate = newSampleRate;
+	numSamplesInBlock = 0;
+
+	rampBuffer.setSize(ramps.size(), maxBlockSize);
+
+	for (auto& r : ramps)
+	{
+		r.rampLength = roundToInt(sampleRate * r.rampTimeMilliseconds * 0.001);
+		r.currentValue = r.targetValue;
+		r.numRemaining = 0;
+		r.active = false;
+	}
+}
+
+void AutomationRampHandler::processBlock(int numSamples, int sampleOffsetMultiplier)
+{
+	if (!processingLocked)
+	{
+		// a ramp is being added or removed, so we keep the changes until the next block
+		return;
+	}
+
+	int numChanges = 0;
+
+	{
+		SpinLock::ScopedLockType sl(pendingLock);
+
+		numChanges = numPendingChanges;
+		memcpy(blockChanges.get(), pendingChanges.get(), sizeof(PendingChange) * (size_t)numChanges);
+		numPendingChanges = 0;
+	}
+
+	// resolve the ramp indexes and discard the changes of attributes without a ramp
+	int numValidChanges = 0;
+
+	for (int i = 0; i < numChanges; i++)
+	{
+		auto c = blockChanges[i];
+		c.rampIndex = getRampIndex(c.processor, c.attributeIndex);
+
+		if (c.rampIndex != -1)
+			blockChanges[numValidChanges++] = c;
+	}
+
+	numChanges = numValidChanges;
+
+	// sort the changes by ramp and sample offset (the order of changes at the same position is kept)
+	std::stable_sort(blockChanges.get(), blockChanges.get() + numChanges, [](const PendingChange& a, const PendingChange& b)
+	{
+		if (a.rampIndex != b.rampIndex)
+			return a.rampIndex < b.rampIndex;
+
+		return a.sampleOffset < b.sampleOffset;
+	});
+
+	numSamplesInBlock = numSamples;
+
+	const bool canRender = numSamples > 0 && numSamples <= rampBuffer.getNumSamples() && ramps.size() == rampBuffer.getNumChannels();
+
+	int changeIndex = 0;
+
+	for (int i = 0; i < ramps.size(); i++)
+	{
+		auto& r = ramps.getReference(i);
+
+		if (!canRender)
+		{
+			// Not prepared (or the block is too big), so we jump to the last value
+			while (changeIndex < numChanges && blockChanges[changeIndex].rampIndex == i)
+				r.jump(r.convert(blockChanges[changeIndex++].value));
+
+			r.active = false;
+			continue;
+		}
+
+		r.active = r.numRemaining > 0;
+
+		auto data = rampBuffer.getWritePointer(i);
+		int pos = 0;
+
+		while (changeIndex < numChanges && blockChanges[changeIndex].rampIndex == i)
+		{
+			const auto& c = blockChanges[changeIndex++];
+			auto offset = jlimit(0, numSamples - 1, c.sampleOffset * sampleOffsetMultiplier);
+
+			r.render(data + pos, offset - pos);
+
+			if (c.jump)
+				r.jump(r.convert(c.value));
+			else
+				r.start(r.convert(c.value));
+
+			r.active = true;
+			pos = offset;
+		}
+
+		if (r.active)
+			r.render(data + pos, numSamples - pos);
+	}
+}
+
+const float* AutomationRampHandler::getRampData(const Processor* p, int attributeIndex, int startSample, int numSamples) const noexcept
+{
+	if (!processingLocked || startSample + numSamples > numSamplesInBlock)
+		return nullptr;
+
+	auto index = getRampIndex(p, attributeIndex);
+
+	if (index != -1 && ramps.getReference(index).active)
+		return rampBuffer.getReadPointer(index, startSample);
+
+	return nullptr;
+}
+
+int AutomationRampHandler::getRampIndex(const Processor* p, int attributeIndex) const noexcept
+{
+	for (int i = 0; i < ramps.size(); i++)
+	{
+		const auto& r = ramps.getReference(i);
+
+		if (r.processor == p && r.attributeIndex == attributeIndex)
+			return i;
+	}
+
+	return -1;
+}
+
+float AutomationRampHandler::Ramp::convert(float attributeValue) const
+{
+	// convert the value once per change so that the ramp itself doesn't need to call pow()
+	if (mode == RampMode::DecibelsToGain)
+		return Decibels::decibelsToGain(attributeValue);
+
+	return attributeValue;
+}
+
+void AutomationRampHandler::Ramp::start(float newTarget)
+{
+	targetValue = newTarget;
+
+	if (rampLength > 1)
+	{
+		delta = (targetValue - currentValue) / (float)rampLength;
+		numRemaining = rampLength;
+	}
+	else
+	{
+		currentValue = targetValue;
+		numRemaining = 0;
+	}
+}
+
+void AutomationRampHandler::Ramp::jump(float newValue)
+{
+	targetValue = newValue;
+	currentValue = newValue;
+	numRemaining = 0;
+}
+
+void AutomationRampHandler::Ramp::render(float* data, int numSamples)
+{
+	auto numToRamp = jmin(numSamples, numRemaining);
+	auto startValue = currentValue;
+
+	// no loop-carried dependency so that this can be vectorised
+	for (int i = 0; i < numToRamp; i++)
+		data[i] = startValue + (float)(i + 1) * delta;
+
+	currentValue = startValue + (float)numToRamp * delta;
+	numRemaining -= numToRamp;
+
+	if (numToRamp > 0 && numRemaining == 0)
+	{
+		// avoid rounding errors at the end of the ramp
+		currentValue = targetValue;
+		data[numToRamp - 1] = targetValue;
+	}
+
+	if (numSamples > numToRamp)
+		FloatVectorOperations::fill(data + numToRamp, currentValue, numSamples - numToRamp);
+}
+
+RenderInputRecorder::RenderInputRecorder(MainController* mc) :
+	ControlledObject(mc),
+	SimpleTimer(mc->getGlobalUIUpdater(), false),
+	fifo(FifoSize)
+{}
+
+RenderInputRecorder::~RenderInputRecorder()
+{
+	stopRecording();
+}
+
+Result RenderInputRecorder::startRecording(const File& logFile)
+{
+	if (isRecording())
+		stopRecording();
+
+	// The buffers are allocated once and kept alive so that the audio thread
+	// can never write into a buffer that has been freed.
+	if (fifoData == nullptr)
+	{
+		fifoData.calloc(FifoSize);
+		blockData.calloc(BlockDataSize);
+	}
+
+	fifo.reset();
+	overflow = false;
+
+	logFile.deleteFile();
+
+	auto newOutput = std::make_unique<FileOutputStream>(logFile);
+
+	if (newOutput->failedToOpen())
+		return Result::fail("Can't write to " + logFile.getFullPathName());
+
+	newOutput->writeInt(MagicNumber);
+	newOutput->writeInt(FormatVersion);
+
+	MemoryOutputStream header;
+	header.writeDouble(getMainController()->getMainSynthChain()->getSampleRate());
+	header.writeInt(getMainController()->getMainSynthChain()->getLargestBlockSize());
+	header.writeString(getMainController()->getMainSynthChain()->getId());
+	header.writeInt(dynamic_cast<AudioProcessor*>(getMainController())->getParameters().size());
+
+	auto ids = getProcessorIds(getMainController());
+
+	header.writeInt(ids.size());
+
+	for (const auto& id : ids)
+		header.writeString(id);
+
+	newOutput->writeByte((char)ChunkType::Header);
+	newOutput->writeInt((int)header.getDataSize());
+	newOutput->write(header.getData(), header.getDataSize());
+
+	{
+		ScopedLock sl(outputLock);
+		output = std::move(newOutput);
+		currentFile = logFile;
+	}
+
+	recording = true;
+	start();
+
+	return Result::ok();
+}
+
+void RenderInputRecorder::stopRecording()
+{
+	stop();
+
+	{
+		// Wait until the pending write operation is done
+		SpinLock::ScopedLockType sl(writeLock);
+		recording = false;
+	}
+
+	flush();
+
+	ScopedLock sl(outputLock);
+	output = nullptr;
+}
+
+void RenderInputRecorder::recordBlock(int numSamples, const MidiBuffer& mb, AudioPlayHead* playHead)
+{
+	if (!isRecording())
+		return;
+
+	MemoryOutputStream mos(blockData.get(), BlockDataSize);
+
+	mos.writeInt(numSamples);
+
+	AudioPlayHead::CurrentPositionInfo info;
+
+	if (playHead != nullptr && playHead->getCurrentPosition(info))
+	{
+		uint8 flags = (uint8)info.isPlaying | ((uint8)info.isRecording << 1) | ((uint8)info.isLooping << 2);
+
+		mos.writeByte(1);
+		mos.writeDouble(info.bpm);
+		mos.writeInt(info.timeSigNumerator);
+		mos.writeInt(info.timeSigDenominator);
+		mos.writeInt64(info.timeInSamples);
+		mos.writeDouble(info.timeInSeconds);
+		mos.writeDouble(info.ppqPosition);
+		mos.writeDouble(info.ppqPositionOfLastBarStart);
+		mos.writeDouble(info.ppqLoopStart);
+		mos.writeDouble(info.ppqLoopEnd);
+		mos.writeByte((char)flags);
+	}
+	else
+	{
+		mos.writeByte(0);
+	}
+
+	auto numEvents = jmin(mb.getNumEvents(), HISE_EVENT_BUFFER_SIZE);
+
+	mos.writeInt(numEvents);
+
+	int eventIndex = 0;
+
+	for (const auto m : mb)
+	{
+		if (eventIndex++ == numEvents)
+			break;
+
+		HiseEvent e(m.getMessage());
+		e.setTimeStamp(m.samplePosition);
+		mos.write(&e, sizeof(HiseEvent));
+	}
+
+	writeChunk(ChunkType::Block, mos.getData(), (int)mos.getDataSize(), false);
+}
+
+void RenderInputRecorder::recordParameterChange(int parameterIndex, float newValue)
+{
+	if (!isRecording())
+		return;
+
+	uint8 data[sizeof(int) + sizeof(float)];
+
+	MemoryOutputStream mos(data, sizeof(data));
+	mos.writeInt(parameterIndex);
+	mos.writeFloat(newValue);
+
+	// This might be called by the host on the audio thread so we must not wait here
+	writeChunk(ChunkType::ParameterChange, data, sizeof(data), false);
+}
+
+void RenderInputRecorder::recordPresetLoad(const ValueTree& presetData, const File& presetFile)
+{
+	if (!isRecording())
+		return;
+
+	MemoryOutputStream mos;
+	mos.writeString(presetFile.getFullPathName());
+	presetData.writeToStream(mos);
+
+	writeChunk(ChunkType::PresetLoad, mos.getData(), (int)mos.getDataSize(), true);
+}
+
+StringArray RenderInputRecorder::getProcessorIds(MainController* mc)
+{
+	StringArray ids;
+
+	Processor::Iterator<Processor> iter(mc->getMainSynthChain(), false);
+
+	while (auto p = iter.getNextProcessor())
+		ids.add(p->getId());
+
+	return ids;
+}
+
+void RenderInputRecorder::timerCallback()
+{
+	flush();
+
+	if (overflow)
+	{
+		stopRecording();
+		getMainController()->getDebugLogger().logMessage("Render input recording stopped because the FIFO overflowed");
+	}
+}
+
+bool RenderInputRecorder::writeChunk(ChunkType t, const void* data, int numBytes, bool waitForSpace)
+{
+	const int numTotal = numBytes + 1 + (int)sizeof(int);
+
+	if (numTotal > FifoSize)
+	{
+		overflow = true;
+		return false;
+	}
+
+	uint8 header[1 + sizeof(int)];
+	header[0] = (uint8)t;
+	memcpy(header + 1, &numBytes, sizeof(int));
+
+	for (int numTries = 0; numTries < 200; numTries++)
+	{
+		{
+			SpinLock::ScopedLockType sl(writeLock);
+
+			if (!isRecording())
+				return false;
+
+			if (fifo.getFreeSpace() >= numTotal)
+			{
+				int start1, size1, start2, size2;
+				fifo.prepareToWrite(numTotal, start1, size1, start2, size2);
+
+				auto write = [&](const uint8* src, int numToCopy)
+				{
+					auto numFirst = jmin(numToCopy, size1);
+
+					memcpy(fifoData + start1, src, numFirst);
+					start1 += numFirst;
+					size1 -= numFirst;
+
+					if (numFirst < numToCopy)
+					{
+						memcpy(fifoData + start2, src + numFirst, numToCopy - numFirst);
+						start2 += numToCopy - numFirst;
+					}
+				};
+
+				write(header, sizeof(header));
+				write(static_cast<const uint8*>(data), numBytes);
+
+				fifo.finishedWrite(numTotal);
+				return true;
+			}
+		}
+
+		if (!waitForSpace)
+			break;
+
+		Thread::sleep(5);
+	}
+
+	overflow = true;
+	return false;
+}
+
+void RenderInputRecorder::flush()
+{
+	ScopedLock sl(outputLock);
+
+	if (output == nullptr)
+		return;
+
+	int start1, size1, start2, size2;
+	fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+	if (size1 > 0)
+		output->write(fifoData + start1, size1);
+
+	if (size2 > 0)
+		output->write(fifoData + start2, size2);
+
+	fifo.finishedRead(size1 + size2);
+	output->flush();
+}
+
+RenderInputPlayer::RenderInputPlayer(MainController* mc) :
+	ControlledObject(mc)
+{}
+
+Result RenderInputPlayer::replay(const File& logFile, const Options& options)
+{
+	timings.clearQuick();
+
+	FileInputStream input(logFile);
+
+	if (!input.openedOk())
+		return Result::fail("Can't open " + logFile.getFullPathName());
+
+	if (input.readInt() != RenderInputRecorder::MagicNumber)
+		return Result::fail(logFile.getFullPathName() + " is not a render input log");
+
+	auto formatVersion = input.readInt();
+
+	if (formatVersion > RenderInputRecorder::FormatVersion)
+		return Result::fail("The render input log was created with a newer version");
+
+	MemoryBlock header;
+
+	if (!readChunk(input, header) || currentChunk != RenderInputRecorder::ChunkType::Header)
+		return Result::fail("Missing header");
+
+	{
+		MemoryInputStream mis(header, false);
+		sampleRate = mis.readDouble();
+		maxBlockSize = mis.readInt();
+
+		if (sampleRate <= 0.0 || maxBlockSize <= 0)
+			return Result::fail("Invalid audio settings in the header");
+
+		// Replaying a log with another module tree would render garbage (or crash
+		// when the recorded events target other processors), so we bail out early
+		auto r = checkProject(mis, formatVersion);
+
+		if (r.failed())
+			return r;
+	}
+
+	auto mc = getMainController();
+	auto& recorder = mc->getRenderInputRecorder();
+	auto processor = dynamic_cast<AudioProcessor*>(mc);
+
+	if (recorder.isRecording())
+		return Result::fail("Can't replay a log while recording");
+
+	processor->prepareToPlay(sampleRate, maxBlockSize);
+
+	SuspendHelpers::ScopedTicket st(mc);
+
+	auto waitStart = Time::getMillisecondCounter();
+
+	while (mc->getKillStateHandler().isAudioRunning())
+	{
+		if (Time::getMillisecondCounter() - waitStart > 5000)
+			return Result::fail("Can't suspend the audio rendering");
+
+		Thread::sleep(20);
+	}
+
+	mc->getKillStateHandler().setCurrentExportThread(Thread::getCurrentThreadId());
+
+	if (options.renderOffline)
+	{
+		processor->setNonRealtime(true);
+		mc->getSampleManager().handleNonRealtimeState();
+	}
+
+	ReplayPlayHead playHead;
+	auto prevPlayHead = processor->getPlayHead();
+	processor->setPlayHead(&playHead);
+	recorder.replaying = true;
+
+	auto r = renderChunks(input, options, playHead);
+
+	recorder.replaying = false;
+	processor->setPlayHead(prevPlayHead);
+
+	if (options.renderOffline)
+	{
+		processor->setNonRealtime(false);
+		mc->getSampleManager().handleNonRealtimeState();
+	}
+
+	mc->getKillStateHandler().setCurrentExportThread(nullptr);
+
+	return r;
+}
+
+String RenderInputPlayer::createReport(int numSlowestBlocks) const
+{
+	if (timings.isEmpty())
+		return "No blocks were rendered";
+
+	NewLine nl;
+	String report;
+
+	auto sorted = timings;
+
+	std::sort(sorted.begin(), sorted.end(), [](const BlockTiming& a, const BlockTiming& b)
+	{
+		return a.load > b.load;
+	});
+
+	double sum = 0.0;
+
+	for (const auto& t : timings)
+		sum += t.load;
+
+	auto percentile99 = sorted[jmin(sorted.size() - 1, sorted.size() / 100)];
+
+	report << "Rendered blocks: " << timings.size() << nl;
+	report << "Samplerate: " << String(sampleRate, 0) << "Hz, Max block size: " << maxBlockSize << nl;
+	report << "Average load: " << String(100.0 * sum / (double)timings.size(), 2) << "%" << nl;
+	report << "99th percentile load: " << String(100.0 * percentile99.load, 2) << "%" << nl;
+	report << "Peak load: " << String(100.0 * sorted.getFirst().load, 2) << "% (block #" << sorted.getFirst().blockIndex << ")" << nl;
+	report << nl << "Slowest blocks:" << nl;
+
+	for (int i = 0; i < jmin(numSlowestBlocks, sorted.size()); i++)
+	{
+		const auto& t = sorted.getReference(i);
+
+		report << "#" << t.blockIndex << ": " << String(t.renderTime * 1000.0, 3) << "ms (";
+		report << String(100.0 * t.load, 1) << "%, " << t.numSamples << " samples)" << nl;
+	}
+
+	return report;
+}
+
+Result RenderInputPlayer::writeTimingsToFile(const File& csvFile) const
+{
+	String csv;
+	NewLine nl;
+
+	csv << "block,samples,render_time_ms,load" << nl;
+
+	for (const auto& t : timings)
+	{
+		csv << t.blockIndex << "," << t.numSamples << ",";
+		csv << String(t.renderTime * 1000.0, 4) << "," << String(t.load, 4) << nl;
+	}
+
+	if (!csvFile.replaceWithText(csv))
+		return Result::fail("Can't write to " + csvFile.getFullPathName());
+
+	return Result::ok();
+}
+
+Result RenderInputPlayer::checkProject(MemoryInputStream& header, int formatVersion) const
+{
+	auto mc = getMainController();
+	auto recordedChainId = header.readString();
+
+	if (recordedChainId != mc->getMainSynthChain()->getId())
+		return Result::fail("The log was recorded with another project (" + recordedChainId + ")");
+
+	// Version 1 logs only contain the ID of the main synth chain
+	if (formatVersion < 2)
+		return Result::ok();
+
+	auto numRecordedParameters = header.readInt();
+	auto numParameters = dynamic_cast<AudioProcessor*>(mc)->getParameters().size();
+
+	if (numRecordedParameters != numParameters)
+	{
+		return Result::fail("The log was recorded with " + String(numRecordedParameters) +
+			                " host parameters, but the project has " + String(numParameters));
+	}
+
+	auto numIds = header.readInt();
+
+	if (!isPositiveAndBelow(numIds, (int)header.getNumBytesRemaining() + 1))
+		return Result::fail("Corrupt processor list in the header");
+
+	StringArray recordedIds;
+
+	for (int i = 0; i < numIds; i++)
+		recordedIds.add(header.readString());
+
+	auto ids = RenderInputRecorder::getProcessorIds(mc);
+
+	if (recordedIds == ids)
+		return Result::ok();
+
+	StringArray missing, unknown;
+
+	for (const auto& id : recordedIds)
+	{
+		if (!ids.contains(id))
+			missing.add(id);
+	}
+
+	for (const auto& id : ids)
+	{
+		if (!recordedIds.contains(id))
+			unknown.add(id);
+	}
+
+	String message;
+	NewLine nl;
+
+	message << "The module tree doesn't match the recorded project";
+
+	if (!missing.isEmpty())
+		message << nl << "Missing processors: " << missing.joinIntoString(", ");
+
+	if (!unknown.isEmpty())
+		message << nl << "Processors that are not in the log: " << unknown.joinIntoString(", ");
+
+	if (missing.isEmpty() && unknown.isEmpty())
+		message << nl << "The processors are in a different order";
+
+	return Result::fail(message);
+}
+
+bool RenderInputPlayer::readChunk(InputStream& input, MemoryBlock& data)
+{
+	if (input.getNumBytesRemaining() < (int64)(1 + sizeof(int)))
+		return false;
+
+	currentChunk = (RenderInputRecorder::ChunkType)input.readByte();
+	auto numBytes = input.readInt();
+
+	if (numBytes < 0 || numBytes > input.getNumBytesRemaining())
+		return false;
+
+	data.setSize((size_t)numBytes);
+	return input.read(data.getData(), numBytes) == numBytes;
+}
+
+Result RenderInputPlayer::renderChunks(InputStream& input, const Options& options, ReplayPlayHead& playHead)
+{
+	using ChunkType = RenderInputRecorder::ChunkType;
+
+	auto mc = getMainController();
+	auto processor = dynamic_cast<AudioProcessor*>(mc);
+	auto numChannels = mc->getMainSynthChain()->getMatrix().getNumSourceChannels();
+
+	AudioSampleBuffer buffer(numChannels, maxBlockSize);
+	MidiBuffer mb;
+	MemoryBlock data;
+
+	if (options.renderedOutput != nullptr)
+		options.renderedOutput->setSize(numChannels, 0);
+
+	int blockIndex = 0;
+	double realtimePosition = 0.0;
+	const auto startTime = Time::getMillisecondCounterHiRes();
+
+	while (!input.isExhausted())
+	{
+		if (!readChunk(input, data))
+			return Result::fail("Corrupt chunk at position " + String(input.getPosition()));
+
+		MemoryInputStream mis(data, false);
+
+		switch (currentChunk)
+		{
+		case ChunkType::ParameterChange:
+		{
+			auto parameterIndex = mis.readInt();
+			auto value = mis.readFloat();
+
+			auto p = processor->getParameters()[parameterIndex];
+
+			if (p == nullptr)
+				return Result::fail("Unknown host parameter #" + String(parameterIndex) + " before block #" + String(blockIndex));
+
+			p->setValue(value);
+			break;
+		}
+		case ChunkType::PresetLoad:
+		{
+			File presetFile(mis.readString());
+			auto v = ValueTree::readFromStream(mis);
+
+			if (v.isValid())
+			{
+				// The preset is loaded on the loading thread so we can't pretend to be the audio thread here...
+				mc->getKillStateHandler().setCurrentExportThread(nullptr);
+
+				auto& uph = mc->getUserPresetHandler();
+				uph.loadUserPresetFromValueTree(v, uph.getCurrentlyLoadedFile(), presetFile, false);
+
+				auto ok = waitForPresetLoad();
+
+				mc->getKillStateHandler().setCurrentExportThread(Thread::getCurrentThreadId());
+
+				if (!ok)
+					return Result::fail("Timeout while loading the preset " + presetFile.getFileName());
+			}
+
+			break;
+		}
+		case ChunkType::Block:
+		{
+			if (options.lastBlock != -1 && blockIndex > options.lastBlock)
+				return Result::ok();
+
+			auto numSamples = mis.readInt();
+
+			if (!isPositiveAndBelow(numSamples, maxBlockSize + 1))
+				return Result::fail("Illegal block size " + String(numSamples) + " at block #" + String(blockIndex));
+
+			playHead.hasInfo = mis.readByte() != 0;
+
+			if (playHead.hasInfo)
+			{
+				auto& info = playHead.info;
+
+				info.bpm = mis.readDouble();
+				info.timeSigNumerator = mis.readInt();
+				info.timeSigDenominator = mis.readInt();
+				info.timeInSamples = mis.readInt64();
+				info.timeInSeconds = mis.readDouble();
+				info.ppqPosition = mis.readDouble();
+				info.ppqPositionOfLastBarStart = mis.readDouble();
+				info.ppqLoopStart = mis.readDouble();
+				info.ppqLoopEnd = mis.readDouble();
+
+				auto flags = (uint8)mis.readByte();
+
+				info.isPlaying = (flags & 1) != 0;
+				info.isRecording = (flags & 2) != 0;
+				info.isLooping = (flags & 4) != 0;
+			}
+
+			auto numEvents = mis.readInt();
+
+			mb.clear();
+
+			for (int i = 0; i < numEvents; i++)
+			{
+				HiseEvent e;
+
+				if (mis.read(&e, sizeof(HiseEvent)) != sizeof(HiseEvent))
+					return Result::fail("Missing events at block #" + String(blockIndex));
+
+				mb.addEvent(e.toMidiMesage(), e.getTimeStamp());
+			}
+
+			AudioSampleBuffer b(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+			b.clear();
+
+			double renderTime;
+
+			{
+				LockHelpers::SafeLock sl(mc, LockHelpers::Type::AudioLock);
+
+				auto before = Time::getHighResolutionTicks();
+				mc->processBlockCommon(b, mb);
+				renderTime = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - before);
+			}
+
+			if (auto output = options.renderedOutput)
+			{
+				auto offset = output->getNumSamples();
+				output->setSize(numChannels, offset + numSamples, true, false, true);
+
+				for (int i = 0; i < numChannels; i++)
+					output->copyFrom(i, offset, b, i, 0, numSamples);
+			}
+
+			auto blockDuration = (double)numSamples / sampleRate;
+
+			if (blockIndex >= options.firstBlock)
+				timings.add({ blockIndex, numSamples, renderTime, renderTime / blockDuration });
+
+			if (options.paceInRealtime && !options.renderOffline)
+			{
+				realtimePosition += blockDuration * 1000.0;
+
+				auto waitTime = roundToInt(startTime + realtimePosition - Time::getMillisecondCounterHiRes());
+
+				if (waitTime > 0)
+					Thread::sleep(waitTime);
+			}
+
+			blockIndex++;
+			break;
+		}
+		default:
+			// Skip unknown chunks
+			break;
+		}
+	}
+
+	return Result::ok();
+}
+
+bool RenderInputPlayer::waitForPresetLoad()
+{
+	auto mc = getMainController();
+
+	// The functions on the loading thread are executed in order, so this
+	// will be called after the preset was loaded
+	auto finished = std::make_shared<std::atomic<bool>>(false);
+
+	mc->killAndCallOnLoadingThread([finished](Processor*)
+	{
+		finished->store(true);
+		return SafeFunctionCall::OK;
+	});
+
+	auto waitStart = Time::getMillisecondCounter();
+
+	while (!finished->load() || mc->getSampleManager().isPreloading())
+	{
+		if (Time::getMillisecondCounter() - waitStart > 30000)
+			return false;
+
+		Thread::sleep(10);
+	}
+
+	return true;
+}
+
+#if HI_RUN_UNIT_TESTS
+
+/** Checks the ramp segments of the AutomationRampHandler and measures the cost of 100 automated parameters. */
+struct AutomationRampTests : public UnitTest
+{
+	AutomationRampTests() :
+		UnitTest("Testing automation ramps")
+	{};
+
+	void runTest() override
+	{
+		// The handler never dereferences the processor, so we can use any pointer as key
+		auto p = reinterpret_cast<Processor*>(this);
+
+		{
+			beginTest("Testing sample accurate ramps");
+
+			AutomationRampHandler h;
+			h.addRamp(p, 0, 0.0f, 1000.0);
+			h.prepareToPlay(100.0, 512);
+
+			AutomationRampHandler::ScopedProcessingLock spl(h);
+
+			{
+				AutomationRampHandler::ScopedSampleOffset sso(h, 64);
+				h.addValueChange(p, 0, 1.0f);
+			}
+
+			h.addValueChange(p, 1, 1.0f);
+
+			h.processBlock(512);
+
+			auto data = h.getRampData(p, 0, 0, 512);
+
+			expect(data != nullptr, "no ramp");
+			expect(h.getRampData(p, 1, 0, 512) == nullptr, "unregistered attribute has a ramp");
+			expectEquals(data[63], 0.0f, "ramp started before the offset");
+			expectWithinAbsoluteError(data[64], 0.01f, 0.0001f, "wrong ramp start");
+			expectWithinAbsoluteError(data[113], 0.5f, 0.0001f, "wrong ramp value");
+			expectEquals(data[163], 1.0f, "ramp didn't reach the target");
+			expectEquals(data[511], 1.0f, "wrong value after the ramp");
+
+			h.processBlock(512);
+
+			expect(h.getRampData(p, 0, 0, 512) == nullptr, "ramp still active");
+
+			// A change in the middle of a ramp starts from the current value
+			h.addValueChange(p, 0, 0.0f);
+
+			{
+				AutomationRampHandler::ScopedSampleOffset sso(h, 50);
+				h.addValueChange(p, 0, 1.0f);
+			}
+
+			h.processBlock(512);
+			data = h.getRampData(p, 0, 0, 512);
+
+			expectWithinAbsoluteError(data[49], 0.5f, 0.0001f, "wrong first segment");
+			expectWithinAbsoluteError(data[99], 0.75f, 0.0001f, "wrong second segment");
+			expectEquals(data[149], 1.0f, "ramp didn't reach the target");
+		}
+
+		{
+			beginTest("Testing decibel ramps and jumps");
+
+			AutomationRampHandler h;
+			h.addRamp(p, 0, -60.0f, 1000.0, AutomationRampHandler::RampMode::DecibelsToGain);
+			h.prepareToPlay(100.0, 512);
+
+			AutomationRampHandler::ScopedProcessingLock spl(h);
+
+			// A restored value must not ramp from the initial value
+			h.addValueChange(p, 0, 0.0f);
+			h.setValueWithoutRamp(p, 0, -60.0f);
+			h.processBlock(512);
+
+			auto data = h.getRampData(p, 0, 0, 512);
+			auto minus60 = Decibels::decibelsToGain(-60.0f);
+
+			expect(data != nullptr, "no ramp");
+			expectWithinAbsoluteError(data[0], minus60, 0.00001f, "jump didn't override the queued change");
+			expectWithinAbsoluteError(data[511], minus60, 0.00001f, "jump didn't override the queued change");
+
+			// The ramp is linear in the gain domain
+			h.addValueChange(p, 0, 0.0f);
+			h.processBlock(512);
+			data = h.getRampData(p, 0, 0, 512);
+
+			expectWithinAbsoluteError(data[49], minus60 + (1.0f - minus60) * 0.5f, 0.0001f, "ramp isn't linear in the gain domain");
+			expectEquals(data[99], 1.0f, "ramp didn't reach the target");
+
+			// The sample offset of another thread must not be used
+			{
+				AutomationRampHandler::ScopedSampleOffset sso(h, 64);
+
+				auto t = std::thread([&]() { h.addValueChange(p, 0, -60.0f); });
+				t.join();
+			}
+
+			h.processBlock(512);
+			data = h.getRampData(p, 0, 0, 512);
+
+			expect(data[0] < 1.0f, "the change used the offset of another thread");
+		}
+
+		{
+			beginTest("Measuring 100 automated parameters");
+
+			static constexpr int NumParameters = 100;
+			static constexpr int NumBlocks = 2000;
+			static constexpr int BlockSize = 512;
+
+			AutomationRampHandler h;
+
+			for (int i = 0; i < NumParameters; i++)
+				h.addRamp(p, i, 0.0f, 20.0);
+
+			h.prepareToPlay(44100.0, BlockSize);
+
+			AutomationRampHandler::ScopedProcessingLock spl(h);
+
+			Random r(42);
+			double seconds = 0.0;
+
+			for (int b = 0; b < NumBlocks; b++)
+			{
+				// every parameter gets four changes per block
+				for (int i = 0; i < NumParameters * 4; i++)
+				{
+					AutomationRampHandler::ScopedSampleOffset sso(h, r.nextInt(BlockSize));
+					h.addValueChange(p, i % NumParameters, r.nextFloat());
+				}
+
+				auto start = Time::getHighResolutionTicks();
+				h.processBlock(BlockSize);
+				seconds += Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+			}
+
+			expect(h.getRampData(p, NumParameters - 1, 0, BlockSize) != nullptr, "no ramp");
+
+			auto usPerBlock = seconds * 1000000.0 / (double)NumBlocks;
+			auto blockDuration = 1000000.0 * (double)BlockSize / 44100.0;
+
+			logMessage(String(NumParameters) + " automated parameters: " + String(usPerBlock, 2) + "us per block (" + String(usPerBlock / blockDuration * 100.0, 3) + "% of the block duration)");
+		}
+	}
+};
+
+static AutomationRampTests automationRampTests;
+
+#endif
+
 } // namespace hise
@@ -73,6 +73,12 @@ public:
 		RLottieManager()
 	{};
 
+	~HiseRLottieManager()
+	{
+		// the shared pool might be gone when the base class destructor is called
+		stopPrerendering();
+	}
+
 	File getLibraryFolder() const override
 	{
 #if JUCE_WINDOWS
@@ -83,6 +89,15 @@ public:
 	return File("/usr/local/lib/");
 #endif
 	}
+
+protected:
+
+	/** Prerenders the frames on the worker pool that is shared with the other background tasks. */
+	ThreadPool& getPrerenderPool() override { return workerPool->getThreadPool(); }
+
+private:
+
+	SharedResourcePointer<SharedWorkerPool> workerPool;
 };
 
 #endif
@@ -734,6 +749,293 @@ struct ScopedSoftBypassDisabler: public ControlledObject
 	bool previousState;
 };
 
+/** A render budget governor that degrades the rendering quality when the CPU load gets too close to the buffer deadline.
+
+	It measures the render time of each audio callback (relative to the duration of the buffer) and escalates
+	through multiple pressure levels when the load stays above the threshold of the next level for the escalation
+	hold time. Each level activates one policy (in the order defined with setPolicyOrder()) and the levels are
+	dropped again one by one when the load stays below the threshold for the release hold time.
+
+	The policies are checked by the audio rendering code with isPolicyActive(), so the governor itself
+	doesn't need to know about the voices or samplers. It's disabled by default.
+*/
+class RenderBudgetGovernor: public ControlledObject,
+							public PooledUIUpdater::SimpleTimer
+{
+public:
+
+	enum class Policy
+	{
+		KillReleasingVoices = 0,
+		ReduceInterpolationQuality,
+		BypassOptionalEffects,
+		numPolicies
+	};
+
+	static constexpr int NumLevels = (int)Policy::numPolicies;
+
+	RenderBudgetGovernor(MainController* mc);
+
+	~RenderBudgetGovernor();
+
+	static String getPolicyName(Policy p);
+
+	static Policy getPolicyFromName(const String& name);
+
+	void setEnabled(bool shouldBeEnabled);
+
+	bool isEnabled() const noexcept { return enabled.load(); }
+
+	/** Sets the load thresholds (render time / buffer duration) for each level. */
+	void setLevelThresholds(const Array<float>& newThresholds);
+
+	/** Sets the order in which the policies are activated when the load increases. */
+	void setPolicyOrder(const Array<Policy>& newOrder);
+
+	/** Sets the amount that the load must drop below the threshold and the time (in seconds) it has to stay there before a level is deactivated. */
+	void setReleaseBehaviour(float hysteresis, double holdTimeSeconds);
+
+	/** Sets the time (in seconds) that the load has to stay above the threshold before the next level is activated. */
+	void setEscalationHoldTime(double holdTimeSeconds);
+
+	/** Marks a master effect as optional. Optional effects will be soft bypassed when the BypassOptionalEffects policy is active. */
+	void setOptionalEffect(Processor* p, bool isOptional);
+
+	/** Returns true if the given policy is currently active. This is cheap enough to be called in the audio thread. */
+	bool isPolicyActive(Policy p) const noexcept
+	{
+		return (activePolicies.load() & (1 << (int)p)) != 0;
+	}
+
+	/** @internal Call this after each audio callback with the time spent in the callback. */
+	void processBlockFinished(double renderTimeSeconds, int numSamples, double sampleRate);
+
+	/** @internal Call this whenever a voice was killed by the KillReleasingVoices policy. */
+	void onVoiceKilled() noexcept { numKilledVoices++; }
+
+	int getCurrentLevel() const noexcept { return currentLevel.load(); }
+
+	float getCurrentLoad() const noexcept { return smoothedLoad.load(); }
+
+	/** Returns the highest load of the current and the previous measurement window (see PeakWindowSeconds). */
+	float getPeakLoad() const noexcept { return peakLoad.load(); }
+
+	int getNumKilledVoices() const noexcept { return numKilledVoices.load(); }
+
+	int getNumLevelChanges() const noexcept { return numLevelChanges.load(); }
+
+	/** Returns a JSON object with the current state. */
+	var getStateObject() const;
+
+	/** This will be called on the message thread whenever the level changes. */
+	LambdaBroadcaster<int> levelBroadcaster;
+
+private:
+
+	friend class RenderBudgetGovernorTests;
+
+	/** The length of the window that is used for the peak load. */
+	static constexpr double PeakWindowSeconds = 1.0;
+
+	void timerCallback() override;
+
+	/** Changes the level and returns false if the optional effects couldn't be updated (the level stays the same then). */
+	bool setLevel(int newLevel, bool waitForEffectLock=false);
+
+	bool updateOptionalEffects(bool shouldBeBypassed, bool waitForEffectLock);
+
+	std::atomic<bool> enabled = { false };
+
+	std::atomic<int> currentLevel = { 0 };
+	std::atomic<int> activePolicies = { 0 };
+	std::atomic<float> smoothedLoad = { 0.0f };
+	std::atomic<float> peakLoad = { 0.0f };
+	std::atomic<int> numKilledVoices = { 0 };
+	std::atomic<int> numLevelChanges = { 0 };
+
+	int lastNotifiedLevel = 0;
+	double secondsBelowThreshold = 0.0;
+	double secondsAboveThreshold = 0.0;
+
+	double secondsInPeakWindow = 0.0;
+	float currentWindowPeak = 0.0f;
+	float lastWindowPeak = 0.0f;
+
+	float thresholds[NumLevels] = { 0.75f, 0.85f, 0.95f };
+	Policy policyOrder[NumLevels] = { Policy::KillReleasingVoices, Policy::ReduceInterpolationQuality, Policy::BypassOptionalEffects };
+	float releaseHysteresis = 0.1f;
+	double releaseHoldTime = 1.0;
+	double escalationHoldTime = 0.05;
+
+	mutable SimpleReadWriteLock optionalEffectLock;
+	Array<WeakReference<Processor>> optionalEffects;
+
+	JUCE_DECLARE_WEAK_REFERENCEABLE(RenderBudgetGovernor);
+};
+
+/** Converts parameter changes of processor attributes into sample accurate ramps.
+
+	Processor::setAttribute() applies the new value at the start of the next block, so every effect that
+	wants to avoid zipper noise has to run its own smoother for each of its parameters. Instead, a processor can
+	register an attribute here: every value change of this attribute will then be queued with the sample offset
+	of the event that caused it (eg. the position of the MIDI CC message within the buffer) and once per block the
+	queued changes are merged into linear ramp segments and rendered into a buffer that can be read in the audio
+	callback with getRampData().
+
+	Each change starts a new linear ramp from the current value at its sample offset, so dense automation is followed
+	sample accurately and sparse automation produces a smooth ramp instead of a step.
+
+	The ramps can be added and removed on any thread while the audio is running: the audio callback holds a read lock
+	(see ScopedProcessingLock) and addRamp() / removeRamps() wait until the current block is finished. The ramps don't
+	dereference the processor, so they stay valid until removeRamps() is called.
+*/
+class AutomationRampHandler
+{
+public:
+
+	/** The number of value changes that can be queued between two audio callbacks. */
+	static constexpr int MaxNumPendingChanges = 1024;
+
+	/** Defines how the attribute value is converted before it is ramped. */
+	enum class RampMode
+	{
+		Linear, ///< ramps the attribute value
+		DecibelsToGain ///< the attribute is a decibel value and the ramp contains the gain factor
+	};
+
+	/** Sets the sample offset for all value changes that are queued on this thread while this object is alive.
+
+		Changes from other threads (eg. the message thread) will always use the offset 0.
+	*/
+	struct ScopedSampleOffset
+	{
+		ScopedSampleOffset(AutomationRampHandler& h, int sampleOffset);
+		~ScopedSampleOffset();
+
+	private:
+
+		AutomationRampHandler& handler;
+	};
+
+	/** Create one of these in the audio callback before calling processBlock() and keep it alive until the processors are rendered.
+
+		This doesn't block the audio thread: if a ramp is added or removed at the same time, the ramps are skipped for this block
+		(the queued changes will be applied in the next block and getRampData() returns nullptr).
+	*/
+	struct ScopedProcessingLock
+	{
+		ScopedProcessingLock(AutomationRampHandler& h) :
+			handler(h),
+			sl(h.rampLock)
+		{
+			handler.processingLocked = (bool)sl;
+		};
+
+		~ScopedProcessingLock()
+		{
+			handler.processingLocked = false;
+		}
+
+	private:
+
+		AutomationRampHandler& handler;
+		SimpleReadWriteLock::ScopedTryReadLock sl;
+	};
+
+	AutomationRampHandler();
+
+	/** Registers the attribute of the processor. The ramp starts at the current value and will take the given time to reach a new value.
+
+		The processor needs to call its Processor::setHasAutomationRamps() so that setAttribute() forwards the value changes.
+	*/
+	void addRamp(Processor* p, int attributeIndex, float currentValue, double rampTimeMilliseconds, RampMode m=RampMode::Linear);
+
+	/** Removes all ramps of the given processor. Call this in the destructor of the processor. */
+	void removeRamps(Processor* p);
+
+	int getNumRamps() const noexcept { return ramps.size(); }
+
+	/** Queues a value change for the given attribute. This is called by Processor::setAttribute(). */
+	void addValueChange(Processor* p, int attributeIndex, float newValue);
+
+	/** Jumps to the given value at the start of the next block (and discards the ramp that is currently running).
+
+		Use this in the prepareToPlay() callback of the processor so that a restored value doesn't start with a ramp.
+	*/
+	void setValueWithoutRamp(Processor* p, int attributeIndex, float newValue);
+
+	void prepareToPlay(double sampleRate, int maxBlockSize);
+
+	/** Renders the queued changes into the ramp buffer. The sample offsets of the changes will be multiplied with the given factor.
+
+		This must be called while a ScopedProcessingLock is alive.
+	*/
+	void processBlock(int numSamples, int sampleOffsetMultiplier=1);
+
+	/** Returns the ramp for the given attribute in the current block or nullptr if the value doesn't change in this block.
+
+		If this returns nullptr, the processor can use the current value of the attribute (it will be the last value of the ramp).
+		Only call this in the audio callback.
+	*/
+	const float* getRampData(const Processor* p, int attributeIndex, int startSample, int numSamples) const noexcept;
+
+private:
+
+	struct Ramp
+	{
+		float convert(float attributeValue) const;
+
+		void start(float newTarget);
+		void jump(float newValue);
+		void render(float* data, int numSamples);
+
+		Processor* processor = nullptr;
+		int attributeIndex = -1;
+		RampMode mode = RampMode::Linear;
+		double rampTimeMilliseconds = 0.0;
+		int rampLength = 0;
+
+		float currentValue = 0.0f;
+		float targetValue = 0.0f;
+		float delta = 0.0f;
+		int numRemaining = 0;
+
+		bool active = false;
+	};
+
+	struct PendingChange
+	{
+		Processor* processor;
+		int attributeIndex;
+		int rampIndex;
+		int sampleOffset;
+		float value;
+		bool jump;
+	};
+
+	void addPendingChange(const PendingChange& c);
+
+	int getRampIndex(const Processor* p, int attributeIndex) const noexcept;
+
+	std::atomic<int> currentSampleOffset = { 0 };
+	std::atomic<std::thread::id> sampleOffsetThread = {};
+
+	double sampleRate = 0.0;
+	int numSamplesInBlock = 0;
+	bool processingLocked = false;
+
+	SpinLock pendingLock;
+	int numPendingChanges = 0;
+	HeapBlock<PendingChange> pendingChanges;
+	HeapBlock<PendingChange> blockChanges;
+
+	SimpleReadWriteLock rampLock;
+	Array<Ramp> ramps;
+	AudioSampleBuffer rampBuffer;
+
+	JUCE_DECLARE_NON_COPYABLE(AutomationRampHandler);
+};
+
 /** This introduces an artificial delay of max 256 samples and calls the internal processing loop with a fixed number of samples.
 *
 *	This is supposed to offer a rather ugly fallback solution for hosts who change their processing size constantly (eg. FL Studio).
@@ -831,6 +1133,164 @@ private:
 	int bufferSize = 0;
 };
 
+/** Records everything that goes into the audio callback into a compact binary log so that it can be replayed
+	deterministically with the RenderInputPlayer.
+
+	The log contains the block size, the incoming MIDI events and the host transport of every rendered block
+	as well as the host parameter changes and user preset loads that happened between the blocks. The header
+	stores the IDs of all processors and the number of host parameters so that the player can make sure that
+	the log is replayed with the same project. The audio
+	thread only copies the data into a preallocated FIFO which is flushed to the file on the message thread.
+	If the FIFO overflows, the recording is stopped (a log with missing blocks can't be replayed anyway).
+*/
+class RenderInputRecorder: public ControlledObject,
+						   public PooledUIUpdater::SimpleTimer
+{
+public:
+
+	enum class ChunkType: uint8
+	{
+		Header = 'H',
+		Block = 'B',
+		ParameterChange = 'P',
+		PresetLoad = 'L',
+		numChunkTypes
+	};
+
+	static constexpr int MagicNumber = 0x43455248; // "HREC"
+	static constexpr int FormatVersion = 2;
+	static constexpr int FifoSize = 1024 * 1024 * 4;
+	static constexpr int BlockDataSize = 128 + HISE_EVENT_BUFFER_SIZE * sizeof(HiseEvent);
+
+	RenderInputRecorder(MainController* mc);
+	~RenderInputRecorder();
+
+	/** Starts recording into the given file. Call this on the message thread. */
+	Result startRecording(const File& logFile);
+
+	/** Stops the recording and flushes the remaining data to the file. */
+	void stopRecording();
+
+	bool isRecording() const noexcept { return recording.load(); }
+
+	/** Returns true while the RenderInputPlayer replays a log. */
+	bool isReplaying() const noexcept { return replaying.load(); }
+
+	/** Records a block. This is called by the audio thread before the events are processed. */
+	void recordBlock(int numSamples, const MidiBuffer& mb, AudioPlayHead* playHead);
+
+	/** Records a host parameter change which will be applied before the next block when replayed. */
+	void recordParameterChange(int parameterIndex, float newValue);
+
+	/** Records a user preset load which will be performed before the next block when replayed. */
+	void recordPresetLoad(const ValueTree& presetData, const File& presetFile);
+
+	File getCurrentFile() const { return currentFile; }
+
+private:
+
+	friend class RenderInputPlayer;
+
+	/** Returns the IDs of all processors in the module tree (in the iteration order). */
+	static StringArray getProcessorIds(MainController* mc);
+
+	void timerCallback() override;
+
+	bool writeChunk(ChunkType t, const void* data, int numBytes, bool waitForSpace);
+	void flush();
+
+	std::atomic<bool> recording = { false };
+	std::atomic<bool> replaying = { false };
+	std::atomic<bool> overflow = { false };
+
+	SpinLock writeLock;
+	AbstractFifo fifo;
+	HeapBlock<uint8> fifoData;
+	HeapBlock<uint8> blockData;
+
+	CriticalSection outputLock;
+	std::unique_ptr<FileOutputStream> output;
+	File currentFile;
+
+	JUCE_DECLARE_NON_COPYABLE(RenderInputRecorder);
+};
+
+/** Replays a log that was written by the RenderInputRecorder and measures the render time of each block.
+
+	It takes exclusive access of the audio rendering (just like the audio export) and feeds the recorded
+	events, transport positions, parameter changes and preset loads into the engine in the exact order
+	they were recorded. The timings can be used to find slow blocks and you can restrict the measurement
+	to a range of blocks in order to bisect a CPU spike (the blocks before the range are still rendered
+	so that the engine is in the same state).
+*/
+class RenderInputPlayer: public ControlledObject
+{
+public:
+
+	struct Options
+	{
+		/** The first block that will be measured. */
+		int firstBlock = 0;
+
+		/** The last block that will be rendered (-1 renders the entire log). */
+		int lastBlock = -1;
+
+		/** Renders in non-realtime mode so that the sample streaming is deterministic. */
+		bool renderOffline = false;
+
+		/** Waits between the blocks so that the background threads are running at the same speed. */
+		bool paceInRealtime = true;
+
+		/** If not null, the rendered audio will be written into this buffer (eg. to compare it with the recording). */
+		AudioSampleBuffer* renderedOutput = nullptr;
+	};
+
+	struct BlockTiming
+	{
+		int blockIndex;
+		int numSamples;
+		double renderTime;
+		double load;
+	};
+
+	RenderInputPlayer(MainController* mc);
+
+	/** Replays the log. Call this from any thread except the audio thread. */
+	Result replay(const File& logFile, const Options& options);
+
+	const Array<BlockTiming>& getTimings() const { return timings; }
+
+	/** Creates a summary with the average and peak load and the slowest blocks. */
+	String createReport(int numSlowestBlocks=10) const;
+
+	/** Writes the timings of each block as CSV file. */
+	Result writeTimingsToFile(const File& csvFile) const;
+
+private:
+
+	struct ReplayPlayHead: public AudioPlayHead
+	{
+		bool getCurrentPosition(CurrentPositionInfo& result) override
+		{
+			result = info;
+			return hasInfo;
+		}
+
+		CurrentPositionInfo info;
+		bool hasInfo = false;
+	};
+
+	bool readChunk(InputStream& input, MemoryBlock& data);
+	Result checkProject(MemoryInputStream& header, int formatVersion) const;
+	Result renderChunks(InputStream& input, const Options& options, ReplayPlayHead& playHead);
+	bool waitForPresetLoad();
+
+	RenderInputRecorder::ChunkType currentChunk = RenderInputRecorder::ChunkType::numChunkTypes;
+	Array<BlockTiming> timings;
+	double sampleRate = 0.0;
+	int maxBlockSize = 0;
+};
+
 
 } // namespace hise
 
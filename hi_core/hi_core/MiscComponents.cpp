@@ -559,6 +559,245 @@ void MouseCallbackComponent::sendToListeners(var clickInformation)
 bool DrawActions::PostActionBase::needsStackData() const
 { return false; }
 
+DrawActions::ContentHash::ContentHash(int typeHash)
+{
+	add(typeHash);
+}
+
+void DrawActions::ContentHash::add(uint64 v)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		value ^= (v >> (i * 8)) & 0xFF;
+		value *= 1099511628211ull;
+	}
+}
+
+void DrawActions::ContentHash::add(int v)
+{ add((uint64)(uint32)v); }
+
+void DrawActions::ContentHash::add(float v)
+{
+	uint32 bits;
+	memcpy(&bits, &v, sizeof(float));
+	add((uint64)bits);
+}
+
+void DrawActions::ContentHash::add(bool v)
+{ add((uint64)(v ? 1 : 0)); }
+
+void DrawActions::ContentHash::add(const String& s)
+{ add((uint64)s.hashCode64()); }
+
+void DrawActions::ContentHash::add(const var& v)
+{
+	if (v.isArray())
+	{
+		for (const auto& e : *v.getArray())
+			add(e);
+	}
+	else
+		add(v.toString());
+}
+
+void DrawActions::ContentHash::add(Colour c)
+{ add((uint64)c.getARGB()); }
+
+void DrawActions::ContentHash::add(Rectangle<float> r)
+{
+	add(r.getX()); add(r.getY()); add(r.getWidth()); add(r.getHeight());
+}
+
+void DrawActions::ContentHash::add(Rectangle<int> r)
+{
+	add(r.getX()); add(r.getY()); add(r.getWidth()); add(r.getHeight());
+}
+
+void DrawActions::ContentHash::add(const Path& p)
+{
+	add(p.isUsingNonZeroWinding());
+
+	Path::Iterator it(p);
+
+	while (it.next())
+	{
+		add((int)it.elementType);
+		add(it.x1); add(it.y1);
+		add(it.x2); add(it.y2);
+		add(it.x3); add(it.y3);
+	}
+}
+
+void DrawActions::ContentHash::add(const PathStrokeType& s)
+{
+	add(s.getStrokeThickness());
+	add((int)s.getJointStyle());
+	add((int)s.getEndStyle());
+}
+
+void DrawActions::ContentHash::add(const AffineTransform& t)
+{
+	add(t.mat00); add(t.mat01); add(t.mat02);
+	add(t.mat10); add(t.mat11); add(t.mat12);
+}
+
+void DrawActions::ContentHash::add(const Font& f)
+{
+	add(f.getTypefaceName());
+	add(f.getTypefaceStyle());
+	add(f.getHeight());
+	add(f.getHorizontalScale());
+	add(f.getExtraKerningFactor());
+	add(f.getStyleFlags());
+}
+
+void DrawActions::ContentHash::add(const ColourGradient& g)
+{
+	add(g.isRadial);
+	add(g.point1.x); add(g.point1.y);
+	add(g.point2.x); add(g.point2.y);
+
+	for (int i = 0; i < g.getNumColours(); i++)
+	{
+		add(g.getColour(i));
+		add((float)g.getColourPosition(i));
+	}
+}
+
+void DrawActions::ContentHash::add(const Justification& j)
+{ add(j.getFlags()); }
+
+void DrawActions::ContentHash::add(const RectanglePlacement& p)
+{ add(p.getFlags()); }
+
+void DrawActions::ContentHash::add(const DropShadow& s)
+{
+	add(s.colour);
+	add(s.radius);
+	add(s.offset.x); add(s.offset.y);
+}
+
+void DrawActions::ContentHash::add(const melatonin::ShadowParameters& sp)
+{
+	add(sp.color);
+	add(sp.radius);
+	add(sp.offset.x); add(sp.offset.y);
+	add(sp.spread);
+	add(sp.inner);
+}
+
+void DrawActions::ContentHash::add(const Image& img)
+{
+	// Hashing the pixels would be too slow, but we can't use the address of the pixel data
+	// because it might be reused by another image after it was freed. So every pixel data
+	// object gets a unique id the first time it's hashed.
+	static SpinLock idLock;
+	static int64 lastId = 0;
+	static const Identifier hashId("DrawActionHashId");
+
+	int64 id = 0;
+
+	if (auto pd = img.getPixelData())
+	{
+		SpinLock::ScopedLockType sl(idLock);
+
+		if (auto existing = pd->userData.getVarPointer(hashId))
+			id = (int64)*existing;
+		else
+		{
+			id = ++lastId;
+			pd->userData.set(hashId, id);
+		}
+	}
+
+	add((uint64)id);
+	add(img.getWidth());
+	add(img.getHeight());
+}
+
+uint64 DrawActions::PostActionBase::getContentHash() const
+{ return 0; }
+
+bool DrawActions::ActionBase::canBeRenderedOnBackgroundThread() const
+{ return true; }
+
+uint64 DrawActions::LayerCache::createKey(uint64 contentHash, Rectangle<int> imageBounds, float scaleFactor)
+{
+	if (contentHash == 0)
+		return 0;
+
+	ContentHash h(0);
+	h.add(contentHash);
+	h.add(imageBounds);
+	h.add(scaleFactor);
+	return h.get();
+}
+
+Image DrawActions::LayerCache::getImage(uint64 key)
+{
+	ScopedLock sl(lock);
+
+	for (auto& e : entries)
+	{
+		if (e.key == key)
+		{
+			e.used = true;
+			numHits++;
+			return e.img;
+		}
+	}
+
+	numMisses++;
+	return {};
+}
+
+bool DrawActions::LayerCache::contains(uint64 key) const
+{
+	ScopedLock sl(lock);
+
+	for (const auto& e : entries)
+	{
+		if (e.key == key)
+			return true;
+	}
+
+	return false;
+}
+
+void DrawActions::LayerCache::storeImage(uint64 key, const Image& img)
+{
+	// Create a copy so that the cached image isn't modified when it's used as blend target
+	auto copy = img.createCopy();
+
+	ScopedLock sl(lock);
+
+	for (auto& e : entries)
+	{
+		if (e.key == key)
+		{
+			e.img = copy;
+			e.used = true;
+			return;
+		}
+	}
+
+	entries.add({ key, copy, true });
+}
+
+void DrawActions::LayerCache::clearUnusedImages()
+{
+	ScopedLock sl(lock);
+
+	for (int i = 0; i < entries.size(); i++)
+	{
+		if (!entries.getReference(i).used)
+			entries.remove(i--);
+		else
+			entries.getReference(i).used = false;
+	}
+}
+
+
 DrawActions::ActionBase::ActionBase()
 {}
 
@@ -577,6 +816,9 @@ void DrawActions::ActionBase::setCachedImage(Image& actionImage_, Image& mainIma
 void DrawActions::ActionBase::setScaleFactor(float sf)
 { scaleFactor = sf; }
 
+uint64 DrawActions::ActionBase::getContentHash() const
+{ return 0; }
+
 DrawActions::MarkdownAction::MarkdownAction(const MarkdownLayout::StringWidthFunction& f):
 	renderer("", f)
 {}
@@ -659,6 +901,63 @@ void DrawActions::ActionLayer::addPostAction(PostActionBase* a)
 	postActions.add(a);
 }
 
+uint64 DrawActions::ActionLayer::getContentHash() const
+{
+	if (contentHashCalculated)
+		return contentHash;
+
+	contentHashCalculated = true;
+	contentHash = 0;
+
+	ContentHash h(getDispatchId().hash());
+	h.add(drawOnParent);
+
+	for (auto a : internalActions)
+	{
+		auto ah = a->getContentHash();
+
+		if (ah == 0)
+			return 0;
+
+		h.add(ah);
+	}
+
+	for (auto p : postActions)
+	{
+		auto ph = p->getContentHash();
+
+		if (ph == 0)
+			return 0;
+
+		h.add(ph);
+	}
+
+	contentHash = h.get();
+	return contentHash;
+}
+
+bool DrawActions::ActionLayer::canBeRenderedOnBackgroundThread() const
+{
+	for (auto a : internalActions)
+	{
+		if (!a->canBeRenderedOnBackgroundThread())
+			return false;
+	}
+
+	return true;
+}
+
+void DrawActions::ActionLayer::setLayerCache(LayerCache* c)
+{
+	layerCache = c;
+
+	for (auto a : internalActions)
+	{
+		if (auto l = dynamic_cast<ActionLayer*>(a))
+			l->setLayerCache(c);
+	}
+}
+
 DrawActions::BlendingLayer::BlendingLayer(gin::BlendMode m, float alpha_):
 	ActionLayer(true),
 	blendMode(m),
@@ -670,6 +969,20 @@ DrawActions::BlendingLayer::BlendingLayer(gin::BlendMode m, float alpha_):
 bool DrawActions::BlendingLayer::wantsCachedImage() const
 { return true; }
 
+uint64 DrawActions::BlendingLayer::getContentHash() const
+{
+	auto lh = ActionLayer::getContentHash();
+
+	if (lh == 0)
+		return 0;
+
+	ContentHash h(getDispatchId().hash());
+	h.add(lh);
+	h.add((int)blendMode);
+	h.add(alpha);
+	return h.get();
+}
+
 void DrawActions::NoiseMapManager::drawNoiseMap(Graphics& g, Rectangle<int> area, float alpha, bool monochrom,
 	float scale)
 {
@@ -698,6 +1011,9 @@ void DrawActions::NoiseMapManager::drawNoiseMap(Graphics& g, Rectangle<int> area
 
 DrawActions::NoiseMapManager::NoiseMap& DrawActions::NoiseMapManager::getNoiseMap(Rectangle<int> area, bool monochrom)
 {
+	// layers might be rendered on multiple background threads
+	SimpleReadWriteLock::ScopedMultiWriteLock sl(lock);
+
 	for (auto m : maps)
 	{
 
@@ -763,6 +1079,130 @@ DrawActions::Handler::Listener::~Listener()
 DrawActions::Handler::~Handler()
 {
 	cancelPendingUpdate();
+	cancelBackgroundRasterisation();
+
+	// The cancelled jobs might still be running, so we have to join them before the cache goes away
+	waitForBackgroundRasterisation();
+}
+
+struct DrawActions::Handler::RasterisationJob : public ThreadPoolJob
+{
+	RasterisationJob(Handler& h, ActionLayer* l, uint64 key_, Rectangle<int> imageBounds_, float sf_):
+		ThreadPoolJob("Rasterise layer"),
+		handler(h),
+		layer(l),
+		key(key_),
+		imageBounds(imageBounds_),
+		sf(sf_)
+	{}
+
+	JobStatus runJob() override
+	{
+		if (shouldExit())
+			return jobHasFinished;
+
+		TRACE_EVENT("drawactions", "rasterise layer");
+
+		// This must match the rendering of a layer in Iterator::render()
+		Image img(Image::ARGB, imageBounds.getWidth(), imageBounds.getHeight(), true);
+
+		{
+			Graphics g(img);
+
+			layer->setLayerCache(&handler.layerCache);
+			layer->setScaleFactor(sf);
+			layer->setCachedImage(img, img);
+			layer->perform(g);
+		}
+
+		// The list was replaced during the rendering, so the image is not needed anymore
+		if (shouldExit())
+			return jobHasFinished;
+
+		handler.layerCache.storeImage(key, img);
+		handler.statistics.numBackgroundRasterisations++;
+
+		return jobHasFinished;
+	}
+
+	Handler& handler;
+	ActionLayer::Ptr layer;
+	const uint64 key;
+	const Rectangle<int> imageBounds;
+	const float sf;
+};
+
+void DrawActions::Handler::rasteriseInBackground(const ReferenceCountedArray<ActionBase>& list, Rectangle<int> imageBounds, float sf)
+{
+	if (imageBounds.isEmpty())
+		return;
+
+	Array<uint64> scheduledKeys;
+	OwnedArray<ThreadPoolJob> newJobs;
+
+	for (auto a : list)
+	{
+		// Layers that draw on their parent depend on everything that was drawn before
+		if (!a->wantsCachedImage() || a->wantsToDrawOnParent())
+			continue;
+
+		if (auto l = dynamic_cast<ActionLayer*>(a))
+		{
+			auto key = LayerCache::createKey(l->getContentHash(), imageBounds, sf);
+
+			if (key == 0 || scheduledKeys.contains(key) || layerCache.contains(key) || !l->canBeRenderedOnBackgroundThread())
+				continue;
+
+			scheduledKeys.add(key);
+			newJobs.add(new RasterisationJob(*this, l, key, imageBounds, sf));
+		}
+	}
+
+	if (newJobs.isEmpty())
+		return;
+
+	ScopedLock sl(jobLock);
+
+	for (auto j : newJobs)
+		rasterisationPool->getThreadPool().addJob(j, false);
+
+	pendingJobs.addArray(newJobs);
+	newJobs.clearQuick(false);
+}
+
+void DrawActions::Handler::waitForBackgroundRasterisation()
+{
+	OwnedArray<ThreadPoolJob> jobsToWaitFor;
+
+	{
+		ScopedLock sl(jobLock);
+		jobsToWaitFor.swapWith(pendingJobs);
+	}
+
+	// The pool might be busy with other tasks, so we take back the layers that haven't
+	// started yet (the Iterator will render them) and only wait for the running ones.
+	// This includes the cancelled jobs as they might still use the layers of the old list.
+	for (auto j : jobsToWaitFor)
+		rasterisationPool->getThreadPool().removeJob(j, false, -1);
+}
+
+void DrawActions::Handler::cancelBackgroundRasterisation()
+{
+	ScopedLock sl(jobLock);
+
+	auto& pool = rasterisationPool->getThreadPool();
+
+	// We can't remove the jobs here because the Iterator must join the running ones
+	// before it renders, so we just tell them to skip the work and clean up the finished jobs
+	for (int i = pendingJobs.size() - 1; i >= 0; i--)
+	{
+		auto j = pendingJobs.getUnchecked(i);
+
+		if (!pool.contains(j))
+			pendingJobs.remove(i);
+		else
+			j->signalJobShouldExit();
+	}
 }
 
 void DrawActions::Handler::beginDrawing()
@@ -796,16 +1236,76 @@ void DrawActions::Handler::addDrawAction(ActionBase* newDrawAction)
 		currentActions.add(newDrawAction);
 }
 
+uint64 DrawActions::Handler::createListHash(const ReferenceCountedArray<ActionBase>& list)
+{
+	if (list.isEmpty())
+		return 0;
+
+	ContentHash h(0);
+	auto comparable = true;
+
+	// Calculate the hash of every action here (even if the list can't be compared) so
+	// that the layers don't have to calculate it lazily on the rendering threads
+	for (auto a : list)
+	{
+		auto ah = a->getContentHash();
+
+		comparable &= (ah != 0);
+		h.add(ah);
+	}
+
+	return comparable ? h.get() : 0;
+}
+
+var DrawActions::Handler::Statistics::toJSON() const
+{
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	obj->setProperty("NumFlushes", numFlushes.load());
+	obj->setProperty("NumUnchangedFlushes", numUnchangedFlushes.load());
+	obj->setProperty("NumLayerCacheHits", cache.numHits.load());
+	obj->setProperty("NumLayerCacheMisses", cache.numMisses.load());
+	obj->setProperty("NumBackgroundRasterisations", numBackgroundRasterisations.load());
+
+	return var(obj.get());
+}
+
 void DrawActions::Handler::flush(uint64_t perfettoTrackId)
 {
+	// If the paint routine created the exact same actions as last time, there's no need to repaint
+	auto newListHash = createListHash(currentActions);
+
+	statistics.numFlushes++;
+
+	Rectangle<int> imageBounds;
+	float sf = 1.0f;
+
 	{
 		SpinLock::ScopedLockType sl(lock);
 
+		layerStack.clear();
+
+		if (newListHash != 0 && newListHash == lastListHash)
+		{
+			currentActions.clear();
+			statistics.numUnchangedFlushes++;
+			return;
+		}
+
 		nextActions.swapWith(currentActions);
 		currentActions.clear();
-		layerStack.clear();
+
+		imageBounds = lastImageBounds;
+		sf = lastRenderScaleFactor;
 	}
 
+	lastListHash = newListHash;
+
+	// The layers of the old list are not needed anymore, so we start with the new ones
+	// right away (using the size of the last render) and let the message thread pick them up
+	cancelBackgroundRasterisation();
+	rasteriseInBackground(nextActions, imageBounds, sf);
+
 	if(perfettoTrackId != 0)
 		flowManager.continueFlow(perfettoTrackId, "flush draw handler");
 
@@ -1412,10 +1912,29 @@ void DrawActions::BlendingLayer::perform(Graphics& g)
 	}
 
 	setCachedImage(blendSource, actionImage);
+
+	// The blend target depends on what's below, but the layer content can be reused
+	auto key = layerCache != nullptr ? LayerCache::createKey(ActionLayer::getContentHash(), actionImage.getBounds(), scaleFactor) : 0;
+
+	if (key != 0)
+	{
+		auto cached = layerCache->getImage(key);
+
+		if (cached.isValid())
+		{
+			gin::applyBlend(imageToBlendOn, cached, blendMode, alpha);
+			return;
+		}
+	}
+
 	Graphics g2(blendSource);
     g2.addTransform(AffineTransform::scale(scaleFactor));
 
 	ActionLayer::perform(g2);
+
+	if (key != 0)
+		layerCache->storeImage(key, blendSource);
+
 	gin::applyBlend(imageToBlendOn, blendSource, blendMode, alpha);
 }
 
@@ -1458,6 +1977,18 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 			cachedImg = Image(Image::ARGB, c->getWidth() * sf, c->getHeight() * sf, true);
 		}
 
+		{
+			SpinLock::ScopedLockType sl(handler->lock);
+			handler->lastImageBounds = cachedImg.getBounds();
+			handler->lastRenderScaleFactor = sf;
+		}
+
+		// Pick up the layers that were rendered after the flush and render the missing
+		// ones (eg. after a resize) in parallel before compositing them below
+		handler->waitForBackgroundRasterisation();
+		handler->rasteriseInBackground(actionsInIterator, cachedImg.getBounds(), sf);
+		handler->waitForBackgroundRasterisation();
+
 		Graphics g2(cachedImg);
 		g2.addTransform(st);
 
@@ -1471,6 +2002,31 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 
 			if (action->wantsCachedImage())
 			{
+				auto layer = dynamic_cast<ActionLayer*>(action.get());
+
+				if (layer != nullptr)
+					layer->setLayerCache(&handler->layerCache);
+
+				// A layer that doesn't draw on its parent only depends on its own content
+				// so we can reuse the image from the last render if nothing has changed
+				uint64 key = 0;
+
+				if (layer != nullptr && !action->wantsToDrawOnParent())
+				{
+					key = LayerCache::createKey(layer->getContentHash(), cachedImg.getBounds(), sf);
+
+					if (key != 0)
+					{
+						auto cachedLayer = handler->layerCache.getImage(key);
+
+						if (cachedLayer.isValid())
+						{
+							g2.drawImageAt(cachedLayer, 0, 0);
+							continue;
+						}
+					}
+				}
+
 				Image actionImage;
 
 				if (action->wantsToDrawOnParent())
@@ -1486,6 +2042,9 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 				action->setCachedImage(actionImage, cachedImg);
 				action->perform(g3);
 
+				if (key != 0)
+					handler->layerCache.storeImage(key, actionImage);
+
 				if (!action->wantsToDrawOnParent())
                 {
                     g2.drawImageAt(actionImage, 0, 0);
@@ -1512,6 +2071,9 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 		}
 			
 	}
+
+	// Drop the layer images that weren't part of this render
+	handler->layerCache.clearUnusedImages();
 }
 
 DrawActions::NoiseMapManager::NoiseMap::NoiseMap(Rectangle<int> a, bool monochrom_) :
@@ -299,12 +299,92 @@ private:
 
 struct DrawActions
 {
+	/** A helper class that creates a hash from the content of a draw action.
+
+		This is used to detect whether a paint routine created the same list of actions as before,
+		so that the handler can skip the repaint and reuse the rasterised images of layers. */
+	struct ContentHash
+	{
+		ContentHash(int typeHash);
+
+		template <typename... Args> static uint64 create(const dispatch::HashedCharPtr& id, const Args&... args)
+		{
+			ContentHash h(id.hash());
+			(h.add(args), ...);
+			return h.get();
+		}
+
+		void add(uint64 v);
+		void add(int v);
+		void add(float v);
+		void add(bool v);
+		void add(const String& s);
+		void add(const var& v);
+		void add(Colour c);
+		void add(Rectangle<float> r);
+		void add(Rectangle<int> r);
+		void add(const Path& p);
+		void add(const PathStrokeType& s);
+		void add(const AffineTransform& t);
+		void add(const Font& f);
+		void add(const ColourGradient& g);
+		void add(const Justification& j);
+		void add(const RectanglePlacement& p);
+		void add(const DropShadow& s);
+		void add(const melatonin::ShadowParameters& sp);
+		void add(const Image& img);
+
+		/** Returns the hash. This will never be zero (which is used for actions that can't be compared). */
+		uint64 get() const { return value != 0 ? value : 1; }
+
+	private:
+
+		uint64 value = 14695981039346656037ull;
+	};
+
 	class PostActionBase : public ReferenceCountedObject
 	{
 	public:
 
 		virtual void perform(PostGraphicsRenderer& r) = 0;
 		virtual bool needsStackData() const;
+
+		/** Override this and return a hash of the parameters. Zero means that the action can't be cached. */
+		virtual uint64 getContentHash() const;
+	};
+
+	/** Stores the rasterised images of layers so that they don't need to be rendered again if their content didn't change. */
+	struct LayerCache
+	{
+		static uint64 createKey(uint64 contentHash, Rectangle<int> imageBounds, float scaleFactor);
+
+		/** Returns the image for the key (or a null image), marks it as used and counts the cache hit or miss. */
+		Image getImage(uint64 key);
+
+		/** Checks whether there is an image for the key without marking it as used. */
+		bool contains(uint64 key) const;
+
+		void storeImage(uint64 key, const Image& img);
+
+		/** Removes all images that were not used since the last call to this method. */
+		void clearUnusedImages();
+
+		std::atomic<int> numHits = { 0 };
+		std::atomic<int> numMisses = { 0 };
+
+	private:
+
+		// Layers are rasterised on background threads too, so the entries need to be locked
+		CriticalSection lock;
+
+		struct Entry
+		{
+			uint64 key;
+			Image img;
+			bool used;
+		};
+
+		Array<Entry> entries;
 	};
 
 	class ActionBase: public ReferenceCountedObject
@@ -324,6 +404,13 @@ struct DrawActions
 		virtual void setCachedImage(Image& actionImage_, Image& mainImage_);
 		virtual void setScaleFactor(float sf);
 
+		/** Override this and return a hash of the parameters. Zero means that the action can't be compared
+			(eg. because it draws something that can change without the action being recreated). */
+		virtual uint64 getContentHash() const;
+
+		/** Override this and return false if the action must be performed on the message thread. */
+		virtual bool canBeRenderedOnBackgroundThread() const;
+
 	protected:
 
 		Image actionImage;
@@ -376,10 +463,23 @@ struct DrawActions
 
 		void addPostAction(PostActionBase* a);
 
+		/** Combines the hashes of all actions and post actions. The hash is calculated once after the layer was flushed. */
+		uint64 getContentHash() const override;
+
+		/** Sets the cache that this layer (and all child layers) will use for their rasterised content. */
+		void setLayerCache(LayerCache* c);
+
+		bool canBeRenderedOnBackgroundThread() const override;
+
 	protected:
 
 		bool drawOnParent = false;
 
+		LayerCache* layerCache = nullptr;
+
+		mutable uint64 contentHash = 0;
+		mutable bool contentHashCalculated = false;
+
 		OwnedArray<ActionBase> internalActions;
 		OwnedArray<PostActionBase> postActions;
 		PostGraphicsRenderer::DataStack stack;
@@ -397,6 +497,8 @@ struct DrawActions
 
 		void perform(Graphics& g) override;
 
+		uint64 getContentHash() const override;
+
 		float alpha;
 		
 		Image blendSource;
@@ -459,6 +561,20 @@ struct DrawActions
 			JUCE_DECLARE_WEAK_REFERENCEABLE(Listener);
 		};
 
+		struct Statistics
+		{
+			Statistics(const LayerCache& cache_) : cache(cache_) {}
+
+			var toJSON() const;
+
+			/** The cache counts the hits and misses of all layers (including blending layers). */
+			const LayerCache& cache;
+
+			std::atomic<int> numFlushes = { 0 };
+			std::atomic<int> numUnchangedFlushes = { 0 };
+			std::atomic<int> numBackgroundRasterisations = { 0 };
+		};
+
         ~Handler();
 
 		void beginDrawing();
@@ -493,8 +609,40 @@ struct DrawActions
 
 		NoiseMapManager* getNoiseMapManager();
 
+		/** Returns the statistics about skipped repaints and the layer cache. */
+		const Statistics& getStatistics() const { return statistics; }
+
+		/** Waits until all layers that are currently rasterised on the background threads are finished.
+
+			This is called by the Iterator before it renders the actions so that it can pick up the images from the layer cache. */
+		void waitForBackgroundRasterisation();
+
 	private:
 
+		struct RasterisationJob;
+
+		/** Renders all layers of the list that don't draw on their parent and aren't in the cache yet on the background threads. */
+		void rasteriseInBackground(const ReferenceCountedArray<ActionBase>& list, Rectangle<int> imageBounds, float sf);
+
+		/** Tells the pending jobs to skip their work without waiting for them.
+
+			The jobs stay in the list so that waitForBackgroundRasterisation() still joins the running ones. */
+		void cancelBackgroundRasterisation();
+
+		static uint64 createListHash(const ReferenceCountedArray<ActionBase>& list);
+
+		Statistics statistics { layerCache };
+		LayerCache layerCache;
+		uint64 lastListHash = 0;
+
+		SharedResourcePointer<SharedWorkerPool> rasterisationPool;
+		CriticalSection jobLock;
+		OwnedArray<ThreadPoolJob> pendingJobs;
+
+		// the size of the master image and scale factor of the last render (guarded by the spin lock)
+		Rectangle<int> lastImageBounds;
+		float lastRenderScaleFactor = 1.0f;
+
 		dispatch::AccumulatedFlowManager flowManager;
 
 		SharedResourcePointer<NoiseMapManager> noiseManager;
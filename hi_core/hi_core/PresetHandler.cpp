@@ -3457,7 +3457,9 @@ void ModuleStateManager::restoreFromValueTree(const ValueTree &v)
 		{
 			if(ms->id == id)
 			{
+#if !HISE_SKIP_UNCHANGED_STATE_RESTORE
 				didSomething = true;
+#endif
 				isModuleState = true;
 				break;
 			}
@@ -3484,6 +3486,17 @@ void ModuleStateManager::restoreFromValueTree(const ValueTree &v)
 
 			if (p->getType().toString() == mcopy["Type"].toString())
 			{
+#if HISE_SKIP_UNCHANGED_STATE_RESTORE
+				// Only touch the modules that have changed
+				auto currentState = p->exportAsValueTree();
+				currentState.removeChild(currentState.getChildWithName("EditorStates"), nullptr);
+
+				if (MainController::UserPresetHandler::isStateSectionUnchanged(mcopy, currentState))
+					continue;
+
+				didSomething = true;
+#endif
+
 				p->restoreFromValueTree(mcopy);
 				p->sendOtherChangeMessage(dispatch::library::ProcessorChangeEvent::Preset, dispatch::sendNotificationAsync);
 			}
@@ -438,6 +438,8 @@ void MainController::UserPresetHandler::loadUserPresetFromValueTree(const ValueT
 	}
 	else
 	{
+		mc->getRenderInputRecorder().recordPresetLoad(v, newFile);
+
 		currentlyLoadedFile = newFile;
 		pendingPreset = v;
 
@@ -200,6 +200,9 @@ void Processor::setAttribute(int parameterIndex, float newValue, dispatch::Dispa
 {
 	setInternalAttribute(parameterIndex, newValue);
 
+	if (hasAutomationRamps)
+		getMainController()->getAutomationRampHandler().addValueChange(this, parameterIndex, newValue);
+
 #if HISE_OLD_PROCESSOR_DISPATCH
 	if(notifyEditor == dispatch::DispatchType::sendNotification)
 	{
@@ -866,6 +866,9 @@ protected:
 	*   \param newValue the new value between 0.0 and 1.0
 	*/
 	virtual void setInternalAttribute(int parameterIndex, float newValue) = 0;
+
+	/** Call this after you've registered an attribute at the AutomationRampHandler so that setAttribute() forwards the value changes. */
+	void setHasAutomationRamps(bool shouldForwardChanges) noexcept { hasAutomationRamps = shouldForwardChanges; }
 	
 	bool consoleEnabled;
 
@@ -918,6 +921,7 @@ private:
 
 	bool bypassed;
 	bool visible;
+	bool hasAutomationRamps = false;
 
 	double samplerate;
 
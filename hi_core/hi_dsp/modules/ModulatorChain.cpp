@@ -563,6 +563,10 @@ void ModulatorChain::ModChainWithBuffer::calculateModulationValuesForCurrentVoic
 
 	bool constantValuesAreSmoothed = false;
 
+	// In gain mode, the voice start value, the envelopes and the monophonic values are just multiplied
+	// so we can skip the separate passes and let each envelope apply everything in a single loop
+	const bool fuseGainPasses = c->getMode() == Modulation::GainMode && c->hasActivePolyEnvelopes();
+
 	if (c->hasActivePolyMods())
 	{
 		const float thisConstantValue = c->getConstantVoiceValue(voiceIndex);
@@ -586,14 +590,39 @@ void ModulatorChain::ModChainWithBuffer::calculateModulationValuesForCurrentVoic
 				value += delta;
 			}
 		}
-		else
+		else if (!fuseGainPasses)
 		{
 			FloatVectorOperations::fill(voiceData + startSample_cr, thisConstantValue, numSamples_cr);
 		}
 
 		setConstantVoiceValueInternal(voiceIndex, thisConstantValue);
 
-		if (c->hasActivePolyEnvelopes())
+		if (fuseGainPasses)
+		{
+			// The first envelope writes the voice start value, the last one multiplies the monophonic values
+			const float* voiceStartValue = constantValuesAreSmoothed ? nullptr : &thisConstantValue;
+			int numLeft = static_cast<const ModulatorChainHandler*>(c->getHandler())->activeEnvelopesList.size();
+
+			ModIterator<EnvelopeModulator> iter(c);
+
+			while (auto mod = iter.next())
+			{
+				const float* monoValues = (--numLeft == 0 && useMonophonicData) ? monoData : nullptr;
+
+				mod->renderFused(voiceIndex, voiceData, modBuffer.scratchBuffer, startSample_cr, numSamples_cr, voiceStartValue, monoValues);
+				voiceStartValue = nullptr;
+
+				if (scratchBufferFunction)
+					scratchBufferFunction(voiceIndex, mod, modBuffer.scratchBuffer, startSample_cr, numSamples_cr);
+			}
+
+			currentVoiceData = voiceData;
+
+#if JUCE_DEBUG
+			polyExpandChecker = false;
+#endif
+		}
+		else if (c->hasActivePolyEnvelopes())
 		{
 			ModIterator<EnvelopeModulator> iter(c);
 
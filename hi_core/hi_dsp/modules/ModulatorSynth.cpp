@@ -546,6 +546,11 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 
 	processHiseEventBuffer(inputMidiBuffer, numSamplesFixed);
 
+	auto& governor = getMainController()->getRenderBudgetGovernor();
+
+	if (governor.isPolicyActive(RenderBudgetGovernor::Policy::KillReleasingVoices) && killQuietestReleasingVoice())
+		governor.onVoiceKilled();
+
 	
 
 	HiseEventBuffer::Iterator eventIterator(eventBuffer);
@@ -1553,6 +1558,29 @@ void ModulatorSynth::killAllVoicesWithNoteNumber(int noteNumber)
 
 
 	
+bool ModulatorSynth::killQuietestReleasingVoice()
+{
+	ModulatorSynthVoice* quietestVoice = nullptr;
+	float lowestLevel = std::numeric_limits<float>::max();
+
+	for (auto v : activeVoices)
+	{
+		if (v->isTailingOff() && !v->isBeingKilled() && v->getReleasePeakLevel() < lowestLevel)
+		{
+			quietestVoice = v;
+			lowestLevel = v->getReleasePeakLevel();
+		}
+	}
+
+	if (quietestVoice != nullptr)
+	{
+		quietestVoice->killVoice();
+		return true;
+	}
+
+	return false;
+}
+
 int ModulatorSynth::killLastVoice(bool allowTailOff/*=true*/)
 {
 	ModulatorSynthVoice *oldestUnkilledMessage = nullptr;
@@ -1986,6 +2014,7 @@ void ModulatorSynthVoice::startNote(int, float, SynthesiserSound*, int)
 
 	killThisVoice = false;
 	isTailing = false;
+	releasePeakLevel = 0.0f;
 	voiceUptime = 0.0;
 	uptimeDelta = 0.0;
 	startUptimeDelta = 0.0;
@@ -2181,6 +2210,10 @@ void ModulatorSynthVoice::renderNextBlock (AudioSampleBuffer& outputBuffer, int
 			applyKillFadeout(startSample, numSamples);
 		}
 
+		// the render budget governor uses this to find the quietest releasing voice
+		if (isTailing)
+			releasePeakLevel = voiceBuffer.getMagnitude(startSample, numSamples);
+
 		const int maxChannelAmount = jmin<int>(voiceBuffer.getNumChannels(), outputBuffer.getNumChannels());
 
 		for (int i = 0; i < maxChannelAmount; i++)
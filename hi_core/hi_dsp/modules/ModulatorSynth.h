@@ -307,6 +307,9 @@ public:
 	/** Kills the voice that is playing for the longest time. */
 	int killLastVoice(bool allowTailOff=true);
 
+	/** Kills the releasing voice with the lowest output level. Returns true if a voice was killed. */
+	bool killQuietestReleasingVoice();
+
 	
 
 	bool isSoftBypassed() const;;
@@ -688,6 +691,9 @@ public:
 
 	void applyGainModulation(int startSample, int numSamples, bool copyLeftChannel);
 
+	/** Returns the peak level of the last rendered block. This is only calculated while the voice is in its release phase. */
+	float getReleasePeakLevel() const noexcept { return releasePeakLevel; }
+
 protected:
 
 	
@@ -728,6 +734,8 @@ protected:
 	float killFadeFactor;
 	bool killThisVoice;
 
+	float releasePeakLevel = 0.0f;
+
 private:
 
 	
@@ -237,6 +237,8 @@ void ModulatorSynthChain::compileAllScripts()
 			ValueTreeUpdateWatcher::ScopedDelayer sd(c->getUpdateWatcher());
 			sp->getContent()->resetContentProperties();
 			sp->compileScript();
+
+			LOG_START("Compiled " + dynamic_cast<Processor*>(sp.get())->getId());
 		}
 
 		Processor::Iterator<RuntimeTargetHolder> rti(this, false);
@@ -28,4 +28,302 @@
 *   http://www.juce.com
 *
 *   ===========================================================================
-*/
\ No newline at end of file
+*/
+
+#ifndef MODULATORUNITTEST_H_INCLUDED
+#define MODULATORUNITTEST_H_INCLUDED
+
+#if HI_RUN_UNIT_TESTS
+
+namespace hise { using namespace juce;
+
+/** Tests the block rendering of the envelope modulators against their sample-wise calculation. */
+class EnvelopeBlockRenderingTests : public UnitTest
+{
+public:
+
+	EnvelopeBlockRenderingTests() :
+		UnitTest("Testing envelope block rendering")
+	{}
+
+	void runTest() override
+	{
+		testAhdsrBlockRendering();
+	}
+
+private:
+
+	void testAhdsrBlockRendering()
+	{
+		beginTest("Testing AHDSR block rendering against sample-wise calculation");
+
+		using Envelope = scriptnode::envelope::pimpl::ahdsr_base;
+
+		Random r;
+
+		constexpr int NumSamples = 32768;
+		constexpr int BlockSize = 64;
+
+		HeapBlock<float> sampleWise, blockWise;
+		sampleWise.calloc(NumSamples);
+		blockWise.calloc(NumSamples);
+
+		int64 sampleWiseTicks = 0;
+		int64 blockWiseTicks = 0;
+		float maxError = 0.0f;
+
+		for (int i = 0; i < 200; i++)
+		{
+			Envelope env;
+			env.setBaseSampleRate(44100.0 / (double)HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR);
+			env.setAttackCurve(r.nextFloat());
+			env.setDecayCurve(r.nextFloat());
+			env.setAttackRate(i % 5 == 0 ? 0.0f : r.nextFloat() * 1000.0f);
+			env.attackLevel = 0.5f + 0.5f * r.nextFloat();
+			env.setHoldTime(r.nextFloat() * 100.0f);
+			env.setDecayRate(1.0f + r.nextFloat() * 1000.0f);
+			env.setSustainLevel(i % 7 == 0 ? 0.0f : r.nextFloat());
+			env.setReleaseRate(1.0f + r.nextFloat() * 1000.0f);
+
+			Envelope::state_base s1, s2;
+
+			for (auto s : { &s1, &s2 })
+			{
+				s->envelope = &env;
+				s->attackLevel = env.attackLevel;
+				s->setAttackRate(env.attack);
+				s->setDecayRate(env.decay);
+				s->setReleaseRate(env.release);
+				s->current_state = Envelope::state_base::ATTACK;
+				s->current_value = 0.0f;
+			}
+
+			const int releaseBlock = r.nextInt({ 8, NumSamples / BlockSize - 64 });
+
+			auto start = Time::getHighResolutionTicks();
+
+			for (int b = 0; b < NumSamples / BlockSize; b++)
+			{
+				if (b == releaseBlock)
+					s1.current_state = Envelope::state_base::RELEASE;
+
+				for (int j = 0; j < BlockSize; j++)
+					sampleWise[b * BlockSize + j] = s1.tick();
+			}
+
+			auto mid = Time::getHighResolutionTicks();
+
+			for (int b = 0; b < NumSamples / BlockSize; b++)
+			{
+				if (b == releaseBlock)
+					s2.current_state = Envelope::state_base::RELEASE;
+
+				s2.tickBlock(blockWise + b * BlockSize, BlockSize);
+			}
+
+			sampleWiseTicks += mid - start;
+			blockWiseTicks += Time::getHighResolutionTicks() - mid;
+
+			// A state transition might be detected one sample earlier or later because of rounding errors
+			for (int j = 1; j < NumSamples - 1; j++)
+			{
+				auto error = std::abs(sampleWise[j] - blockWise[j]);
+				error = jmin(error, std::abs(sampleWise[j - 1] - blockWise[j]));
+				error = jmin(error, std::abs(sampleWise[j + 1] - blockWise[j]));
+				maxError = jmax(maxError, error);
+			}
+
+			expectEquals<int>(s1.current_state, s2.current_state, "End state");
+		}
+
+		expect(maxError < 0.002f, "Max error: " + String(maxError));
+
+		logMessage("Sample-wise: " + String(Time::highResolutionTicksToSeconds(sampleWiseTicks) * 1000.0, 2) + "ms, block-wise: " +
+			String(Time::highResolutionTicksToSeconds(blockWiseTicks) * 1000.0, 2) + "ms");
+	}
+};
+
+static EnvelopeBlockRenderingTests envelopeBlockRenderingTests;
+
+/** Renders a gain modulation chain with the fused passes and with the separate passes and compares the results. */
+class FusedGainModulationTests : public UnitTest
+{
+public:
+
+	FusedGainModulationTests() :
+		UnitTest("Testing fused gain modulation")
+	{}
+
+	void runTest() override
+	{
+		testFusedGainModulation(false);
+		testFusedGainModulation(true);
+	}
+
+private:
+
+	static constexpr int NumSamples = 256;
+	static constexpr int Offset = 8;
+
+	/** A gain modulation that applies precalculated values from the scratch buffer. */
+	struct TestModulation : public TimeModulation
+	{
+		TestModulation(float intensity_) :
+			Modulation(Modulation::GainMode),
+			TimeModulation(Modulation::GainMode)
+		{
+			setIntensity(intensity_);
+		}
+
+		Processor* getProcessor() override { return nullptr; }
+		void calculateBlock(int, int) override {}
+
+		/** Starts a ramp to the new intensity so that the smoothed code path is used. */
+		void rampIntensity(float newIntensity)
+		{
+			smoothedIntensity.reset(1000.0, 0.1);
+			setIntensity(newIntensity);
+		}
+	};
+
+	/** The state of one modulator (the modulation values will be changed by the rendering). */
+	struct ModData
+	{
+		ScopedPointer<TestModulation> mod;
+		HeapBlock<float> values;
+	};
+
+	/** Renders the chain like ModulatorChain::ModChainWithBuffer does it with and without fusing the gain passes.
+
+		If voiceStartValue is nullptr, the buffer contains a ramp of the smoothed constant value.
+	*/
+	static void renderChain(OwnedArray<ModData>& mods, float* dest, const float* voiceStartValue, const float* mono, bool fuse)
+	{
+		if (!fuse && voiceStartValue != nullptr)
+			FloatVectorOperations::fill(dest + Offset, *voiceStartValue, NumSamples);
+
+		for (int i = 0; i < mods.size(); i++)
+		{
+			auto m = mods[i];
+			m->mod->setScratchBuffer(m->values, Offset + NumSamples);
+
+			if (fuse)
+			{
+				const float* monoValues = (i == mods.size() - 1) ? mono : nullptr;
+				m->mod->applyFusedGainModulation(dest, Offset, NumSamples, voiceStartValue, monoValues);
+				voiceStartValue = nullptr;
+			}
+			else
+			{
+				m->mod->applyTimeModulation(dest, Offset, NumSamples);
+			}
+		}
+
+		if (!fuse && mono != nullptr)
+			FloatVectorOperations::multiply(dest + Offset, mono + Offset, NumSamples);
+	}
+
+	void testFusedGainModulation(bool smoothIntensity)
+	{
+		beginTest(String("Testing fused gain modulation") + (smoothIntensity ? " with smoothed intensity" : ""));
+
+		Random r;
+
+		HeapBlock<float> monoValues, initialValues, unfused, fused;
+		monoValues.calloc(Offset + NumSamples);
+		initialValues.calloc(Offset + NumSamples);
+		unfused.calloc(Offset + NumSamples);
+		fused.calloc(Offset + NumSamples);
+
+		for (int i = 0; i < Offset + NumSamples; i++)
+		{
+			monoValues[i] = r.nextFloat();
+			initialValues[i] = 0.5f + 0.5f * r.nextFloat();
+		}
+
+		const float voiceStartValue = 0.3f + 0.6f * r.nextFloat();
+
+		// One envelope uses the <true, x> loop, the others use <true, false>, <false, false> and <false, x>
+		for (int numEnvelopes = 1; numEnvelopes <= 3; numEnvelopes++)
+		{
+			for (auto useVoiceStartValue : { true, false })
+			{
+				for (auto useMono : { true, false })
+				{
+					OwnedArray<ModData> unfusedMods, fusedMods;
+
+					for (int i = 0; i < numEnvelopes; i++)
+					{
+						auto intensity = 0.2f + 0.8f * r.nextFloat();
+						auto newIntensity = r.nextFloat();
+
+						for (auto list : { &unfusedMods, &fusedMods })
+						{
+							auto m = list->add(new ModData());
+							m->mod = new TestModulation(intensity);
+							m->values.calloc(Offset + NumSamples);
+
+							if (smoothIntensity)
+								m->mod->rampIntensity(newIntensity);
+						}
+
+						for (int j = 0; j < Offset + NumSamples; j++)
+							unfusedMods[i]->values[j] = fusedMods[i]->values[j] = r.nextFloat();
+					}
+
+					// Without a voice start value the buffer contains the smoothed constant value
+					memcpy(unfused.get(), initialValues.get(), sizeof(float) * (Offset + NumSamples));
+					memcpy(fused.get(), initialValues.get(), sizeof(float) * (Offset + NumSamples));
+
+					auto vs = useVoiceStartValue ? &voiceStartValue : nullptr;
+					auto mono = useMono ? monoValues.get() : nullptr;
+
+					renderChain(unfusedMods, unfused, vs, mono, false);
+					renderChain(fusedMods, fused, vs, mono, true);
+
+					String context;
+					context << numEnvelopes << " envelopes, voice start value: " << (useVoiceStartValue ? "yes" : "no") << ", mono: " << (useMono ? "yes" : "no");
+
+					float maxError = 0.0f;
+
+					for (int i = 0; i < Offset + NumSamples; i++)
+						maxError = jmax(maxError, std::abs(unfused[i] - fused[i]));
+
+					expect(maxError < 1e-6f, context + ", max error: " + String(maxError));
+
+					// The scratch buffer function of the chain reads the intensity-applied values
+					float maxModError = 0.0f;
+
+					for (int i = 0; i < numEnvelopes; i++)
+					{
+						for (int j = 0; j < Offset + NumSamples; j++)
+							maxModError = jmax(maxModError, std::abs(unfusedMods[i]->values[j] - fusedMods[i]->values[j]));
+					}
+
+					expect(maxModError < 1e-6f, context + ", max modulation value error: " + String(maxModError));
+
+					if (useVoiceStartValue)
+					{
+						auto expectedFirst = voiceStartValue;
+
+						for (auto m : unfusedMods)
+							expectedFirst *= m->values[Offset];
+
+						if (useMono)
+							expectedFirst *= monoValues[Offset];
+
+						expectWithinAbsoluteError(fused[Offset], expectedFirst, 1e-6f, context + ": voice start value not applied");
+					}
+				}
+			}
+		}
+	}
+};
+
+static FusedGainModulationTests fusedGainModulationTests;
+
+}
+
+#endif
+
+#endif
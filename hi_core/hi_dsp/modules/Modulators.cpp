@@ -419,6 +419,65 @@ void TimeModulation::applyTimeModulation(float* destinationBuffer, int startInde
 	
 }
 
+template <bool OverwriteDestination, bool MultiplyMonoValues> static void fusedGainLoop(float* dest, float* mod, const float* mono, float voiceStartValue, float intensity, int numValues)
+{
+	const float a = 1.0f - intensity;
+
+	for (int i = 0; i < numValues; i++)
+	{
+		// Keep the order of operations from the unfused path so that the result is identical
+		const float v = mod[i] * intensity + a;
+		mod[i] = v;
+
+		float d = OverwriteDestination ? voiceStartValue : dest[i];
+		d *= v;
+
+		if (MultiplyMonoValues)
+			d *= mono[i];
+
+		dest[i] = d;
+	}
+}
+
+void TimeModulation::applyFusedGainModulation(float* destinationBuffer, int startIndex, int samplesToCopy, const float* voiceStartValue, const float* monoValues)
+{
+	jassert(modulationMode == GainMode);
+
+	float *dest = destinationBuffer + startIndex;
+	const float* mono = monoValues != nullptr ? monoValues + startIndex : nullptr;
+
+	if (smoothedIntensity.isSmoothing())
+	{
+		if (voiceStartValue != nullptr)
+			FloatVectorOperations::fill(dest, *voiceStartValue, samplesToCopy);
+
+		applyTimeModulation(destinationBuffer, startIndex, samplesToCopy);
+
+		if (mono != nullptr)
+			FloatVectorOperations::multiply(dest, mono, samplesToCopy);
+
+		return;
+	}
+
+	float *mod = internalBuffer.getWritePointer(0, startIndex);
+	const auto intensity = getIntensity();
+
+	if (voiceStartValue != nullptr)
+	{
+		if (mono != nullptr)
+			fusedGainLoop<true, true>(dest, mod, mono, *voiceStartValue, intensity, samplesToCopy);
+		else
+			fusedGainLoop<true, false>(dest, mod, mono, *voiceStartValue, intensity, samplesToCopy);
+	}
+	else
+	{
+		if (mono != nullptr)
+			fusedGainLoop<false, true>(dest, mod, mono, 1.0f, intensity, samplesToCopy);
+		else
+			fusedGainLoop<false, false>(dest, mod, mono, 1.0f, intensity, samplesToCopy);
+	}
+}
+
 const float * TimeModulation::getCalculatedValues(int /*voiceIndex*/)
 {
 	return internalBuffer.getReadPointer(0);
@@ -1194,6 +1253,27 @@ void EnvelopeModulator::render(int voiceIndex, float* voiceBuffer, float* scratc
 	polyManager.clearCurrentVoice();
 }
 
+void EnvelopeModulator::renderFused(int voiceIndex, float* voiceBuffer, float* scratchBuffer, int startSample, int numSamples, const float* voiceStartValue, const float* monoValues)
+{
+	polyManager.setCurrentVoice(voiceIndex);
+
+	setScratchBuffer(scratchBuffer, startSample + numSamples);
+	calculateBlock(startSample, numSamples);
+	applyFusedGainModulation(voiceBuffer, startSample, numSamples, voiceStartValue, monoValues);
+
+#if ENABLE_ALL_PEAK_METERS
+	if (isMonophonic || polyManager.getLastStartedVoice() == voiceIndex)
+	{
+		const float displayValue = scratchBuffer[startSample];
+		setOutputValue(displayValue);
+
+		pushPlotterValues(scratchBuffer, startSample, numSamples);
+	}
+#endif
+
+	polyManager.clearCurrentVoice();
+}
+
 int EnvelopeModulator::getNumPressedKeys() const
 {
 	jassert(isMonophonic);
@@ -295,6 +295,15 @@ public:
 	*/
 	void applyTimeModulation(float* destinationBuffer, int startIndex, int samplesToCopy);
 
+	/** Applies the intensity to the calculated gain values and multiplies them with the destination buffer in a single loop.
+	*
+	*	This is used by the modulator chain to fuse the passes of a gain modulation chain:
+	*	- if voiceStartValue is not nullptr, the destination buffer will be overwritten with this value times the modulation values.
+	*	- if monoValues is not nullptr, they will be multiplied in the same loop.
+	*
+	*	The result is the same as filling the buffer, calling applyTimeModulation() and multiplying the monophonic values afterwards.
+	*/
+	void applyFusedGainModulation(float* destinationBuffer, int startIndex, int samplesToCopy, const float* voiceStartValue, const float* monoValues);
 	
 
 	/** Returns a read pointer to the calculated values. This is used by the global modulator system. */
@@ -620,6 +629,9 @@ public:
 
 	void render(int voiceIndex, float* voiceBuffer, float* scratchBuffer, int startSample, int numSamples);
 
+	/** Same as render(), but uses TimeModulation::applyFusedGainModulation() to apply the values. */
+	void renderFused(int voiceIndex, float* voiceBuffer, float* scratchBuffer, int startSample, int numSamples, const float* voiceStartValue, const float* monoValues);
+
 protected:
 
 	int getNumPressedKeys() const;
@@ -87,6 +87,8 @@ struct CustomAutomationParameter : NEW_AUTOMATION_WITH_COMMA(public dispatch::Li
 		if (recursive)
 			return;
 
+		data->getMainController()->getRenderInputRecorder().recordParameterChange(getParameterIndex(), newValue);
+
 		newValue = data->range.convertFrom0to1(newValue);
 
 		data->call(newValue, dispatch::DispatchType::sendNotificationSync);
@@ -109,7 +109,7 @@ void ConvolutionEffect::setInternalAttribute(int parameterIndex, float newValue)
 		{
 			SimpleReadWriteLock::ScopedWriteLock sl(swapLock);
             
-            auto tToUse = useBackgroundThread && !nonRealtime ? &backgroundThread : nullptr;
+            auto tToUse = useBackgroundThread && !nonRealtime ? &workerPool.getObject() : nullptr;
             
 			convolverL->setUseBackgroundThread(tToUse);
 			convolverR->setUseBackgroundThread(tToUse);
@@ -60,7 +60,7 @@ public:
 		Latency, ///< you can change the latency (unused)
 		ImpulseLength, ///< the Impulse length (deprecated, use the SampleArea of the AudioSampleBufferComponent to change the impulse response)
 		ProcessInput, ///< if this attribute is set, the engine will fade out in a short time and reset itself.
-		UseBackgroundThread, ///< if true, then the tail of the impulse response will be rendered on a background thread to save cycles on the audio thread.
+		UseBackgroundThread, ///< if true, then the tail stages of the impulse response will be rendered on the shared convolution worker pool to save cycles on the audio thread.
 		Predelay, ///< delays the reverb tail by the given amount in milliseconds
 		HiCut, ///< applies a low pass filter to the impulse response
 		Damping, ///< applies a fade-out to the impulse response
@@ -56,6 +56,10 @@ smoothedGainR(1.0f)
 
 	smoother.setSmoothingTime(0.2f);
 
+	// The gain attribute is ramped by the automation ramp handler (the smoothed gain values only smooth the modulation)
+	mc->getAutomationRampHandler().addRamp(this, Gain, Decibels::gainToDecibels(gain), 50.0, AutomationRampHandler::RampMode::DecibelsToGain);
+	setHasAutomationRamps(true);
+
 	parameterNames.add("Gain");
     parameterNames.add("Delay");
     parameterNames.add("Width");
@@ -129,6 +133,8 @@ smoothedGainR(1.0f)
 
 GainEffect::~GainEffect()
 {
+	getMainController()->getAutomationRampHandler().removeRamps(this);
+
 	modChains.clear();
 }
     
@@ -212,8 +218,8 @@ void GainEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, int num
 
 	const float gainModValue = modChains[InternalChains::GainChain].getOneModulationValue(startSample);
 
-	smoothedGainL.setValue(gain * gainModValue);
-	smoothedGainR.setValue(gain * gainModValue);
+	smoothedGainL.setValue(gainModValue);
+	smoothedGainR.setValue(gainModValue);
 
 	const float delayModValue = modChains[InternalChains::DelayChain].getOneModulationValue(startSample);
 
@@ -239,6 +245,17 @@ void GainEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, int num
 		smoothedGainR.applyGain(r, numSamples);
 	}
 
+	if (auto gainRamp = getMainController()->getAutomationRampHandler().getRampData(this, Gain, startSample, numSamples))
+	{
+		FloatVectorOperations::multiply(l, gainRamp, numSamples);
+		FloatVectorOperations::multiply(r, gainRamp, numSamples);
+	}
+	else if (gain != 1.0f)
+	{
+		FloatVectorOperations::multiply(l, gain, numSamples);
+		FloatVectorOperations::multiply(r, gain, numSamples);
+	}
+
 	if (msDecoder.getWidth() != 1.0f)
 	{
 		numSamples = samplesToCopy;
@@ -314,8 +331,11 @@ void GainEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 		balanceSmoother.prepareToPlay(sampleRate / (double)samplesPerBlock);
 		balanceSmoother.setSmoothingTime(1000.0f);
 
-		smoothedGainL.setValueWithoutSmoothing(gain);
-		smoothedGainR.setValueWithoutSmoothing(gain);
+		smoothedGainL.setValueWithoutSmoothing(1.0f);
+		smoothedGainR.setValueWithoutSmoothing(1.0f);
+
+		// Don't ramp from the initial value to a restored gain
+		getMainController()->getAutomationRampHandler().setValueWithoutRamp(this, Gain, Decibels::gainToDecibels(gain));
 	}
 }
 
@@ -27,6 +27,8 @@
 #include "modulators/mods/MPEComponents.cpp"
 #include "modulators/mods/HardcodedNetworkModulators.cpp"
 
+#include "../hi_dsp/modules/ModulatorUnitTest.h"
+
 #if USE_BACKEND
 
 #include "modulators/editors/AhdsrEnvelopeEditor.cpp"
@@ -199,10 +199,19 @@ void TableEnvelope::calculateBlock(int startSample, int numSamples)
 
 	auto state = static_cast<TableEnvelopeState*>(isMonophonic ? monophonicState.get() : states[voiceIndex]);
 
-	while (--numSamples >= 0)
+	auto data = internalBuffer.getWritePointer(0, startSample);
+
+	while (numSamples > 0)
 	{
-		internalBuffer.setSample(0, startSample, calculateNewValue(voiceIndex));
-		++startSample;
+		// The sustain and idle states are constant, so we can fill the rest of the buffer
+		if (state->current_state == TableEnvelopeState::SUSTAIN || state->current_state == TableEnvelopeState::IDLE)
+		{
+			FloatVectorOperations::fill(data, state->current_value, numSamples);
+			break;
+		}
+
+		*data++ = calculateNewValue(voiceIndex);
+		--numSamples;
 	}
 
 	if (polyManager.getLastStartedVoice() == voiceIndex && uiUpdater.shouldUpdate())
@@ -95,11 +95,11 @@ ModulatorSynth(mc, id, numVoices)
 
 	modChains[BasicChains::GainChain].setScratchBufferFunction([this](int voiceIndex, Modulator* m, float* data, int offset, int numSamples)
 	{
-		for (auto& ev : envelopeData)
+		for (auto ev : envelopeData)
 		{
-			if (ev.getModulator() == m)
+			if (ev->getModulator() == m)
 			{
-				ev.saveValues(voiceIndex, data, offset, numSamples);
+				ev->saveValues(voiceIndex, data, offset, numSamples);
 			}
 		}
 	});
@@ -143,15 +143,55 @@ void GlobalModulatorContainer::restoreFromValueTree(const ValueTree &v)
 
 const float* GlobalModulatorContainer::getEnvelopeValuesForModulator(Processor* p, int startIndex, int voiceIndex)
 {
-	for (auto& tv : envelopeData)
+	for (auto tv : envelopeData)
 	{
-		if (tv.getModulator() == p)
-			return tv.getReadPointer(voiceIndex, startIndex);
+		if (tv->getModulator() == p)
+			return tv->getReadPointer(voiceIndex, startIndex);
 	}
 
 	return nullptr;
 }
 
+var GlobalModulatorContainer::getEnvelopeMemoryReport() const
+{
+	Array<var> list;
+
+	int64 numBytes = 0;
+	int64 numBytesWithoutPooling = 0;
+	int numFailedSlotRequests = 0;
+
+	for (auto e : envelopeData)
+	{
+		auto r = e->getMemoryReport();
+
+		DynamicObject::Ptr obj = new DynamicObject();
+
+		if (auto m = e->getModulator())
+			obj->setProperty("ID", m->getId());
+
+		obj->setProperty("NumSlots", r.numSlots);
+		obj->setProperty("NumActiveSlots", r.numActiveSlots);
+		obj->setProperty("NumBytes", r.numBytes);
+		obj->setProperty("NumBytesWithoutPooling", r.numBytesWithoutPooling);
+		obj->setProperty("NumFailedSlotRequests", r.numFailedSlotRequests);
+
+		numBytes += r.numBytes;
+		numBytesWithoutPooling += r.numBytesWithoutPooling;
+		numFailedSlotRequests += r.numFailedSlotRequests;
+
+		list.add(var(obj.get()));
+	}
+
+	DynamicObject::Ptr report = new DynamicObject();
+
+	report->setProperty("Envelopes", var(list));
+	report->setProperty("NumBytes", numBytes);
+	report->setProperty("NumBytesWithoutPooling", numBytesWithoutPooling);
+	report->setProperty("NumFailedSlotRequests", numFailedSlotRequests);
+
+	return var(report.get());
+}
+
 float GlobalModulatorContainer::getVoiceStartValueFor(const Processor * /*voiceStartModulator*/)
 {
 	return 1.0f;
@@ -264,9 +304,9 @@ void GlobalModulatorContainer::connectToGlobalCable(Modulator* childMod, var cab
 
 bool GlobalModulatorContainer::shouldReset(int voiceIndex)
 {
-	for (auto& e : envelopeData)
+	for (auto e : envelopeData)
 	{
-		if (static_cast<EnvelopeModulator*>(e.getModulator())->isPlaying(voiceIndex))
+		if (static_cast<EnvelopeModulator*>(e->getModulator())->isPlaying(voiceIndex))
 			return false;
 	}
 
@@ -320,8 +360,8 @@ void GlobalModulatorContainer::prepareToPlay(double newSampleRate, int samplesPe
 	for (auto& d : timeVariantData)
 		d.prepareToPlay(samplesPerBlock);
 
-	for (auto& d : envelopeData)
-		d.prepareToPlay(samplesPerBlock);
+	for (auto d : envelopeData)
+		d->prepareToPlay(samplesPerBlock, getNumVoices());
 
 	for (int i = 0; i < data.size(); i++)
 	{
@@ -428,11 +468,17 @@ void GlobalModulatorContainer::refreshList()
 		//mod->deactivateIntensitySmoothing();
 	}
 
-	envelopeData.clearQuick();
+	// The envelope data is owned, so we need to make sure that the audio thread isn't using it while we swap it
+	OwnedArray<EnvelopeData> newEnvelopeData;
 
 	for (auto& mod : handler_->activeEnvelopesList)
 	{
-		envelopeData.add(EnvelopeData(mod, getLargestBlockSize()));
+		newEnvelopeData.add(new EnvelopeData(mod, getLargestBlockSize(), getNumVoices()));
+	}
+
+	{
+		LockHelpers::SafeLock sl(getMainController(), LockHelpers::Type::AudioLock);
+		envelopeData.swapWith(newEnvelopeData);
 	}
 }
 
@@ -478,9 +524,9 @@ void GlobalModulatorContainerVoice::checkRelease()
 
 	if (g->hasActivePolyEnvelopes())
 	{
-		for (auto& e : gc->envelopeData)
+		for (auto e : gc->envelopeData)
 		{
-			if (e.getModulator()->isPlaying(getVoiceIndex()))
+			if (e->getModulator()->isPlaying(getVoiceIndex()))
 				return;
 		}
 	}
@@ -488,6 +534,16 @@ void GlobalModulatorContainerVoice::checkRelease()
 	resetVoice();
 }
 
+void GlobalModulatorContainerVoice::resetVoice()
+{
+	auto gc = static_cast<GlobalModulatorContainer*>(getOwnerSynth());
+
+	for (auto e : gc->envelopeData)
+		e->releaseVoice(getVoiceIndex());
+
+	ModulatorSynthVoice::resetVoice();
+}
+
 GlobalModulatorData::GlobalModulatorData(Processor *modulator_):
 modulator(modulator_),
 valuesForCurrentBuffer(1, 0)
@@ -59,6 +59,8 @@ public:
 
 	void checkRelease() override;
 
+	void resetVoice() override;
+
 };
 
 template <class ModulatorType> class GlobalModulatorDataBase
@@ -185,47 +187,181 @@ private:
 	bool isClear = false;
 };
 
+/** Stores the envelope values of a global envelope modulator for each voice.
+
+	The voices that are currently rendered are mapped to a slot from a pool of control rate buffers (the modulator
+	chain calls saveValues() with downsampled indexes). The pool is allocated in prepareToPlay() with enough slots for the
+	expected number of active voices (not for every voice), so acquiring a slot never allocates on the audio thread.
+	If there's no free slot, the voice reads silence and the failed request is counted in the memory report. The next
+	prepareToPlay() call will then grow the pool by one chunk.
+
+	A voice keeps its slot until the container voice is reset, so the slot handle that a receiver reads from stays the
+	same for the lifetime of a voice.
+*/
 class EnvelopeData : public GlobalModulatorDataBase<EnvelopeModulator>
 {
 public:
 
-	EnvelopeData(Modulator* mod, int samplesPerBlock) :
-		GlobalModulatorDataBase(mod),
-		savedValuesForBlock(NUM_POLYPHONIC_VOICES, 0)
+	static constexpr int NumSlotsPerChunk = 16;
+
+	/** The number of voices that get a preallocated slot. */
+	static constexpr int DefaultNumActiveVoices = 32;
+
+	struct MemoryReport
 	{
-		prepareToPlay(samplesPerBlock);
+		int numSlots = 0;
+		int numActiveSlots = 0;
+		int64 numBytes = 0;
+
+		/** The amount of memory a buffer with a channel for each voice would need. */
+		int64 numBytesWithoutPooling = 0;
+
+		/** The number of times a voice couldn't get a slot (and used silence instead). */
+		int numFailedSlotRequests = 0;
+	};
+
+	EnvelopeData(Modulator* mod, int samplesPerBlock, int numVoices) :
+		GlobalModulatorDataBase(mod)
+	{
+		for (auto& s : voiceSlots)
+			s = -1;
+
+		chunks.ensureStorageAllocated(NUM_POLYPHONIC_VOICES / NumSlotsPerChunk + 1);
+		freeSlots.ensureStorageAllocated(NUM_POLYPHONIC_VOICES);
+
+		prepareToPlay(samplesPerBlock, numVoices);
 	}
 
-	void prepareToPlay(int samplesPerBlock)
+	/** Resizes the slots and preallocates the slots for the expected number of active voices. Don't call this on the audio thread. */
+	void prepareToPlay(int samplesPerBlock, int numVoices)
 	{
-		ProcessorHelpers::increaseBufferIfNeeded(savedValuesForBlock, samplesPerBlock);
+		auto numSamples = samplesPerBlock / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR + 1;
+
+		if (numSamples > numSamplesPerSlot)
+		{
+			numSamplesPerSlot = numSamples;
+
+			for (auto c : chunks)
+				c->setSize(NumSlotsPerChunk, numSamplesPerSlot, true, true, false);
+
+			silence.calloc(numSamplesPerSlot);
+		}
+
+		// Grow the pool if the voices ran out of slots since the last call
+		if (numFailedSlotRequests.load() > lastNumFailedSlotRequests)
+		{
+			lastNumFailedSlotRequests = numFailedSlotRequests.load();
+			expectedNumActiveVoices = chunks.size() * NumSlotsPerChunk + NumSlotsPerChunk;
+		}
+
+		auto numSlotsToAllocate = jmin(jlimit(1, (int)NUM_POLYPHONIC_VOICES, numVoices), expectedNumActiveVoices);
+
+		while (chunks.size() * NumSlotsPerChunk < numSlotsToAllocate)
+			addChunk();
 	}
 
+	/** Returns the values for the given voice. If the voice doesn't have a slot, it will return silence. */
 	const float* getReadPointer(int voiceIndex, int startSample) const
 	{
-		return savedValuesForBlock.getReadPointer(voiceIndex, startSample);
+		auto slotIndex = getSlotIndex(voiceIndex);
+
+		if (slotIndex == -1)
+			return silence.get() != nullptr ? silence.get() + startSample : nullptr;
+
+		return getSlotData(slotIndex) + startSample;
 	}
 
 	void saveValues(int voiceIndex, const float* data, int startSample, int numSamples)
 	{
-		auto dest = savedValuesForBlock.getWritePointer(voiceIndex, startSample);
+		if (!isPositiveAndBelow(voiceIndex, NUM_POLYPHONIC_VOICES))
+			return;
+
+		if (voiceSlots[voiceIndex] == -1)
+			voiceSlots[voiceIndex] = (int16)acquireSlot();
+
+		if (voiceSlots[voiceIndex] == -1)
+			return;
+
+		auto dest = getSlotData(voiceSlots[voiceIndex]) + startSample;
 		FloatVectorOperations::copy(dest, data + startSample, numSamples);
-		isClear = false;
 	}
 
-	void clear(int voiceIndex)
+	/** Returns the slot handle for the given voice or -1 if the voice isn't active. */
+	int getSlotIndex(int voiceIndex) const
 	{
-		if (!isClear)
+		if (!isPositiveAndBelow(voiceIndex, NUM_POLYPHONIC_VOICES))
+			return -1;
+
+		return voiceSlots[voiceIndex];
+	}
+
+	/** Gives the slot of the voice back to the pool. Call this when the voice was reset. */
+	void releaseVoice(int voiceIndex)
+	{
+		auto slotIndex = getSlotIndex(voiceIndex);
+
+		if (slotIndex != -1)
 		{
-			FloatVectorOperations::fill(savedValuesForBlock.getWritePointer(voiceIndex, 0), 1.0f, savedValuesForBlock.getNumSamples());
-			isClear = true;
+			freeSlots.add(slotIndex);
+			voiceSlots[voiceIndex] = -1;
 		}
 	}
 
+	MemoryReport getMemoryReport() const
+	{
+		MemoryReport r;
+
+		r.numSlots = chunks.size() * NumSlotsPerChunk;
+		r.numActiveSlots = r.numSlots - freeSlots.size();
+		r.numBytes = (int64)(r.numSlots + 1) * numSamplesPerSlot * sizeof(float);
+		r.numBytesWithoutPooling = (int64)NUM_POLYPHONIC_VOICES * numSamplesPerSlot * sizeof(float);
+		r.numFailedSlotRequests = numFailedSlotRequests.load();
+
+		return r;
+	}
+
 private:
 
-	AudioSampleBuffer savedValuesForBlock;
-	bool isClear = false;
+	float* getSlotData(int slotIndex) const
+	{
+		return chunks[slotIndex / NumSlotsPerChunk]->getWritePointer(slotIndex % NumSlotsPerChunk);
+	}
+
+	int acquireSlot()
+	{
+		if (freeSlots.isEmpty())
+		{
+			numFailedSlotRequests++;
+			return -1;
+		}
+
+		return freeSlots.removeAndReturn(freeSlots.size() - 1);
+	}
+
+	void addChunk()
+	{
+		auto firstSlot = chunks.size() * NumSlotsPerChunk;
+
+		chunks.add(new AudioSampleBuffer(NumSlotsPerChunk, numSamplesPerSlot));
+		chunks.getLast()->clear();
+
+		// add them in reverse order so that the lowest slot is used first
+		for (int i = NumSlotsPerChunk - 1; i >= 0; i--)
+			freeSlots.add(firstSlot + i);
+	}
+
+	OwnedArray<AudioSampleBuffer> chunks;
+	Array<int> freeSlots;
+	int16 voiceSlots[NUM_POLYPHONIC_VOICES];
+
+	int numSamplesPerSlot = 0;
+	HeapBlock<float> silence;
+
+	int expectedNumActiveVoices = DefaultNumActiveVoices;
+	std::atomic<int> numFailedSlotRequests = { 0 };
+	int lastNumFailedSlotRequests = 0;
+
+	JUCE_DECLARE_NON_COPYABLE(EnvelopeData);
 };
 
 class GlobalModulatorData
@@ -431,6 +567,9 @@ public:
 	
 	void renderEnvelopeData(int voiceIndex, int startSample, int numSamples);
 
+	/** Returns the memory usage of the envelope voice storage as JSON object. */
+	var getEnvelopeMemoryReport() const;
+
     void sendVoiceStartCableValue(Modulator* m, const HiseEvent& e);
     
     
@@ -446,7 +585,7 @@ private:
     
 	Array<VoiceStartData> voiceStartData;
 	Array<TimeVariantData> timeVariantData;
-	Array<EnvelopeData> envelopeData;
+	OwnedArray<EnvelopeData> envelopeData;
 
 	Array<WeakReference<ModulatorListListener>> modListeners;
 
@@ -290,11 +290,19 @@ WavetableSynthVoice::WavetableSynthVoice(ModulatorSynth *ownerSynth):
 	wavetableSynth(dynamic_cast<WavetableSynth*>(ownerSynth)),
 	octaveTransposeFactor(1),
 	currentSound(nullptr),
-	hqMode(true)
+	hqMode(true),
+	tableIndexBuffer(1, 0)
 {
 		
 };
 
+void WavetableSynthVoice::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+	ProcessorHelpers::increaseBufferIfNeeded(tableIndexBuffer, samplesPerBlock);
+
+	ModulatorSynthVoice::prepareToPlay(sampleRate, samplesPerBlock);
+}
+
 bool WavetableSynthVoice::updateSoundFromPitchFactor(double pitchFactor, WavetableSound* soundToUse)
 {
     if(soundToUse == nullptr)
@@ -358,9 +366,16 @@ void WavetableSynthVoice::calculateBlock(int startSample, int numSamples)
 	auto stereoMode = currentSound->isStereo();
 	auto owner = static_cast<WavetableSynth*>(getOwnerSynth());
 	
+	jassert(startSample + numSamples <= tableIndexBuffer.getNumSamples());
+
+	auto tableIndexValues = tableIndexBuffer.getWritePointer(0);
+
+	for (int i = startSample; i < startSample + numSamples; i++)
+		tableIndexValues[i] = owner->getTotalTableModValue(i);
+
 	WavetableSound::RenderData r(voiceBuffer, startSample, numSamples, uptimeDelta, voicePitchValues, hqMode);
 
-	r.render(currentSound, voiceUptime, [owner](int startSample) { return owner->getTotalTableModValue(startSample); });
+	r.render(currentSound, voiceUptime, tableIndexValues);
 
 	if (refreshMipmap)
 	{
@@ -521,6 +536,10 @@ WavetableSound::WavetableSound(const ValueTree &wavetableData, Processor* parent
 
 	normalizeTables();
 
+#if HISE_USE_WAVETABLE_MIPMAPS
+	createMipmaps();
+#endif
+
 	pitchRatio = 1.0;
     
     auto lowDelta = MidiMessage::getMidiNoteInHertz(midiNotes.findNextSetBit(0));
@@ -539,6 +558,134 @@ const float * WavetableSound::getWaveTableData(int channelIndex, int wavetableIn
 	return wavetables.getReadPointer(channelIndex, wavetableIndex * wavetableSize);
 }
 
+const float * WavetableSound::getWaveTableData(int channelIndex, int wavetableIndex, int mipmapLevel) const
+{
+	if (mipmapLevel == 0)
+		return getWaveTableData(channelIndex, wavetableIndex);
+
+	jassert(isPositiveAndBelow(wavetableIndex, wavetableAmount));
+	jassert(isPositiveAndNotGreaterThan(mipmapLevel, mipmaps.size()));
+
+	auto levelSize = getTableSize(mipmapLevel);
+	return mipmaps.getReference(mipmapLevel - 1).getReadPointer(channelIndex, wavetableIndex * levelSize);
+}
+
+int WavetableSound::getMipmapLevel(double maxUptimeDelta) const
+{
+	// The original tables can be used as long as the highest harmonic stays below nyquist
+	if (mipmaps.isEmpty() || (double)maxHarmonic * maxUptimeDelta <= (double)(wavetableSize / 2))
+		return 0;
+
+	// Level n contains the harmonics below wavetableSize / 2^(n+1)
+	auto level = (int)std::ceil(std::log2(maxUptimeDelta));
+
+	return jlimit(0, mipmaps.size(), level);
+}
+
+void WavetableSound::createMipmaps()
+{
+	mipmaps.clear();
+	maxHarmonic = wavetableSize / 2;
+
+	if (wavetableAmount == 0 || !isPowerOfTwo(wavetableSize) || wavetableSize < 2 * MinMipmapSize)
+		return;
+
+	const int order = roundToInt(std::log2((double)wavetableSize));
+	const int numBins = wavetableSize / 2;
+	const int numChannels = wavetables.getNumChannels();
+
+	juce::dsp::FFT fft(order);
+	HeapBlock<float> spectrum(wavetableSize * 2);
+
+	auto calculateSpectrum = [&](int channelIndex, int tableIndex)
+	{
+		FloatVectorOperations::copy(spectrum.get(), getWaveTableData(channelIndex, tableIndex), wavetableSize);
+		fft.performRealOnlyForwardTransform(spectrum.get(), true);
+		return reinterpret_cast<juce::dsp::Complex<float>*>(spectrum.get());
+	};
+
+	// Find the highest harmonic above -80dB (relative to the loudest harmonic) in all tables
+	int highestBin = 0;
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		for (int t = 0; t < wavetableAmount; t++)
+		{
+			auto bins = calculateSpectrum(c, t);
+
+			float maxMagnitude = 0.0f;
+
+			for (int i = 1; i < numBins; i++)
+				maxMagnitude = jmax(maxMagnitude, std::abs(bins[i]));
+
+			for (int i = numBins - 1; i > highestBin; i--)
+			{
+				if (std::abs(bins[i]) > maxMagnitude * 0.0001f)
+				{
+					highestBin = i;
+					break;
+				}
+			}
+		}
+	}
+
+	maxHarmonic = highestBin;
+
+	int numLevels = 0;
+
+	// Only create levels that actually remove harmonics
+	while ((wavetableSize >> (numLevels + 1)) >= MinMipmapSize && (wavetableSize >> (numLevels + 2)) < maxHarmonic)
+		numLevels++;
+
+	if (numLevels == 0)
+		return;
+
+	OwnedArray<juce::dsp::FFT> inverseFFTs;
+	HeapBlock<juce::dsp::Complex<float>> levelBins(numBins), levelOutput(numBins);
+
+	for (int l = 1; l <= numLevels; l++)
+	{
+		inverseFFTs.add(new juce::dsp::FFT(order - l));
+		mipmaps.add(AudioSampleBuffer(numChannels, getTableSize(l) * wavetableAmount));
+	}
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		for (int t = 0; t < wavetableAmount; t++)
+		{
+			auto bins = calculateSpectrum(c, t);
+
+			for (int l = 1; l <= numLevels; l++)
+			{
+				// Copy the bins below the nyquist frequency of the smaller table and use an
+				// inverse FFT with the smaller size to get the band limited downsampled table.
+				auto levelSize = getTableSize(l);
+				auto scale = (float)levelSize / (float)wavetableSize;
+
+				FloatVectorOperations::clear(reinterpret_cast<float*>(levelBins.get()), levelSize * 2);
+
+				levelBins[0] = bins[0] * scale;
+
+				for (int i = 1; i < levelSize / 2; i++)
+				{
+					levelBins[i] = bins[i] * scale;
+					levelBins[levelSize - i] = std::conj(bins[i]) * scale;
+				}
+
+				inverseFFTs[l - 1]->perform(levelBins.get(), levelOutput.get(), true);
+
+				auto dst = mipmaps.getReference(l - 1).getWritePointer(c, t * levelSize);
+
+				for (int i = 0; i < levelSize; i++)
+					dst[i] = levelOutput[i].real();
+			}
+		}
+	}
+
+	for (const auto& m : mipmaps)
+		memoryUsage += m.getNumChannels() * m.getNumSamples() * sizeof(float);
+}
+
 void WavetableSound::calculatePitchRatio(double playBackSampleRate_)
 {
     playbackSampleRate = playBackSampleRate_;
@@ -594,17 +741,32 @@ String WavetableSound::getMarkdownDescription() const
 	return s;
 }
 
-void WavetableSound::RenderData::render(WavetableSound* currentSound, double& voiceUptime, const TableIndexFunction& tf)
+void WavetableSound::RenderData::render(WavetableSound* currentSound, double& voiceUptime, const float* tableIndexValues)
 {
 	auto numTables = currentSound->getWavetableAmount();
 	auto stereoMode = currentSound->isStereo();
-	auto tableSize = currentSound->getTableSize();
 
 	dynamicPhase = currentSound->dynamicPhase;
 
+#if HISE_USE_WAVETABLE_MIPMAPS
+	// Pick the mipmap level for the highest pitch in this block
+	auto maxDelta = uptimeDelta;
+
+	if (voicePitchValues != nullptr && numSamples > 0)
+		maxDelta *= (double)FloatVectorOperations::findMaximum(voicePitchValues + startSample, numSamples);
+
+	const auto mipmapLevel = currentSound->getMipmapLevel(maxDelta);
+#else
+	const int mipmapLevel = 0;
+#endif
+	const auto tableSize = currentSound->getTableSize(mipmapLevel);
+	const auto levelScale = 1.0 / (double)(1 << mipmapLevel);
+
 	while (--numSamples >= 0)
 	{
-		int index = (int)voiceUptime;
+		const double levelUptime = voiceUptime * levelScale;
+
+		int index = (int)levelUptime;
 
 		span<int, 4> i;
 
@@ -625,7 +787,7 @@ void WavetableSound::RenderData::render(WavetableSound* currentSound, double& vo
 
 #endif
 
-		const float tableModValue = tf(startSample);
+		const float tableModValue = tableIndexValues[startSample];
 		const float tableValue = tableModValue * (float)(numTables - 1);
 
 		const int lowerTableIndex = (int)(tableValue);
@@ -635,9 +797,9 @@ void WavetableSound::RenderData::render(WavetableSound* currentSound, double& vo
 
 		const int upperTableIndex = jmin(numTables - 1, lowerTableIndex + 1);
 
-		auto lowerTable = currentSound->getWaveTableData(0, lowerTableIndex);
-		auto upperTable = currentSound->getWaveTableData(0, upperTableIndex);
-		const float alpha = float(voiceUptime) - (float)index;
+		auto lowerTable = currentSound->getWaveTableData(0, lowerTableIndex, mipmapLevel);
+		auto upperTable = currentSound->getWaveTableData(0, upperTableIndex, mipmapLevel);
+		const float alpha = float(levelUptime) - (float)index;
 
 		auto l = calculateSample(lowerTable, upperTable, i, alpha, tableDelta);
 
@@ -646,8 +808,8 @@ void WavetableSound::RenderData::render(WavetableSound* currentSound, double& vo
 
 		if (stereoMode)
 		{
-			auto lowerTableR = currentSound->getWaveTableData(1, lowerTableIndex);
-			auto upperTableR = currentSound->getWaveTableData(1, upperTableIndex);
+			auto lowerTableR = currentSound->getWaveTableData(1, lowerTableIndex, mipmapLevel);
+			auto upperTableR = currentSound->getWaveTableData(1, upperTableIndex, mipmapLevel);
 
 			auto r = calculateSample(lowerTableR, upperTableR, i, alpha, tableDelta);
 			b.setSample(1, startSample, r);
@@ -790,4 +952,122 @@ Array<hise::WavetableMonolithHeader> WavetableMonolithHeader::readHeader(InputSt
 	return headers;
 }
 
+#if HI_RUN_UNIT_TESTS
+
+struct WavetableMipmapTests : public juce::UnitTest
+{
+	static constexpr int TableSize = 2048;
+	static constexpr int NumTables = 2;
+
+	WavetableMipmapTests() :
+		UnitTest("Testing wavetable mipmaps")
+	{}
+
+	/** Additive saw (table 0) or square (table 1) with all harmonics below the limit. */
+	static float getReferenceSample(int tableIndex, int sampleIndex, int tableSize, int harmonicLimit)
+	{
+		double value = 0.0;
+		const double phase = 2.0 * double_Pi * (double)sampleIndex / (double)tableSize;
+
+		for (int k = 1; k < harmonicLimit; k++)
+		{
+			if (tableIndex == 1 && k % 2 == 0)
+				continue;
+
+			value += std::sin(phase * (double)k) / (double)k;
+		}
+
+		return (float)value;
+	}
+
+	static ReferenceCountedObjectPtr<WavetableSound> createSound()
+	{
+		HeapBlock<float> data(TableSize * NumTables);
+
+		for (int t = 0; t < NumTables; t++)
+		{
+			for (int i = 0; i < TableSize; i++)
+				data[t * TableSize + i] = getReferenceSample(t, i, TableSize, TableSize / 2);
+		}
+
+		ValueTree v("wavetable");
+		v.setProperty("data", var(MemoryBlock(data.get(), sizeof(float) * TableSize * NumTables)), nullptr);
+		v.setProperty("amount", NumTables, nullptr);
+		v.setProperty("noteNumber", 60, nullptr);
+
+		ReferenceCountedObjectPtr<WavetableSound> s = new WavetableSound(v, nullptr);
+
+		// The tests run regardless of HISE_USE_WAVETABLE_MIPMAPS
+		s->createMipmaps();
+
+		return s;
+	}
+
+	void runTest() override
+	{
+		testBandLimit();
+		testLevelSelection();
+	}
+
+	void testBandLimit()
+	{
+		beginTest("Testing the band limit of each mipmap level");
+
+		auto s = createSound();
+
+		expectEquals(s->getNumMipmapLevels(), 6, "number of levels");
+		expectEquals(s->maxHarmonic, TableSize / 2 - 1, "highest harmonic");
+
+		for (int l = 1; l <= s->getNumMipmapLevels(); l++)
+		{
+			auto levelSize = s->getTableSize(l);
+
+			for (int t = 0; t < NumTables; t++)
+			{
+				auto data = s->getWaveTableData(0, t, l);
+				float maxError = 0.0f;
+
+				for (int i = 0; i < levelSize; i++)
+				{
+					auto expected = getReferenceSample(t, i, levelSize, levelSize / 2);
+					maxError = jmax(maxError, std::abs(data[i] - expected));
+				}
+
+				expect(maxError < 0.001f, "level " + String(l) + ", table " + String(t) + ": error " + String(maxError));
+			}
+		}
+	}
+
+	void testLevelSelection()
+	{
+		beginTest("Testing the mipmap level selection");
+
+		auto s = createSound();
+
+		expectEquals(s->getMipmapLevel(1.0), 0, "original pitch");
+
+		for (double delta = 1.1; delta < 64.0; delta *= 1.3)
+		{
+			auto l = s->getMipmapLevel(delta);
+
+			expect(l > 0, "level for delta " + String(delta));
+
+			// The highest harmonic of the level must stay below nyquist
+			auto highestHarmonic = s->getTableSize(l) / 2 - 1;
+			auto normalisedFrequency = (double)highestHarmonic * delta / (double)TableSize;
+
+			if (l < s->getNumMipmapLevels())
+				expect(normalisedFrequency < 0.5, "aliasing at delta " + String(delta));
+
+			// The level above must not be band limited more than necessary
+			if (l > 1)
+				expect((double)(s->getTableSize(l - 1) / 2 - 1) * delta / (double)TableSize >= 0.5, "level too high at delta " + String(delta));
+		}
+	}
+};
+
+static WavetableMipmapTests wavetableMipmapTests;
+
+#endif
+
 } // namespace hise
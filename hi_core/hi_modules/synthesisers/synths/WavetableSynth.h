@@ -87,6 +87,9 @@ public:
 	*/
 	const float *getWaveTableData(int channelIndex, int wavetableIndex) const;
 
+	/** Returns a read pointer to the wavetable of the given mipmap level (see getMipmapLevel()). */
+	const float *getWaveTableData(int channelIndex, int wavetableIndex, int mipmapLevel) const;
+
 	float getUnnormalizedMaximum() const
 	{
 		return unnormalizedMaximum;
@@ -102,6 +105,24 @@ public:
 		return wavetableSize;
 	};
 
+	/** Returns the table size of the mipmap level. Every level halves the table size. */
+	int getTableSize(int mipmapLevel) const
+	{
+		return wavetableSize >> mipmapLevel;
+	}
+
+	/** Returns the number of band limited mipmap levels (excluding the original tables).
+	*
+	*	The levels are only created if HISE_USE_WAVETABLE_MIPMAPS is enabled.
+	*/
+	int getNumMipmapLevels() const { return mipmaps.size(); }
+
+	/** Returns the lowest mipmap level that can be played back without aliasing.
+	*
+	*	The delta is the highest uptime delta (in samples of the original table) of the rendered block.
+	*/
+	int getMipmapLevel(double maxUptimeDelta) const;
+
 	float getMaxLevel() const
 	{
 		return maximum;
@@ -143,7 +164,6 @@ public:
 
 	struct RenderData
 	{
-		using TableIndexFunction = std::function<float(int)>;
 		RenderData(AudioSampleBuffer& b_, int startSample_, int numSamples_, double uptimeDelta_, const float* voicePitchValues_, bool hqMode_) :
 			b(b_),
 			startSample(startSample_),
@@ -161,13 +181,22 @@ public:
 		const bool hqMode;
 		bool dynamicPhase = false;
 
-		void render(WavetableSound* currentSound, double& voiceUptime, const TableIndexFunction& tf);
+		/** Renders the wavetable into the buffer. The table index values (0...1) must be supplied for every sample (and use the same offset as the buffer). */
+		void render(WavetableSound* currentSound, double& voiceUptime, const float* tableIndexValues);
 
 		float calculateSample(const float* lowerTable, const float* upperTable, const span<int, 4>& i, float alpha, float tableAlpha) const;
 	};
 
 private:
 
+	friend struct WavetableMipmapTests;
+
+	/** The smallest table size of a mipmap level. */
+	static constexpr int MinMipmapSize = 32;
+
+	/** Creates band limited versions of the wavetables with half the table size for each octave. */
+	void createMipmaps();
+
 	float reversed = 0.0f;
 	bool stereo = false;
 
@@ -186,6 +215,9 @@ private:
 	AudioSampleBuffer wavetables;
 	AudioSampleBuffer emptyBuffer;
 
+	Array<AudioSampleBuffer> mipmaps;
+	int maxHarmonic = 0;
+
 	double sampleRate;
 	double pitchRatio;
     double playbackSampleRate;
@@ -225,9 +257,13 @@ public:
 	};
 
     bool updateSoundFromPitchFactor(double pitchFactor, WavetableSound* soundToUse);
+
+	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     
 private:
 
+	AudioSampleBuffer tableIndexBuffer;
+
 	WavetableSynth *wavetableSynth;
 
 	int octaveTransposeFactor;
@@ -42,6 +42,36 @@ using namespace juce;
 struct ResynthesisHelpers
 {
     static constexpr int MinTableLength = 128;
+
+	/** Calls f(i) for every index using the worker threads and this thread.
+	
+		The items must not access the thread controller (it's not thread safe), instead
+		this thread will update the progress after each item and stop the processing when
+		the thread should exit. Returns false if the operation was cancelled.
+	*/
+	template <typename F> static bool forEachParallel(ThreadController* threadController, int numItems, const F& f)
+	{
+		SharedResourcePointer<SharedWorkerPool> workerPool;
+
+		std::atomic<int> nextItem = { 0 };
+		std::atomic<int> numDone = { 0 };
+		std::atomic<bool> cancelled = { false };
+
+		workerPool->runOnWorkers([&](int threadIndex)
+		{
+			for (int i = nextItem++; i < numItems && !cancelled; i = nextItem++)
+			{
+				f(i);
+
+				auto progress = (double)++numDone / (double)numItems;
+
+				if (threadIndex == 0 && threadController != nullptr && (!threadController->setProgress(progress) || !*threadController))
+					cancelled = true;
+			}
+		}, numItems);
+
+		return !cancelled;
+	}
     
 	struct SimpleNoteConversionData
 	{
@@ -146,7 +176,7 @@ struct ResynthesisHelpers
 
 	static void removeHarmonicsAboveNyquist(const float* source, float* target, int numThisTime, int targetNoteNumber, double sampleRate)
 	{
-		juce::dsp::FFT fft(log2(numThisTime));
+		juce::dsp::FFT fft(roundToInt(log2(numThisTime)));
 
 		HeapBlock<juce::dsp::Complex<float>> input, output;
 
@@ -175,7 +205,7 @@ struct ResynthesisHelpers
 		}
 	}
 
-	static void createWavetableFromHarmonicSpectrum(ThreadController* threadController, const float* hmx, int numHarmonics, float* data, int noteNumber, double sampleRate = 48000.0, const float* phaseData = nullptr)
+	static void createWavetableFromHarmonicSpectrum(const float* hmx, int numHarmonics, float* data, int noteNumber, double sampleRate = 48000.0, const float* phaseData = nullptr)
 	{
 		auto length = getWavetableLength(noteNumber, sampleRate);
 
@@ -184,8 +214,6 @@ struct ResynthesisHelpers
 
 		auto rootFreq = MidiMessage::getMidiNoteInHertz(noteNumber);
 
-		double rootDelta = 2.0 * double_Pi / (double)length;
-
 		auto offsets = (double*)alloca(sizeof(double)*numHarmonics);
 
 		FloatVectorOperations::clear(offsets, numHarmonics);
@@ -220,40 +248,46 @@ struct ResynthesisHelpers
 			}
 		}
 
-		for (int h = 0; h < numHarmonics; h++)
-		{
-			if (auto s = ThreadController::ScopedStepScaler(threadController, h, numHarmonics))
-			{
-				float harmonicGain = hmx[h];
+		// The length is always a power of two, so instead of summing up the sine waves of all
+		// harmonics we can write them into the spectrum and calculate the table with an inverse FFT.
+		juce::dsp::FFT fft(roundToInt(log2(length)));
 
-				// make a smooth rollof at nyquist
-				auto nyquistGain = 1.0f - hmath::smoothstep(rootFreq * (double)(h + 1), 18000.0, 22000.0);
+		HeapBlock<juce::dsp::Complex<float>> spectrum, output;
+		spectrum.calloc(length);
+		output.calloc(length);
 
-				harmonicGain *= nyquistGain;
+		for (int h = 0; h < numHarmonics; h++)
+		{
+			float harmonicGain = hmx[h];
 
-				// the rest of the harmonics will also be above nyquist...
-				if (nyquistGain == 0.0f)
-					break;
+			// make a smooth rollof at nyquist
+			auto nyquistGain = 1.0f - hmath::smoothstep(rootFreq * (double)(h + 1), 18000.0, 22000.0);
 
-				if (harmonicGain <= 0.0001f)
-					continue;
+			harmonicGain *= nyquistGain;
 
-				double uptime = 0.0;
+			// the rest of the harmonics will also be above nyquist...
+			if (nyquistGain == 0.0f)
+				break;
 
-				if (phaseData != nullptr)
-				{
-					uptime = offsets[h];
-				}
+			if (harmonicGain <= 0.0001f)
+				continue;
 
+			double uptime = 0.0;
 
-				for (int i = 0; i < length; i++)
-				{
-					data[i] += harmonicGain * (float)sin(uptime);
-					uptime += rootDelta * (double)(h + 1);
-				}
+			if (phaseData != nullptr)
+			{
+				uptime = offsets[h];
 			}
+
+			// gain * sin(w * i + uptime) is the imaginary part of gain * e^(j * uptime) * e^(j * w * i)
+			spectrum[(h + 1) % length] += std::polar(harmonicGain, (float)uptime);
 		}
 
+		fft.perform(spectrum, output, true);
+
+		for (int i = 0; i < length; i++)
+			data[i] = output[i].imag() * (float)length;
+
 		auto range = FloatVectorOperations::findMinAndMax(data, length);
 
 		auto maxLevel = jmax<float>(fabsf(range.getStart()), fabsf(range.getEnd()));
@@ -396,7 +430,12 @@ void SampleMapToWavetableConverter::rebuildPreviewBuffersInternal()
 
 			WavetableSound::RenderData r(previewBuffer, 0, previewBuffer.getNumSamples(), uptimeDelta, nullptr, true);
 
-			r.render(ws, voiceUptime, [&](int startSample) { return jlimit(0.0f, 1.0f, (float)startSample / (float)previewBuffer.getNumSamples()); });
+			HeapBlock<float> tableIndexValues(previewBuffer.getNumSamples());
+
+			for (int i = 0; i < previewBuffer.getNumSamples(); i++)
+				tableIndexValues[i] = jlimit(0.0f, 1.0f, (float)i / (float)previewBuffer.getNumSamples());
+
+			r.render(ws, voiceUptime, tableIndexValues.get());
 
 			if (!currentMap->isStereo)
 				FloatVectorOperations::copy(previewBuffer.getWritePointer(1), previewBuffer.getReadPointer(0), previewBuffer.getNumSamples());
@@ -987,105 +1026,96 @@ void SampleMapToWavetableConverter::renderAllWavetablesFromSingleWavetables(int
 			}
 
 
-			auto doit = [&](int i, Range<int> r)
+			// Resamples all cycles to the wavetable length of the given note number.
+			auto resampleCycles = [&](int i)
 			{
-				if (auto s = ThreadController::ScopedStepScaler(threadController.get(), i - loKey, jmax(1, hiKey - loKey)))
-				{
-					auto length = ResynthesisHelpers::getWavetableLength(i, fileSampleRate);
+				auto length = ResynthesisHelpers::getWavetableLength(i, fileSampleRate);
 
-					AudioSampleBuffer resampled(fileContent.getNumChannels(), length * cycles.size());
+				AudioSampleBuffer resampled(fileContent.getNumChannels(), length * cycles.size());
 
-					int offset = 0;
-
-					int cycleIndex = 0;
-
-					for (auto& cycle : cycles)
-					{
-						if (auto s2 = ThreadController::ScopedStepScaler(threadController.get(), cycleIndex++, cycles.size()))
-						{
-							int numThisTime = cycle.getNumSamples();
+				int offset = 0;
 
-							auto ratio = (double)numThisTime / (double)length;
+				for (auto& cycle : cycles)
+				{
+					int numThisTime = cycle.getNumSamples();
 
-							if (ratio != 1.0)
-							{
-								AudioSampleBuffer source(cycle.getNumChannels(), numThisTime * 3);
+					auto ratio = (double)numThisTime / (double)length;
 
-								juce::Interpolators::Lagrange ip;
-								auto latency = roundToInt(ip.getBaseLatency() / ratio);
+					if (ratio != 1.0)
+					{
+						AudioSampleBuffer source(cycle.getNumChannels(), numThisTime * 3);
 
-								AudioSampleBuffer target(cycle.getNumChannels(), length * 3 + latency);
-								target.clear();
+						juce::Interpolators::Lagrange ip;
+						auto latency = roundToInt(ip.getBaseLatency() / ratio);
 
-								if (ratio > 1.5)
-								{
-									ResynthesisHelpers::removeHarmonicsAboveNyquist(cycle.getReadPointer(0), source.getWritePointer(0), numThisTime, i, fileSampleRate);
+						AudioSampleBuffer target(cycle.getNumChannels(), length * 3 + latency);
+						target.clear();
 
-									if(isStereo)
-										ResynthesisHelpers::removeHarmonicsAboveNyquist(cycle.getReadPointer(1), source.getWritePointer(1), numThisTime, i, fileSampleRate);
-								}
-								else
-								{
-									FloatVectorOperations::copy(source.getWritePointer(0), cycle.getReadPointer(0), numThisTime);
+						if (ratio > 1.5)
+						{
+							ResynthesisHelpers::removeHarmonicsAboveNyquist(cycle.getReadPointer(0), source.getWritePointer(0), numThisTime, i, fileSampleRate);
 
-									if(isStereo)
-										FloatVectorOperations::copy(source.getWritePointer(1), cycle.getReadPointer(1), numThisTime);
-								}
+							if(isStereo)
+								ResynthesisHelpers::removeHarmonicsAboveNyquist(cycle.getReadPointer(1), source.getWritePointer(1), numThisTime, i, fileSampleRate);
+						}
+						else
+						{
+							FloatVectorOperations::copy(source.getWritePointer(0), cycle.getReadPointer(0), numThisTime);
 
-								FloatVectorOperations::copy(source.getWritePointer(0, numThisTime * 1), source.getReadPointer(0), numThisTime);
-								FloatVectorOperations::copy(source.getWritePointer(0, numThisTime * 2), source.getReadPointer(0), numThisTime);
+							if(isStereo)
+								FloatVectorOperations::copy(source.getWritePointer(1), cycle.getReadPointer(1), numThisTime);
+						}
 
-								if (isStereo)
-								{
-									FloatVectorOperations::copy(source.getWritePointer(1, numThisTime * 1), source.getReadPointer(1), numThisTime);
-									FloatVectorOperations::copy(source.getWritePointer(1, numThisTime * 2), source.getReadPointer(1), numThisTime);
-								}
+						FloatVectorOperations::copy(source.getWritePointer(0, numThisTime * 1), source.getReadPointer(0), numThisTime);
+						FloatVectorOperations::copy(source.getWritePointer(0, numThisTime * 2), source.getReadPointer(0), numThisTime);
 
-								ip.process(ratio, source.getWritePointer(0), target.getWritePointer(0), length * 3);
+						if (isStereo)
+						{
+							FloatVectorOperations::copy(source.getWritePointer(1, numThisTime * 1), source.getReadPointer(1), numThisTime);
+							FloatVectorOperations::copy(source.getWritePointer(1, numThisTime * 2), source.getReadPointer(1), numThisTime);
+						}
 
-								if (isStereo)
-								{
-									ip.reset();
-									ip.process(ratio, source.getWritePointer(1), target.getWritePointer(1), length * 3);
-								}
+						ip.process(ratio, source.getWritePointer(0), target.getWritePointer(0), length * 3);
 
-								auto thisOffset = length + latency;
+						if (isStereo)
+						{
+							ip.reset();
+							ip.process(ratio, source.getWritePointer(1), target.getWritePointer(1), length * 3);
+						}
 
-								FloatVectorOperations::copy(resampled.getWritePointer(0, offset), target.getReadPointer(0, thisOffset), length);
+						auto thisOffset = length + latency;
 
-								if(isStereo)
-									FloatVectorOperations::copy(resampled.getWritePointer(1, offset), target.getReadPointer(1, thisOffset), length);
-							}
-							else
-							{
-								FloatVectorOperations::copy(resampled.getWritePointer(0, offset), cycle.getReadPointer(0, 0), length);
+						FloatVectorOperations::copy(resampled.getWritePointer(0, offset), target.getReadPointer(0, thisOffset), length);
 
-								if(isStereo)
-									FloatVectorOperations::copy(resampled.getWritePointer(1, offset), cycle.getReadPointer(1, 0), length);
-							}
+						if(isStereo)
+							FloatVectorOperations::copy(resampled.getWritePointer(1, offset), target.getReadPointer(1, thisOffset), length);
+					}
+					else
+					{
+						FloatVectorOperations::copy(resampled.getWritePointer(0, offset), cycle.getReadPointer(0, 0), length);
 
-							offset += length;
-						}
+						if(isStereo)
+							FloatVectorOperations::copy(resampled.getWritePointer(1, offset), cycle.getReadPointer(1, 0), length);
 					}
 
+					offset += length;
+				}
 
-					StoreData sd;
-					sd.sample.noteNumber = i;
-					sd.noteRange = r;
-					sd.dataBuffer = std::move(resampled);
+				return resampled;
+			};
 
-					sd.numChannels = isStereo ? 2 : 1;
-					
-					sd.parent = waveTableTree;
-					sd.sampleRate = fileSampleRate;
-					sd.numParts = cycles.size();
-					storeData(sd);
-				}
+			struct MipmapData
+			{
+				int noteNumber;
+				Range<int> noteRange;
+				AudioSampleBuffer buffer;
 			};
 
+			std::vector<MipmapData> mipmapsToCreate;
+
 			if (sampleIndex != -1)
 			{
-				doit((int)s[SampleIds::Root], { loKey, hiKey });
+				mipmapsToCreate.push_back({ (int)s[SampleIds::Root], { loKey, hiKey }, {} });
 			}
 			else if (hiKey - loKey > mipmapSize)
 			{
@@ -1094,13 +1124,36 @@ void SampleMapToWavetableConverter::renderAllWavetablesFromSingleWavetables(int
 					logFunction("Create mipmap for root note " + MidiMessage::getMidiNoteName(i, true, true, 3));
 
 					Range<int> nr(i - mipmapSize / 2, i + mipmapSize / 2 - 1);
-					doit(i, nr);
+					mipmapsToCreate.push_back({ i, nr, {} });
 				}
 			}
 			else
 			{
 				// Do not use the root not here as it might be retuned... s[SampleIds::Root]
-				doit(loKey, { loKey, hiKey });
+				mipmapsToCreate.push_back({ loKey, { loKey, hiKey }, {} });
+			}
+
+			// The mipmaps are independent, so we can resample them in parallel
+			ResynthesisHelpers::forEachParallel(threadController.get(), (int)mipmapsToCreate.size(), [&](int index)
+			{
+				mipmapsToCreate[index].buffer = resampleCycles(mipmapsToCreate[index].noteNumber);
+			});
+
+			checkIfShouldExit();
+
+			for (auto& m : mipmapsToCreate)
+			{
+				StoreData sd;
+				sd.sample.noteNumber = m.noteNumber;
+				sd.noteRange = m.noteRange;
+				sd.dataBuffer = std::move(m.buffer);
+
+				sd.numChannels = isStereo ? 2 : 1;
+				
+				sd.parent = waveTableTree;
+				sd.sampleRate = fileSampleRate;
+				sd.numParts = cycles.size();
+				storeData(sd);
 			}
 		}
 	}
@@ -1226,53 +1279,34 @@ AudioSampleBuffer SampleMapToWavetableConverter::calculateWavetableBank(const Ha
 	float* dataL = bank.getWritePointer(0);
 	float* dataR = bank.getWritePointer(1);
 
-	int offset = 0;
-
-	int partIndex = 0;
+	// Fetch the phase data on this thread, then calculate the slices in parallel
+	Array<std::pair<float*, float*>> phaseData;
 
 	for (int i = 0; i < numSlices; i++)
+		phaseData.add({ getPhaseData(map, i, false), map.isStereo ? getPhaseData(map, i, true) : nullptr });
+
+	ResynthesisHelpers::forEachParallel(threadController.get(), numSlices, [&](int partIndex)
 	{
-		checkIfShouldExit();
+		auto offset = partIndex * numSamples;
 
-		if (auto s = ThreadController::ScopedStepScaler(threadController.get(), i, numSlices))
-		{
-			auto phase = getPhaseData(map, i, false);
+		ResynthesisHelpers::createWavetableFromHarmonicSpectrum(map.harmonicGains.getReadPointer(partIndex), numHarmonics, dataL + offset, noteNumber, sampleRate, phaseData[partIndex].first);
 
-			{
-				ThreadController::ScopedRangeScaler s(threadController.get(), 0.0, 0.5);
+		if (map.isStereo)
+			ResynthesisHelpers::createWavetableFromHarmonicSpectrum(map.harmonicGainsRight.getReadPointer(partIndex), numHarmonics, dataR + offset, noteNumber, sampleRate, phaseData[partIndex].second);
 
-				ResynthesisHelpers::createWavetableFromHarmonicSpectrum(threadController.get(), map.harmonicGains.getReadPointer(partIndex), numHarmonics, dataL + offset, noteNumber, sampleRate, phase);
+		if (useOriginalGain)
+		{
+			const float gainL = map.gainValues.getSample(0, partIndex);
+			const float gainR = map.isStereo ? map.gainValues.getSample(1, partIndex) : gainL;
 
-				checkIfShouldExit();
-			}
+			FloatVectorOperations::multiply(dataL + offset, gainL, numSamples);
 
 			if (map.isStereo)
-			{
-				phase = getPhaseData(map, i, true);
-
-				ThreadController::ScopedRangeScaler s(threadController.get(), 0.5, 1.0);
-
-				ResynthesisHelpers::createWavetableFromHarmonicSpectrum(threadController.get(), map.harmonicGainsRight.getReadPointer(partIndex), numHarmonics, dataR + offset, noteNumber, sampleRate, phase);
-
-				checkIfShouldExit();
-			}
-
-			if (useOriginalGain)
-			{
-				const float gainL = map.gainValues.getSample(0, partIndex);
-				const float gainR = map.isStereo ? map.gainValues.getSample(1, partIndex) : gainL;
-
-				FloatVectorOperations::multiply(dataL + offset, gainL, numSamples);
-
-				if (map.isStereo)
-					FloatVectorOperations::multiply(dataR + offset, gainR, numSamples);
-			}
-
-			offset += numSamples;
-
-			partIndex++;
+				FloatVectorOperations::multiply(dataR + offset, gainR, numSamples);
 		}
-	}
+	});
+
+	checkIfShouldExit();
 
 	return bank;
 }
@@ -398,7 +398,15 @@ void ModulatorSampler::restoreFromValueTree(const ValueTree &v)
 	loadAttribute(PreloadSize, "PreloadSize");
     loadAttribute(UseStaticMatrix, "UseStaticMatrix");
 	
+#if HISE_SKIP_UNCHANGED_STATE_RESTORE
+	const int newBufferSize = v.getProperty("BufferSize", 4096);
+
+	// Avoid reallocating the streaming buffers if nothing has changed
+	if (newBufferSize != bufferSize)
+		setInternalAttribute(BufferSize, (float)newBufferSize);
+#else
 	setInternalAttribute(BufferSize, v.getProperty("BufferSize", 4096));
+#endif
 
 	loadAttribute(PitchTracking, "PitchTracking");
 	loadAttribute(OneShot, "OneShot");
@@ -1179,6 +1187,14 @@ String ModulatorSampler::getMemoryUsage() const
 	memory << String(m, 2);
 	memory << "MB";
 
+#if HISE_SHARE_PRELOAD_BUFFERS
+	SharedResourcePointer<SharedPreloadBufferStore> preloadStore;
+	auto stats = preloadStore->getStatistics();
+
+	if (stats.numBytesSaved > 0)
+		memory << " (" << String((double)stats.numBytesSaved / 1024.0 / 1024.0, 2) << "MB shared)";
+#endif
+
 	return memory;
 }
 
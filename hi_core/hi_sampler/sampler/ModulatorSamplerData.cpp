@@ -1261,6 +1261,66 @@ void MonolithExporter::threadFinished()
 }
 
 
+/** Encodes a single sample into a temporary writer on a worker thread.
+
+	The encoded data is appended to the monolith in the original order, so the output is identical to the serial path. */
+struct MonolithExporter::EncodeJob : public ThreadPoolJob
+{
+	EncodeJob(const File& sourceFile_, bool isMono_, double sampleRate_, const hlac::HlacEncoder::CompressorOptions& options_) :
+		ThreadPoolJob("Encode " + sourceFile_.getFileName()),
+		sourceFile(sourceFile_),
+		isMono(isMono_),
+		sampleRate(sampleRate_),
+		options(options_)
+	{}
+
+	JobStatus runJob() override
+	{
+		AudioFormatManager afm;
+		afm.registerBasicFormats();
+		afm.registerFormat(new hlac::HiseLosslessAudioFormat(), false);
+
+		ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(sourceFile);
+
+		if (reader == nullptr)
+			return jobHasFinished;
+
+		StringPairArray empty;
+
+		ScopedPointer<AudioFormatWriter> w = hlacFormat.createWriterFor(new MemoryOutputStream(), sampleRate, isMono ? 1 : 2, 16, empty, 5);
+
+		if (auto hWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(w.get()))
+		{
+			hWriter->setOptions(options);
+			hWriter->preallocateMemory(reader->lengthInSamples, reader->numChannels);
+
+			if (hWriter->writeFromAudioReader(*reader, 0, -1))
+				writer = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(w.release());
+		}
+
+		return jobHasFinished;
+	}
+
+	const File sourceFile;
+	const bool isMono;
+	const double sampleRate;
+	hlac::HlacEncoder::CompressorOptions options;
+
+	// The writer keeps a pointer to the block offset table of its format, so it needs to live as long as the writer
+	hlac::HiseLosslessAudioFormat hlacFormat;
+	ScopedPointer<hlac::HiseLosslessAudioFormatWriter> writer;
+};
+
+hlac::HlacEncoder::CompressorOptions MonolithExporter::getEncoderOptions()
+{
+	auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
+
+	options.applyDithering = false;
+	options.normalisationMode = (uint8)getComboBoxComponent("normalise")->getSelectedItemIndex();
+
+	return options;
+}
+
 juce::AudioFormatWriter* MonolithExporter::createWriter(hlac::HiseLosslessAudioFormat& hlac, const File& outputFile, bool isMono)
 {
 	bool ok = outputFile.deleteFile();
@@ -1271,10 +1331,7 @@ juce::AudioFormatWriter* MonolithExporter::createWriter(hlac::HiseLosslessAudioF
 
 	FileOutputStream* hlacOutput = new FileOutputStream(outputFile);
 
-	auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
-
-	options.applyDithering = false;
-	options.normalisationMode = (uint8)getComboBoxComponent("normalise")->getSelectedItemIndex();
+	auto options = getEncoderOptions();
 
 	StringPairArray empty;
 
@@ -1424,30 +1481,82 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 
 		int64 numBytesWritten = 0;
 
+		// The samples are encoded in parallel and appended to the monolith in the original order.
+		SharedResourcePointer<SharedWorkerPool> workerPool;
+		auto& pool = workerPool->getThreadPool();
+
+		OwnedArray<EncodeJob> jobs;
+
+		// The pool is shared, so we must only remove our own jobs (this is also called when we
+		// leave this scope so that no job is deleted while it's still in the pool).
+		auto cancelJobs = [&pool, &jobs]()
+		{
+			for (auto j : jobs)
+			{
+				if (j != nullptr)
+					pool.removeJob(j, true, -1);
+			}
+		};
+
+		struct ScopedJobRemover
+		{
+			~ScopedJobRemover() { f(); }
+			std::function<void()> f;
+		} jobRemover { cancelJobs };
+
+		const auto options = getEncoderOptions();
+		const int maxNumJobsAhead = pool.getNumThreads() * 2;
+		int numJobsStarted = 0;
+
 		for (int i = 0; i < channelList->size(); i++)
 		{
 			auto s = channelList->getUnchecked(i);
 
-			showStatusMessage("Encode file " + s.getFileName());
+			// Keep a bounded amount of encoded data in memory
+			while (numJobsStarted < channelList->size() && numJobsStarted <= i + maxNumJobsAhead)
+			{
+				auto job = jobs.add(new EncodeJob(channelList->getUnchecked(numJobsStarted++), isMono, sampleRate, options));
+				pool.addJob(job, false);
+			}
+
+			String message;
+			message << "Encode file " << s.getFileName() << " (" << String(i + 1) << "/" << String(channelList->size()) << ")";
+			showStatusMessage(message);
 
 			setProgress((double)i / (double)numSamples);
 
+			auto job = jobs[i];
+
+			while (!pool.waitForJobToFinish(job, 100))
+			{
+				if (threadShouldExit())
+				{
+					cancelJobs();
+					return;
+				}
+			}
+
             if(threadShouldExit())
+			{
+				cancelJobs();
                 return;
-            
-			ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(s);
+			}
 
-			if (reader != nullptr)
+			if (job->writer != nullptr)
 			{
-				writer->writeFromAudioReader(*reader, 0, -1);
-				
 				if (auto hWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get()))
 				{
+					hWriter->appendDataFrom(*job->writer);
 					numBytesWritten = hWriter->getNumBytesWritten();
 				}
+
+				// Free the encoded data
+				jobs.set(i, nullptr, true);
 			}
 			else
 			{
+				cancelJobs();
+
 				error = "Could not read the source file " + s.getFullPathName();
 				writer->flush();
 				writer = nullptr;
@@ -553,10 +553,14 @@ protected:
 
 private:
 
+	struct EncodeJob;
+
 	bool silentMode = false;
 
 	Array<int> splitIndexes;
 
+	hlac::HlacEncoder::CompressorOptions getEncoderOptions();
+
 	AudioFormatWriter* createWriter(hlac::HiseLosslessAudioFormat& hlaf, const File& f, bool isMono);
 
 	/** The max monolith size is 2GB - 60MB (to guarantee to stay below 2GB for FAT32. */
@@ -169,6 +169,8 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 
 	applyConstantPitchFactor(propertyPitch);
 
+	reducePitchResolutionIfRequired(voicePitchValues, uptimeDelta, startSample);
+
 	const double pitchCounter = limitPitchDataToMaxSamplerPitch(voicePitchValues, uptimeDelta, startSample, numSamples);
 
 	wrappedVoice.setPitchCounterForThisBlock(pitchCounter);
@@ -320,6 +322,19 @@ void ModulatorSamplerVoice::handlePlaybackPosition(const StreamingSamplerSound *
 	sampler->setCurrentPlayingPosition(normPos);
 }
 
+void ModulatorSamplerVoice::reducePitchResolutionIfRequired(float*& pitchData, double& uptimeDeltaToUse, int startSample)
+{
+	if (pitchData == nullptr)
+		return;
+
+	if (getOwnerSynth()->getMainController()->getRenderBudgetGovernor().isPolicyActive(RenderBudgetGovernor::Policy::ReduceInterpolationQuality))
+	{
+		// use the first pitch value for the entire block so that the resampling can skip the per-sample pitch data
+		uptimeDeltaToUse *= (double)pitchData[startSample];
+		pitchData = nullptr;
+	}
+}
+
 double ModulatorSamplerVoice::limitPitchDataToMaxSamplerPitch(float * pitchData, double uptimeDelta, int startSample, int numSamples)
 {
 	double pitchCounter = 0.0;
@@ -525,6 +540,8 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 		propertyPitch *= env->getUptimeValue(voiceUptime);
 	}
 
+	reducePitchResolutionIfRequired(voicePitchValues, uptimeDelta, startSample);
+
 	const double pitchCounter = limitPitchDataToMaxSamplerPitch(voicePitchValues, uptimeDelta * propertyPitch, startSample, numSamples);
 
 	auto oldUptime = voiceUptime;
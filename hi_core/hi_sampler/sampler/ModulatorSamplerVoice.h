@@ -78,6 +78,9 @@ public:
 
 	static double limitPitchDataToMaxSamplerPitch(float * pitchData, double uptimeDelta, int startSample, int numSamples);
 
+	/** Replaces the pitch modulation data with a constant pitch factor if the render budget governor asks for a lower quality. */
+	void reducePitchResolutionIfRequired(float*& pitchData, double& uptimeDeltaToUse, int startSample);
+
 	// ================================================================================================================
 
 	virtual void setLoaderBufferSize(int newBufferSize);
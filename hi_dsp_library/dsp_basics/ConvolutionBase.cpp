@@ -161,11 +161,80 @@ double MultithreadedConvolver::getResampleFactor(double sampleRate, double impul
 	}
 }
 
+bool MultithreadedConvolver::tryToRenderStage(int stageIndex)
+{
+	auto expected = StageState::Pending;
+
+	if (stageStates[stageIndex].compare_exchange_strong(expected, StageState::Rendering))
+	{
+		doBackgroundProcessing(stageIndex);
+		stageStates[stageIndex].store(StageState::Idle);
+		return true;
+	}
+
+	return false;
+}
+
+void MultithreadedConvolver::renderStageJob(void* obj, int stageIndex)
+{
+	static_cast<MultithreadedConvolver*>(obj)->tryToRenderStage(stageIndex);
+}
+
+void MultithreadedConvolver::startBackgroundProcessing(int stageIndex)
+{
+	if (workerPool != nullptr)
+	{
+		stageStates[stageIndex].store(StageState::Pending);
+
+		auto level = RealtimeWorkerPool::getDeadlineLevel(getStageBlockSize(stageIndex));
+
+		// The job keeps a reference so that the convolver isn't deleted while it's in the queue
+		if (workerPool->addJob(this, renderStageJob, stageIndex, level, this))
+			return;
+
+		// the queue is full, so we need to render it here
+		tryToRenderStage(stageIndex);
+	}
+	else
+	{
+		doBackgroundProcessing(stageIndex);
+	}
+}
+
+void MultithreadedConvolver::waitForBackgroundProcessing(int stageIndex)
+{
+	if (stageStates[stageIndex].load() == StageState::Idle)
+		return;
+
+	if (workerPool != nullptr)
+		workerPool->addMissedDeadline();
+
+	// The job hasn't been picked up by a worker, so we render it ourselves...
+	if (tryToRenderStage(stageIndex))
+		return;
+
+	// ...or wait for the worker to finish it. We spin for a short time, then we
+	// help out with the jobs that have an earlier deadline instead of burning the core.
+	for (int i = 0; i < 4096; i++)
+	{
+		if (stageStates[stageIndex].load() == StageState::Idle)
+			return;
+	}
+
+	auto level = RealtimeWorkerPool::getDeadlineLevel(getStageBlockSize(stageIndex));
+
+	while (stageStates[stageIndex].load() != StageState::Idle)
+	{
+		if (workerPool == nullptr || !workerPool->processNextJob(level))
+			Thread::yield();
+	}
+}
+
 MultithreadedConvolver::Ptr ConvolutionEffectBase::createNewEngine(audiofft::ImplementationType fftType)
 {
     MultithreadedConvolver::Ptr newConvolver = new MultithreadedConvolver(fftType);
 	newConvolver->reset();
-	newConvolver->setUseBackgroundThread(useBackgroundThread ? &backgroundThread : nullptr, true);
+	newConvolver->setUseBackgroundThread(useBackgroundThread ? &workerPool.getObject() : nullptr, true);
 
 	return newConvolver;
 }
@@ -486,8 +555,8 @@ void ConvolutionEffectBase::processBase(ProcessDataDyn& d)
                 
                 if(fadeValue >= 1.0f)
                 {
-                    backgroundThread.addConvolverToBeDeleted(fadeOutConvolverL);
-                    backgroundThread.addConvolverToBeDeleted(fadeOutConvolverR);
+                    workerPool->releaseLater(fadeOutConvolverL.get());
+                    workerPool->releaseLater(fadeOutConvolverR.get());
                     
                     fadeOutConvolverL = nullptr;
                     fadeOutConvolverR = nullptr;
@@ -574,9 +643,6 @@ bool ConvolutionEffectBase::reloadInternal()
 		getImpulseBufferBase().getBuffer().getNumChannels() == 0|| 
 		getImpulseBufferBase().getBuffer().getNumSamples() == 0 )
 	{
-		while(backgroundThread.isBusy())
-            Thread::getCurrentThread()->wait(10);
-
 		SimpleReadWriteLock::ScopedMultiWriteLock sl(swapLock);
 
 		convolverL->reset();
@@ -649,14 +715,6 @@ bool ConvolutionEffectBase::reloadInternal()
     
     
 	{
-		while (backgroundThread.isBusy())
-		{
-			auto currentThread = Thread::getCurrentThread();
-			
-			if(currentThread != nullptr)
-				currentThread->wait(10);
-		}
-
 		SimpleReadWriteLock::ScopedMultiWriteLock sl(swapLock);
         
         std::swap(fadeOutConvolverL, convolverL);
@@ -666,14 +724,17 @@ bool ConvolutionEffectBase::reloadInternal()
         
         if(convolverL != nullptr)
         {
-            backgroundThread.addConvolverToBeDeleted(convolverL);
-            backgroundThread.addConvolverToBeDeleted(convolverR);
+            workerPool->releaseLater(convolverL.get());
+            workerPool->releaseLater(convolverR.get());
         }
         
         convolverL = s1;
         convolverR = s2;
 	}
 
+	// If the pool has no workers, nobody else would delete the old engines
+	workerPool->clearDeleteList();
+
 	return true;
 }
 
@@ -106,157 +106,79 @@ private:
 	Smoother smoother;
 };
 
-class MultithreadedConvolver : public fftconvolver::TwoStageFFTConvolver,
+/** A convolution engine that uses a non-uniform partitioning and renders the tail stages on a shared worker pool.
+
+	The impulse response is split into a small head that is rendered on the audio thread and multiple
+	tail stages with growing block sizes (see fftconvolver::MultiStageFFTConvolver). Every tail stage
+	is dispatched to the RealtimeWorkerPool as a job with a deadline of its block size, so that many long
+	impulse responses can be rendered by multiple threads without increasing the latency.
+
+	Since the deadline of a stage equals its block size, the workers always pick the stage with the
+	earliest deadline first. If a stage is not finished when the audio thread needs the result, the
+	audio thread will either render it itself (if it wasn't picked up yet) or wait for the worker.
+*/
+class MultithreadedConvolver : public fftconvolver::MultiStageFFTConvolver,
                                public ReferenceCountedObject
 {
 public:
     
     using Ptr = ReferenceCountedObjectPtr<MultithreadedConvolver>;
     
-	class BackgroundThread : public Thread
-	{
-	public:
-
-		BackgroundThread() :
-          Thread("Convolution Background Thread"),
-          queue(512)
-		{}
-
-        ~BackgroundThread()
-        {
-            soonToBeDeleted.clear();
-            jassert(numRegisteredConvolvers == 0);
-            
-            stopThread(1000);
-            queue.callForEveryElementInQueue({});
-            
-        }
-        
-		void run() override
-		{
-			while (!threadShouldExit())
-			{
-                {
-                    ScopedValueSetter<bool> svs(currentlyRendering, true);
-                    
-                    queue.callForEveryElementInQueue([this](MultithreadedConvolver::Ptr c)
-                    {
-                        if (threadShouldExit())
-                            return false;
-                        
-                        c->doBackgroundProcessing();
-                        c->pending.store(false);
-                        
-                        return true;
-                    });
-                }
-                
-                ReferenceCountedArray<MultithreadedConvolver> copy;
-                
-                if(!soonToBeDeleted.isEmpty())
-                {
-                    SpinLock::ScopedLockType sl(deleteLock);
-                    copy.swapWith(soonToBeDeleted);
-                }
-                
-                copy.clear();
-                
-				wait(500);
-			}
-		};
-
-        void addConvolverJob(MultithreadedConvolver::Ptr c)
-        {
-            queue.push(c);
-            notify();
-        }
-        
-        void addConvolverToBeDeleted(MultithreadedConvolver::Ptr c)
-        {
-            SpinLock::ScopedLockType sl(deleteLock);
-            soonToBeDeleted.add(c);
-        }
-        
-		bool isBusy() const { return currentlyRendering; }
-		bool currentlyRendering = false;
-		
-        int numRegisteredConvolvers = 0;
-        
-        hise::LockfreeQueue<MultithreadedConvolver::Ptr> queue;
-        
-        SpinLock deleteLock;
-        
-        ReferenceCountedArray<MultithreadedConvolver> soonToBeDeleted;
-	};
-
-
 public:
 
 	MultithreadedConvolver(audiofft::ImplementationType fftType) :
-		TwoStageFFTConvolver(fftType),
-		backgroundThread(nullptr)
-	{};
+		MultiStageFFTConvolver(fftType),
+		workerPool(nullptr)
+	{
+		for (auto& s : stageStates)
+			s.store(StageState::Idle);
+	};
 
 	virtual ~MultithreadedConvolver()
 	{
-        jassert(!pending);
-        
-        if(backgroundThread != nullptr)
-            backgroundThread->numRegisteredConvolvers--;
+		waitForAllStages();
 	};
 
-	void startBackgroundProcessing() override
-	{
-        pending.store(true);
-        
-		if (backgroundThread != nullptr)
-		{
-            backgroundThread->addConvolverJob(this);
-		}
-		else
-		{
-			doBackgroundProcessing();
-            pending.store(false);
-		}
-	}
+	void startBackgroundProcessing(int stageIndex) override;
 
-	void waitForBackgroundProcessing() override
-	{
-        while (pending.load())
-            jassertfalse;
-	}
+	void waitForBackgroundProcessing(int stageIndex) override;
 
 	static bool prepareImpulseResponse(const AudioSampleBuffer& originalBuffer, AudioSampleBuffer& buffer, bool* abortFlag, Range<int> range, double resampleRatio);
 
 	static double getResampleFactor(double sampleRate, double impulseSampleRate);
 
-	void setUseBackgroundThread(BackgroundThread* newThreadToUse, bool forceUpdate = false)
+	void setUseBackgroundThread(RealtimeWorkerPool* newPoolToUse, bool forceUpdate = false)
 	{
-		if (backgroundThread != newThreadToUse || forceUpdate)
+		if (workerPool != newPoolToUse || forceUpdate)
         {
-            if(backgroundThread != nullptr)
-                backgroundThread->numRegisteredConvolvers--;
-            
-            backgroundThread = newThreadToUse;
-            
-            if(backgroundThread != nullptr)
-                backgroundThread->numRegisteredConvolvers++;
-            
-            if (backgroundThread != nullptr && !backgroundThread->isThreadRunning())
-                backgroundThread->startThread(10);
+			// make sure that no job is rendered with the old pool
+			waitForAllStages();
+            workerPool = newPoolToUse;
         }
 	}
 
 	bool isUsingBackgroundThread() const
 	{
-		return backgroundThread != nullptr;
+		return workerPool != nullptr;
 	}
 
 private:
 
-    std::atomic<bool> pending = { false };
+	enum class StageState
+	{
+		Idle,
+		Pending,
+		Rendering
+	};
+
+	/** Renders the stage if it's pending. This is called by the worker threads and the audio thread. */
+	bool tryToRenderStage(int stageIndex);
+
+	static void renderStageJob(void* obj, int stageIndex);
+
+	std::array<std::atomic<StageState>, MaxNumStages> stageStates;
     
-    BackgroundThread* backgroundThread = nullptr;
+    RealtimeWorkerPool* workerPool = nullptr;
 };
 
 struct ConvolutionEffectBase : public AsyncUpdater,
@@ -278,7 +200,7 @@ struct ConvolutionEffectBase : public AsyncUpdater,
 
 		SimpleReadWriteLock::ScopedReadLock sl(swapLock);
         
-        auto tToUse = !nonRealtime && useBackgroundThread ? &backgroundThread : nullptr;
+        auto tToUse = !nonRealtime && useBackgroundThread ? &workerPool.getObject() : nullptr;
         
         convolverL->setUseBackgroundThread(tToUse);
 		convolverR->setUseBackgroundThread(tToUse);
@@ -289,7 +211,7 @@ struct ConvolutionEffectBase : public AsyncUpdater,
 
 protected:
 
-    MultithreadedConvolver::BackgroundThread backgroundThread;
+    SharedResourcePointer<RealtimeWorkerPool> workerPool;
     
 	void resetBase();
 
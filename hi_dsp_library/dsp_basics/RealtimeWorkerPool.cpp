@@ -0,0 +1,222 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+namespace hise { using namespace juce;
+
+RealtimeWorkerPool::Worker::Worker(RealtimeWorkerPool& parent_, int index) :
+	Thread("Realtime Worker " + String(index + 1)),
+	parent(parent_)
+{}
+
+void RealtimeWorkerPool::Worker::run()
+{
+	juce::ScopedNoDenormals snd;
+
+	while (!threadShouldExit())
+	{
+		idle.store(false);
+
+		currentlyProcessing.store(true);
+
+		while (!threadShouldExit() && parent.processNextJob())
+			;
+
+		currentlyProcessing.store(false);
+
+		parent.clearDeleteList();
+
+		// set the idle flag before checking the queues so that we can't miss a notification
+		idle.store(true);
+
+		if (parent.hasPendingJobs())
+			continue;
+
+		wait(100);
+	}
+}
+
+RealtimeWorkerPool::RealtimeWorkerPool()
+{
+	for (int i = 0; i < NumDeadlineLevels; i++)
+		queues.add(new JobQueue(512));
+
+#if HISE_NUM_REALTIME_WORKERS
+	setNumWorkers(HISE_NUM_REALTIME_WORKERS);
+#else
+	setNumWorkers(SystemStats::getNumCpus() - 1);
+#endif
+}
+
+RealtimeWorkerPool::~RealtimeWorkerPool()
+{
+	setNumWorkers(0);
+
+	for (auto q : queues)
+		jassert(q->isEmpty());
+
+	soonToBeDeleted.clear();
+}
+
+void RealtimeWorkerPool::setNumWorkers(int numWorkersToUse)
+{
+	numWorkersToUse = jlimit(0, MaxNumWorkers, numWorkersToUse);
+
+	for (auto w : workers)
+		w->signalThreadShouldExit();
+
+	for (auto w : workers)
+	{
+		w->notify();
+		w->stopThread(1000);
+	}
+
+	workers.clear();
+
+	// Process the remaining jobs here so that nobody waits for a job forever
+	while (processNextJob())
+		;
+
+	clearDeleteList();
+
+	for (int i = 0; i < numWorkersToUse; i++)
+		workers.add(new Worker(*this, i))->startThread(9);
+}
+
+bool RealtimeWorkerPool::isBusy() const
+{
+	for (auto w : workers)
+	{
+		if (w->currentlyProcessing)
+			return true;
+	}
+
+	return false;
+}
+
+int RealtimeWorkerPool::getDeadlineLevel(size_t numSamples)
+{
+	int level = 0;
+
+	while ((size_t(1) << level) < numSamples && level < NumDeadlineLevels - 1)
+		level++;
+
+	return level;
+}
+
+bool RealtimeWorkerPool::addJob(void* obj, JobFunction f, int index, int deadlineLevel, ReferenceCountedObject* owner)
+{
+	// Nobody would pick up the job, so we process it right away. The caller
+	// is still alive at this point, so there's no need to keep a reference.
+	if (workers.isEmpty())
+	{
+		f(obj, index);
+		numProcessedJobs++;
+		return true;
+	}
+
+	Job j;
+	j.obj = obj;
+	j.f = f;
+	j.index = index;
+	j.owner = owner;
+
+	if (!queues[jlimit(0, NumDeadlineLevels - 1, deadlineLevel)]->push(std::move(j)))
+		return false;
+
+	for (auto w : workers)
+	{
+		if (w->idle.load())
+		{
+			w->notify();
+			break;
+		}
+	}
+
+	return true;
+}
+
+void RealtimeWorkerPool::releaseLater(ReferenceCountedObject* obj)
+{
+	SpinLock::ScopedLockType sl(deleteLock);
+	soonToBeDeleted.add(obj);
+}
+
+bool RealtimeWorkerPool::processNextJob(int maxDeadlineLevel, bool releaseOwnerLater)
+{
+	maxDeadlineLevel = jlimit(0, NumDeadlineLevels - 1, maxDeadlineLevel);
+
+	for (int i = 0; i <= maxDeadlineLevel; i++)
+	{
+		Job j;
+
+		if (queues[i]->pop(j))
+		{
+			j.f(j.obj, j.index);
+			numProcessedJobs++;
+
+			// Don't delete the owner on the (audio) thread that helps out
+			if (releaseOwnerLater && j.owner != nullptr && j.owner->getReferenceCount() == 1)
+				releaseLater(j.owner.get());
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool RealtimeWorkerPool::hasPendingJobs() const
+{
+	for (auto q : queues)
+	{
+		if (!q->isEmpty())
+			return true;
+	}
+
+	return false;
+}
+
+void RealtimeWorkerPool::clearDeleteList()
+{
+	ReferenceCountedArray<ReferenceCountedObject> copy;
+
+	if (!soonToBeDeleted.isEmpty())
+	{
+		SpinLock::ScopedLockType sl(deleteLock);
+		copy.swapWith(soonToBeDeleted);
+	}
+
+	copy.clear();
+}
+
+}
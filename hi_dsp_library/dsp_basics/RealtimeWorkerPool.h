@@ -0,0 +1,148 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+#pragma once
+
+namespace hise { using namespace juce;
+
+/** A pool of high priority worker threads that process jobs which are added from the audio thread.
+
+	The jobs are pushed into lockfree queues, so adding a job doesn't lock or allocate. There is one
+	queue for each deadline level and the workers always pick the job with the earliest deadline first.
+
+	The convolution engines and the parallel scriptnode containers share a single instance (use a
+	SharedResourcePointer to access it) so that they don't oversubscribe the CPU with multiple sets
+	of worker threads. Background tasks that are not added from the audio thread should use the
+	SharedWorkerPool instead.
+*/
+class RealtimeWorkerPool
+{
+public:
+
+	/** The function that processes a job. The arguments are the object and the index passed into addJob(). */
+	using JobFunction = void(*)(void*, int);
+
+	static constexpr int NumDeadlineLevels = 17;
+	static constexpr int MaxNumWorkers = 16;
+
+	RealtimeWorkerPool();
+	~RealtimeWorkerPool();
+
+	/** Returns the deadline level for a job that must be finished within the given number of samples. */
+	static int getDeadlineLevel(size_t numSamples);
+
+	/** Adds a job to the queue of the deadline level and wakes up an idle worker. Returns false if the queue is full.
+
+		If you pass in an owner, the job keeps a reference to it until it was processed. Otherwise you need
+		to make sure that the object stays alive until the job was processed.
+
+		If the pool has no workers (eg. on a single core machine), the job is processed on the calling thread.
+	*/
+	bool addJob(void* obj, JobFunction f, int index, int deadlineLevel, ReferenceCountedObject* owner = nullptr);
+
+	/** Processes the next job with a deadline level up to the given level on the calling thread.
+
+		Use this to help the workers while waiting for a result instead of spinning. Returns false if there was no job. */
+	bool processNextJob(int maxDeadlineLevel) { return processNextJob(maxDeadlineLevel, true); }
+
+	/** Keeps the object alive until the next run of the worker threads so that it isn't deleted on the audio thread. */
+	void releaseLater(ReferenceCountedObject* obj);
+
+	/** Deletes the objects passed into releaseLater().
+
+		The workers call this after each run, but if the pool has no workers you need to call this from a
+		non-realtime thread (eg. when loading a new impulse response). Never call this on the audio thread.
+	*/
+	void clearDeleteList();
+
+	/** Changes the amount of worker threads. This stops all threads, so don't call it during playback. */
+	void setNumWorkers(int numWorkersToUse);
+
+	int getNumWorkers() const { return workers.size(); }
+
+	/** Returns true if any of the worker threads is currently processing a job. */
+	bool isBusy() const;
+
+	/** Call this when a job wasn't finished in time and had to be waited for. */
+	void addMissedDeadline() { numMissedDeadlines++; }
+
+	/** Returns the number of jobs that weren't finished in time and had to be waited for. */
+	int getNumMissedDeadlines() const { return numMissedDeadlines.load(); }
+
+	/** Returns the number of jobs that were processed by the worker threads. */
+	int getNumProcessedJobs() const { return numProcessedJobs.load(); }
+
+private:
+
+	struct Job
+	{
+		void* obj = nullptr;
+		JobFunction f = nullptr;
+		int index = 0;
+		ReferenceCountedObjectPtr<ReferenceCountedObject> owner;
+	};
+
+	struct Worker : public Thread
+	{
+		Worker(RealtimeWorkerPool& parent_, int index);
+
+		void run() override;
+
+		RealtimeWorkerPool& parent;
+		std::atomic<bool> idle = { false };
+		std::atomic<bool> currentlyProcessing = { false };
+	};
+
+	using JobQueue = MultithreadedLockfreeQueue<Job, MultithreadedQueueHelpers::Configuration::NoAllocationsTokenlessUsageAllowed>;
+
+	/** Pops the job with the earliest deadline and processes it. Returns false if all queues were empty. */
+	bool processNextJob() { return processNextJob(NumDeadlineLevels - 1, false); }
+
+	/** Processes the next job. If releaseOwnerLater is true, the owner of the job is passed into releaseLater() if this was the last reference. */
+	bool processNextJob(int maxDeadlineLevel, bool releaseOwnerLater);
+
+	bool hasPendingJobs() const;
+
+	OwnedArray<JobQueue> queues;
+	OwnedArray<Worker> workers;
+
+	std::atomic<int> numMissedDeadlines = { 0 };
+	std::atomic<int> numProcessedJobs = { 0 };
+
+	SpinLock deleteLock;
+	ReferenceCountedArray<ReferenceCountedObject> soonToBeDeleted;
+
+	JUCE_DECLARE_NON_COPYABLE(RealtimeWorkerPool);
+};
+
+}
@@ -431,6 +431,162 @@ float ahdsr_base::state_base::tick()
 	return state->current_value;
 }
 
+namespace ahdsr_helpers
+{
+/** Returns the number of samples of the recursion y[n+1] = base + y[n] * coef that can be calculated
+	before the value reaches the given limit. The result is one sample too small to compensate
+	rounding errors so that the actual transition is always handled by the sample-wise code.
+*/
+static int getNumSamplesUntil(float value, float base, float coef, float limit, int maxSamples)
+{
+	if (coef <= 0.0f || coef == 1.0f)
+		return 0;
+
+	// the value converges to (or diverges from) this target
+	const auto target = base / (1.0f - coef);
+	const auto delta = value - target;
+
+	if (delta == 0.0f)
+		return maxSamples;
+
+	const auto ratio = (double)(limit - target) / (double)delta;
+
+	// the limit is on the other side of the target, so it will never be reached
+	if (ratio <= 0.0)
+		return maxSamples;
+
+	const auto numSamples = std::log(ratio) / std::log((double)coef);
+
+	return jlimit(0, maxSamples, (int)jmin(numSamples, (double)maxSamples + 1.0) - 1);
+}
+
+/** Writes y[n] = target + delta * coef^n for n = 1...numSamples and returns the last value.
+
+	Four successive powers are calculated independently so that the loop can be vectorised
+	by the compiler (there's no dependency to the previous sample like in the recursion). */
+static float renderExponentialSegment(float* data, int numSamples, float value, float base, float coef)
+{
+	const auto target = base / (1.0f - coef);
+	const auto delta = value - target;
+
+	float powers[4];
+	powers[0] = coef;
+
+	for (int i = 1; i < 4; i++)
+		powers[i] = powers[i - 1] * coef;
+
+	const auto coef4 = powers[3];
+
+	int i = 0;
+
+	for (; i + 4 <= numSamples; i += 4)
+	{
+		for (int l = 0; l < 4; l++)
+		{
+			data[i + l] = target + delta * powers[l];
+			powers[l] *= coef4;
+		}
+	}
+
+	for (int l = 0; i < numSamples; i++, l++)
+		data[i] = target + delta * powers[l];
+
+	return data[numSamples - 1];
+}
+}
+
+void ahdsr_base::state_base::tickBlock(float* data, int numSamples)
+{
+	static const float silence = std::pow(10.0f, (float)HISE_SILENCE_THRESHOLD_DB * -0.05f);
+
+	const float thisSustain = envelope->sustain * modValues[3];
+
+	while (numSamples > 0)
+	{
+		active = current_state != state_base::IDLE;
+
+		int numToRender = 0;
+
+		switch (current_state)
+		{
+		case state_base::IDLE:
+		{
+			FloatVectorOperations::fill(data, current_value, numSamples);
+			return;
+		}
+		case state_base::SUSTAIN:
+		{
+			current_value = thisSustain;
+			FloatVectorOperations::fill(data, current_value, numSamples);
+			return;
+		}
+		case state_base::HOLD:
+		{
+			numToRender = jlimit(0, numSamples, (int)(envelope->holdTimeSamples - (float)holdCounter) - 1);
+
+			if (numToRender > 0)
+			{
+				holdCounter += numToRender;
+				current_value = attackLevel;
+				FloatVectorOperations::fill(data, current_value, numToRender);
+			}
+
+			break;
+		}
+		case state_base::ATTACK:
+		{
+			if (envelope->attack != 0.0f)
+			{
+				const auto limit = attackLevel > thisSustain ? attackLevel : thisSustain;
+				numToRender = ahdsr_helpers::getNumSamplesUntil(current_value, attackBase, attackCoef, limit, numSamples);
+
+				if (numToRender > 0)
+					current_value = ahdsr_helpers::renderExponentialSegment(data, numToRender, current_value, attackBase, attackCoef);
+			}
+
+			break;
+		}
+		case state_base::DECAY:
+		{
+			if (envelope->decay != 0.0f)
+			{
+				const auto limit = current_value > thisSustain ? thisSustain + silence : thisSustain - silence;
+				numToRender = ahdsr_helpers::getNumSamplesUntil(current_value, decayBase, decayCoef, limit, numSamples);
+
+				if (numToRender > 0)
+					current_value = ahdsr_helpers::renderExponentialSegment(data, numToRender, current_value, decayBase, decayCoef);
+			}
+
+			break;
+		}
+		case state_base::RELEASE:
+		{
+			if (envelope->release != 0.0f && current_value > silence)
+			{
+				numToRender = ahdsr_helpers::getNumSamplesUntil(current_value, releaseBase, releaseCoef, silence, numSamples);
+
+				if (numToRender > 0)
+					current_value = ahdsr_helpers::renderExponentialSegment(data, numToRender, current_value, releaseBase, releaseCoef);
+			}
+
+			break;
+		}
+		case state_base::RETRIGGER:
+			break;
+		}
+
+		// Use the sample-wise calculation for the transition into the next state
+		if (numToRender == 0)
+		{
+			*data = tick();
+			numToRender = 1;
+		}
+
+		data += numToRender;
+		numSamples -= numToRender;
+	}
+}
+
 static float ratioOrZero(double nom, double denom) { return denom != 0.0 ? nom / denom : 0.0; }
 
 float ahdsr_base::state_base::getUIPosition(double deltaMs)
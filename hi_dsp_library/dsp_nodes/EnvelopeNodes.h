@@ -246,6 +246,13 @@ struct ahdsr_base: public mothernode,
 
 		float tick();
 
+		/** Calculates a block of envelope values.
+
+			This evaluates the exponential segments in closed form and only uses tick() for the
+			samples around a state transition, so the result is equal to calling tick() for each
+			sample (within floating point precision). */
+		void tickBlock(float* data, int numSamples);
+
 		float getUIPosition(double delta);
 
 		void refreshAttackTime();
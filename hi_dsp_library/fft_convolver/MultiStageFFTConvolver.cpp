@@ -0,0 +1,244 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+#include "MultiStageFFTConvolver.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace fftconvolver
+{
+
+MultiStageFFTConvolver::Stage::Stage(audiofft::ImplementationType fftType) :
+  blockSize(0),
+  convolver(fftType),
+  input(),
+  inputFill(0),
+  backgroundInput(),
+  output(),
+  precalculated(),
+  precalculatedPos(0)
+{
+}
+
+
+MultiStageFFTConvolver::MultiStageFFTConvolver(audiofft::ImplementationType fftType) :
+  _fftType(fftType),
+  _headBlockSize(0),
+  _headConvolver(fftType),
+  _stages()
+{
+}
+
+
+MultiStageFFTConvolver::~MultiStageFFTConvolver()
+{
+  reset();
+}
+
+
+void MultiStageFFTConvolver::reset()
+{
+  waitForAllStages();
+
+  _headBlockSize = 0;
+  _headConvolver.reset();
+  _stages.clear();
+}
+
+
+void MultiStageFFTConvolver::cleanPipeline()
+{
+  waitForAllStages();
+
+  _headConvolver.resetInput();
+
+  for (auto& s : _stages)
+  {
+    s->convolver.resetInput();
+    s->input.setZero();
+    s->backgroundInput.setZero();
+    s->output.setZero();
+    s->precalculated.setZero();
+    s->inputFill = 0;
+    s->precalculatedPos = 0;
+  }
+}
+
+
+void MultiStageFFTConvolver::waitForAllStages()
+{
+  for (int i = 0; i < getNumStages(); i++)
+    waitForBackgroundProcessing(i);
+}
+
+
+size_t MultiStageFFTConvolver::getStageBlockSize(int stageIndex) const
+{
+  if (stageIndex >= 0 && stageIndex < getNumStages())
+    return _stages[stageIndex]->blockSize;
+
+  return 0;
+}
+
+
+bool MultiStageFFTConvolver::init(size_t headBlockSize,
+                                  size_t maxTailBlockSize,
+                                  const Sample* ir,
+                                  size_t irLen)
+{
+  reset();
+
+  if (headBlockSize == 0 || maxTailBlockSize == 0)
+  {
+    return false;
+  }
+
+  if (headBlockSize > maxTailBlockSize)
+  {
+    assert(false);
+    std::swap(headBlockSize, maxTailBlockSize);
+  }
+
+  // Ignore zeros at the end of the impulse response because they only waste computation time
+  while (irLen > 0 && ::fabs(ir[irLen-1]) < 0.000001f)
+  {
+    --irLen;
+  }
+
+  if (irLen == 0)
+  {
+    return true;
+  }
+
+  _headBlockSize = NextPowerOf2(headBlockSize);
+  maxTailBlockSize = jmax(_headBlockSize, NextPowerOf2(maxTailBlockSize));
+
+  // The first stage starts at twice its block size, so this is the part the head has to cover
+  size_t blockSize = jmin(2 * _headBlockSize, maxTailBlockSize);
+  size_t offset = jmin(irLen, 2 * blockSize);
+
+  _headConvolver.init(_headBlockSize, ir, offset);
+
+  while (offset < irLen)
+  {
+    const bool isLastStage = blockSize == maxTailBlockSize || (int)_stages.size() == MaxNumStages - 1;
+    const size_t end = isLastStage ? irLen : jmin(irLen, 4 * blockSize);
+
+    assert(offset == 2 * blockSize);
+
+    std::unique_ptr<Stage> s(new Stage(_fftType));
+
+    s->blockSize = blockSize;
+    s->convolver.init(blockSize, ir + offset, end - offset);
+    s->input.resize(blockSize);
+    s->backgroundInput.resize(blockSize);
+    s->output.resize(blockSize);
+    s->precalculated.resize(blockSize);
+
+    _stages.push_back(std::move(s));
+
+    offset = end;
+    blockSize *= 2;
+  }
+
+  return true;
+}
+
+
+void MultiStageFFTConvolver::process(const Sample* input, Sample* output, size_t len)
+{
+  // Head
+  _headConvolver.process(input, output, len);
+
+  // Tail stages
+  for (int i = 0; i < getNumStages(); i++)
+  {
+    auto& s = *_stages[i];
+
+    size_t processed = 0;
+
+    while (processed < len)
+    {
+      const size_t processing = jmin(len - processed, s.blockSize - s.inputFill);
+
+      // Sum the result of the previous block
+      const Sample* precalculated = s.precalculated.data() + s.precalculatedPos;
+      Sample* dst = output + processed;
+
+      for (size_t j = 0; j < processing; ++j)
+        dst[j] += precalculated[j];
+
+      s.precalculatedPos += processing;
+
+      // Fill input buffer
+      ::memcpy(s.input.data() + s.inputFill, input + processed, processing * sizeof(Sample));
+      s.inputFill += processing;
+      assert(s.inputFill <= s.blockSize);
+
+      if (s.inputFill == s.blockSize)
+      {
+        waitForBackgroundProcessing(i);
+        SampleBuffer::Swap(s.precalculated, s.output);
+        s.backgroundInput.copyFrom(s.input);
+        startBackgroundProcessing(i);
+
+        s.inputFill = 0;
+        s.precalculatedPos = 0;
+      }
+
+      processed += processing;
+    }
+  }
+}
+
+
+void MultiStageFFTConvolver::startBackgroundProcessing(int stageIndex)
+{
+  doBackgroundProcessing(stageIndex);
+}
+
+
+void MultiStageFFTConvolver::waitForBackgroundProcessing(int /*stageIndex*/)
+{
+}
+
+
+void MultiStageFFTConvolver::doBackgroundProcessing(int stageIndex)
+{
+  auto& s = *_stages[stageIndex];
+  s.convolver.process(s.backgroundInput.data(), s.output.data(), s.blockSize);
+}
+
+} // End of namespace fftconvolver
@@ -0,0 +1,166 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+#ifndef _FFTCONVOLVER_MULTISTAGEFFTCONVOLVER_H
+#define _FFTCONVOLVER_MULTISTAGEFFTCONVOLVER_H
+
+#include "FFTConvolver.h"
+#include "Utilities.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace fftconvolver
+{
+
+/**
+* @class MultiStageFFTConvolver
+* @brief FFT convolver using a non-uniform partitioning with an arbitrary number of stages
+*
+* This is a generalisation of the TwoStageFFTConvolver: instead of splitting the impulse
+* response into a head and a single tail, the tail is divided into segments with
+* progressively larger block sizes:
+*
+* - The head convolver processes the first 2 * B1 samples of the impulse response with
+*   the (small) head block size in the calling thread.
+*
+* - Every tail stage i uses the block size Bi = 2^i * B1 (capped at the maximum tail block
+*   size) and processes the segment [2 * Bi, 2 * Bi+1) of the impulse response. The last
+*   stage takes the remainder of the impulse response.
+*
+* Because a stage's segment starts at twice its block size, the result of a stage is
+* needed exactly Bi samples after its input block was completed. This is the deadline
+* that can be used to schedule the stages on background threads: small stages must
+* finish quickly, large stages have plenty of time.
+*
+* As with the TwoStageFFTConvolver, the processing of the stages can be moved to other
+* threads by overriding startBackgroundProcessing() / waitForBackgroundProcessing().
+*/
+class MultiStageFFTConvolver
+{
+public:
+
+  /** The maximum number of tail stages. With a head size of 1 sample this covers block sizes up to 65536. */
+  static constexpr int MaxNumStages = 16;
+
+  MultiStageFFTConvolver(audiofft::ImplementationType fftType);
+  virtual ~MultiStageFFTConvolver();
+
+  /**
+  * @brief Initializes the convolver
+  * @param headBlockSize The block size of the head (should be the audio buffer size)
+  * @param maxTailBlockSize The block size of the last (largest) stage
+  * @param ir The impulse response
+  * @param irLen Length of the impulse response in samples
+  * @return true: Success - false: Failed
+  */
+  bool init(size_t headBlockSize, size_t maxTailBlockSize, const Sample* ir, size_t irLen);
+
+  /**
+  * @brief Convolves the the given input samples and immediately outputs the result
+  * @param input The input samples
+  * @param output The convolution result
+  * @param len Number of input/output samples
+  */
+  void process(const Sample* input, Sample* output, size_t len);
+
+  /**
+  * @brief Resets the convolver and discards the set impulse response
+  */
+  void reset();
+
+  /** Clears the internal buffers so that it resets the convolution pipeline. */
+  void cleanPipeline();
+
+  /** Returns the number of tail stages that are used for the current impulse response. */
+  int getNumStages() const { return (int)_stages.size(); }
+
+  /** Returns the block size of the given stage (which is also its deadline in samples). */
+  size_t getStageBlockSize(int stageIndex) const;
+
+protected:
+
+  /**
+  * @brief Called by the convolver when the input block of the given stage is complete
+  *
+  * The default implementation calls doBackgroundProcessing() immediately. Override this
+  * method in order to dispatch the stage to another thread. The work must be finished
+  * within getStageBlockSize(stageIndex) samples.
+  */
+  virtual void startBackgroundProcessing(int stageIndex);
+
+  /**
+  * @brief Called by the convolver when it needs the result of the given stage
+  *
+  * After returning from this method, the processing of this stage has to be completed.
+  */
+  virtual void waitForBackgroundProcessing(int stageIndex);
+
+  /**
+  * @brief Actually performs the convolution of the given stage
+  */
+  void doBackgroundProcessing(int stageIndex);
+
+  /** Waits for all stages. Call this before you modify the stages. */
+  void waitForAllStages();
+
+private:
+
+  struct Stage
+  {
+    Stage(audiofft::ImplementationType fftType);
+
+    size_t blockSize;
+    FFTConvolver convolver;
+    SampleBuffer input;
+    size_t inputFill;
+    SampleBuffer backgroundInput;
+    SampleBuffer output;
+    SampleBuffer precalculated;
+    size_t precalculatedPos;
+  };
+
+  audiofft::ImplementationType _fftType;
+  size_t _headBlockSize;
+  FFTConvolver _headConvolver;
+  std::vector<std::unique_ptr<Stage>> _stages;
+
+  // Prevent uncontrolled usage
+  MultiStageFFTConvolver(const MultiStageFFTConvolver&);
+  MultiStageFFTConvolver& operator=(const MultiStageFFTConvolver&);
+};
+
+} // End of namespace fftconvolver
+
+#endif // Header guard
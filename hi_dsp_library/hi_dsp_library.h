@@ -103,6 +103,17 @@ Set this to 1 if you want to embed the libraries created with this module into y
 #define HISE_MAX_DELAY_TIME_SAMPLES 65536
 #endif
 
+/** Config: HISE_NUM_REALTIME_WORKERS
+
+	Sets the number of worker threads that render the tail stages of the convolution engines and
+	process the branches of scriptnode containers that have the ProcessInParallel property enabled.
+	The threads are shared between all convolution effects and containers. If this is 0, it will
+	use the number of CPU cores minus one.
+*/
+#ifndef HISE_NUM_REALTIME_WORKERS
+#define HISE_NUM_REALTIME_WORKERS 0
+#endif
+
 
 
 
@@ -159,6 +170,8 @@ Set this to 1 if you want to embed the libraries created with this module into y
 #include "fft_convolver/AudioFFT.h"
 #include "fft_convolver/FFTConvolver.h"
 #include "fft_convolver/TwoStageFFTConvolver.h"
+#include "fft_convolver/MultiStageFFTConvolver.h"
+#include "dsp_basics/RealtimeWorkerPool.h"
 #include "dsp_basics/ConvolutionBase.h"
 
 #include "node_api/helpers/Error.h"
@@ -171,6 +184,7 @@ Set this to 1 if you want to embed the libraries created with this module into y
 
 #include "node_api/helpers/parameter.h"
 #include "node_api/helpers/parameter_impl.h"
+#include "node_api/helpers/parallel.h"
 
 
 
@@ -58,6 +58,8 @@
 #include "snex_basics/snex_ExternalData.cpp"
 #include "node_api/helpers/Error.cpp"
 #include "node_api/helpers/ParameterData.cpp"
+#include "dsp_basics/RealtimeWorkerPool.cpp"
+#include "node_api/helpers/parallel.cpp"
 #include "node_api/nodes/Base.cpp"
 #include "node_api/nodes/OpaqueNode.cpp"
 #include "node_api/nodes/prototypes.cpp"
@@ -72,6 +74,7 @@
 #include "fft_convolver/AudioFFT.cpp"
 #include "fft_convolver/FFTConvolver.cpp"
 #include "fft_convolver/TwoStageFFTConvolver.cpp"
+#include "fft_convolver/MultiStageFFTConvolver.cpp"
 
 
 #include "dsp_basics/ConvolutionBase.cpp"
@@ -111,6 +111,7 @@ DECLARE_ID(FillMode);
 DECLARE_ID(AddToSignal);
 DECLARE_ID(UseFreqDomain);
 DECLARE_ID(IsVertical);
+DECLARE_ID(ProcessInParallel);
 DECLARE_ID(ResetValue);
 DECLARE_ID(UseResetValue);
 DECLARE_ID(RoutingMatrix);
@@ -0,0 +1,129 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+namespace scriptnode
+{
+using namespace juce;
+using namespace hise;
+
+namespace parallel
+{
+
+fork_join::fork_join()
+{}
+
+fork_join::~fork_join()
+{
+	enabled.store(false);
+
+	// wait until all workers that still have a reference to this object are done
+	while (numQueuedReferences.load() > 0)
+		Thread::sleep(1);
+}
+
+void fork_join::setEnabled(bool shouldBeEnabled)
+{
+	if (shouldBeEnabled && pool == nullptr)
+		pool.reset(new SharedResourcePointer<RealtimeWorkerPool>());
+
+	enabled.store(shouldBeEnabled);
+}
+
+void fork_join::process(void* obj, BranchFunction f, int numBranchesToProcess)
+{
+	if (!enabled.load() || suspended || numBranchesToProcess < 2)
+	{
+		for (int i = 0; i < numBranchesToProcess; i++)
+			f(obj, i);
+
+		return;
+	}
+
+	currentObject = obj;
+	currentFunction = f;
+	numRemaining.store(numBranchesToProcess);
+	numUnclaimed.store(numBranchesToProcess);
+
+	auto& p = pool->getObject();
+	auto numHelpers = jmin(numBranchesToProcess - 1, p.getNumWorkers());
+
+	for (int i = 0; i < numHelpers; i++)
+	{
+		numQueuedReferences++;
+
+		// The audio thread waits for the branches, so this uses the earliest deadline
+		if (!p.addJob(this, runAsWorker, 0, 0))
+		{
+			numQueuedReferences--;
+			break;
+		}
+	}
+
+	// Help processing the branches...
+	while (processNextBranch(false))
+		;
+
+	// ...and wait for the ones that are processed by the workers
+	while (numRemaining.load() > 0)
+		;
+}
+
+bool fork_join::processNextBranch(bool isWorker)
+{
+	auto prev = numUnclaimed.fetch_sub(1);
+
+	if (prev <= 0)
+		return false;
+
+	currentFunction(currentObject, prev - 1);
+
+	if (isWorker)
+		numProcessedByWorkers++;
+
+	numRemaining--;
+	return true;
+}
+
+void fork_join::runAsWorker(void* obj, int)
+{
+	auto f = static_cast<fork_join*>(obj);
+
+	while (f->processNextBranch(true))
+		;
+
+	f->numQueuedReferences--;
+}
+
+}
+
+}
@@ -0,0 +1,110 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+#pragma once
+
+namespace scriptnode
+{
+using namespace juce;
+using namespace hise;
+
+namespace parallel
+{
+
+/** A fork-join helper that processes the branches of a container on the RealtimeWorkerPool.
+
+	Create one of these in the container, call setEnabled() when the parallel mode is changed and then use process()
+	with a function that processes a single branch. The branches must be independent (ie. use separate buffers)
+	and the function must not allocate or lock. The sum of the branches should be performed after process()
+	returns so that the result does not depend on the order of execution.
+
+	The audio thread pushes a reference to this object into the queue with the earliest deadline and wakes
+	up idle workers. The workers and the audio thread then pick the branches one by one until all branches
+	are processed, so the audio thread never has to wait for a worker that hasn't started yet.
+*/
+struct fork_join
+{
+	/** The function that processes a branch. The first argument is the object passed into process(). */
+	using BranchFunction = void(*)(void*, int);
+
+	fork_join();
+	~fork_join();
+
+	/** Enables the parallel processing. This creates the worker pool if it hasn't been created yet. */
+	void setEnabled(bool shouldBeEnabled);
+
+	bool isEnabled() const { return enabled.load(); }
+
+	/** Processes the branches serially on the calling thread without changing the enabled state.
+
+		Call this from the audio thread before process() if the branches can't be processed on another
+		thread at the moment (eg. because they use the voice index of a PolyHandler).
+	*/
+	void setSuspended(bool shouldBeSuspended) { suspended = shouldBeSuspended; }
+
+	/** Calls f(obj, i) for every branch index and returns when all branches are processed.
+
+		If the parallel processing is disabled, the branches are processed serially on the calling thread.
+	*/
+	void process(void* obj, BranchFunction f, int numBranches);
+
+	/** Returns the number of branches that were processed by a worker thread. */
+	int getNumBranchesProcessedByWorkers() const { return numProcessedByWorkers.load(); }
+
+private:
+
+	/** Claims and processes a single branch. Returns false if there are no branches left. */
+	bool processNextBranch(bool isWorker);
+
+	/** Called by the worker after it popped this object from the queue. */
+	static void runAsWorker(void* obj, int);
+
+	std::unique_ptr<SharedResourcePointer<RealtimeWorkerPool>> pool;
+	std::atomic<bool> enabled = { false };
+	bool suspended = false;
+
+	void* currentObject = nullptr;
+	BranchFunction currentFunction = nullptr;
+
+	// the number of unclaimed branches. This counts down so that a late worker can't claim a branch of the next call
+	std::atomic<int> numUnclaimed = { 0 };
+	std::atomic<int> numRemaining = { 0 };
+	std::atomic<int> numQueuedReferences = { 0 };
+	std::atomic<int> numProcessedByWorkers = { 0 };
+
+	JUCE_DECLARE_NON_COPYABLE(fork_join);
+};
+
+}
+
+}
@@ -138,6 +138,75 @@ private:
 	
 };
 
+/** A multi container that processes its children on the realtime worker pool.
+
+	Since every child processes its own channels, there is no need for additional buffers.
+	The frame processing and the event handling is not parallelised.
+*/
+template <class ParameterClass, typename... Processors> struct multi_parallel: public multi<ParameterClass, Processors...>
+{
+	using MultiType = multi<ParameterClass, Processors...>;
+
+	SN_GET_SELF_AS_OBJECT(multi_parallel);
+
+	constexpr static int NumChannels = MultiType::NumChannels;
+
+	using BlockType = typename MultiType::BlockType;
+
+	static constexpr int getNumChannels()
+	{
+		return NumChannels;
+	}
+
+	multi_parallel()
+	{
+		forkJoin.setEnabled(true);
+	}
+
+	void process(BlockType& d)
+	{
+		currentData = &d;
+		forkJoin.process(this, processBranchStatic, (int)sizeof...(Processors));
+		currentData = nullptr;
+	}
+
+private:
+
+	template <size_t I, size_t... Js> static constexpr int getChannelOffset(std::index_sequence<Js...>)
+	{
+		return (0 + ... + (Js < I ? std::tuple_element<Js, std::tuple<Processors...>>::type::NumChannels : 0));
+	}
+
+	static void processBranchStatic(void* obj, int index)
+	{
+		processBranch(*static_cast<multi_parallel*>(obj), index, std::index_sequence_for<Processors...>());
+	}
+
+	template <size_t... Is> static void processBranch(multi_parallel& m, int index, std::index_sequence<Is...>)
+	{
+		using FunctionType = void(*)(multi_parallel&);
+		static constexpr FunctionType functions[] = { &processElement<Is>... };
+		functions[index](m);
+	}
+
+	template <size_t I> static void processElement(multi_parallel& m)
+	{
+		using ElementType = typename std::tuple_element<I, std::tuple<Processors...>>::type;
+		constexpr int NumChannelsThisTime = ElementType::NumChannels;
+		constexpr int ChannelOffset = getChannelOffset<I>(std::index_sequence_for<Processors...>());
+
+		auto& d = *m.currentData;
+
+		ProcessData<NumChannelsThisTime> thisData(d.getRawDataPointers() + ChannelOffset, d.getNumSamples());
+		thisData.copyNonAudioDataFrom(d);
+
+		std::get<I>(m.elements).process(thisData);
+	}
+
+	BlockType* currentData = nullptr;
+	parallel::fork_join forkJoin;
+};
+
 }
 
 }
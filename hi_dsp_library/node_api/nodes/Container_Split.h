@@ -198,6 +198,122 @@ private:
 	BufferType workBuffer;
 };
 
+/** A split container that processes its children on the realtime worker pool.
+
+	Every child except the first one gets its own buffer with a copy of the input signal. After
+	all children are processed, the buffers are added to the signal in the original order, so
+	the output is identical to the split container regardless of which thread processed which child.
+	The frame processing and the event handling is not parallelised.
+*/
+template <class ParameterClass, typename... Processors> struct split_parallel : public split<ParameterClass, Processors...>
+{
+	using SplitType = split<ParameterClass, Processors...>;
+
+	SN_GET_SELF_AS_OBJECT(split_parallel);
+
+	static constexpr int N = sizeof...(Processors);
+	static constexpr int NumChannels = SplitType::NumChannels;
+	static constexpr int getNumChannels() { return NumChannels; }
+
+	using BlockType = typename SplitType::BlockType;
+
+	split_parallel()
+	{
+		forkJoin.setEnabled(true);
+	}
+
+	void prepare(PrepareSpecs ps)
+	{
+		SplitType::prepare(ps);
+
+		if (N > 1 && ps.blockSize > 1)
+			branchBuffer.setSize((N - 1) * NumChannels * ps.blockSize);
+	}
+
+	template <class ProcessDataType> void process(ProcessDataType& d)
+	{
+		if constexpr (std::is_same<ProcessDataType, BlockType>())
+		{
+			if (N > 1 && (N - 1) * NumChannels * d.getNumSamples() <= branchBuffer.size())
+			{
+				auto numSamples = d.getNumSamples();
+				auto src = d.getRawDataPointers();
+				auto dst = branchBuffer.begin();
+
+				for (int i = 1; i < N; i++)
+				{
+					for (int c = 0; c < NumChannels; c++)
+					{
+						FloatVectorOperations::copy(dst, src[c], numSamples);
+						dst += numSamples;
+					}
+				}
+
+				currentData = &d;
+				forkJoin.process(this, processBranchStatic, N);
+				currentData = nullptr;
+
+				const float* b = branchBuffer.begin();
+
+				for (int i = 1; i < N; i++)
+				{
+					for (int c = 0; c < NumChannels; c++)
+					{
+						FloatVectorOperations::add(src[c], b, numSamples);
+						b += numSamples;
+					}
+				}
+
+				return;
+			}
+		}
+
+		SplitType::process(d);
+	}
+
+private:
+
+	static void processBranchStatic(void* obj, int index)
+	{
+		processBranch(*static_cast<split_parallel*>(obj), index, std::index_sequence_for<Processors...>());
+	}
+
+	template <size_t... Is> static void processBranch(split_parallel& s, int index, std::index_sequence<Is...>)
+	{
+		using FunctionType = void(*)(split_parallel&);
+		static constexpr FunctionType functions[] = { &processElement<Is>... };
+		functions[index](s);
+	}
+
+	template <size_t I> static void processElement(split_parallel& s)
+	{
+		auto& d = *s.currentData;
+
+		if constexpr (I == 0)
+		{
+			std::get<0>(s.elements).process(d);
+		}
+		else
+		{
+			auto numSamples = d.getNumSamples();
+			float* ptrs[NumChannels];
+
+			auto b = s.branchBuffer.begin() + (I - 1) * NumChannels * numSamples;
+
+			for (int c = 0; c < NumChannels; c++)
+				ptrs[c] = b + c * numSamples;
+
+			BlockType wd(ptrs, numSamples);
+			wd.copyNonAudioDataFrom(d);
+			std::get<I>(s.elements).process(wd);
+		}
+	}
+
+	BlockType* currentData = nullptr;
+	parallel::fork_join forkJoin;
+	snex::Types::heap<float> branchBuffer;
+};
+
 }
 
 }
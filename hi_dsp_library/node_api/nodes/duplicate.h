@@ -335,6 +335,19 @@ template <typename DataType, CloneProcessType ProcessType>
 
 	int getTotalNumClones() const override { return cloneData.getTotalNumClones(); }
 
+    /** Processes the clones on the realtime worker pool if the process type is Parallel or Copy.
+        Every clone will get its own buffer so the output is the same as with serial processing. */
+    void setProcessInParallel(bool shouldProcessInParallel)
+    {
+        if(forkJoin.isEnabled() != shouldProcessInParallel)
+        {
+            forkJoin.setEnabled(shouldProcessInParallel);
+            resetCopyBuffer();
+        }
+    }
+
+    parallel::fork_join& getForkJoin() { return forkJoin; }
+
 	void resetCopyBuffer()
 	{
         SimpleReadWriteLock::ScopedWriteLock sl(getCloneResizeLock());
@@ -343,12 +356,16 @@ template <typename DataType, CloneProcessType ProcessType>
         
         workBuffer.setSize(0);
         originalBuffer.setSize(0);
+        cloneBuffer.setSize(0);
         
         if (pt > CloneProcessType::Serial)
             FrameConverters::increaseBuffer(workBuffer, lastSpecs);
         
         if(pt == CloneProcessType::Copy)
             FrameConverters::increaseBuffer(originalBuffer, lastSpecs);
+
+        if(pt > CloneProcessType::Serial && forkJoin.isEnabled() && lastSpecs.blockSize > 1)
+            cloneBuffer.setSize(getTotalNumClones() * lastSpecs.numChannels * lastSpecs.blockSize);
 	}
 
 	void prepare(PrepareSpecs ps)
@@ -426,6 +443,18 @@ template <typename DataType, CloneProcessType ProcessType>
 
         bool shouldCopy = getProcessType() == CloneProcessType::Copy;
         
+        if(forkJoin.isEnabled())
+        {
+            ActiveIterator it(cloneData);
+            auto numClones = (int)(it.end() - it.begin());
+            
+            if(numClones * NumChannels * d.getNumSamples() <= cloneBuffer.size())
+            {
+                processParallel(d, numClones, shouldCopy);
+                return;
+            }
+        }
+        
         if(shouldCopy)
         {
             ProcessDataHelpers<NumChannels>::copyTo(d, originalBuffer);
@@ -455,6 +484,62 @@ template <typename DataType, CloneProcessType ProcessType>
         }
 	}
 
+	template <int P> void processParallel(ProcessData<P>& d, int numClones, bool shouldCopy)
+	{
+        auto numSamples = d.getNumSamples();
+        
+        currentCopyMode = shouldCopy;
+        currentData = &d;
+        forkJoin.process(this, processCloneStatic<P>, numClones);
+        currentData = nullptr;
+        
+        auto dPtr = d.getRawDataPointers();
+        
+        if(shouldCopy)
+        {
+            for(int i = 0; i < P; i++)
+                FloatVectorOperations::clear(dPtr[i], numSamples);
+        }
+        
+        const float* b = cloneBuffer.begin();
+        
+        for(int c = 0; c < numClones; c++)
+        {
+            for(int i = 0; i < P; i++)
+            {
+                FloatVectorOperations::add(dPtr[i], b, numSamples);
+                b += numSamples;
+            }
+        }
+	}
+
+    template <int P> static void processCloneStatic(void* obj, int cloneIndex)
+    {
+        auto& typed = *static_cast<clone_base*>(obj);
+        auto& d = *static_cast<ProcessData<P>*>(typed.currentData);
+        
+        auto numSamples = d.getNumSamples();
+        auto b = typed.cloneBuffer.begin() + cloneIndex * P * numSamples;
+        
+        float* ptrs[P];
+        
+        for(int i = 0; i < P; i++)
+        {
+            ptrs[i] = b + i * numSamples;
+            
+            if(typed.currentCopyMode)
+                FloatVectorOperations::copy(ptrs[i], d.getRawDataPointers()[i], numSamples);
+            else
+                FloatVectorOperations::clear(ptrs[i], numSamples);
+        }
+        
+        ProcessData<P> wd(ptrs, numSamples);
+        wd.copyNonAudioDataFrom(d);
+        
+        auto& clone = *(ActiveIterator(typed.cloneData).begin() + cloneIndex);
+        clone.process(wd);
+    }
+
 	template <typename ProcessDataType> void process(ProcessDataType& d)
 	{
 		if (auto sl = SimpleReadWriteLock::ScopedTryReadLock(getCloneResizeLock()))
@@ -529,6 +614,23 @@ template <typename DataType, CloneProcessType ProcessType>
 	heap<float> workBuffer;
     heap<float> originalBuffer;
 	CloneProcessType processType;
+
+    parallel::fork_join forkJoin;
+    heap<float> cloneBuffer;
+    void* currentData = nullptr;
+    bool currentCopyMode = false;
+};
+
+/** A clone container that processes the clones on the realtime worker pool.
+
+    The C++ export uses this for clone containers with the ProcessInParallel property
+    (see the clonesplit_parallel / clonecopy_parallel aliases). */
+template <typename CloneType> struct clone_parallel : public CloneType
+{
+    clone_parallel()
+    {
+        this->setProcessInParallel(true);
+    }
 };
 
 }
@@ -1789,6 +1789,18 @@ using fix_clonesplit = clone_base<clone_data<T, options::no, NumDuplicates>, Clo
 template <typename T, int NumDuplicates>
 using fix_clonecopy = clone_base<clone_data<T, options::no, NumDuplicates>, CloneProcessType::Copy>;
 
+template <typename T, int NumDuplicates>
+using clonesplit_parallel = clone_parallel<clonesplit<T, NumDuplicates>>;
+
+template <typename T, int NumDuplicates>
+using clonecopy_parallel = clone_parallel<clonecopy<T, NumDuplicates>>;
+
+template <typename T, int NumDuplicates>
+using fix_clonesplit_parallel = clone_parallel<fix_clonesplit<T, NumDuplicates>>;
+
+template <typename T, int NumDuplicates>
+using fix_clonecopy_parallel = clone_parallel<fix_clonecopy<T, NumDuplicates>>;
+
 
 }
 
@@ -167,6 +167,11 @@ void FrontendProcessor::decActiveEditors()
 	{
 		updater.suspendState = true;
         updater.updateDelayed();
+
+#if HISE_INCLUDE_RLOTTIE
+		// The animations will render their frames again when the interface is opened
+		releaseRLottieFrameCache();
+#endif
 	}
 }
 
@@ -339,6 +344,11 @@ updater(*this)
 	{
 		getSampleManager().getProjectHandler().setNetworkData(externalFiles->getChildWithName("Networks"));
 		setExternalScriptData(externalFiles->getChildWithName("ExternalScripts"));
+
+		auto numRestored = scriptTokenCache->restoreSnapshot(externalFiles->getChildWithName("ExternalScripts"));
+		ignoreUnused(numRestored);
+		LOG_START("Restored the tokens of " + String(numRestored) + " scripts");
+
 		restoreCustomFontValueTree(externalFiles->getChildWithName("CustomFonts"));
 		restoreEmbeddedMarkdownDocs(externalFiles->getChildWithName("MarkdownDocs"));
 		restoreWebResources(externalFiles->getChildWithName("WebViewResources"));
@@ -591,14 +601,14 @@ void FrontendProcessor::setStateInformation(const void *data, int sizeInBytes)
 	if (getMacroManager().isMacroEnabledOnFrontend())
 		getMacroManager().getMacroChain()->loadMacrosFromValueTree(v, false);
 
-    getUserPresetHandler().restoreStateManager(v, UserPresetIds::MidiAutomation);
+	restoreStateSection(v, UserPresetIds::MidiAutomation);
 
 	channelData = v.getProperty("MidiChannelFilterData", -1);
 	if (channelData != -1) synthChain->getActiveChannelData()->restoreFromData(channelData);
 
 	globalBPM = v.getProperty("HostTempo", -1.0);
 
-    getUserPresetHandler().restoreStateManager(v, UserPresetIds::Modules);
+	restoreStateSection(v, UserPresetIds::Modules);
     
 	const String userPresetName = v.getProperty("UserPreset").toString();
 
@@ -608,11 +618,21 @@ void FrontendProcessor::setStateInformation(const void *data, int sizeInBytes)
 	}
 
 	if (getUserPresetHandler().isUsingCustomDataModel())
-        getUserPresetHandler().restoreStateManager(v, UserPresetIds::CustomJSON);
+		restoreStateSection(v, UserPresetIds::CustomJSON);
 	else
-		synthChain->restoreInterfaceValues(v.getChildWithName("InterfaceData"));
+	{
+		auto interfaceData = v.getChildWithName("InterfaceData");
+
+#if HISE_SKIP_UNCHANGED_STATE_RESTORE
+		ValueTree currentState("ControlData");
+		synthChain->saveInterfaceValues(currentState);
+
+		if (!UserPresetHandler::isStateSectionUnchanged(interfaceData, currentState.getChildWithName("InterfaceData")))
+#endif
+			synthChain->restoreInterfaceValues(interfaceData);
+	}
 
-    getUserPresetHandler().restoreStateManager(v, UserPresetIds::MPEData);
+	restoreStateSection(v, UserPresetIds::MPEData);
     
 	getUserPresetHandler().postPresetLoad();
 
@@ -625,6 +645,15 @@ void FrontendProcessor::setStateInformation(const void *data, int sizeInBytes)
 	}
 }
 
+void FrontendProcessor::restoreStateSection(const ValueTree& v, const Identifier& stateId)
+{
+#if HISE_SKIP_UNCHANGED_STATE_RESTORE
+	getUserPresetHandler().restoreStateManagerIfChanged(v, stateId);
+#else
+	getUserPresetHandler().restoreStateManager(v, stateId);
+#endif
+}
+
 AudioProcessorEditor* FrontendProcessor::createEditor()
 {
 	return new FrontendProcessorEditor(this);
@@ -242,6 +242,9 @@ private:
     
     SuspendUpdater updater;
     
+	/** Restores the state manager (and skips it if the state hasn't changed). */
+	void restoreStateSection(const ValueTree& v, const Identifier& stateId);
+
 	friend class FrontendProcessorEditor;
 	friend class DefaultFrontendBar;
 
@@ -260,6 +263,9 @@ private:
 
 	friend class FrontendProcessorEditor;
 
+	/** Keeps the restored script tokens alive until the scripts are compiled. */
+	SharedResourcePointer<HiseJavascriptTokenCache> scriptTokenCache;
+
 	ScopedPointer<ModulatorSynthChain> synthChain;
 
 	int currentlyLoadedProgram;
@@ -1166,8 +1166,8 @@ bool CompressionHelpers::Misc::validateChecksum(uint32 data)
 
 #define CHECK_FLAG(x) if(!readAndCheckFlag(fis, x)) { if(listener != nullptr) listener->criticalErrorOccured("Read error"); return false; }
 
-#define VERBOSE_LOG(x) if(listener != nullptr) listener->logVerboseMessage(x);
-#define STATUS_LOG(x) if(listener != nullptr) listener->logStatusMessage(x);
+#define VERBOSE_LOG(x) if(listener != nullptr) { ScopedLock sl(listenerLock); listener->logVerboseMessage(x); }
+#define STATUS_LOG(x) if(listener != nullptr) { ScopedLock sl(listenerLock); listener->logStatusMessage(x); }
 
 var HlacArchiver::readMetadataFromArchive(const File& sourceFile)
 {
@@ -1186,6 +1186,341 @@ var HlacArchiver::readMetadataFromArchive(const File& sourceFile)
 	return var();
 }
 
+/** A decode job that converts a temporary FLAC file into the target HLAC monolith on a worker thread. */
+struct HlacArchiver::ExtractionJob : public ThreadPoolJob
+{
+	ExtractionJob(ExtractionPipeline& pipeline_, const String& name_, const File& tmpFlacFile_, const File& targetHlacFile_, int64 numBytes_) :
+		ThreadPoolJob("Extract " + name_),
+		pipeline(pipeline_),
+		name(name_),
+		tmpFlacFile(tmpFlacFile_),
+		targetHlacFile(targetHlacFile_),
+		numBytes(numBytes_)
+	{}
+
+	~ExtractionJob()
+	{
+		tmpFlacFile.deleteFile();
+	}
+
+	JobStatus runJob() override;
+
+	bool extract();
+
+	ExtractionPipeline& pipeline;
+
+	const String name;
+	const File tmpFlacFile;
+	const File targetHlacFile;
+	const int64 numBytes;
+
+	std::atomic<int64> numSamplesDone = { 0 };
+	std::atomic<int64> numSamplesTotal = { 0 };
+
+	// the size of the encoding buffer that is charged against the memory budget of the pipeline
+	int64 numReservedBytes = 0;
+};
+
+/** Keeps track of the decode jobs that are in flight and throttles the reading thread so that
+	the amount of temporary data stays bounded. */
+struct HlacArchiver::ExtractionPipeline
+{
+	ExtractionPipeline(HlacArchiver& parent_, const DecompressData& data_) :
+		parent(parent_),
+		data(data_),
+		ownedPool(data_.threadPool == nullptr ? new ThreadPool(data_.numThreads > 0 ? data_.numThreads : jmax(1, SystemStats::getNumCpus() - 1)) : nullptr),
+		pool(data_.threadPool != nullptr ? *data_.threadPool : *ownedPool),
+		numWorkers(pool.getNumThreads())
+	{}
+
+	~ExtractionPipeline()
+	{
+		aborted = true;
+
+		// The pool might be shared, so we only remove our own jobs
+		Array<ExtractionJob*> jobsToRemove;
+
+		{
+			ScopedLock sl(lock);
+			jobsToRemove.addArray(activeJobs);
+		}
+
+		for (auto j : jobsToRemove)
+			pool.removeJob(j, true, -1);
+	}
+
+	bool shouldExit() const
+	{
+		return aborted || errorOccured || parent.thread->threadShouldExit();
+	}
+
+	/** Blocks the reading thread until there is room for another temp file of the given size. */
+	bool waitForFreeSlot(int64 numBytes)
+	{
+		while (!shouldExit())
+		{
+			{
+				ScopedLock sl(lock);
+
+				// Keep one job waiting for each worker so that they never run dry while we read the archive
+				const bool hasFreeWorker = activeJobs.size() < numWorkers * 2;
+				const bool hasFreeMemory = activeJobs.isEmpty() || numBytesInFlight + numBytes <= data.maxBytesInFlight;
+
+				if (hasFreeWorker && hasFreeMemory)
+					return true;
+			}
+
+			jobFinishedEvent.wait(100);
+		}
+
+		return false;
+	}
+
+	/** Charges the memory that a job needs for encoding against the budget. Returns false if it doesn't fit.
+
+		This doesn't wait because the memory is only released by other jobs that might be queued behind this one. */
+	bool tryToReserveMemory(ExtractionJob* job, int64 numBytes)
+	{
+		ScopedLock sl(lock);
+
+		if (numBytesInFlight + numBytes > data.maxBytesInFlight)
+			return false;
+
+		job->numReservedBytes = numBytes;
+		numBytesInFlight += numBytes;
+		return true;
+	}
+
+	void addJob(const String& name, const File& tmpFlacFile, const File& targetHlacFile, int64 numBytes)
+	{
+		auto job = new ExtractionJob(*this, name, tmpFlacFile, targetHlacFile, numBytes);
+
+		{
+			ScopedLock sl(lock);
+			activeJobs.add(job);
+			numBytesInFlight += numBytes;
+		}
+
+		pool.addJob(job, true);
+	}
+
+	void jobFinished(ExtractionJob* job, bool ok)
+	{
+		{
+			ScopedLock sl(lock);
+			activeJobs.removeFirstMatchingValue(job);
+			numBytesInFlight -= job->numBytes + job->numReservedBytes;
+			numBytesCompleted += job->numBytes;
+
+			if (!ok)
+				errorOccured = true;
+
+			updateProgress();
+
+			// Signal while holding the lock so that the pipeline can't be deleted before
+			// this job is done with it (the destructor only waits for the active jobs)
+			jobFinishedEvent.signal();
+		}
+	}
+
+	/** Waits until every queued monolith was written. Returns false if a job failed or the thread was cancelled. */
+	bool waitUntilFinished()
+	{
+		for (;;)
+		{
+			{
+				ScopedLock sl(lock);
+
+				if (activeJobs.isEmpty())
+					break;
+
+				updateProgress();
+			}
+
+			if (shouldExit())
+				return false;
+
+			jobFinishedEvent.wait(100);
+		}
+
+		return !errorOccured;
+	}
+
+	/** Updates the progress of the decoding. Call this with the lock held.
+
+		The finished jobs are kept in a running count so that the progress doesn't jump back when a job is
+		removed from the active list. The jobs in flight are weighted with their size because the amount of
+		samples is not known before the decoding starts.
+	*/
+	void updateProgress()
+	{
+		if (data.progress == nullptr)
+			return;
+
+		auto numBytesDone = (double)numBytesCompleted;
+		auto numBytesTotal = numBytesCompleted;
+
+		for (auto j : activeJobs)
+		{
+			auto numSamplesTotal = j->numSamplesTotal.load();
+
+			if (numSamplesTotal > 0)
+				numBytesDone += (double)j->numBytes * (double)j->numSamplesDone.load() / (double)numSamplesTotal;
+
+			numBytesTotal += j->numBytes;
+		}
+
+		if (numBytesTotal > 0)
+		{
+			// New jobs are added while the archive is read, so we don't report a smaller value
+			lastProgress = jmax(lastProgress, numBytesDone / (double)numBytesTotal);
+			*data.progress = lastProgress;
+		}
+	}
+
+	void logVerbose(const String& message)
+	{
+		ScopedLock sl(parent.listenerLock);
+
+		if (parent.listener != nullptr)
+			parent.listener->logVerboseMessage(message);
+	}
+
+	void logStatus(const String& message)
+	{
+		ScopedLock sl(parent.listenerLock);
+
+		if (parent.listener != nullptr)
+			parent.listener->logStatusMessage(message);
+	}
+
+	void reportError(const String& message)
+	{
+		errorOccured = true;
+
+		ScopedLock sl(parent.listenerLock);
+
+		if (parent.listener != nullptr)
+			parent.listener->criticalErrorOccured(message);
+	}
+
+	HlacArchiver& parent;
+	const DecompressData& data;
+
+	ScopedPointer<ThreadPool> ownedPool;
+	ThreadPool& pool;
+	const int numWorkers;
+
+	CriticalSection lock;
+	WaitableEvent jobFinishedEvent;
+	Array<ExtractionJob*> activeJobs;
+	int64 numBytesInFlight = 0;
+	int64 numBytesCompleted = 0;
+	double lastProgress = 0.0;
+
+	std::atomic<bool> aborted = { false };
+	std::atomic<bool> errorOccured = { false };
+};
+
+ThreadPoolJob::JobStatus HlacArchiver::ExtractionJob::runJob()
+{
+	auto ok = extract();
+	pipeline.jobFinished(this, ok);
+	return jobHasFinished;
+}
+
+bool HlacArchiver::ExtractionJob::extract()
+{
+	const auto& data = pipeline.data;
+
+	FlacAudioFormat flacFormat;
+	hlac::HiseLosslessAudioFormat hlacFormat;
+	StringPairArray metadata;
+
+	FileInputStream* flacTempInputStream = new FileInputStream(tmpFlacFile);
+
+	jassert(flacTempInputStream->openedOk());
+
+	ScopedPointer<AudioFormatReader> flacReader = flacFormat.createReaderFor(flacTempInputStream, true);
+
+	if (flacReader == nullptr)
+	{
+		pipeline.reportError("Can't decode " + name);
+		return false;
+	}
+
+	pipeline.logVerbose("    " + name + " Samplerate: " + String(flacReader->sampleRate, 1));
+	pipeline.logVerbose("    " + name + " Channels: " + String(flacReader->numChannels));
+	pipeline.logVerbose("    " + name + " Length: " + String(flacReader->lengthInSamples));
+
+	numSamplesTotal = flacReader->lengthInSamples;
+
+	if (data.debugLogMode)
+		return true;
+
+	if (targetHlacFile.existsAsFile())
+		targetHlacFile.create();
+
+	FileOutputStream* monolithOutputStream = new FileOutputStream(targetHlacFile);
+	ScopedPointer<AudioFormatWriter> writer = hlacFormat.createWriterFor(monolithOutputStream, flacReader->sampleRate, flacReader->numChannels, 5, metadata, 5);
+
+	auto hlacWriter = dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get());
+
+	if (hlacWriter == nullptr)
+	{
+		pipeline.reportError("File write error for " + targetHlacFile.getFileName());
+		return false;
+	}
+
+	pipeline.logStatus("Decompressing " + name);
+
+	const int bufferSize = 8192 * 32;
+
+	hlac::HlacEncoder::CompressorOptions options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
+
+	options.applyDithering = false;
+	options.normalisationMode = data.supportFullDynamics ? 2 : 0;
+
+	// The encoded data is buffered in memory until it's flushed. If this doesn't fit into the budget
+	// (together with the other jobs), we buffer it in a temporary file next to the target instead.
+	auto numBytesToBuffer = HiseLosslessAudioFormatWriter::getPreallocationSize(flacReader->lengthInSamples, flacReader->numChannels);
+
+	if (pipeline.tryToReserveMemory(this, numBytesToBuffer))
+		hlacWriter->preallocateMemory(flacReader->lengthInSamples, flacReader->numChannels);
+	else
+		hlacWriter->setTemporaryBufferType(true);
+
+	hlacWriter->setOptions(options);
+
+	AudioSampleBuffer tempBuffer(flacReader->numChannels, bufferSize);
+
+	for (int64 readerOffset = 0; readerOffset < flacReader->lengthInSamples; readerOffset += bufferSize)
+	{
+		if (shouldExit() || pipeline.shouldExit())
+			return false;
+
+		const int numToRead = jmin<int>(bufferSize, (int)(flacReader->lengthInSamples - readerOffset));
+
+		flacReader->read(&tempBuffer, 0, numToRead, readerOffset, true, true);
+
+		if (!writer->writeFromAudioSampleBuffer(tempBuffer, 0, numToRead))
+		{
+			pipeline.reportError("File write error for " + targetHlacFile.getFileName());
+			return false;
+		}
+
+		numSamplesDone = readerOffset + numToRead;
+	}
+
+	if (!writer->flush())
+	{
+		pipeline.reportError("File write error: Flushing file " + targetHlacFile.getFileName());
+		return false;
+	}
+
+	return true;
+}
+
 bool HlacArchiver::extractSampleData(const DecompressData& data)
 {
 	jassert(listener != nullptr);
@@ -1212,8 +1547,7 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 
 	ScopedPointer<FileInputStream> fis = new FileInputStream(sourceFile);
 
-	FlacAudioFormat flacFormat;
-	hlac::HiseLosslessAudioFormat hlacFormat;
+	ExtractionPipeline pipeline(*this, data);
 
 	CHECK_FLAG(Flag::BeginMetadata);
 	auto metadataString = fis->readString();
@@ -1221,8 +1555,6 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 
 	VERBOSE_LOG(metadataString);
 
-	StringPairArray metadata;
-
 	int partIndex = 1;
 
 	currentFlag = readFlag(fis);
@@ -1315,7 +1647,13 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 		{
 			VERBOSE_LOG("  Overwriting File ");
 
-			bool ok = true;
+			CHECK_FLAG(Flag::BeginMonolithLength);
+			auto bytesToRead = fis->readInt64();
+			CHECK_FLAG(Flag::EndMonolithLength);
+
+			// Wait until the decoder threads have caught up before creating another temp file
+			if (!pipeline.waitForFreeSlot(bytesToRead))
+				return false;
 
 			File tmpFlacFile = targetHlacFile.getSiblingFile("TmpFlac.flac").getNonexistentSibling();
 
@@ -1324,14 +1662,12 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 
 			ScopedPointer<FileOutputStream> flacTempWriteStream = new FileOutputStream(tmpFlacFile);
 
-			CHECK_FLAG(Flag::BeginMonolithLength);
-			auto bytesToRead = fis->readInt64();
-			CHECK_FLAG(Flag::EndMonolithLength);
-
 			STATUS_LOG("Creating temp file");
 
 			CHECK_FLAG(Flag::BeginMonolith);
 
+			auto numBytesInTempFile = bytesToRead;
+
 			flacTempWriteStream->writeFromInputStream(*fis, bytesToRead);
 
 			currentFlag = readFlag(fis);
@@ -1351,103 +1687,25 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 				CHECK_FLAG(Flag::ResumeMonolith);
 
 				flacTempWriteStream->writeFromInputStream(*fis, bytesToRead);
+				numBytesInTempFile += bytesToRead;
 
 				currentFlag = readFlag(fis);
 			}
 
-			if (thread->threadShouldExit())
-				return false;
-
-			jassert(currentFlag == Flag::EndMonolith);
-
 			flacTempWriteStream->flush();
 			flacTempWriteStream = nullptr;
 
-			FileInputStream* flacTempInputStream = new FileInputStream(tmpFlacFile);
-
-			jassert(flacTempInputStream->openedOk());
-
-			ScopedPointer<AudioFormatReader> flacReader = flacFormat.createReaderFor(flacTempInputStream, true);
-
-			if (flacReader == nullptr)
-				return false;
-
-			VERBOSE_LOG("    Samplerate: " + String(flacReader->sampleRate, 1));
-			VERBOSE_LOG("    Channels: " + String(flacReader->numChannels));
-			VERBOSE_LOG("    Length: " + String(flacReader->lengthInSamples));
-
-			FileOutputStream* monolithOutputStream; 
-			ScopedPointer<AudioFormatWriter> writer;
-
-			if (!data.debugLogMode)
-			{
-				if (targetHlacFile.existsAsFile())
-					targetHlacFile.create();
-
-				monolithOutputStream = new FileOutputStream(targetHlacFile);
-				writer = hlacFormat.createWriterFor(monolithOutputStream, flacReader->sampleRate, flacReader->numChannels, 5, metadata, 5);
-			}
-
-			STATUS_LOG("Decompressing " + name);
-
-			const int bufferSize = 8192 * 32;
-
-			hlac::HlacEncoder::CompressorOptions options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
-
 			if (thread->threadShouldExit())
-				return false;
-
-			options.applyDithering = false;
-			options.normalisationMode = data.supportFullDynamics ? 2 : 0;
-
-			//dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get())->setTemporaryBufferType(true);
-
-			dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get())->preallocateMemory(flacReader->lengthInSamples, flacReader->numChannels);
-
-			if(!data.debugLogMode)
-				dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get())->setOptions(options);
-
-			AudioSampleBuffer tempBuffer(flacReader->numChannels, data.debugLogMode ? 0 : bufferSize);
-
-			for (int64 readerOffset = 0; readerOffset < flacReader->lengthInSamples; readerOffset += bufferSize)
 			{
-				if (thread->threadShouldExit())
-					return false;
-
-				const int numToRead = jmin<int>(bufferSize, (int)(flacReader->lengthInSamples - readerOffset));
-
-				if (!data.debugLogMode)
-				{
-					flacReader->read(&tempBuffer, 0, numToRead, readerOffset, true, true);
-					ok = writer->writeFromAudioSampleBuffer(tempBuffer, 0, numToRead);
-					if (!ok)
-					{
-						listener->criticalErrorOccured("File write error for " + targetHlacFile.getFileName());
-						return false;
-					}
-				}
-
-				*data.progress = (double)readerOffset / (double)flacReader->lengthInSamples;
+				tmpFlacFile.deleteFile();
+				return false;
 			}
 
-			
-			if (!data.debugLogMode)
-			{
-				ok = writer->flush();
-				if (!ok)
-				{
-					listener->criticalErrorOccured("File write error: Flushing file " + targetHlacFile.getFileName());
-					return false;
-				}
-
-				if (thread->threadShouldExit())
-					return false;
+			jassert(currentFlag == Flag::EndMonolith);
 
-				writer = nullptr;
-			}
+			// The decoding and HLAC encoding happens on the worker threads while we read the next monolith
+			pipeline.addJob(name, tmpFlacFile, targetHlacFile, numBytesInTempFile);
 
-			flacReader = nullptr;
-			tmpFlacFile.deleteFile();
 			currentFlag = readFlag(fis);
 		}
 		else
@@ -1489,7 +1747,7 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 
 	jassert(currentFlag == Flag::EndOfArchive);
 
-	return true;
+	return pipeline.waitUntilFinished();
 }
 
 #undef CHECK_FLAG
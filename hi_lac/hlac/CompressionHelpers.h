@@ -411,6 +411,22 @@ struct HlacArchiver
 		double* totalProgress = nullptr;
 		bool debugLogMode = false;
 
+		/** The number of monoliths that are decoded in parallel while the archive is being read.
+		
+			-1 uses all available cores (minus the one that reads the archive). */
+		int numThreads = -1;
+
+		/** If this is not null, the monoliths are decoded on this pool instead of a new one (numThreads will be ignored then).
+		
+			Use this to share the threads with other parallel tasks of the application. */
+		ThreadPool* threadPool = nullptr;
+
+		/** The maximum amount of temporary FLAC data that is waiting to be decoded plus the memory buffers of the running encoders.
+		
+			This limits the disk space and memory the pipeline uses - if a single monolith exceeds this
+			limit, it will still be extracted, but nothing else is queued until it's done. If the encoding
+			buffer of a monolith doesn't fit into the budget, it is buffered in a temporary file instead. */
+		int64 maxBytesInFlight = 1024 * 1024 * 1024;
 	};
 
 	HlacArchiver(Thread* threadToUse) :
@@ -454,6 +470,11 @@ struct HlacArchiver
 
 private:
 
+	struct ExtractionJob;
+	struct ExtractionPipeline;
+
+	CriticalSection listenerLock;
+
 	FileInputStream* writeTempFile(AudioFormatReader* reader, int bitDepth=16);
 
 	Listener* listener = nullptr;
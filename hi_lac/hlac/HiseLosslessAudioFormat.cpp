@@ -289,14 +289,14 @@ uint32 HiseLosslessHeader::getBlockAmount() const
 	return blockAmount;
 }
 
-bool HiseLosslessHeader::write(OutputStream* output)
+bool HiseLosslessHeader::write(OutputStream* output, uint32 fixedChecksum)
 {
 	output->writeByte(headerByte1);
 
 	if (headerByte1 < 2)
 		return true;
 
-	auto checkSum = CompressionHelpers::Misc::createChecksum();
+	auto checkSum = fixedChecksum != 0 ? fixedChecksum : CompressionHelpers::Misc::createChecksum();
 
 	output->writeInt((int)checkSum);
 
@@ -56,7 +56,8 @@ struct HiseLosslessHeader
 
 	uint32 getOffsetForNextBlock(int64 samplePosition, bool addHeaderOffset);
 
-	bool write(OutputStream* output);
+	/** Writes the header. If fixedChecksum is zero, it will write a random checksum. */
+	bool write(OutputStream* output, uint32 fixedChecksum=0);
 
 	void storeOffsets(uint32* offsets, int numOffsets);
 
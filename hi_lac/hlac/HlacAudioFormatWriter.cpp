@@ -159,6 +159,7 @@ void HiseLosslessAudioFormatWriter::setTemporaryBufferType(bool shouldUseTempora
 		{
 			tempFile = new TemporaryFile(File::getCurrentWorkingDirectory(), TemporaryFile::OptionFlags::putNumbersInBrackets);
 			File tempTarget = tempFile->getFile();
+			tempOutputStream = new FileOutputStream(tempTarget);
 		}
 	}
 	else
@@ -172,7 +173,7 @@ void HiseLosslessAudioFormatWriter::preallocateMemory(int64 numSamplesToWrite, i
 {
 	if (auto mos = dynamic_cast<MemoryOutputStream*>(tempOutputStream.get()))
 	{
-		int64 b = numSamplesToWrite * numChannelsToAllocate * 2 * 2 / 3;
+		int64 b = getPreallocationSize(numSamplesToWrite, numChannelsToAllocate);
 
 		// Set the limit to 1.5GB
 		int64 limit = 1024;
@@ -181,10 +182,14 @@ void HiseLosslessAudioFormatWriter::preallocateMemory(int64 numSamplesToWrite, i
 		limit *= 3;
 		limit /= 2;
 
-		if (b > limit)
-			setTemporaryBufferType(true);
-		else
+		// Writers that encode into memory (eg. the parallel monolith encoder) don't have a target file,
+		// so they just skip the preallocation.
+		const bool writesToFile = dynamic_cast<FileOutputStream*>(output) != nullptr;
+
+		if (b <= limit)
 			mos->preallocate(b);
+		else if (writesToFile)
+			setTemporaryBufferType(true);
 	}
 }
 
@@ -193,6 +198,45 @@ int64 HiseLosslessAudioFormatWriter::getNumBytesWritten() const
 	return numBytesWritten;
 }
 
+bool HiseLosslessAudioFormatWriter::appendDataFrom(HiseLosslessAudioFormatWriter& other)
+{
+	jassert(options.useCompression == other.options.useCompression);
+	jassert(numChannels == other.numChannels);
+
+	if (other.tempOutputStream == nullptr)
+		return false;
+
+	tempWasFlushed = false;
+
+	if (options.useCompression)
+		encoder.appendBlocks(other.encoder, other.blockOffsets, blockOffsets);
+
+	other.tempOutputStream->flush();
+
+	bool ok;
+
+	if (auto fos = dynamic_cast<FileOutputStream*>(other.tempOutputStream.get()))
+	{
+		FileInputStream fis(fos->getFile());
+		ok = tempOutputStream->writeFromInputStream(fis, fis.getTotalLength()) == fis.getTotalLength();
+	}
+	else
+	{
+		auto mos = dynamic_cast<MemoryOutputStream*>(other.tempOutputStream.get());
+
+		jassert(mos != nullptr);
+		ok = tempOutputStream->write(mos->getData(), mos->getDataSize());
+	}
+
+	numBytesWritten = tempOutputStream->getPosition();
+
+	// The data is now owned by this writer, so we don't want the other one to write anything
+	other.tempWasFlushed = true;
+	other.deleteTemp();
+
+	return ok;
+}
+
 bool HiseLosslessAudioFormatWriter::writeHeader()
 {
 	if (options.useCompression)
@@ -210,13 +254,13 @@ bool HiseLosslessAudioFormatWriter::writeHeader()
 
 		header.storeOffsets(blockOffsets, numBlocks);
 
-		return header.write(output);
+		return header.write(output, options.fixedChecksum);
 	}
 	else
 	{
 		auto monoHeader = HiseLosslessHeader::createMonolithHeader(numChannels, sampleRate);
 
-		return monoHeader.write(output);
+		return monoHeader.write(output, options.fixedChecksum);
 	}
 }
 
@@ -68,9 +68,22 @@ public:
 	/** Call this to preallocate the amount of memory approximately required for the extraction. */
 	void preallocateMemory(int64 numSamplesToWrite, int numChannels);
 
+	/** Returns the approximate size of the memory buffer that is used to encode the given amount of samples. */
+	static int64 getPreallocationSize(int64 numSamplesToWrite, int numChannels)
+	{
+		return numSamplesToWrite * numChannels * 2 * 2 / 3;
+	}
+
 	/** Returns the number of written bytes for this reader. */
 	int64 getNumBytesWritten() const;
 
+	/** Appends the data that was written to another (unflushed) writer with the same options.
+	
+		This allows you to encode multiple files in parallel with separate writers and assemble them in order afterwards.
+		The output will be identical to writing the files one after another into this writer.
+		The other writer will be discarded and must not be used anymore. */
+	bool appendDataFrom(HiseLosslessAudioFormatWriter& other);
+
 private:
 
 	bool writeHeader();
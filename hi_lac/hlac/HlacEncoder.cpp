@@ -119,6 +119,16 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 	
 }
 
+void HlacEncoder::appendBlocks(const HlacEncoder& other, const uint32* otherBlockOffsetData, uint32* blockOffsetData)
+{
+	for (uint32 i = 0; i < other.blockIndex; i++)
+		blockOffsetData[blockIndex + i] = numBytesWritten + otherBlockOffsetData[i];
+
+	blockIndex += other.blockIndex;
+	numBytesWritten += other.numBytesWritten;
+	numBytesUncompressed += other.numBytesUncompressed;
+}
+
 void HlacEncoder::reset()
 {
 	indexInBlock = 0;
@@ -335,7 +345,7 @@ uint8 HlacEncoder::getBitReductionAmountForMSEncoding(AudioSampleBuffer& block)
 bool HlacEncoder::writeChecksumBytesForBlock(OutputStream& output)
 {
 	
-	auto checkSum = CompressionHelpers::Misc::createChecksum();
+	auto checkSum = options.fixedChecksum != 0 ? options.fixedChecksum : CompressionHelpers::Misc::createChecksum();
 
 	if (!output.writeInt((int)checkSum))
 		return false;
@@ -68,6 +68,11 @@ public:
 		int bitRateForWholeBlock = 6;
 		bool useDiffEncodingWithFixedBlocks = false;
 
+		/** If not zero, this is written instead of the random checksums (eg. to compare the output of two writers). 
+		
+			It must be a value that was created with CompressionHelpers::Misc::createChecksum(). */
+		uint32 fixedChecksum = 0;
+
 		static String getBoolString(bool b)
 		{
 			return b ? "true" : "false";
@@ -130,6 +135,12 @@ public:
 
 	void compress(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData);
 	
+	/** Adds the blocks that another encoder has written to the block offset table so that its data can be appended
+		to the output stream of this encoder.
+		
+		Every block is encoded independently, so the result is the same as if this encoder had compressed the data itself. */
+	void appendBlocks(const HlacEncoder& other, const uint32* otherBlockOffsetData, uint32* blockOffsetData);
+
 	void reset();
 
 	void setOptions(CompressorOptions& newOptions)
@@ -343,6 +343,49 @@ void HiseSampleBuffer::copyNormalisationRanges(const HiseSampleBuffer& otherBuff
 
 }
 
+void HiseSampleBuffer::referToData(const HiseSampleBuffer& source)
+{
+	isFloat = source.isFloat;
+	numChannels = source.numChannels;
+	size = source.size;
+	useOneMap = source.useOneMap;
+	useNormalisationMap = source.useNormalisationMap;
+
+	if (isFloat)
+	{
+		auto data = const_cast<float**>(source.floatBuffer.getArrayOfReadPointers());
+		floatBuffer.setDataToReferTo(data, source.floatBuffer.getNumChannels(), source.floatBuffer.getNumSamples());
+
+		leftIntBuffer = FixedSampleBuffer(0);
+		rightIntBuffer = FixedSampleBuffer(0);
+	}
+	else
+	{
+		floatBuffer.setSize(0, 0);
+
+		leftIntBuffer = FixedSampleBuffer(source.leftIntBuffer.getReadPointer(), source.leftIntBuffer.size);
+
+		if (hasSecondChannel())
+			rightIntBuffer = FixedSampleBuffer(source.rightIntBuffer.getReadPointer(), source.rightIntBuffer.size);
+		else
+			rightIntBuffer = FixedSampleBuffer(0);
+	}
+
+	copyNormalisationInfo(source.normaliser);
+}
+
+void HiseSampleBuffer::copyNormalisationInfo(const Normaliser& source)
+{
+	normaliser.clear();
+	normaliser.infos.ensureStorageAllocated(source.infos.size());
+
+	for (const auto& i : source.infos)
+	{
+		Normaliser::NormalisationInfo i_copy(i);
+		normaliser.infos.add(std::move(i_copy), false);
+	}
+}
+
 static int dummy = 0;
 
 void HiseSampleBuffer::copy(HiseSampleBuffer& dst, const HiseSampleBuffer& source, int startSampleDst, int startSampleSource, int numSamples)
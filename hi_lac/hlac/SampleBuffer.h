@@ -227,14 +227,17 @@ public:
 	}
 
 	HiseSampleBuffer(HiseSampleBuffer&& otherBuffer) :
-		floatBuffer(otherBuffer.floatBuffer),
+		floatBuffer(std::move(otherBuffer.floatBuffer)),
 		isFloat(otherBuffer.isFloat),
 		leftIntBuffer(std::move(otherBuffer.leftIntBuffer)),
 		rightIntBuffer(std::move(otherBuffer.rightIntBuffer)),
 		numChannels(otherBuffer.numChannels),
 		size(otherBuffer.size),
-		useOneMap(otherBuffer.useOneMap)
-	{};
+		useOneMap(otherBuffer.useOneMap),
+		useNormalisationMap(otherBuffer.useNormalisationMap)
+	{
+		copyNormalisationInfo(otherBuffer.normaliser);
+	};
 
 	/** Creates an HiseSampleBuffer from an array of data pointers. */
 	HiseSampleBuffer(int16** sampleData, int numChannels_, int numSamples):
@@ -253,10 +256,12 @@ public:
 		isFloat = other.isFloat;
 		leftIntBuffer = std::move(other.leftIntBuffer);
 		rightIntBuffer = std::move(other.rightIntBuffer);
-		floatBuffer = other.floatBuffer;
+		floatBuffer = std::move(other.floatBuffer);
 		numChannels = other.numChannels;
 		size = other.size;
 		useOneMap = other.useOneMap;
+		useNormalisationMap = other.useNormalisationMap;
+		copyNormalisationInfo(other.normaliser);
 
 		return *this;
 	}
@@ -321,6 +326,13 @@ public:
 
 	void copyNormalisationRanges(const HiseSampleBuffer& otherBuffset, int startOffsetInBuffer);
 
+	/** Turns this buffer into a read-only view of the sample data of the source buffer.
+	*
+	*	The samples are not copied (only the normalisation ranges are), so the source buffer must outlive this buffer
+	*	and you must not write into it. This is used to share preload buffers between multiple sounds.
+	*/
+	void referToData(const HiseSampleBuffer& source);
+
 	/** Copies the samples from the source to the destination. The buffers must have the same data type. */
 	static void copy(HiseSampleBuffer& dst, const HiseSampleBuffer& source, int startSampleDst, int startSampleSource, int numSamples);
 
@@ -414,6 +426,8 @@ public:
 
 private:
 
+	void copyNormalisationInfo(const Normaliser& source);
+
 	Normaliser normaliser;
 
 	int numChannels = 0;
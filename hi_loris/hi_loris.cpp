@@ -39,6 +39,7 @@
 
 #include "wrapper/Helpers.cpp"
 #include "wrapper/LorisState.cpp"
+#include "wrapper/OscillatorBank.cpp"
 #include "wrapper/MultichannelPartialList.cpp"
 
 
@@ -160,6 +160,93 @@ struct CustomFunctionArgs
     double bandwidth = 0.0;
 };
 
+/** This struct will be used as argument for the batch version of the custom function.
+
+    Instead of calling the function for every breakpoint, it will be called once per partial
+    with the values of all breakpoints as arrays. The arrays have numBreakpoints elements and
+    the values you write into them (except for the time) will be written back to the breakpoints.
+*/
+struct CustomBatchArgs
+{
+    /** The function pointer type that is passed into loris_process_custom_batch(). */
+    using FunctionType = bool(*)(CustomBatchArgs&);
+
+    /** @internal The function object alias. */
+    using Function = std::function<bool(CustomBatchArgs&)>;
+
+    // Constants ========================================
+
+    /** The channel in the supplied audio file. */
+    int channelIndex = 0;
+
+    /** The index of the partial. */
+    int partialIndex = 0;
+
+    /** The sample rate of the file. */
+    double sampleRate = 44100.0;
+
+    /** the root frequency that was passed into loris_analyze. */
+    double rootFrequency = 0.0;
+
+    /** @internal: a pointer to the state context. */
+    void* obj = nullptr;
+
+    /** The number of breakpoints in this partial. */
+    int numBreakpoints = 0;
+
+    // Breakpoint arrays ================================
+
+    /** The times of the breakpoints. The domain depends on the `timedomain` configuration option. */
+    const double* time = nullptr;
+
+    /** The frequencies of the partial at the breakpoints in Hz. */
+    double* frequency = nullptr;
+
+    /** The phases of the partial at the breakpoints in radians (0 ... 2*PI). */
+    double* phase = nullptr;
+
+    /** The amplitudes of the partial. */
+    double* gain = nullptr;
+
+    /** The "noisiness" of the partial at the breakpoints. */
+    double* bandwidth = nullptr;
+};
+
+/** @internal Runs the parallel tasks (analysing multiple files and synthesising partials) on the threads of the host application.
+
+	The library doesn't create its own threads, but the host can set a function with loris_set_executor() that
+	distributes the work across its worker threads. If no function is set, the tasks are processed on the calling thread.
+*/
+struct Executor
+{
+	using JobFunction = void(*)(void* obj, int threadIndex);
+	using FunctionType = void(*)(void* executor, void* obj, JobFunction job, int maxNumThreads);
+
+	/** Calls job(obj, threadIndex) on up to maxNumThreads threads and returns when all calls are finished.
+	
+		Every call gets a unique thread index below maxNumThreads and the calling thread always uses the index 0.
+	*/
+	void run(void* obj, JobFunction job, int maxNumThreads) const
+	{
+		if (function != nullptr && maxNumThreads > 1)
+			function(executor, obj, job, maxNumThreads);
+		else
+			job(obj, 0);
+	}
+
+	/** Calls the lambda with the thread index on up to maxNumThreads threads. */
+	template <typename T> void run(T& lambda, int maxNumThreads) const
+	{
+		run(&lambda, [](void* obj, int threadIndex)
+		{
+			(*static_cast<T*>(obj))(threadIndex);
+		}, maxNumThreads);
+	}
+
+	void* executor = nullptr;
+	FunctionType function = nullptr;
+};
+
 /** @internal Some helper functions. */
 struct Helpers
 {
@@ -16,6 +16,7 @@
  */
 
 #include "LorisState.h"
+#include "../loris/src/Analyzer.h"
 
 namespace loris2hise {
 
@@ -149,6 +150,178 @@ bool LorisState::analyse(const juce::File& audioFile, double rootFrequency)
 	return false;
 }
 
+bool LorisState::analyseMultiple(const Array<File>& audioFiles, const Array<double>& rootFrequencies)
+{
+	jassert(audioFiles.size() == rootFrequencies.size());
+
+	struct Job
+	{
+		File file;
+		double rootFrequency;
+		std::unique_ptr<MultichannelPartialList> result;
+		String error;
+	};
+
+	std::vector<Job> jobs;
+
+	for (int i = 0; i < audioFiles.size(); i++)
+	{
+		auto f = audioFiles[i];
+
+		if (auto existing = getExisting(f))
+		{
+			if (currentOption.enablecache)
+			{
+				messages.add("Skip " + f.getFileName());
+				continue;
+			}
+
+			analysedFiles.removeObject(existing);
+		}
+
+		jobs.push_back({ f, rootFrequencies[i], nullptr, {} });
+	}
+
+	if (jobs.empty())
+		return true;
+
+	// Make sure that the options are initialised from the global analyzer like in analyse()
+	analyzer_configure(jobs.front().rootFrequency * 0.8, jobs.front().rootFrequency * currentOption.windowwidth, nullptr);
+	analyzer_setFreqDrift(jobs.front().rootFrequency * 0.25);
+	analyzer_storeNoBandwidth();
+
+	if (!currentOption.initialised)
+	{
+		currentOption.initLorisParameters();
+		currentOption.initialised = true;
+	}
+
+	const auto options = currentOption;
+
+	auto analyseFile = [&options](Job& job, hise::ThreadController* tc)
+	{
+		juce::AudioFormatManager m;
+		m.registerBasicFormats();
+
+		juce::ScopedPointer<juce::AudioFormatReader> r = m.createReaderFor(job.file);
+
+		if (r == nullptr)
+		{
+			job.error = "Can't read " + job.file.getFullPathName();
+			return;
+		}
+
+		auto root = job.rootFrequency;
+		std::unique_ptr<MultichannelPartialList> newEntry(new MultichannelPartialList(job.file.getFullPathName(), r->numChannels));
+
+		newEntry->setMetadata(r, root);
+		newEntry->setOptions(options);
+
+		juce::AudioSampleBuffer bf(r->numChannels, (int)r->lengthInSamples);
+		r->read(&bf, 0, (int)r->lengthInSamples, 0, true, true);
+
+		juce::HeapBlock<double> buffer;
+		buffer.allocate(bf.getNumSamples(), true);
+
+		try
+		{
+			for (int c = 0; c < bf.getNumChannels(); c++)
+			{
+				auto src = bf.getReadPointer(c);
+
+				for (int i = 0; i < bf.getNumSamples(); i++)
+					buffer[i] = src[i];
+
+				if (bf.getNumSamples() == 0)
+					continue;
+
+				// This uses the same configuration as the global analyzer in analyse()
+				Loris::Analyzer a(root * 0.8, root * options.windowwidth);
+				a.setFreqDrift(root * 0.25);
+				a.storeNoBandwidth();
+				a.setHopTime(options.hoptime);
+				a.setCropTime(options.croptime);
+				a.threadController = tc;
+
+				a.analyze(buffer.get(), buffer.get() + bf.getNumSamples(), r->sampleRate);
+
+				auto list = newEntry->get(c);
+				list->splice(list->end(), a.partials());
+			}
+		}
+		catch (Loris::Exception& ex)
+		{
+			job.error = "Loris exception in analyze(): " + String(ex.what());
+			return;
+		}
+		catch (std::exception& ex)
+		{
+			job.error = "std C++ exception in analyze(): " + String(ex.what());
+			return;
+		}
+
+		newEntry->saveAsOriginal();
+		job.result = std::move(newEntry);
+	};
+
+	const int numJobs = (int)jobs.size();
+
+	std::atomic<int> nextJob = { 0 };
+	std::atomic<int> numFinished = { 0 };
+	std::atomic<bool> cancelled = { false };
+
+	auto analyseFiles = [&](int threadIndex)
+	{
+		auto tc = currentOption.threadController;
+
+		// The progress of the thread controller is not thread safe, so every worker
+		// checks the thread state with its own controller and only the calling thread
+		// updates the total progress.
+		double workerProgress = 0.0;
+		uint32 workerLastTime = 0;
+		std::unique_ptr<hise::ThreadController> workerController;
+
+		if (tc != nullptr)
+			workerController.reset(new hise::ThreadController(*tc, &workerProgress, workerLastTime));
+
+		for (int j = nextJob++; j < numJobs && !cancelled; j = nextJob++)
+		{
+			workerProgress = 0.0;
+			analyseFile(jobs[j], workerController.get());
+			numFinished++;
+
+			if (workerController != nullptr && !*workerController)
+				cancelled = true;
+
+			if (threadIndex == 0 && tc != nullptr && !tc->setProgress((double)numFinished / (double)numJobs))
+				cancelled = true;
+		}
+	};
+
+	executor.run(analyseFiles, numJobs);
+
+	bool ok = true;
+
+	for (auto& job : jobs)
+	{
+		if (job.result != nullptr)
+		{
+			messages.add("Analyse " + job.file.getFileName());
+			analysedFiles.add(job.result.release());
+			messages.add("... Analysed OK");
+		}
+		else
+		{
+			if (ok && job.error.isNotEmpty() && !cancelled)
+				reportError(job.error.getCharPointer().getAddress());
+
+			ok = false;
+		}
+	}
+
+	return ok && !cancelled;
+}
+
 double LorisState::getOption(const juce::Identifier &id) const
 {
     juce::String msg;
@@ -43,6 +43,14 @@ struct LorisState
     void reportError(const char* msg);
     
     bool analyse(const juce::File& audioFile, double rootFrequency);
+
+    /** Analyses multiple files in parallel using the Executor.
+     
+        The result is the same as calling analyse() for each file, but every file is analysed
+        on its own thread with a separate Loris::Analyzer. The thread controller will be updated
+        after each file of the calling thread (so cancelling stops the analysis between files).
+    */
+    bool analyseMultiple(const Array<File>& audioFiles, const Array<double>& rootFrequencies);
     
     bool setOption(const juce::Identifier& id, const juce::var& data);
     
@@ -72,12 +80,22 @@ struct LorisState
 		currentOption.threadController = tc;
 	}
 
+	void setExecutor(void* executorObject, Executor::FunctionType f)
+	{
+		executor.executor = executorObject;
+		executor.function = f;
+	}
+
+	const Executor& getExecutor() const { return executor; }
+
 private:
 
     friend struct Helpers;
     
     Options currentOption;
 
+    Executor executor;
+
     juce::Result lastError;
 
     juce::OwnedArray<MultichannelPartialList> analysedFiles;
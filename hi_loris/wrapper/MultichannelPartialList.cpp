@@ -16,6 +16,7 @@
  */
 
 #include "MultichannelPartialList.h"
+#include "OscillatorBank.h"
 #include "../loris/src/Resampler.h"
 
 namespace loris2hise {
@@ -169,6 +170,80 @@ bool MultichannelPartialList::processCustom(void* obj, const CustomFunctionArgs:
 	return false;
 }
 
+bool MultichannelPartialList::processCustomBatch(void* obj, const CustomBatchArgs::Function& f)
+{
+	juce::HeapBlock<double> data;
+	size_t numAllocated = 0;
+
+	int channelIndex = 0;
+
+	for (auto l : list)
+	{
+		int partialIndex = 0;
+
+		for (auto& p : *l)
+		{
+			auto numBreakpoints = (size_t)p.numBreakpoints();
+
+			if (numBreakpoints > numAllocated)
+			{
+				data.realloc(numBreakpoints * 5);
+				numAllocated = numBreakpoints;
+			}
+
+			auto time = data.get();
+
+			CustomBatchArgs a;
+			a.channelIndex = channelIndex;
+			a.partialIndex = partialIndex;
+			a.sampleRate = sampleRate;
+			a.rootFrequency = rootFrequency;
+			a.obj = obj;
+			a.numBreakpoints = (int)numBreakpoints;
+			a.time = time;
+			a.frequency = time + numBreakpoints;
+			a.phase = a.frequency + numBreakpoints;
+			a.gain = a.phase + numBreakpoints;
+			a.bandwidth = a.gain + numBreakpoints;
+
+			int i = 0;
+
+			for (Partial::iterator iter = p.begin(); iter != p.end(); ++iter)
+			{
+				auto& b = iter.breakpoint();
+
+				time[i] = convertSecondsToTime(iter.time());
+				a.frequency[i] = b.frequency();
+				a.phase[i] = b.phase();
+				a.gain[i] = b.amplitude();
+				a.bandwidth[i] = b.bandwidth();
+				i++;
+			}
+
+			if (f(a))
+				return true;
+
+			i = 0;
+
+			for (Partial::iterator iter = p.begin(); iter != p.end(); ++iter)
+			{
+				auto& b = iter.breakpoint();
+
+				breakpoint_setAmplitude(&b, a.gain[i]);
+				breakpoint_setPhase(&b, a.phase[i]);
+				breakpoint_setFrequency(&b, a.frequency[i]);
+				breakpoint_setBandwidth(&b, a.bandwidth[i]);
+				i++;
+			}
+
+			partialIndex++;
+		}
+
+		channelIndex++;
+	}
+
+	return false;
+}
 
 bool MultichannelPartialList::process(const juce::Identifier& command, const juce::var& data)
 {
@@ -314,7 +389,7 @@ size_t MultichannelPartialList::getRequiredBytes() const
 	return list.size() * numSamples * sizeof(float);
 }
 
-juce::AudioSampleBuffer MultichannelPartialList::synthesize()
+juce::AudioSampleBuffer MultichannelPartialList::synthesize(const Executor& executor)
 {
 	juce::String msg;
 	msg << "Synthesize " << filename << "...";
@@ -324,15 +399,22 @@ juce::AudioSampleBuffer MultichannelPartialList::synthesize()
 	juce::HeapBlock<double> buffer;
 	buffer.allocate(numSamples, true);
 
+	OscillatorBank bank(sampleRate, executor);
+
 	for (int i = 0; i < list.size(); i++)
 	{
 		juce::FloatVectorOperations::clear(buffer, numSamples);
-		::synthesize(list[i], buffer, numSamples, sampleRate);
+
+		// The bandwidth enhanced partials must be rendered by the Loris synthesizer
+		if (OscillatorBank::canRender(*list[i]))
+			bank.render(*list[i], buffer, numSamples);
+		else
+			::synthesize(list[i], buffer, numSamples, sampleRate);
+
+		auto dst = output.getWritePointer(i);
 
 		for (int s = 0; s < numSamples; s++)
-		{
-			output.setSample(i, s, (float)buffer[s]);
-		}
+			dst[s] = (float)buffer[s];
 	}
 
 	Helpers::logMessage("...Synthesize OK");
@@ -72,6 +72,13 @@ struct MultichannelPartialList
         returns true if the processing was sucessful and false if there was an error.
     */
 	bool processCustom(void* obj, const CustomFunctionArgs::Function& f);
+
+    /** Same as processCustom, but calls the function once for every partial with the data of all its breakpoints.
+     
+        This avoids the overhead of calling the function for every single breakpoint. See CustomBatchArgs for the
+        data layout.
+    */
+	bool processCustomBatch(void* obj, const CustomBatchArgs::Function& f);
     
     /** Processes the partials of each channel with a predefined function.
         
@@ -92,7 +99,8 @@ struct MultichannelPartialList
     
     bool createSnapshot(const juce::Identifier& id, double timeSeconds, double* buffer, int& numChannels, int& numHarmonics);
     
-	juce::AudioSampleBuffer synthesize();
+	/** Synthesises all channels. The sinusoidal partials are rendered in parallel using the executor. */
+	juce::AudioSampleBuffer synthesize(const Executor& executor);
     
     juce::AudioSampleBuffer renderEnvelope(const Identifier& parameter, int partialIndex);
 
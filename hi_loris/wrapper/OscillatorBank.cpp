@@ -0,0 +1,352 @@
+/*
+ * This file is part of the HISE loris_library codebase (https://github.com/christophhart/loris-tools).
+ * Copyright (c) 2023 Christoph Hart
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OscillatorBank.h"
+#include "../loris/src/BreakpointUtils.h"
+#include "../loris/src/Resampler.h"
+#include "../loris/src/Synthesizer.h"
+
+namespace loris2hise {
+using namespace juce;
+
+// The same phase wrapping function as in the Loris Oscillator
+static double wrapPhase(double x)
+{
+	return x + (MathConstants<double>::twoPi * std::floor(0.5 - x / MathConstants<double>::twoPi));
+}
+
+OscillatorBank::OscillatorBank(double sampleRate_, const Executor& executor_) :
+	executor(executor_),
+	sampleRate(sampleRate_),
+	fadeTime(Loris::Synthesizer::DefaultParameters().fadeTime)
+{
+	jassert(sampleRate > 0.0);
+}
+
+bool OscillatorBank::canRender(const PartialList& partials)
+{
+	for (const auto& p : partials)
+	{
+		if (p.numBreakpoints() > 0 && p.startTime() < 0.0)
+			return false;
+
+		for (auto it = p.begin(); it != p.end(); ++it)
+		{
+			if (it.breakpoint().bandwidth() > 0.0)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+void OscillatorBank::render(const PartialList& partials, double* buffer, int numSamples) const
+{
+	std::vector<const Partial*> partialPointers;
+
+	for (const auto& p : partials)
+	{
+		if (p.numBreakpoints() > 0)
+			partialPointers.push_back(&p);
+	}
+
+	const int numPartials = (int)partialPointers.size();
+
+	// Every thread renders chunks of partials into its own buffer, which will
+	// be added to the output at the end. The calling thread (index 0) renders
+	// directly into the output buffer.
+	static constexpr int NumPartialsPerChunk = 8;
+
+	auto numChunks = (numPartials + NumPartialsPerChunk - 1) / NumPartialsPerChunk;
+	auto maxNumThreads = jmax(1, jmin(SystemStats::getNumCpus(), numChunks));
+
+	std::atomic<int> nextChunk = { 0 };
+	std::vector<HeapBlock<double>> threadBuffers((size_t)maxNumThreads);
+
+	auto renderChunks = [&](int threadIndex)
+	{
+		auto dst = buffer;
+
+		if (threadIndex > 0)
+		{
+			threadBuffers[threadIndex].calloc((size_t)numSamples);
+			dst = threadBuffers[threadIndex].get();
+		}
+
+		for (int chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+		{
+			auto end = jmin(numPartials, (chunk + 1) * NumPartialsPerChunk);
+
+			for (int i = chunk * NumPartialsPerChunk; i < end; i++)
+				renderPartial(*partialPointers[i], dst, numSamples);
+		}
+	};
+
+	executor.run(renderChunks, maxNumThreads);
+
+	for (int j = 1; j < maxNumThreads; j++)
+	{
+		if (auto tb = threadBuffers[j].get())
+		{
+			for (int i = 0; i < numSamples; i++)
+				buffer[i] += tb[i];
+		}
+	}
+}
+
+void OscillatorBank::renderPartial(Partial p, double* buffer, int numSamples) const
+{
+	// This follows Loris::Synthesizer::synthesize(Partial) exactly so that the
+	// output matches (except for rounding errors in the phase recursion).
+
+	const double oneOverSampleRate = 1.0 / sampleRate;
+
+	Loris::Resampler quantizer(oneOverSampleRate);
+	quantizer.setPhaseCorrect(true);
+	quantizer.quantize(p);
+
+	auto endSamp = (int64)(uint64)((p.endTime() + fadeTime) * sampleRate);
+
+	auto itime = (fadeTime < p.startTime()) ? (p.startTime() - fadeTime) : 0.0;
+	auto currentSamp = (int64)(uint64)((itime * sampleRate) + 0.5);
+
+	auto nullBefore = Loris::BreakpointUtils::makeNullBefore(p.first(), p.startTime() - itime);
+
+	State s;
+	s.frequency = nullBefore.frequency() * MathConstants<double>::twoPi / sampleRate;
+	s.amplitude = s.frequency > MathConstants<double>::pi ? 0.0 : nullBefore.amplitude();
+	s.phase = nullBefore.phase();
+
+	auto prevFrequency = p.first().frequency();
+
+	for (auto it = p.begin(); it != p.end(); ++it)
+	{
+		auto tgtSamp = (int64)(uint64)((it.time() * sampleRate) + 0.5);
+		jassert(tgtSamp >= currentSamp);
+
+		// reset the phase so that it matches the target breakpoint
+		if (s.amplitude == 0.0)
+		{
+			auto dphase = MathConstants<double>::pi * (prevFrequency + it.breakpoint().frequency()) * (double)(tgtSamp - currentSamp) * oneOverSampleRate;
+			s.phase = wrapPhase(it.breakpoint().phase() - dphase);
+		}
+
+		oscillate(buffer, currentSamp, tgtSamp, numSamples, s, it.breakpoint());
+
+		currentSamp = tgtSamp;
+		prevFrequency = it.breakpoint().frequency();
+	}
+
+	// render a fade out segment
+	oscillate(buffer, currentSamp, endSamp, numSamples, s, Loris::BreakpointUtils::makeNullAfter(p.last(), fadeTime));
+}
+
+void OscillatorBank::oscillate(double* buffer, int64 start, int64 end, int64 limit, State& s, const Breakpoint& target) const
+{
+	auto targetFreq = target.frequency() * MathConstants<double>::twoPi / sampleRate;
+	auto targetAmp = targetFreq > MathConstants<double>::pi ? 0.0 : target.amplitude();
+
+	const auto numSamples = end - start;
+
+	if (numSamples > 0)
+	{
+		// The Loris oscillator updates the frequency in two half steps around the phase
+		// increment, so the phase after n samples is phase + n * frequency + n^2 * dFreqOver2.
+		const double dTime = 1.0 / (double)numSamples;
+		const double dFreqOver2 = 0.5 * (targetFreq - s.frequency) * dTime;
+		const double dAmp = (targetAmp - s.amplitude) * dTime;
+
+		auto numToRender = jmin(end, limit) - start;
+
+		if (numToRender > 0)
+		{
+			static constexpr int NumLanes = 4;
+
+			// Lane j renders the samples j, j + 4, j + 8...
+			// The phase increment between two samples of a lane is 4 * f + (8k + 16) * dFreqOver2,
+			// so it is rotated by 32 * dFreqOver2 after every step.
+			double zr[NumLanes], zi[NumLanes], wr[NumLanes], wi[NumLanes];
+
+			for (int j = 0; j < NumLanes; j++)
+			{
+				auto ph = s.phase + (double)j * s.frequency + (double)(j * j) * dFreqOver2;
+				auto dph = (double)NumLanes * s.frequency + (double)(8 * j + 16) * dFreqOver2;
+
+				zr[j] = std::cos(ph);
+				zi[j] = std::sin(ph);
+				wr[j] = std::cos(dph);
+				wi[j] = std::sin(dph);
+			}
+
+			const double rr = std::cos(32.0 * dFreqOver2);
+			const double ri = std::sin(32.0 * dFreqOver2);
+
+			auto dst = buffer + start;
+			auto numBlocks = (int)(numToRender / NumLanes);
+			double a = s.amplitude;
+
+			for (int i = 0; i < numBlocks; i++)
+			{
+				for (int j = 0; j < NumLanes; j++)
+				{
+					dst[j] += (a + (double)j * dAmp) * zr[j];
+
+					auto nzr = zr[j] * wr[j] - zi[j] * wi[j];
+					auto nzi = zr[j] * wi[j] + zi[j] * wr[j];
+					auto nwr = wr[j] * rr - wi[j] * ri;
+					auto nwi = wr[j] * ri + wi[j] * rr;
+
+					zr[j] = nzr;
+					zi[j] = nzi;
+					wr[j] = nwr;
+					wi[j] = nwi;
+				}
+
+				dst += NumLanes;
+				a += (double)NumLanes * dAmp;
+			}
+
+			auto numRemaining = (int)(numToRender - (int64)numBlocks * NumLanes);
+
+			for (int j = 0; j < numRemaining; j++)
+				dst[j] += (a + (double)j * dAmp) * zr[j];
+		}
+
+		auto n = (double)numSamples;
+		s.phase = wrapPhase(s.phase + n * s.frequency + n * n * dFreqOver2);
+	}
+	else
+	{
+		s.phase = wrapPhase(s.phase);
+	}
+
+	s.frequency = targetFreq;
+	s.amplitude = targetAmp;
+}
+
+#if HI_RUN_UNIT_TESTS
+
+struct OscillatorBankTests : public juce::UnitTest
+{
+	OscillatorBankTests() :
+		UnitTest("Testing the Loris oscillator bank")
+	{}
+
+	/** Runs every job on its own std::thread. */
+	static void runOnThreads(void*, void* obj, Executor::JobFunction job, int maxNumThreads)
+	{
+		std::vector<std::thread> threads;
+
+		for (int i = 1; i < maxNumThreads; i++)
+			threads.emplace_back(job, obj, i);
+
+		job(obj, 0);
+
+		for (auto& t : threads)
+			t.join();
+	}
+
+	static PartialList createPartials(double sampleRate)
+	{
+		Random r(42);
+		PartialList partials;
+
+		for (int i = 0; i < 20; i++)
+		{
+			Partial p;
+
+			auto start = 0.01 * (double)r.nextInt(20);
+			auto f = 110.0 * (double)(i + 1);
+
+			for (int b = 0; b < 8; b++)
+			{
+				// glide the frequency and amplitude, the last partials go above nyquist
+				auto freq = f * (1.0 + 0.1 * (r.nextDouble() - 0.5)) * (i >= 18 ? (1.0 + (double)b) : 1.0);
+				auto amp = 0.05 * r.nextDouble();
+
+				p.insert(start + 0.05 * (double)b, Breakpoint(jmin(freq, sampleRate), amp, 0.0, r.nextDouble() * MathConstants<double>::twoPi));
+			}
+
+			partials.push_back(p);
+		}
+
+		return partials;
+	}
+
+	void runTest() override
+	{
+		testCanRender();
+		testMatchesSynthesizer(false);
+		testMatchesSynthesizer(true);
+	}
+
+	void testCanRender()
+	{
+		beginTest("Testing the bandwidth check");
+
+		auto partials = createPartials(44100.0);
+		expect(OscillatorBank::canRender(partials), "sinusoidal partials");
+
+		partials.back().first().setBandwidth(0.5);
+		expect(!OscillatorBank::canRender(partials), "bandwidth enhanced partials");
+	}
+
+	void testMatchesSynthesizer(bool useThreads)
+	{
+		beginTest(String("Comparing the output with the Loris synthesizer") + (useThreads ? " using multiple threads" : ""));
+
+		const double sampleRate = 44100.0;
+		const int numSamples = (int)(sampleRate * 0.7);
+
+		auto partials = createPartials(sampleRate);
+
+		std::vector<double> expected;
+		Loris::Synthesizer synth(sampleRate, expected);
+		synth.synthesize(partials.begin(), partials.end());
+
+		expected.resize((size_t)numSamples, 0.0);
+
+		Executor executor;
+
+		if (useThreads)
+			executor.function = runOnThreads;
+
+		HeapBlock<double> actual;
+		actual.calloc((size_t)numSamples);
+
+		OscillatorBank bank(sampleRate, executor);
+		bank.render(partials, actual.get(), numSamples);
+
+		double maxError = 0.0;
+		double maxValue = 0.0;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			maxError = jmax(maxError, std::abs(actual[i] - expected[i]));
+			maxValue = jmax(maxValue, std::abs(expected[i]));
+		}
+
+		expect(maxValue > 0.01, "the reference is not silent");
+		expect(maxError < 1e-6, "max error: " + String(maxError));
+	}
+};
+
+static OscillatorBankTests oscillatorBankTests;
+
+#endif
+
+}
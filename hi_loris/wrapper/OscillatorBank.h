@@ -0,0 +1,70 @@
+/*
+ * This file is part of the HISE loris_library codebase (https://github.com/christophhart/loris-tools).
+ * Copyright (c) 2023 Christoph Hart
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../loris/src/loris.h"
+#include "../loris/src/Partial.h"
+
+#include "Helpers.h"
+
+namespace loris2hise {
+using namespace juce;
+
+/** A bank of sine oscillators that renders a PartialList.
+
+	This produces the same output as the Loris Synthesizer (except for rounding errors), but it
+	computes the oscillators with a complex phasor recursion instead of calling cos() for every
+	sample. The recursion runs on four interleaved lanes so that the compiler can vectorise the
+	inner loop, and the partials are distributed over the threads of the Executor.
+
+	It only supports sinusoidal partials, so you need to check canRender() before using it (the
+	bandwidth enhanced oscillators use a noise generator that is shared between all partials, so
+	they must be rendered one after another by the Loris Synthesizer).
+*/
+struct OscillatorBank
+{
+	/** Creates a bank with the given sample rate and the default fade time of the Loris Synthesizer. */
+	OscillatorBank(double sampleRate, const Executor& executor);
+
+	/** Returns true if all partials in the list can be rendered by this class (= have no bandwidth). */
+	static bool canRender(const PartialList& partials);
+
+	/** Renders all partials and adds them to the buffer. Samples after numSamples are discarded. */
+	void render(const PartialList& partials, double* buffer, int numSamples) const;
+
+private:
+
+	/** The state of a single oscillator (the frequency is in radians per sample). */
+	struct State
+	{
+		double frequency = 0.0;
+		double amplitude = 0.0;
+		double phase = 0.0;
+	};
+
+	void renderPartial(Partial p, double* buffer, int numSamples) const;
+
+	/** Ramps the state to the breakpoint over the range [start, end) and adds the samples before limit to the buffer. */
+	void oscillate(double* buffer, int64 start, int64 end, int64 limit, State& s, const Breakpoint& target) const;
+
+	const Executor& executor;
+	const double sampleRate;
+	const double fadeTime;
+};
+
+}
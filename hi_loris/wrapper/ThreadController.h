@@ -84,6 +84,14 @@ namespace hise
 			lastTime(nullptr)
 		{};
 
+		/** Creates a controller for a worker thread that checks the same thread as the parent, but uses its own progress and timer. */
+		ThreadController(const ThreadController& parent, double* workerProgress, uint32& workerLastTime) :
+			juceThreadPointer(parent.juceThreadPointer),
+			progress(workerProgress),
+			lastTime(&workerLastTime),
+			timeout(parent.timeout)
+		{};
+
 		operator bool() const
 		{
 			if (juceThreadPointer == nullptr)
@@ -70,6 +70,33 @@ bool LorisLibrary::loris_analyze(void* state, char* file, double rootFrequency)
 	return typed->analyse(f, rootFrequency);
 }
 
+bool LorisLibrary::loris_analyze_multiple(void* state, const char* files, const double* rootFrequencies, int numFiles)
+{
+	loris2hise::LorisState::resetState(state);
+
+	auto typed = (loris2hise::LorisState*)state;
+
+	auto fileList = juce::StringArray::fromLines(juce::String(files));
+	fileList.removeEmptyStrings();
+
+	if (fileList.size() != numFiles)
+	{
+		typed->reportError("file count mismatch");
+		return false;
+	}
+
+	juce::Array<juce::File> audioFiles;
+	juce::Array<double> roots;
+
+	for (int i = 0; i < numFiles; i++)
+	{
+		audioFiles.add(juce::File(fileList[i]));
+		roots.add(rootFrequencies[i]);
+	}
+
+	return typed->analyseMultiple(audioFiles, roots);
+}
+
 bool LorisLibrary::loris_process(void* state, const char* file, const char* command, const char* json)
 {
 	loris2hise::LorisState::resetState(state);
@@ -107,6 +134,20 @@ bool LorisLibrary::loris_process_custom(void* state, const char* file, void* obj
 	return false;
 }
 
+bool LorisLibrary::loris_process_custom_batch(void* state, const char* file, void* obj, void* function)
+{
+	loris2hise::CustomBatchArgs::Function f = (loris2hise::CustomBatchArgs::FunctionType)function;
+
+	loris2hise::LorisState::resetState(state);
+
+	if (auto s = getExisting(state, file))
+	{
+		return s->processCustomBatch(obj, f);
+	}
+
+	return false;
+}
+
 bool LorisLibrary::loris_set(void* state, const char* setting, const char* value)
 {
     loris2hise::LorisState::resetState(state);
@@ -139,7 +180,7 @@ bool LorisLibrary::loris_synthesize(void* state, const char* file, float* dst, i
 	{
 		jassert(s->getRequiredBytes() > 0);
 
-		auto buffer = s->synthesize();
+		auto buffer = s->synthesize(((loris2hise::LorisState*)state)->getExecutor());
 
 		for (int i = 0; i < buffer.getNumChannels(); i++)
 		{
@@ -264,3 +305,9 @@ void LorisLibrary::setThreadController(void* state, void* t)
 			typed->setThreadController(tc);
 	}
 }
+
+void LorisLibrary::loris_set_executor(void* state, void* executor, void* function)
+{
+	if (auto typed = ((loris2hise::LorisState*)state))
+		typed->setExecutor(executor, (loris2hise::Executor::FunctionType)function);
+}
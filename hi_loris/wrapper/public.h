@@ -56,6 +56,18 @@ struct LorisLibrary
 	*/
 	static bool loris_analyze(void* state, char* file, double rootFrequency);
 
+	/** Analyses multiple audio files in parallel.
+	 
+	    - state the state context created with createLorisState().
+	    - files the full path names separated by a new line character
+	    - rootFrequencies an array with the root frequency of each file
+	    - numFiles the number of files
+
+	    This produces the same result as calling loris_analyze() for each file, but distributes the files
+	    across multiple threads.
+	*/
+	static bool loris_analyze_multiple(void* state, const char* files, const double* rootFrequencies, int numFiles);
+
 	/** Processes the analyzed partials with a predefined function.
 	 
 	    - state: the state context pointer
@@ -70,6 +82,9 @@ struct LorisLibrary
 	/** Processes the analyzed partials with a custom function. */
 	static bool loris_process_custom(void* state, const char* file, void* obj, void* function);
 
+	/** Processes the analyzed partials with a custom function that is called once per partial. See CustomBatchArgs. */
+	static bool loris_process_custom_batch(void* state, const char* file, void* obj, void* function);
+
 	static bool loris_set(void* state, const char* setting, const char* value);
 
 	static double loris_get(void* state, const char* setting);
@@ -109,5 +124,16 @@ struct LorisLibrary
 	static const char* getLastError(void* state);
 
 	static void setThreadController(void* state, void* t);
+
+	/** Sets a function that distributes the parallel tasks (loris_analyze_multiple and loris_synthesize) across the threads of the host.
+
+	    - state the state context
+	    - executor an opaque pointer that is passed back into the function
+	    - function a function pointer with the signature void(void* executor, void* obj, void(*job)(void* obj, int threadIndex), int maxNumThreads).
+	      It must call job(obj, threadIndex) on up to maxNumThreads threads with a unique thread index (0 for the calling thread) and return when all calls are finished.
+
+	    If no function is set, the tasks are processed on the calling thread.
+	*/
+	static void loris_set_executor(void* state, void* executor, void* function);
 	
 }; // extern "C"
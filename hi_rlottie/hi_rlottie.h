@@ -79,6 +79,15 @@ END_JUCE_MODULE_DECLARATION
 #define HISE_RLOTTIE_DYNAMIC_LIBRARY 0
 #endif
 
+/** Config: HISE_RLOTTIE_FRAME_CACHE_SIZE
+
+	The memory budget in megabytes that all animations of a RLottieManager can use to cache
+	their pre-rendered frames. Set this to zero to render every frame on demand.
+*/
+#ifndef HISE_RLOTTIE_FRAME_CACHE_SIZE
+#define HISE_RLOTTIE_FRAME_CACHE_SIZE 64
+#endif
+
 #if HISE_INCLUDE_RLOTTIE
 #include "include/rlottie_capi.h"
 #include "wrapper/RLottieManager.h"
@@ -14,11 +14,66 @@ namespace hise {
 using namespace juce;
 
 
-RLottieAnimation::RLottieAnimation(RLottieManager* manager, const String& data)
+struct RLottieAnimation::PrerenderJob : public ThreadPoolJob
+{
+	PrerenderJob(RLottieAnimation& parent_, int startFrame_) :
+		ThreadPoolJob("Prerender Lottie frames"),
+		parent(parent_),
+		startFrame(startFrame_),
+		width(parent_.canvas.getWidth()),
+		height(parent_.canvas.getHeight())
+	{}
+
+	JobStatus runJob() override
+	{
+		auto m = parent.manager.get();
+
+		if (m == nullptr)
+			return jobHasFinished;
+
+		auto numBytes = (int64)width * (int64)height * 4;
+		auto numFrames = parent.numFrames;
+
+		// We only evict frames that weren't used since the job was started. This prevents
+		// the prerendering from evicting its own frames (or those of another prerendering job).
+		auto evictBefore = m->getFrameCacheTime();
+
+		// Start at the current frame so that the playback catches up with the cache as soon as possible
+		for (int i = 0; i < numFrames; i++)
+		{
+			if (shouldExit())
+				break;
+
+			auto frameIndex = (startFrame + i) % numFrames;
+
+			if (m->isFrameCached(&parent, frameIndex, width, height))
+				continue;
+
+			// Stop if the cache is full of frames that are currently in use
+			if (!m->reserveFrameCacheMemory(numBytes, evictBefore))
+				break;
+
+			Image img(Image::ARGB, width, height, true);
+			parent.renderFrame(img, frameIndex);
+			m->addFrameToCache(&parent, frameIndex, img);
+			m->numPrerenderedFrames++;
+		}
+
+		return jobHasFinished;
+	}
+
+	RLottieAnimation& parent;
+	const int startFrame;
+	const int width;
+	const int height;
+};
+
+RLottieAnimation::RLottieAnimation(RLottieManager* manager_, const String& data):
+	manager(manager_)
 {
 	animation = manager->createAnimation(RLottieComponent::decompressIfBase64(data));
     
-#if HISE_RLOTTE_DYNAMIC_LIBRARY
+#if HISE_RLOTTIE_DYNAMIC_LIBRARY
 	rf = manager->getRenderFunction();
 #endif
 
@@ -28,6 +83,9 @@ RLottieAnimation::RLottieAnimation(RLottieManager* manager, const String& data)
 
 RLottieAnimation::~RLottieAnimation()
 {
+	stopPrerendering();
+	clearFrameCache();
+
 	if (manager != nullptr && animation != nullptr)
 		manager->destroy(animation);
 }
@@ -42,7 +100,10 @@ void RLottieAnimation::setSize(int width, int height)
 
 	if (newWidth != canvas.getWidth() || newHeight != canvas.getHeight())
 	{
+		stopPrerendering();
 		canvas = Image(Image::ARGB, newWidth, newHeight, true);
+		lastFrame = -1;
+		startPrerendering();
 	}
 }
 
@@ -60,14 +121,7 @@ void RLottieAnimation::render(Graphics& g, Point<int> topLeft)
 {
 	if (isValid() && isPositiveAndBelow(currentFrame, numFrames+1) && lastFrame != currentFrame)
 	{
-		Image::BitmapData bd(canvas, Image::BitmapData::ReadWriteMode::writeOnly);
-
-#if HISE_RLOTTE_DYNAMIC_LIBRARY
-		rf(animation, (size_t)currentFrame, reinterpret_cast<uint32*>(bd.data), canvas.getWidth(), canvas.getHeight(), canvas.getWidth() * 4);
-#else
-        lottie_animation_render(animation, (size_t)currentFrame, reinterpret_cast<uint32*>(bd.data), canvas.getWidth(), canvas.getHeight(), canvas.getWidth() * 4);
-#endif
-
+		canvas = getFrameImage(currentFrame);
 		lastFrame = currentFrame;
 	}
 
@@ -114,4 +168,84 @@ void RLottieAnimation::setScaleFactor(float newScaleFactor)
 	}
 }
 
+void RLottieAnimation::clearFrameCache()
+{
+	if (auto m = manager.get())
+		m->clearFrameCache(this);
+}
+
+Image RLottieAnimation::getFrameImage(int frameIndex)
+{
+	auto w = canvas.getWidth();
+	auto h = canvas.getHeight();
+
+	if (auto m = manager.get())
+	{
+		auto cached = m->getCachedFrame(this, frameIndex, w, h);
+
+		if (cached.isValid())
+		{
+			m->numFrameCacheHits++;
+			return cached;
+		}
+
+		m->numFrameCacheMisses++;
+
+		// A cache miss can evict the least recently used frames of all animations
+		if (m->reserveFrameCacheMemory((int64)w * (int64)h * 4, std::numeric_limits<uint32>::max()))
+		{
+			Image img(Image::ARGB, w, h, true);
+			renderFrame(img, frameIndex);
+
+			// The prerendering might have added the frame in the meantime
+			return m->addFrameToCache(this, frameIndex, img);
+		}
+	}
+
+	// The frame doesn't fit into the cache, so we render into the canvas 
+	// (unless it's still referenced by the cache).
+	if (canvas.getReferenceCount() > 1)
+		canvas = Image(Image::ARGB, w, h, true);
+	else
+		canvas.clear(canvas.getBounds());
+
+	renderFrame(canvas, frameIndex);
+	return canvas;
+}
+
+void RLottieAnimation::renderFrame(Image& target, int frameIndex)
+{
+	ScopedLock sl(renderLock);
+
+	Image::BitmapData bd(target, Image::BitmapData::ReadWriteMode::writeOnly);
+
+#if HISE_RLOTTIE_DYNAMIC_LIBRARY
+	rf(animation, (size_t)frameIndex, reinterpret_cast<uint32*>(bd.data), target.getWidth(), target.getHeight(), bd.lineStride);
+#else
+	lottie_animation_render(animation, (size_t)frameIndex, reinterpret_cast<uint32*>(bd.data), target.getWidth(), target.getHeight(), bd.lineStride);
+#endif
+}
+
+void RLottieAnimation::stopPrerendering()
+{
+	if (prerenderJob != nullptr)
+	{
+		if (auto m = manager.get())
+			m->removePrerenderJob(prerenderJob);
+
+		prerenderJob = nullptr;
+	}
+}
+
+void RLottieAnimation::startPrerendering()
+{
+	auto m = manager.get();
+
+	if (m == nullptr || m->getFrameCacheBudget() == 0 || !isValid() || numFrames <= 0)
+		return;
+
+	prerenderJob = new PrerenderJob(*this, jlimit(0, numFrames - 1, currentFrame));
+	m->addPrerenderJob(prerenderJob);
+}
+
 }
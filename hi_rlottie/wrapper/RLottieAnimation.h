@@ -52,8 +52,25 @@ public:
 	/** Set a scale factor that is applied to the internal canvas. */
 	void setScaleFactor(float newScaleFactor);
 
+	/** Removes all cached frames and returns their memory to the manager's budget. */
+	void clearFrameCache();
+
 private:
 
+	struct PrerenderJob;
+
+	/** Returns the image of the given frame, either from the cache or by rendering it synchronously. */
+	Image getFrameImage(int frameIndex);
+
+	/** Renders the frame into the image. This can be called from any thread. */
+	void renderFrame(Image& target, int frameIndex);
+
+	void stopPrerendering();
+	void startPrerendering();
+
+	CriticalSection renderLock;
+	ScopedPointer<ThreadPoolJob> prerenderJob;
+
 	int originalWidth = 0;
 	int originalHeight = 0;
 	float scaleFactor = 1.0f;
@@ -16,7 +16,8 @@ using namespace juce;
 
 
 RLottieManager::RLottieManager():
-	lastResult(Result::fail("This Manager is not initialised. Call init() before using it"))
+	lastResult(Result::fail("This Manager is not initialised. Call init() before using it")),
+	frameCacheBudget((int64)HISE_RLOTTIE_FRAME_CACHE_SIZE * 1024 * 1024)
 {
 	
 }
@@ -159,6 +160,215 @@ double RLottieManager::getFrameRate(Lottie_Animation* animation)
 #endif
 }
 
+void RLottieManager::setFrameCacheBudget(int64 newBudgetInBytes)
+{
+	frameCacheBudget.store(jmax<int64>(0, newBudgetInBytes));
+
+	auto numExcessBytes = numFrameCacheBytes.load() - frameCacheBudget.load();
+
+	if (numExcessBytes > 0)
+		releaseFrameCacheMemory(numExcessBytes);
+}
+
+int64 RLottieManager::releaseFrameCacheMemory(int64 numBytesToRelease)
+{
+	ScopedLock sl(frameCacheLock);
+
+	int64 numReleased = 0;
+
+	while (!frameCache.empty() && (numBytesToRelease < 0 || numReleased < numBytesToRelease))
+	{
+		numReleased += frameCache.front().getNumBytes();
+		removeFrame(frameCache.begin());
+	}
+
+	jassert(numFrameCacheBytes.load() >= 0);
+
+	return numReleased;
+}
+
+RLottieManager::FrameCacheStatistics RLottieManager::getFrameCacheStatistics() const
+{
+	FrameCacheStatistics s;
+	s.numHits = numFrameCacheHits.load();
+	s.numMisses = numFrameCacheMisses.load();
+	s.numPrerenderedFrames = numPrerenderedFrames.load();
+	s.numBytesUsed = numFrameCacheBytes.load();
+	s.budget = frameCacheBudget.load();
+	return s;
+}
+
+void RLottieManager::resetFrameCacheStatistics()
+{
+	numFrameCacheHits.store(0);
+	numFrameCacheMisses.store(0);
+	numPrerenderedFrames.store(0);
+}
+
+Image RLottieManager::getCachedFrame(const RLottieAnimation* owner, int frameIndex, int width, int height)
+{
+	ScopedLock sl(frameCacheLock);
+
+	auto f = frameCacheIndex.find({ owner, frameIndex });
+
+	if (f == frameCacheIndex.end() || !f->second->matches(width, height))
+		return {};
+
+	touchFrame(f->second);
+	return f->second->image;
+}
+
+bool RLottieManager::isFrameCached(const RLottieAnimation* owner, int frameIndex, int width, int height) const
+{
+	ScopedLock sl(frameCacheLock);
+
+	auto f = frameCacheIndex.find({ owner, frameIndex });
+	return f != frameCacheIndex.end() && f->second->matches(width, height);
+}
+
+uint32 RLottieManager::getFrameCacheTime() const
+{
+	ScopedLock sl(frameCacheLock);
+	return frameCacheAccessCounter;
+}
+
+bool RLottieManager::reserveFrameCacheMemory(int64 numBytes, uint32 evictBefore)
+{
+	if (numBytes <= 0)
+		return false;
+
+	ScopedLock sl(frameCacheLock);
+
+	while (numFrameCacheBytes.load() + numBytes > frameCacheBudget.load())
+	{
+		if (frameCache.empty() || frameCache.front().lastAccess >= evictBefore)
+			return false;
+
+		removeFrame(frameCache.begin());
+	}
+
+	numFrameCacheBytes += numBytes;
+	return true;
+}
+
+Image RLottieManager::addFrameToCache(const RLottieAnimation* owner, int frameIndex, const Image& img)
+{
+	ScopedLock sl(frameCacheLock);
+
+	auto f = frameCacheIndex.find({ owner, frameIndex });
+
+	if (f != frameCacheIndex.end())
+	{
+		if (f->second->matches(img.getWidth(), img.getHeight()))
+		{
+			// The memory was reserved for the new image, so we give it back
+			numFrameCacheBytes -= f->second->getNumBytes();
+			touchFrame(f->second);
+			return f->second->image;
+		}
+
+		// The frame was rendered with another canvas size
+		removeFrame(f->second);
+	}
+
+	frameCache.push_back({ owner, frameIndex, img, ++frameCacheAccessCounter });
+	frameCacheIndex[{ owner, frameIndex }] = std::prev(frameCache.end());
+	return img;
+}
+
+void RLottieManager::clearFrameCache(const RLottieAnimation* owner)
+{
+	ScopedLock sl(frameCacheLock);
+
+	// The index is sorted by the animation, so the frames of the owner are in a contiguous range
+	auto f = frameCacheIndex.lower_bound({ owner, std::numeric_limits<int>::min() });
+
+	while (f != frameCacheIndex.end() && f->first.first == owner)
+	{
+		numFrameCacheBytes -= f->second->getNumBytes();
+		frameCache.erase(f->second);
+		f = frameCacheIndex.erase(f);
+	}
+}
+
+void RLottieManager::touchFrame(FrameList::iterator it)
+{
+	it->lastAccess = ++frameCacheAccessCounter;
+	frameCache.splice(frameCache.end(), frameCache, it);
+}
+
+void RLottieManager::removeFrame(FrameList::iterator it)
+{
+	numFrameCacheBytes -= it->getNumBytes();
+	frameCacheIndex.erase({ it->owner, it->frameIndex });
+	frameCache.erase(it);
+}
+
+ThreadPool& RLottieManager::getPrerenderPool()
+{
+	if (ownedPrerenderPool == nullptr)
+		ownedPrerenderPool = new ThreadPool(1);
+
+	return *ownedPrerenderPool;
+}
+
+void RLottieManager::addPrerenderJob(ThreadPoolJob* job)
+{
+	ScopedLock sl(prerenderLock);
+
+	// The pool is fetched once so that a subclass can't hand out another pool while jobs are running
+	if (prerenderPool == nullptr)
+		prerenderPool = &getPrerenderPool();
+
+	prerenderJobs.addIfNotAlreadyThere(job);
+	prerenderPool->addJob(job, false);
+}
+
+void RLottieManager::removePrerenderJob(ThreadPoolJob* job)
+{
+	ThreadPool* pool = nullptr;
+
+	{
+		ScopedLock sl(prerenderLock);
+
+		if (!prerenderJobs.contains(job))
+			return;
+
+		pool = prerenderPool;
+	}
+
+	pool->removeJob(job, true, -1);
+
+	ScopedLock sl(prerenderLock);
+	prerenderJobs.removeFirstMatchingValue(job);
+}
+
+void RLottieManager::stopPrerendering()
+{
+	ScopedLock sl(prerenderLock);
+
+	if (prerenderPool == nullptr)
+		return;
+
+	struct Selector : public ThreadPool::JobSelector
+	{
+		Selector(const Array<ThreadPoolJob*>& jobs_) :
+			jobs(jobs_)
+		{};
+
+		bool isJobSuitable(ThreadPoolJob* job) override { return jobs.contains(job); }
+
+		const Array<ThreadPoolJob*>& jobs;
+	};
+
+	// Only remove our own jobs, the pool might be shared with other tasks
+	Selector selector(prerenderJobs);
+	prerenderPool->removeAllJobs(true, -1, &selector);
+
+	prerenderJobs.clear();
+	prerenderPool = nullptr;
+}
+
 #if HISE_RLOTTIE_DYNAMIC_LIBRARY
 juce::File RLottieManager::getLibFile()
 {
@@ -177,6 +387,144 @@ juce::File RLottieManager::getLibFile()
 }
 #endif
 
+#if HI_RUN_UNIT_TESTS
+
+/** Tests the eviction of the frame cache. The animations are only used as keys, so the test uses dummy pointers. */
+struct RLottieFrameCacheTests : public UnitTest
+{
+	RLottieFrameCacheTests() :
+		UnitTest("Testing the RLottie frame cache")
+	{};
+
+	struct TestManager : public RLottieManager
+	{
+		File getLibraryFolder() const override { return {}; }
+	};
+
+	static constexpr int FrameSize = 4;
+	static constexpr int64 NumBytesPerFrame = FrameSize * FrameSize * 4;
+
+	void runTest() override
+	{
+		testLeastRecentlyUsedEviction();
+		testReleaseMemory();
+		testFrameIndex();
+	}
+
+	bool addFrame(TestManager& m, const RLottieAnimation* owner, int frameIndex, uint32 evictBefore=std::numeric_limits<uint32>::max())
+	{
+		if (!m.reserveFrameCacheMemory(NumBytesPerFrame, evictBefore))
+			return false;
+
+		m.addFrameToCache(owner, frameIndex, Image(Image::ARGB, FrameSize, FrameSize, true));
+		return true;
+	}
+
+	bool isCached(TestManager& m, const RLottieAnimation* owner, int frameIndex)
+	{
+		return m.isFrameCached(owner, frameIndex, FrameSize, FrameSize);
+	}
+
+	void testLeastRecentlyUsedEviction()
+	{
+		beginTest("Testing the least recently used eviction");
+
+		TestManager m;
+		m.setFrameCacheBudget(3 * NumBytesPerFrame);
+
+		int dummyA, dummyB;
+		auto a = reinterpret_cast<const RLottieAnimation*>(&dummyA);
+		auto b = reinterpret_cast<const RLottieAnimation*>(&dummyB);
+
+		expect(addFrame(m, a, 0), "first frame not added");
+		expect(addFrame(m, a, 1), "second frame not added");
+		expect(addFrame(m, b, 0), "third frame not added");
+
+		// use the first frame so that the second frame is the least recently used one
+		expect(m.getCachedFrame(a, 0, FrameSize, FrameSize).isValid(), "cached frame not found");
+
+		expect(addFrame(m, b, 1), "the frame of another animation couldn't evict a frame");
+
+		expect(isCached(m, a, 0), "recently used frame was evicted");
+		expect(!isCached(m, a, 1), "least recently used frame wasn't evicted");
+		expect(isCached(m, b, 0) && isCached(m, b, 1), "frames of the other animation were evicted");
+		expectEquals(m.getFrameCacheStatistics().numBytesUsed, 3 * NumBytesPerFrame, "wrong memory usage after eviction");
+
+		// the prerendering must not evict frames that were used after it was started
+		expect(!addFrame(m, a, 2, 0), "frames that are in use were evicted");
+		expectEquals(m.getFrameCacheStatistics().numBytesUsed, 3 * NumBytesPerFrame, "failed reservation changed the memory usage");
+
+		m.setFrameCacheBudget(NumBytesPerFrame);
+
+		expectEquals(m.getFrameCacheStatistics().numBytesUsed, NumBytesPerFrame, "lowering the budget didn't evict the frames");
+		expect(isCached(m, b, 1), "the most recently used frame was evicted");
+	}
+
+	void testReleaseMemory()
+	{
+		beginTest("Testing the release of the frame cache memory");
+
+		TestManager m;
+		m.setFrameCacheBudget(8 * NumBytesPerFrame);
+
+		int dummy;
+		auto a = reinterpret_cast<const RLottieAnimation*>(&dummy);
+
+		for (int i = 0; i < 4; i++)
+			expect(addFrame(m, a, i), "frame not added");
 
+		// adding the same frame twice (eg. from the prerendering) must not account the memory twice
+		expect(addFrame(m, a, 3), "duplicate frame not accepted");
+		expectEquals(m.getFrameCacheStatistics().numBytesUsed, 4 * NumBytesPerFrame, "duplicate frame was counted twice");
+
+		expectEquals(m.releaseFrameCacheMemory(NumBytesPerFrame + 1), 2 * NumBytesPerFrame, "wrong amount of released memory");
+		expect(!isCached(m, a, 0) && !isCached(m, a, 1), "the oldest frames were not released");
+		expect(isCached(m, a, 2) && isCached(m, a, 3), "too many frames were released");
+
+		expectEquals(m.releaseFrameCacheMemory(), 2 * NumBytesPerFrame, "clearing the cache released the wrong amount");
+		expectEquals(m.getFrameCacheStatistics().numBytesUsed, (int64)0, "memory usage after clearing the cache");
+		expectEquals(m.releaseFrameCacheMemory(), (int64)0, "released memory from an empty cache");
+	}
+
+	void testFrameIndex()
+	{
+		beginTest("Testing the frame index");
+
+		TestManager m;
+		m.setFrameCacheBudget(64 * NumBytesPerFrame);
+
+		int dummyA, dummyB;
+		auto a = reinterpret_cast<const RLottieAnimation*>(&dummyA);
+		auto b = reinterpret_cast<const RLottieAnimation*>(&dummyB);
+
+		for (int i = 0; i < 8; i++)
+		{
+			expect(addFrame(m, a, i), "frame not added");
+			expect(addFrame(m, b, i), "frame not added");
+		}
+
+		// a frame with another canvas size replaces the old frame
+		expect(m.reserveFrameCacheMemory(4 * NumBytesPerFrame, std::numeric_limits<uint32>::max()), "no memory for the larger frame");
+		m.addFrameToCache(a, 3, Image(Image::ARGB, 2 * FrameSize, 2 * FrameSize, true));
+
+		expect(!isCached(m, a, 3), "old frame size still cached");
+		expect(m.isFrameCached(a, 3, 2 * FrameSize, 2 * FrameSize), "new frame size not cached");
+		expectEquals(m.getFrameCacheStatistics().numBytesUsed, 19 * NumBytesPerFrame, "wrong memory usage after replacing a frame");
+
+		m.clearFrameCache(a);
+
+		for (int i = 0; i < 8; i++)
+		{
+			expect(!isCached(m, a, i), "frame of the cleared animation still cached");
+			expect(isCached(m, b, i), "frame of the other animation was removed");
+		}
+
+		expectEquals(m.getFrameCacheStatistics().numBytesUsed, 8 * NumBytesPerFrame, "wrong memory usage after clearing an animation");
+	}
+};
+
+static RLottieFrameCacheTests rLottieFrameCacheTests;
+
+#endif
 
 }
@@ -15,7 +15,7 @@
 namespace hise {
 using namespace juce;
 
-
+class RLottieAnimation;
 
 
 /** This class will open the dynamic libraries and close them when it is deleted. 
@@ -27,6 +27,9 @@ public:
 
 	virtual ~RLottieManager()
     {
+		// stop the prerendering before the weak reference master goes away
+		stopPrerendering();
+
 #if HISE_RLOTTIE_DYNAMIC_LIBRARY
         dynLib = nullptr;
 #endif
@@ -41,6 +44,47 @@ public:
 	/** Returns the result of the initialisation. */
 	Result getInitResult() const { return lastResult; }
 
+	/** A snapshot of the frame cache usage of all animations that were created by this manager. */
+	struct FrameCacheStatistics
+	{
+		/** Returns the ratio of rendered frames that could be taken from the cache. */
+		double getHitRate() const
+		{
+			auto numTotal = numHits + numMisses;
+			return numTotal > 0 ? (double)numHits / (double)numTotal : 0.0;
+		}
+
+		int numHits = 0;
+		int numMisses = 0;
+		int numPrerenderedFrames = 0;
+		int64 numBytesUsed = 0;
+		int64 budget = 0;
+	};
+
+	/** Sets the amount of memory in bytes that all animations can use for their frame cache.
+	
+		If you lower the budget below the current usage, the least recently used frames of all
+		animations will be evicted. Set it to zero to disable the cache.
+	*/
+	void setFrameCacheBudget(int64 newBudgetInBytes);
+
+	/** Evicts the least recently used frames of all animations until at least the given amount of bytes is released.
+	
+		Call this when the system is low on memory or when the animations are not visible anymore (the frames
+		will be rendered again when they are needed). Pass in a negative number to clear the entire cache.
+		Returns the amount of bytes that were released.
+	*/
+	int64 releaseFrameCacheMemory(int64 numBytesToRelease=-1);
+
+	/** Returns the memory budget of the frame cache in bytes. */
+	int64 getFrameCacheBudget() const { return frameCacheBudget.load(); }
+
+	/** Returns the current cache statistics. */
+	FrameCacheStatistics getFrameCacheStatistics() const;
+
+	/** Resets the hit / miss counters of the frame cache. */
+	void resetFrameCacheStatistics();
+
 protected:
 
 	RLottieManager();
@@ -48,6 +92,16 @@ protected:
 	/** Override this method and return the library folder. */
 	virtual File getLibraryFolder() const = 0;
 
+	/** Override this method and return the thread pool that prerenders the frames of all animations.
+
+		The default implementation creates a single background thread. If you return a pool that is shared
+		with other tasks, you need to call stopPrerendering() in the destructor of your subclass.
+	*/
+	virtual ThreadPool& getPrerenderPool();
+
+	/** Removes the prerender jobs of all animations from the pool and waits until they are finished. */
+	void stopPrerendering();
+
 private:
 
 	Result lastResult;
@@ -70,7 +124,81 @@ private:
 	/** @internal */
 	double getFrameRate(Lottie_Animation* animation);
 
+	/** A rendered frame. An animation only caches one size per frame, so a frame with another canvas size will be replaced. */
+	struct CachedFrame
+	{
+		int64 getNumBytes() const { return (int64)image.getWidth() * (int64)image.getHeight() * 4; }
+
+		bool matches(int width, int height) const { return image.getWidth() == width && image.getHeight() == height; }
+
+		const RLottieAnimation* owner;
+		int frameIndex;
+		Image image;
+		uint32 lastAccess;
+	};
+
+	/** The frames sorted by their last access (the least recently used frame is at the front). */
+	using FrameList = std::list<CachedFrame>;
+
+	/** The position of each frame in the list, indexed by the animation and the frame index. */
+	using FrameIndex = std::map<std::pair<const RLottieAnimation*, int>, FrameList::iterator>;
+
+	/** @internal Returns the cached frame (or a null image) and marks it as used. */
+	Image getCachedFrame(const RLottieAnimation* owner, int frameIndex, int width, int height);
+
+	/** @internal */
+	bool isFrameCached(const RLottieAnimation* owner, int frameIndex, int width, int height) const;
+
+	/** @internal Returns the current value of the access counter. */
+	uint32 getFrameCacheTime() const;
+
+	/** @internal Tries to account the given amount of bytes against the frame cache budget.
+	
+		If the budget is exhausted, it will evict the least recently used frames of all animations that 
+		weren't accessed after evictBefore until the frame fits. 
+	*/
+	bool reserveFrameCacheMemory(int64 numBytes, uint32 evictBefore);
+
+	/** @internal Adds the frame to the cache and returns the image that should be used. 
+	
+		If the frame was added by another thread in the meantime, it will release the reserved memory
+		and return the existing image.
+	*/
+	Image addFrameToCache(const RLottieAnimation* owner, int frameIndex, const Image& img);
+
+	/** @internal Removes all frames of the animation. */
+	void clearFrameCache(const RLottieAnimation* owner);
+
+	/** @internal Adds the job to the prerender pool. The job is owned by the animation. */
+	void addPrerenderJob(ThreadPoolJob* job);
+
+	/** @internal Removes the job from the prerender pool and waits until it's finished. */
+	void removePrerenderJob(ThreadPoolJob* job);
+
+	/** @internal Marks the frame as used and moves it to the end of the list. */
+	void touchFrame(FrameList::iterator it);
+
+	/** @internal Removes the frame from the cache and returns its memory to the budget. */
+	void removeFrame(FrameList::iterator it);
+
+	CriticalSection frameCacheLock;
+	FrameList frameCache;
+	FrameIndex frameCacheIndex;
+	uint32 frameCacheAccessCounter = 0;
+
+	std::atomic<int64> frameCacheBudget;
+	std::atomic<int64> numFrameCacheBytes = { 0 };
+	std::atomic<int> numFrameCacheHits = { 0 };
+	std::atomic<int> numFrameCacheMisses = { 0 };
+	std::atomic<int> numPrerenderedFrames = { 0 };
+
+	CriticalSection prerenderLock;
+	ThreadPool* prerenderPool = nullptr;
+	ScopedPointer<ThreadPool> ownedPrerenderPool;
+	Array<ThreadPoolJob*> prerenderJobs;
+
 	friend class RLottieAnimation;
+	friend struct RLottieFrameCacheTests;
 
 #if HISE_RLOTTIE_DYNAMIC_LIBRARY
     
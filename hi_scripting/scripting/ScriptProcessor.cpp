@@ -716,6 +716,9 @@ ValueTree FileChangeListener::collectAllScriptFiles(ModulatorSynthChain *chainTo
 		}
 	}
 
+	// Embed the tokens so that the plugin doesn't need to tokenise the scripts when it's loaded
+	HiseJavascriptTokenCache::addSnapshotToScripts(externalScriptFiles);
+
 	return externalScriptFiles;
 }
 
@@ -674,6 +674,9 @@ private:
 
 	ValueTree allInterfaceData;
 
+	// keeps the tokens of the included files alive between compilations
+	SharedResourcePointer<HiseJavascriptTokenCache> tokenCache;
+
 	JUCE_DECLARE_WEAK_REFERENCEABLE(JavascriptProcessor);
 
 public:
@@ -1940,6 +1940,549 @@ private:
 
 static CustomContainerTest unorderedStackTest;
 
+/** Checks that the embedded references are decompressed lazily and that releasing a pool item
+    doesn't mix up items with the same hash code. */
+class SharedPoolTests : public UnitTest
+{
+public:
+
+	SharedPoolTests() :
+		UnitTest("Testing shared pools")
+	{};
+
+	void runTest() override
+	{
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		testLazyEmbeddedReferences(bp);
+		testReleaseItemsWithSameHash(bp);
+	}
+
+private:
+
+	static constexpr int NumItems = 4;
+
+	static PoolReference createReference(PoolBase& pool, int index)
+	{
+		return PoolReference(&pool, "{PROJECT_FOLDER}Map" + String(index), FileHandlerBase::SampleMaps);
+	}
+
+	void testLazyEmbeddedReferences(MainController* mc)
+	{
+		beginTest("Testing lazy embedded references");
+
+		auto handler = &mc->getCurrentFileHandler();
+
+		MemoryBlock mb;
+
+		{
+			SharedPoolBase<ValueTree> source(mc, handler);
+
+			for (int i = 0; i < NumItems; i++)
+			{
+				ValueTree v("samplemap");
+				v.setProperty("Index", i, nullptr);
+				source.createAsEmbeddedReference(createReference(source, i), v);
+			}
+
+			source.getDataProvider()->writePool(new MemoryOutputStream(mb, false));
+		}
+
+		SharedPoolBase<ValueTree> target(mc, handler);
+		target.getDataProvider()->restorePool(new MemoryInputStream(mb, false));
+		target.loadAllFilesFromDataProvider();
+
+		expectEquals(target.getNumLoadedFiles(), NumItems, "wrong number of files");
+		expectEquals(target.indexOf(createReference(target, 2)), 2, "wrong index of pending reference");
+		expectEquals(target.getReference(3).getReferenceString(), createReference(target, 3).getReferenceString(), "wrong pending reference");
+		expect(target.getStatistics().contains(String(NumItems) + " not loaded"), "counting decompressed the data");
+
+		auto ptr = target.loadFromReference(createReference(target, 0), PoolHelpers::LoadAndCacheWeak);
+
+		expect(ptr && (int)ptr.getData()->getProperty("Index") == 0, "wrong data");
+		expectEquals(target.getNumLoadedFiles(), NumItems, "wrong number of files after loading");
+		expectEquals(target.indexOf(createReference(target, 0)), 0, "wrong index after loading");
+		expectEquals(target.getTextDataForId(1)[1], String("not loaded"), "other references were decompressed");
+
+		// loading a reference in the middle must not change the index of the others
+		target.loadFromReference(createReference(target, 2), PoolHelpers::LoadAndCacheWeak);
+
+		for (int i = 0; i < NumItems; i++)
+		{
+			auto expected = createReference(target, i).getReferenceString();
+
+			expectEquals(target.getReference(i).getReferenceString(), expected, "wrong reference order after loading");
+			expectEquals(target.indexOf(createReference(target, i)), i, "wrong index after loading");
+			expectEquals(target.getIdList()[i], expected, "wrong id list order after loading");
+		}
+
+		expectEquals(target.getTextDataForId(2)[0], createReference(target, 2).getReferenceString(), "wrong text data after loading");
+		expectEquals(target.getTextDataForId(3)[1], String("not loaded"), "wrong text data of pending reference");
+	}
+
+	void testReleaseItemsWithSameHash(MainController* mc)
+	{
+		beginTest("Testing release of items with the same hash code");
+
+		TemporaryFile tf(".xml");
+		tf.getFile().replaceWithText("<samplemap ID=\"Test\"/>");
+
+		PoolReference ref(mc, tf.getFile().getFullPathName(), FileHandlerBase::SampleMaps);
+
+		SharedPoolBase<ValueTree> pool(mc, &mc->getCurrentFileHandler());
+
+		auto first = pool.loadFromReference(ref, PoolHelpers::SkipPoolSearchWeak);
+		auto second = pool.loadFromReference(ref, PoolHelpers::SkipPoolSearchWeak);
+
+		expect(first.get() != second.get(), "items are not duplicates");
+		expectEquals(pool.getNumLoadedFiles(), 2, "wrong number of files");
+
+		second.clear();
+
+		expectEquals(pool.getNumLoadedFiles(), 1, "the released item is still in the pool");
+		expect(pool.getWeakReferenceToItem(ref).get() == first.get(), "the wrong item was released");
+	}
+};
+
+static SharedPoolTests sharedPoolTests;
+
+/** Checks the section comparison that is used to skip unchanged parts of the plugin state (see HISE_SKIP_UNCHANGED_STATE_RESTORE). */
+class StateRestoreTests : public UnitTest
+{
+public:
+
+	StateRestoreTests() :
+		UnitTest("Testing the unchanged state restore")
+	{};
+
+	void runTest() override
+	{
+		testSectionComparison();
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		testSkipUnchangedSection(bp);
+		testRestoreChangedSection(bp);
+	}
+
+private:
+
+	struct TestStateManager : public UserPresetStateManager
+	{
+		Identifier getUserPresetStateId() const override { RETURN_STATIC_IDENTIFIER("TestState"); }
+
+		void resetUserPresetState() override
+		{
+			value = 0;
+			numResets++;
+		}
+
+		ValueTree exportAsValueTree() const override
+		{
+			ValueTree v(getUserPresetStateId());
+			v.setProperty("Value", value, nullptr);
+			return v;
+		}
+
+		void restoreFromValueTree(const ValueTree& v) override
+		{
+			value = v["Value"];
+			numRestores++;
+		}
+
+		int value = 1;
+		int numRestores = 0;
+		int numResets = 0;
+	};
+
+	static ValueTree createSection(int value)
+	{
+		ValueTree v("TestState");
+		v.setProperty("Value", value, nullptr);
+		return v;
+	}
+
+	void testSectionComparison()
+	{
+		beginTest("Testing the section comparison");
+
+		using UPH = MainController::UserPresetHandler;
+
+		expect(UPH::isStateSectionUnchanged(createSection(1), createSection(1)), "equal sections");
+		expect(UPH::isStateSectionUnchanged({}, {}), "both sections missing");
+		expect(!UPH::isStateSectionUnchanged(createSection(1), createSection(2)), "different value");
+		expect(!UPH::isStateSectionUnchanged({}, createSection(1)), "missing in the restored state");
+		expect(!UPH::isStateSectionUnchanged(createSection(1), {}), "missing in the current state");
+
+		auto withChild = createSection(1);
+		withChild.addChild(ValueTree("Child"), -1, nullptr);
+
+		expect(!UPH::isStateSectionUnchanged(withChild, createSection(1)), "additional child");
+	}
+
+	void testSkipUnchangedSection(MainController* mc)
+	{
+		beginTest("Testing that an unchanged section is skipped");
+
+		auto& uph = mc->getUserPresetHandler();
+
+		TestStateManager m;
+		uph.addStateManager(&m);
+
+		ValueTree preset("Preset");
+		uph.saveStateManager(preset, m.getUserPresetStateId());
+
+		expect(!uph.restoreStateManagerIfChanged(preset, m.getUserPresetStateId()), "the section was restored");
+		expectEquals(m.numRestores, 0, "restore function was called");
+		expectEquals(m.numResets, 0, "reset function was called");
+
+		uph.removeStateManager(&m);
+	}
+
+	void testRestoreChangedSection(MainController* mc)
+	{
+		beginTest("Testing that a changed section is restored");
+
+		auto& uph = mc->getUserPresetHandler();
+
+		TestStateManager m;
+		uph.addStateManager(&m);
+
+		ValueTree preset("Preset");
+		preset.addChild(createSection(5), -1, nullptr);
+
+		expect(uph.restoreStateManagerIfChanged(preset, m.getUserPresetStateId()), "the changed section was skipped");
+		expectEquals(m.numRestores, 1, "restore function wasn't called");
+		expectEquals(m.value, 5, "value wasn't restored");
+
+		// A section that is missing in the preset must reset the current state
+		expect(uph.restoreStateManagerIfChanged(ValueTree("Preset"), m.getUserPresetStateId()), "the missing section was skipped");
+		expectEquals(m.numResets, 1, "reset function wasn't called");
+		expectEquals(m.value, 0, "value wasn't reset");
+
+		uph.removeStateManager(&m);
+	}
+};
+
+static StateRestoreTests stateRestoreTests;
+
+namespace hise
+{
+
+/** Feeds synthetic load values into the render budget governor and checks the level changes. */
+class RenderBudgetGovernorTests : public UnitTest
+{
+public:
+
+	RenderBudgetGovernorTests() :
+		UnitTest("Testing the render budget governor")
+	{};
+
+	static constexpr int BlockSize = 512;
+	static constexpr double SampleRate = 44100.0;
+	static constexpr double BlockDuration = (double)BlockSize / SampleRate;
+
+	static void feed(RenderBudgetGovernor& g, float load, int numBlocks = 1)
+	{
+		for (int i = 0; i < numBlocks; i++)
+			g.processBlockFinished((double)load * BlockDuration, BlockSize, SampleRate);
+	}
+
+	static int getNumBlocks(double seconds)
+	{
+		return (int)std::ceil(seconds / BlockDuration);
+	}
+
+	void runTest() override
+	{
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		testEscalationHold(bp->getRenderBudgetGovernor());
+		testRelease(bp->getRenderBudgetGovernor());
+		testPeakWindow(bp->getRenderBudgetGovernor());
+		testBlockedEffectToggle(bp);
+	}
+
+private:
+
+	void init(RenderBudgetGovernor& g)
+	{
+		g.setEnabled(false);
+		g.setEnabled(true);
+		g.setLevelThresholds({ 0.5f, 0.6f, 0.7f });
+		g.setReleaseBehaviour(0.1f, 0.1);
+		g.setEscalationHoldTime(0.05);
+		g.setPolicyOrder({ RenderBudgetGovernor::Policy::KillReleasingVoices,
+						   RenderBudgetGovernor::Policy::ReduceInterpolationQuality,
+						   RenderBudgetGovernor::Policy::BypassOptionalEffects });
+
+		expectEquals(g.getCurrentLevel(), 0, "initial level");
+	}
+
+	void testEscalationHold(RenderBudgetGovernor& g)
+	{
+		beginTest("Testing the escalation hold time");
+
+		init(g);
+
+		auto numHoldBlocks = getNumBlocks(0.05);
+
+		feed(g, 0.55f, numHoldBlocks - 1);
+		expectEquals(g.getCurrentLevel(), 0, "escalated before the hold time");
+
+		feed(g, 0.55f);
+		expectEquals(g.getCurrentLevel(), 1, "not escalated after the hold time");
+		expect(g.isPolicyActive(RenderBudgetGovernor::Policy::KillReleasingVoices), "first policy not active");
+
+		// The next level needs its own hold time
+		feed(g, 0.65f, numHoldBlocks - 1);
+		expectEquals(g.getCurrentLevel(), 1, "escalated twice within the hold time");
+
+		feed(g, 0.65f);
+		expectEquals(g.getCurrentLevel(), 2, "second level not reached");
+
+		// A short spike must not escalate
+		feed(g, 0.1f, 2);
+		feed(g, 0.8f, 2);
+		feed(g, 0.65f);
+		expectEquals(g.getCurrentLevel(), 2, "short spike escalated");
+	}
+
+	void testRelease(RenderBudgetGovernor& g)
+	{
+		beginTest("Testing the release hold time");
+
+		init(g);
+
+		feed(g, 0.55f, getNumBlocks(0.05));
+		expectEquals(g.getCurrentLevel(), 1, "level not reached");
+
+		// The load must fall below the threshold minus the hysteresis and stay there for the hold time
+		int numBlocksBelow = 0;
+		int numBlocks = 0;
+
+		while (g.getCurrentLevel() == 1 && numBlocks++ < 1000)
+		{
+			feed(g, 0.1f);
+
+			if (g.getCurrentLoad() < 0.4f)
+				numBlocksBelow++;
+		}
+
+		expectEquals(g.getCurrentLevel(), 0, "level not released");
+		expect(numBlocksBelow >= getNumBlocks(0.1), "released before the hold time: " + String(numBlocksBelow));
+		expect(numBlocksBelow <= getNumBlocks(0.1) + 1, "released too late: " + String(numBlocksBelow));
+
+		// A load between the threshold and the hysteresis must not release the level
+		init(g);
+		feed(g, 0.55f, getNumBlocks(0.05));
+		feed(g, 0.45f, getNumBlocks(2.0));
+		expectEquals(g.getCurrentLevel(), 1, "released within the hysteresis");
+	}
+
+	void testPeakWindow(RenderBudgetGovernor& g)
+	{
+		beginTest("Testing the peak load window");
+
+		init(g);
+
+		feed(g, 0.9f);
+		expectWithinAbsoluteError(g.getPeakLoad(), 0.9f, 0.001f, "peak not measured");
+
+		feed(g, 0.1f, getNumBlocks(RenderBudgetGovernor::PeakWindowSeconds));
+		expectWithinAbsoluteError(g.getPeakLoad(), 0.9f, 0.001f, "peak of the last window was dropped");
+
+		feed(g, 0.1f, getNumBlocks(RenderBudgetGovernor::PeakWindowSeconds));
+		expectWithinAbsoluteError(g.getPeakLoad(), 0.1f, 0.001f, "peak didn't decay");
+	}
+
+	void testBlockedEffectToggle(MainController* mc)
+	{
+		beginTest("Testing the retry of a blocked effect toggle");
+
+		auto& g = mc->getRenderBudgetGovernor();
+
+		init(g);
+		g.setPolicyOrder({ RenderBudgetGovernor::Policy::BypassOptionalEffects,
+						   RenderBudgetGovernor::Policy::KillReleasingVoices,
+						   RenderBudgetGovernor::Policy::ReduceInterpolationQuality });
+
+		ScopedPointer<GainEffect> fx = new GainEffect(mc, "OptionalGain");
+		g.setOptionalEffect(fx, true);
+
+		auto isBypassing = [&]() { return fx->isSoftBypassed() || fx->isFadeOutPending(); };
+
+		{
+			// Hold the lock on another thread like a concurrent setOptionalEffect() call
+			WaitableEvent locked, release;
+
+			std::thread t([&]()
+			{
+				SimpleReadWriteLock::ScopedWriteLock sl(g.optionalEffectLock);
+				locked.signal();
+				release.wait(5000);
+			});
+
+			locked.wait(5000);
+
+			feed(g, 0.55f, getNumBlocks(0.05) + 5);
+
+			expectEquals(g.getCurrentLevel(), 0, "level changed while the effects are locked");
+			expect(!g.isPolicyActive(RenderBudgetGovernor::Policy::BypassOptionalEffects), "policy active without the effect toggle");
+			expect(!isBypassing(), "effect was bypassed");
+
+			release.signal();
+			t.join();
+		}
+
+		// The next block must retry the toggle
+		feed(g, 0.55f);
+
+		expectEquals(g.getCurrentLevel(), 1, "toggle wasn't retried");
+		expect(g.isPolicyActive(RenderBudgetGovernor::Policy::BypassOptionalEffects), "policy not active");
+		expect(isBypassing(), "effect wasn't bypassed");
+
+		g.setOptionalEffect(fx, false);
+		g.setEnabled(false);
+	}
+};
+
+static RenderBudgetGovernorTests renderBudgetGovernorTests;
+
+}
+
+/** Records a few blocks with notes, replays the log in another instance and compares the rendered output. */
+class RenderInputTests : public UnitTest
+{
+public:
+
+	RenderInputTests() :
+		UnitTest("Testing the render input recorder")
+	{};
+
+	static constexpr int BlockSize = 512;
+	static constexpr int NumBlocks = 64;
+
+	static BackendProcessor* createProcessor()
+	{
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		ScopedPointer<NoiseSynth> noiseSynth = new NoiseSynth(bp, "TestSynth", NUM_POLYPHONIC_VOICES);
+
+		noiseSynth->addProcessorsWhenEmpty();
+
+		// The white noise is random so we use a deterministic test signal
+		noiseSynth->setTestSignal(NoiseSynth::Ramp);
+
+		bp->getMainSynthChain()->getHandler()->add(noiseSynth.release(), nullptr);
+		bp->prepareToPlay(44100.0, BlockSize);
+
+		return bp.release();
+	}
+
+	void runTest() override
+	{
+		auto logFile = File::createTempFile("hiserec");
+
+		AudioSampleBuffer recorded(2, NumBlocks * BlockSize);
+		recorded.clear();
+
+		{
+			beginTest("Testing the recording");
+
+			ScopedPointer<BackendProcessor> bp = createProcessor();
+
+			auto r = bp->getRenderInputRecorder().startRecording(logFile);
+			expect(r.wasOk(), r.getErrorMessage());
+
+			for (int i = 0; i < NumBlocks; i++)
+			{
+				MidiBuffer mb;
+
+				if (i == 2)
+					mb.addEvent(MidiMessage::noteOn(1, 64, 1.0f), 100);
+
+				if (i == 3)
+					mb.addEvent(MidiMessage::noteOn(1, 67, 0.5f), 0);
+
+				if (i == 20)
+					mb.addEvent(MidiMessage::noteOff(1, 64), 300);
+
+				if (i == 40)
+					mb.addEvent(MidiMessage::noteOff(1, 67), 17);
+
+				AudioSampleBuffer b(recorded.getArrayOfWritePointers(), 2, i * BlockSize, BlockSize);
+				bp->processBlock(b, mb);
+			}
+
+			bp->getRenderInputRecorder().stopRecording();
+
+			expect(recorded.getMagnitude(0, recorded.getNumSamples()) > 0.0f, "no signal was rendered");
+		}
+
+		{
+			beginTest("Testing the playback");
+
+			ScopedPointer<BackendProcessor> bp = createProcessor();
+
+			AudioSampleBuffer replayed;
+
+			RenderInputPlayer::Options options;
+			options.renderOffline = true;
+			options.paceInRealtime = false;
+			options.renderedOutput = &replayed;
+
+			RenderInputPlayer player(bp);
+			auto r = player.replay(logFile, options);
+
+			expect(r.wasOk(), r.getErrorMessage());
+			expectEquals(player.getTimings().size(), NumBlocks, "block amount mismatch");
+			expectEquals(replayed.getNumSamples(), recorded.getNumSamples(), "sample amount mismatch");
+
+			if (replayed.getNumSamples() == recorded.getNumSamples())
+			{
+				for (int c = 0; c < 2; c++)
+				{
+					for (int i = 0; i < recorded.getNumSamples(); i++)
+					{
+						auto expected = recorded.getSample(c, i);
+						auto actual = replayed.getSample(c, i);
+
+						if (std::abs(expected - actual) > 1e-6f)
+						{
+							expectEquals(actual, expected, "sample mismatch at channel " + String(c) + ", index " + String(i));
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		{
+			beginTest("Testing the project mismatch");
+
+			ScopedPointer<BackendProcessor> bp = createProcessor();
+			bp->getMainSynthChain()->getHandler()->getProcessor(0)->setId("OtherSynth");
+
+			RenderInputPlayer::Options options;
+			options.renderOffline = true;
+			options.paceInRealtime = false;
+
+			RenderInputPlayer player(bp);
+			auto r = player.replay(logFile, options);
+
+			expect(r.failed(), "the log was replayed with another module tree");
+			expect(r.getErrorMessage().contains("TestSynth"), "missing processor not reported: " + r.getErrorMessage());
+			expect(r.getErrorMessage().contains("OtherSynth"), "unknown processor not reported: " + r.getErrorMessage());
+			expect(player.getTimings().isEmpty(), "blocks were rendered");
+		}
+
+		logFile.deleteFile();
+	}
+};
+
+static RenderInputTests renderInputTests;
+
 
 
 #endif
@@ -3738,6 +3738,7 @@ void ScriptBroadcaster::sendMessageInternal(var args, bool isSync)
 
 ScriptBroadcaster::DelayedFunction::DelayedFunction(ScriptBroadcaster* b, var f, const Array<var>& args_,
 	int milliSeconds, const var& thisObj):
+	Client(&b->getScriptProcessor()->getMainController_()->getTimingWheel()),
 	c(b->getScriptProcessor(), b, f, 0),
 	bc(b),
 	args(args_)
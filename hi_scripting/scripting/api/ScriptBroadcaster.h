@@ -265,7 +265,7 @@ private:
 	bool enableQueue = false;
 	bool forceSend = false;
 
-	struct DelayedFunction : public Timer
+	struct DelayedFunction : public TimingWheel::Client
 	{
 		DelayedFunction(ScriptBroadcaster* b, var f, const Array<var>& args_, int milliSeconds, const var& thisObj);
 
@@ -3091,6 +3091,8 @@ void ScriptedControlAudioParameter::setValue(float newValue)
 {
 	if (scriptProcessor.get() != nullptr)
 	{
+		dynamic_cast<MainController*>(parentProcessor)->getRenderInputRecorder().recordParameterChange(getParameterIndex(), newValue);
+
 		bool *enableUpdate = &dynamic_cast<MainController*>(parentProcessor)->getPluginParameterUpdateState();
 
 		if (enableUpdate)
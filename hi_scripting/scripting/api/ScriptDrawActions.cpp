@@ -39,6 +39,7 @@ struct ScriptedPostDrawActions
 		guassianBlur(int b) : blurAmount(b) {};
 
 		bool needsStackData() const override { return false; }
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(dispatch::HashedCharPtr("gaussianBlur"), blurAmount); }
 		void perform(PostGraphicsRenderer& r) override
 		{
 			r.gaussianBlur(blurAmount);
@@ -52,6 +53,7 @@ struct ScriptedPostDrawActions
 		boxBlur(int b) : blurAmount(b) {};
 
 		bool needsStackData() const override { return false; }
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(dispatch::HashedCharPtr("boxBlur"), blurAmount); }
 		void perform(PostGraphicsRenderer& r) override
 		{
 			r.boxBlur(blurAmount);
@@ -65,6 +67,7 @@ struct ScriptedPostDrawActions
 		desaturate() {};
 
 		bool needsStackData() const override { return false; }
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(dispatch::HashedCharPtr("desaturate")); }
 		void perform(PostGraphicsRenderer& r) override
 		{
 			r.desaturate();
@@ -85,6 +88,8 @@ struct ScriptedPostDrawActions
 
 		SET_ACTION_ID(addNoise);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), noise, scale, area, monochrom); }
+
 		void perform(Graphics& g) override
 		{
 			m->drawNoiseMap(g, area, noise, monochrom, scale);
@@ -112,6 +117,7 @@ struct ScriptedPostDrawActions
 		{}
 
 		bool needsStackData() const override { return false; }
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(dispatch::HashedCharPtr("applyHSL"), h, s, l); }
 
 		void perform(PostGraphicsRenderer& r) override
 		{
@@ -130,6 +136,7 @@ struct ScriptedPostDrawActions
 		{}
 
 		bool needsStackData() const override { return false; }
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(dispatch::HashedCharPtr("applyGradientMap"), c1, c2); }
 
 		void perform(PostGraphicsRenderer& r) override
 		{
@@ -146,6 +153,7 @@ struct ScriptedPostDrawActions
 		{}
 
 		bool needsStackData() const override { return false; }
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(dispatch::HashedCharPtr("applyGamma"), gamma); }
 
 		void perform(PostGraphicsRenderer& r) override
 		{
@@ -162,6 +170,7 @@ struct ScriptedPostDrawActions
 		{}
 
 		bool needsStackData() const override { return false; }
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(dispatch::HashedCharPtr("applySharpness"), delta); }
 
 		void perform(PostGraphicsRenderer& r) override
 		{
@@ -180,6 +189,7 @@ struct ScriptedPostDrawActions
 		{}
 
 		bool needsStackData() const override { return false; }
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(dispatch::HashedCharPtr("applyVignette"), amount, radius, falloff); }
 
 		void perform(PostGraphicsRenderer& r) override
 		{
@@ -194,6 +204,7 @@ struct ScriptedPostDrawActions
 		applySepia() = default;
 
 		bool needsStackData() const override { return false; }
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(dispatch::HashedCharPtr("applySepia")); }
 
 		void perform(PostGraphicsRenderer& r) override
 		{
@@ -206,6 +217,7 @@ struct ScriptedPostDrawActions
 		applyMask(const Path& p, bool i) : path(p), invert(i) {};
 
 		bool needsStackData() const override { return true; }
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(dispatch::HashedCharPtr("applyMask"), path, invert); }
 		void perform(PostGraphicsRenderer& r) override
 		{
 			
@@ -224,6 +236,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(fillAll);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), c); }
+
 		fillAll(Colour c_) : c(c_) {};
 		void perform(Graphics& g) { g.fillAll(c); };
 		Colour c;
@@ -233,6 +247,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(setColour);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), c); }
+
 		setColour(Colour c_) : c(c_) {};
 		void perform(Graphics& g) { g.setColour(c); };
 		Colour c;
@@ -242,6 +258,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(addTransform);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), a); }
+
 		addTransform(AffineTransform a_) : a(a_) {};
 		void perform(Graphics& g) override { g.addTransform(a); };
 		AffineTransform a;
@@ -251,6 +269,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(fillPath);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), p); }
+
 		fillPath(const Path& p_) : p(p_) {};
 		void perform(Graphics& g) override { g.fillPath(p); };
 		Path p;
@@ -260,6 +280,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawPath);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), p, s); }
+
 		drawPath(const Path& p_, PathStrokeType strokeType) : p(p_), s(strokeType) {};
 		void perform(Graphics& g) override
 		{
@@ -300,6 +322,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(fillRect);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), area); }
+
 		fillRect(Rectangle<float> area_) : area(area_) {};
 		void perform(Graphics& g) { g.fillRect(area); };
 		Rectangle<float> area;
@@ -309,6 +333,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(fillEllipse);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), area); }
+
 		fillEllipse(Rectangle<float> area_) : area(area_) {};
 		void perform(Graphics& g) { g.fillEllipse(area); };
 		Rectangle<float> area;
@@ -318,6 +344,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawRect);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), area, borderSize); }
+
 		drawRect(Rectangle<float> area_, float borderSize_) : area(area_), borderSize(borderSize_) {};
 		void perform(Graphics& g) { g.drawRect(area, borderSize); };
 		Rectangle<float> area;
@@ -328,6 +356,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawEllipse);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), area, borderSize); }
+
 		drawEllipse(Rectangle<float> area_, float borderSize_) : area(area_), borderSize(borderSize_) {};
 		void perform(Graphics& g) { g.drawEllipse(area, borderSize); };
 		Rectangle<float> area;
@@ -338,6 +368,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(fillRoundedRect);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), area, cornerSize, allRounded, rounded[0], rounded[1], rounded[2], rounded[3]); }
+
 		fillRoundedRect(Rectangle<float> area_, float cornerSize_) :
 			area(area_), cornerSize(cornerSize_) {};
 		void perform(Graphics& g) 
@@ -367,6 +399,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawRoundedRectangle);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), area, cornerSize, borderSize, allRounded, rounded[0], rounded[1], rounded[2], rounded[3]); }
+
 		drawRoundedRectangle(Rectangle<float> area_, float borderSize_, float cornerSize_) :
 			area(area_), borderSize(borderSize_), cornerSize(cornerSize_) {};
 		void perform(Graphics& g) 
@@ -413,6 +447,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawImageWithin);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), img, r, placement); }
+
 		drawImageWithin(const Image& img_, Rectangle<float> r_, RectanglePlacement p=RectanglePlacement::centred) :
 			img(img_), r(r_), placement(p) {};
 
@@ -433,6 +469,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawImage);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), img, r, scaleFactor, yOffset); }
+
 		drawImage(const Image& img_, Rectangle<float> r_, float scaleFactor_, int yOffset_) :
 			img(img_), r(r_), scaleFactor(scaleFactor_), yOffset(yOffset_) {};
 
@@ -454,6 +492,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawHorizontalLine);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), y, x1, x2); }
+
 		drawHorizontalLine(int y_, float x1_, float x2_) :
 			y(y_), x1(x1_), x2(x2_) {};
 		void perform(Graphics& g) { g.drawHorizontalLine(y, x1, x2); };
@@ -464,6 +504,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawVerticalLine);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), x, y1, y2); }
+
 		drawVerticalLine(int x_, float y1_, float y2_) :
 			x(x_), y1(y1_), y2(y2_) {};
 		void perform(Graphics& g) { g.drawVerticalLine(x, y1, y2); };
@@ -474,6 +516,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(setOpacity);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), alpha); }
+
 		setOpacity(float alpha_) :
 			alpha(alpha_) {};
 		void perform(Graphics& g) { g.setOpacity(alpha); };
@@ -484,6 +528,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawLine);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), x1, x2, y1, y2, lineThickness); }
+
 		drawLine(float x1_, float x2_, float y1_, float y2_, float lineThickness_) :
 			x1(x1_), x2(x2_), y1(y1_), y2(y2_), lineThickness(lineThickness_) {};
 		void perform(Graphics& g) { g.drawLine(x1, x2, y1, y2, lineThickness); };
@@ -494,6 +540,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(setFont);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), f); }
+
 		setFont(Font f_) : f(f_) {};
 		void perform(Graphics& g) { g.setFont(f); };
 		Font f;
@@ -503,6 +551,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(setGradientFill);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), grad); }
+
 		setGradientFill(ColourGradient grad_) : grad(grad_) {};
 		void perform(Graphics& g) { g.setGradientFill(grad); };
 		ColourGradient grad;
@@ -512,6 +562,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawText);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), text, area, j); }
+
 		drawText(const String& text_, Rectangle<float> area_, Justification j_ = Justification::centred) : text(text_), area(area_), j(j_) {};
 		void perform(Graphics& g) override { g.drawText(text, area, j); };
 		String text;
@@ -523,6 +575,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawTextShadow);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), text, area, j, sp); }
+
 		drawTextShadow(const String& text_, Rectangle<float> area_, Justification j_ = Justification::centred, const melatonin::ShadowParameters& sp_={}) : text(text_), area(area_), j(j_), sp(sp_)
 		{
 			if(sp.inner)
@@ -551,6 +605,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawFittedText);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), text, area, j, maxLines, scale); }
+
 		drawFittedText(const String& text_, var area_, Justification j_, int maxLines_, float scale_ = Justification::centred) : text(text_), area(area_), j(j_), maxLines(maxLines_), scale(scale_) {};
 		void perform(Graphics& g) override { g.drawFittedText(text, area[0], area[1], area[2], area[3], j, maxLines, scale); };
 		String text;
@@ -564,6 +620,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawMultiLineText);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), text, startX, baseLineY, maxWidth, j, leading); }
+
 		drawMultiLineText(const String& text_, int startX_, int baseLineY_, int maxWidth_, Justification j_ = Justification::centred, float leading_ = 0.0f) : text(text_), startX(startX_), baseLineY(baseLineY_), maxWidth(maxWidth_), j(j_), leading(leading_) {};
 		void perform(Graphics& g) override { g.drawMultiLineText(text, startX, baseLineY, maxWidth, j, leading); };
 		String text;
@@ -578,6 +636,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawDropShadow);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), r, shadow); }
+
 		drawDropShadow(Rectangle<int> r_, DropShadow& shadow_) : r(r_), shadow(shadow_) {};
 		void perform(Graphics& g) override { shadow.drawForRectangle(g, r); };
 		Rectangle<int> r;
@@ -588,6 +648,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(addDropShadowFromAlpha);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), shadow); }
+
 		addDropShadowFromAlpha(const DropShadow& shadow_) : shadow(shadow_) {};
 
 		bool wantsCachedImage() const override { return true; };
@@ -626,6 +688,8 @@ namespace ScriptedDrawActions
 	{
 		SET_ACTION_ID(drawDropShadowFromPath);
 
+		uint64 getContentHash() const override { return DrawActions::ContentHash::create(getDispatchId(), p, area, c, radius); }
+
 		drawDropShadowFromPath(const Path& p_, Rectangle<float> a, Colour c_, int r_) :
 			p(p_),
 			c(c_),
@@ -672,6 +736,20 @@ namespace ScriptedDrawActions
     {
 		SET_ACTION_ID(drawSVG);
 
+		uint64 getContentHash() const override
+		{
+			auto obj = dynamic_cast<ScriptingObjects::SVGObject*>(svg.getObject());
+
+			// Use the hash of the SVG data instead of the object address (which might be reused)
+			if (obj == nullptr)
+				return 0;
+
+			return DrawActions::ContentHash::create(getDispatchId(), obj->getContentHash(), bounds, opacity);
+		}
+
+		// The SVG is a Drawable component that must be resized on the message thread
+		bool canBeRenderedOnBackgroundThread() const override { return false; }
+
         drawSVG(var svgObject, Rectangle<float> bounds_, float opacity_):
            svg(svgObject),
            bounds(bounds_),
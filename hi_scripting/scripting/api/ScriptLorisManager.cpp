@@ -38,9 +38,11 @@ struct ScriptLorisManager::Wrapper
     API_VOID_METHOD_WRAPPER_2(ScriptLorisManager, set);
     API_METHOD_WRAPPER_1(ScriptLorisManager, get);
     API_METHOD_WRAPPER_2(ScriptLorisManager, analyse);
+    API_METHOD_WRAPPER_2(ScriptLorisManager, analyseMultiple);
     API_METHOD_WRAPPER_1(ScriptLorisManager, synthesise);
     API_VOID_METHOD_WRAPPER_3(ScriptLorisManager, process);
     API_VOID_METHOD_WRAPPER_2(ScriptLorisManager, processCustom);
+    API_VOID_METHOD_WRAPPER_2(ScriptLorisManager, processCustomBatch);
     
     API_METHOD_WRAPPER_3(ScriptLorisManager, createEnvelopes);
     API_METHOD_WRAPPER_3(ScriptLorisManager, createEnvelopePaths);
@@ -66,9 +68,11 @@ ScriptLorisManager::ScriptLorisManager(ProcessorWithScriptingContent* p):
     ADD_API_METHOD_2(set);
     ADD_API_METHOD_1(get);
     ADD_API_METHOD_2(analyse);
+    ADD_API_METHOD_2(analyseMultiple);
     ADD_API_METHOD_1(synthesise);
     ADD_API_METHOD_3(process);
     ADD_API_METHOD_2(processCustom);
+    ADD_API_METHOD_2(processCustomBatch);
     
     ADD_API_METHOD_3(createEnvelopes);
     ADD_API_METHOD_3(createEnvelopePaths);
@@ -90,6 +94,33 @@ bool ScriptLorisManager::analyse(var file, double rootFrequency)
     return false;
 }
 
+bool ScriptLorisManager::analyseMultiple(var files, var estimatedRootFrequencies)
+{
+    initThreadController();
+
+    auto fileList = files.getArray();
+    auto rootList = estimatedRootFrequencies.getArray();
+
+    if(fileList == nullptr || rootList == nullptr || fileList->size() != rootList->size())
+    {
+        reportScriptError("You need to pass in two arrays with the same size");
+        return false;
+    }
+
+    Array<LorisManager::AnalyseData> data;
+
+    for(int i = 0; i < fileList->size(); i++)
+    {
+        if(auto sf = dynamic_cast<ScriptingObjects::ScriptFile*>((*fileList)[i].getObject()))
+            data.add({sf->f, (double)(*rootList)[i]});
+        else
+            reportScriptError("Element " + String(i) + " is not a file");
+    }
+
+    lorisManager->analyse(data);
+    return true;
+}
+
 var ScriptLorisManager::synthesise(var file)
 {
     initThreadController();
@@ -132,6 +163,29 @@ void ScriptLorisManager::processCustom(var file, var processCallback)
     }
 }
 
+void ScriptLorisManager::processCustomBatch(var file, var processCallback)
+{
+    initThreadController();
+
+    processFunction = WeakCallbackHolder(getScriptProcessor(), this, processCallback, 1);
+
+    if(auto sf = dynamic_cast<ScriptingObjects::ScriptFile*>(file.getObject()))
+    {
+        lorisManager->processCustomBatch(sf->f, [&](LorisManager::CustomBatchPOD& data)
+        {
+            auto obj = data.toJSON();
+            auto ok = processFunction.callSync(&obj, 1);
+            
+            if(!ok.wasOk())
+                reportScriptError(ok.getErrorMessage());
+            
+            data.writeJSON(obj);
+            
+            return false;
+        });
+    }
+}
+
 juce::var ScriptLorisManager::createEnvelopes(juce::var file, juce::String parameter, int harmonicIndex)
 {
     initThreadController();
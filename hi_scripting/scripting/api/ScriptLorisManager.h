@@ -61,12 +61,18 @@ public:
     /** Analyse a file. */
     bool analyse(var file, double estimatedRootFrequency);
     
+    /** Analyses multiple files in parallel. Pass in an array of files and an array with the root frequency of each file. */
+    bool analyseMultiple(var files, var estimatedRootFrequencies);
+    
     /** Processes the partial list using predefined commands. */
     void process(var file, String command, var data);
     
     /** Processes the partial list using the given function. */
     void processCustom(var file, var processCallback);
     
+    /** Processes the partial list using the given function that is called once per partial with arrays of all breakpoint values. */
+    void processCustomBatch(var file, var processCallback);
+    
     /** Resynthesise the file from the partial lists. Returns an array of variant buffers. */
     var synthesise(var file);
     
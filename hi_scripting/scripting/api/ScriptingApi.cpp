@@ -1183,6 +1183,7 @@ struct ScriptingApi::Engine::Wrapper
 	API_METHOD_WRAPPER_0(Engine, createUnorderedStack);
 	API_METHOD_WRAPPER_0(Engine, createThreadSafeStorage);
 	API_METHOD_WRAPPER_0(Engine, createTimerObject);
+	API_METHOD_WRAPPER_0(Engine, getTimerStatistics);
 	API_METHOD_WRAPPER_0(Engine, createMessageHolder);
 	API_METHOD_WRAPPER_0(Engine, createTransportHandler);
 	API_METHOD_WRAPPER_0(Engine, createMidiAutomationHandler);
@@ -1230,6 +1231,7 @@ struct ScriptingApi::Engine::Wrapper
 	API_METHOD_WRAPPER_0(Engine, createErrorHandler);
 	API_METHOD_WRAPPER_1(Engine, createModulationMatrix);
 	API_METHOD_WRAPPER_0(Engine, createMacroHandler);
+	API_METHOD_WRAPPER_0(Engine, createRenderBudgetGovernor);
 	API_METHOD_WRAPPER_0(Engine, getWavetableList);
 	API_VOID_METHOD_WRAPPER_3(Engine, showYesNoWindow);
 	API_VOID_METHOD_WRAPPER_1(Engine, addModuleStateToUserPreset);
@@ -1323,6 +1325,7 @@ parentMidiProcessor(dynamic_cast<ScriptBaseMidiProcessor*>(p))
 	ADD_API_METHOD_0(createUserPresetHandler);
 	ADD_API_METHOD_0(createMidiAutomationHandler);
 	ADD_API_METHOD_0(createMacroHandler);
+	ADD_API_METHOD_0(createRenderBudgetGovernor);
   ADD_API_METHOD_1(loadNextUserPreset);
 	ADD_API_METHOD_1(loadPreviousUserPreset);
 	ADD_API_METHOD_1(isUserPresetReadOnly);
@@ -1371,6 +1374,7 @@ parentMidiProcessor(dynamic_cast<ScriptBaseMidiProcessor*>(p))
 	ADD_API_METHOD_1(isControllerUsedByAutomation);
 	ADD_API_METHOD_0(getSettingsWindowObject);
 	ADD_API_METHOD_0(createTimerObject);
+	ADD_API_METHOD_0(getTimerStatistics);
 	ADD_API_METHOD_0(createMessageHolder);
 	ADD_API_METHOD_1(createAndRegisterSliderPackData);
 	ADD_API_METHOD_1(createAndRegisterTableData);
@@ -3401,6 +3405,8 @@ hise::ScriptingObjects::ScriptRingBuffer* ScriptingApi::Engine::createAndRegiste
 
 ScriptingObjects::TimerObject* ScriptingApi::Engine::createTimerObject() { return new ScriptingObjects::TimerObject(getScriptProcessor()); }
 
+var ScriptingApi::Engine::getTimerStatistics() { return getScriptProcessor()->getMainController_()->getTimingWheel().getStatistics().toJSON(); }
+
 ScriptingObjects::ScriptingMessageHolder* ScriptingApi::Engine::createMessageHolder()
 {
 	return new ScriptingObjects::ScriptingMessageHolder(getScriptProcessor());
@@ -3426,6 +3432,11 @@ var ScriptingApi::Engine::createMacroHandler()
 	return new ScriptingObjects::ScriptedMacroHandler(getScriptProcessor());
 }
 
+var ScriptingApi::Engine::createRenderBudgetGovernor()
+{
+	return new ScriptingObjects::ScriptRenderBudgetGovernor(getScriptProcessor());
+}
+
 void ScriptingApi::Engine::dumpAsJSON(var object, String fileName)
 {
 	if (!object.isObject())
@@ -610,6 +610,9 @@ public:
 		/** Creates a new timer object. */
 		ScriptingObjects::TimerObject* createTimerObject();
 
+		/** Returns the number of active timers and how many timer callbacks were executed in the last second (and how long they took). */
+		var getTimerStatistics();
+
 		/** Creates a storage object for Message events. */
 		ScriptingObjects::ScriptingMessageHolder* createMessageHolder();
 
@@ -625,6 +628,9 @@ public:
 		/** Creates a macro handler that lets you programmatically change the macro connections. */
 		var createMacroHandler();
 
+		/** Creates an object that controls the render budget governor which reduces the CPU load under pressure. */
+		var createRenderBudgetGovernor();
+
 		/** Exports an object as JSON. */
 		void dumpAsJSON(var object, String fileName);
 
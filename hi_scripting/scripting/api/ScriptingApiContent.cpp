@@ -4094,6 +4094,14 @@ DrawActions::Handler* ScriptingApi::Content::ScriptPanel::getDrawActionHandler()
 	return nullptr;
 }
 
+var ScriptingApi::Content::ScriptPanel::getDrawCacheStatistics()
+{
+	if (auto dh = getDrawActionHandler())
+		return dh->getStatistics().toJSON();
+
+	return var();
+}
+
 struct ScriptingApi::Content::ScriptPanel::Wrapper
 {
 	API_VOID_METHOD_WRAPPER_0(ScriptPanel, repaint);
@@ -4120,6 +4128,7 @@ struct ScriptingApi::Content::ScriptPanel::Wrapper
 	API_METHOD_WRAPPER_0(ScriptPanel, removeFromParent);
 	API_METHOD_WRAPPER_0(ScriptPanel, getChildPanelList);
 	API_METHOD_WRAPPER_0(ScriptPanel, getParentPanel);
+	API_METHOD_WRAPPER_0(ScriptPanel, getDrawCacheStatistics);
 	API_VOID_METHOD_WRAPPER_1(ScriptPanel, setAnimation);
 	API_VOID_METHOD_WRAPPER_1(ScriptPanel, setAnimationFrame);
 	API_METHOD_WRAPPER_0(ScriptPanel, getAnimationData);
@@ -4161,6 +4170,8 @@ ScriptingApi::Content::ScriptPanel::ScriptPanel(ScriptPanel* parent) :
 
 void ScriptingApi::Content::ScriptPanel::init()
 {
+	setTimingWheel(&getScriptProcessor()->getMainController_()->getTimingWheel());
+
 	ADD_NUMBER_PROPERTY(i00, "borderSize");					ADD_AS_SLIDER_TYPE(0, 20, 1);
 	ADD_NUMBER_PROPERTY(i01, "borderRadius");				ADD_AS_SLIDER_TYPE(0, 20, 1);
 	ADD_SCRIPT_PROPERTY(i02, "opaque");						ADD_TO_TYPE_SELECTOR(SelectorTypes::ToggleSelector);
@@ -4231,6 +4242,7 @@ void ScriptingApi::Content::ScriptPanel::init()
 	ADD_API_METHOD_0(removeFromParent);
 	ADD_API_METHOD_0(getChildPanelList);
 	ADD_API_METHOD_0(getParentPanel);
+	ADD_API_METHOD_0(getDrawCacheStatistics);
 	ADD_API_METHOD_3(setMouseCursor);
 	ADD_API_METHOD_0(getAnimationData);
 	ADD_API_METHOD_1(setAnimation);
@@ -4936,6 +4948,17 @@ void ScriptingApi::Content::ScriptPanel::updateAnimationData()
 		obj->setProperty("currentFrame", animation->getCurrentFrame());
 		obj->setProperty("numFrames", animation->getNumFrames());
 		obj->setProperty("frameRate", animation->getFrameRate());
+
+		// The frame cache is shared between all animations
+		if (auto m = getScriptProcessor()->getMainController_()->getRLottieManager())
+		{
+			auto s = m->getFrameCacheStatistics();
+
+			obj->setProperty("cacheHitRate", s.getHitRate());
+			obj->setProperty("cachedBytes", s.numBytesUsed);
+			obj->setProperty("cacheBudget", s.budget);
+			obj->setProperty("numPrerenderedFrames", s.numPrerenderedFrames);
+		}
 	}
 	else
 	{
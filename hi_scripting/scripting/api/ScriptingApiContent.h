@@ -1719,7 +1719,7 @@ public:
 		/** Sets a frame to be displayed. */
 		void setAnimationFrame(int numFrame);
 
-		/** Returns a JSON object containing the data of the animation object. */
+		/** Returns a JSON object containing the data of the animation object (including the usage of the shared frame cache). */
 		var getAnimationData();
 
 		/** Sets a paint routine (a function with one parameter). */
@@ -1788,6 +1788,9 @@ public:
 		/** Returns the panel that this panel has been added to with addChildPanel. */
 		var getParentPanel();
 
+		/** Returns a JSON object with the hit / miss counters of the draw action cache. */
+		var getDrawCacheStatistics();
+
 		int getNumSubPanels() const;
 
 		ScriptPanel* getSubPanel(int index);
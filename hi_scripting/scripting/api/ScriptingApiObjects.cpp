@@ -3830,6 +3830,7 @@ struct ScriptingObjects::ScriptingSynth::Wrapper
 	API_METHOD_WRAPPER_3(ScriptingSynth, addStaticGlobalModulator);
 	API_METHOD_WRAPPER_0(ScriptingSynth, asSampler);
 	API_METHOD_WRAPPER_0(ScriptingSynth, getRoutingMatrix);
+	API_METHOD_WRAPPER_0(ScriptingSynth, getEnvelopeMemoryReport);
 	API_METHOD_WRAPPER_0(ScriptingSynth, getId);
 };
 
@@ -3872,6 +3873,7 @@ ScriptingObjects::ScriptingSynth::ScriptingSynth(ProcessorWithScriptingContent *
 	ADD_API_METHOD_3(addStaticGlobalModulator);
 	ADD_API_METHOD_0(asSampler);
 	ADD_API_METHOD_0(getRoutingMatrix);
+	ADD_API_METHOD_0(getEnvelopeMemoryReport);
 };
 
 
@@ -4121,6 +4123,17 @@ var ScriptingObjects::ScriptingSynth::getRoutingMatrix()
 	return var(r);
 }
 
+var ScriptingObjects::ScriptingSynth::getEnvelopeMemoryReport()
+{
+	if (checkValidObject())
+	{
+		if (auto gc = dynamic_cast<GlobalModulatorContainer*>(synth.get()))
+			return gc->getEnvelopeMemoryReport();
+	}
+
+	return var(); // don't complain here, handle it on scripting level
+}
+
 // ScriptingMidiProcessor ==============================================================================================================
 
 struct ScriptingObjects::ScriptingMidiProcessor::Wrapper
@@ -4701,7 +4714,7 @@ struct ScriptingObjects::TimerObject::Wrapper
 ScriptingObjects::TimerObject::TimerObject(ProcessorWithScriptingContent *p) :
 	ConstScriptingObject(p, 0),
 	ControlledObject(p->getMainController_(), true),
-	it(this),
+	it(this, p->getMainController_()->getTimingWheel()),
 	tc(p, this, {}, 0)
 {
 	ADD_API_METHOD_0(isTimerRunning);
@@ -5491,6 +5504,8 @@ ScriptingObjects::ScriptedMidiPlayer::ScriptedMidiPlayer(ProcessorWithScriptingC
 	ConstScriptingObject(p, 0),
 	updateCallback(p, this, var(), 1)
 {
+	setTimingWheel(&p->getMainController_()->getTimingWheel());
+
 	ADD_API_METHOD_0(getPlaybackPosition);
 	ADD_API_METHOD_1(setPlaybackPosition);
 	ADD_API_METHOD_1(getNoteRectangleList);
@@ -8817,6 +8832,140 @@ var ScriptingObjects::ScriptedMacroHandler::getCallbackArg(int macroIndex, Proce
 	return v;
 }
 
+struct ScriptingObjects::ScriptRenderBudgetGovernor::Wrapper
+{
+	API_VOID_METHOD_WRAPPER_1(ScriptRenderBudgetGovernor, setEnabled);
+	API_VOID_METHOD_WRAPPER_1(ScriptRenderBudgetGovernor, setLevelThresholds);
+	API_VOID_METHOD_WRAPPER_1(ScriptRenderBudgetGovernor, setPolicyOrder);
+	API_VOID_METHOD_WRAPPER_2(ScriptRenderBudgetGovernor, setReleaseBehaviour);
+	API_VOID_METHOD_WRAPPER_1(ScriptRenderBudgetGovernor, setEscalationHoldTime);
+	API_VOID_METHOD_WRAPPER_2(ScriptRenderBudgetGovernor, setOptionalEffect);
+	API_METHOD_WRAPPER_0(ScriptRenderBudgetGovernor, getState);
+	API_VOID_METHOD_WRAPPER_1(ScriptRenderBudgetGovernor, setLevelChangeCallback);
+};
+
+ScriptingObjects::ScriptRenderBudgetGovernor::ScriptRenderBudgetGovernor(ProcessorWithScriptingContent* sp):
+	ConstScriptingObject(sp, RenderBudgetGovernor::NumLevels),
+	levelChangeCallback(getScriptProcessor(), this, var(), 1)
+{
+	for (int i = 0; i < RenderBudgetGovernor::NumLevels; i++)
+		addConstant(RenderBudgetGovernor::getPolicyName((RenderBudgetGovernor::Policy)i), RenderBudgetGovernor::getPolicyName((RenderBudgetGovernor::Policy)i));
+
+	ADD_API_METHOD_1(setEnabled);
+	ADD_API_METHOD_1(setLevelThresholds);
+	ADD_API_METHOD_1(setPolicyOrder);
+	ADD_API_METHOD_2(setReleaseBehaviour);
+	ADD_API_METHOD_1(setEscalationHoldTime);
+	ADD_API_METHOD_2(setOptionalEffect);
+	ADD_API_METHOD_0(getState);
+	ADD_API_METHOD_1(setLevelChangeCallback);
+}
+
+ScriptingObjects::ScriptRenderBudgetGovernor::~ScriptRenderBudgetGovernor()
+{
+	getGovernor().levelBroadcaster.removeListener(*this);
+}
+
+RenderBudgetGovernor& ScriptingObjects::ScriptRenderBudgetGovernor::getGovernor()
+{
+	return getScriptProcessor()->getMainController_()->getRenderBudgetGovernor();
+}
+
+void ScriptingObjects::ScriptRenderBudgetGovernor::setEnabled(bool shouldBeEnabled)
+{
+	getGovernor().setEnabled(shouldBeEnabled);
+}
+
+void ScriptingObjects::ScriptRenderBudgetGovernor::setLevelThresholds(var thresholdArray)
+{
+	if (auto ar = thresholdArray.getArray())
+	{
+		Array<float> thresholds;
+
+		for (const auto& v : *ar)
+			thresholds.add((float)v);
+
+		getGovernor().setLevelThresholds(thresholds);
+	}
+	else
+		reportScriptError("You need to pass in an array of thresholds");
+}
+
+void ScriptingObjects::ScriptRenderBudgetGovernor::setPolicyOrder(var policyNames)
+{
+	if (auto ar = policyNames.getArray())
+	{
+		Array<RenderBudgetGovernor::Policy> order;
+
+		for (const auto& v : *ar)
+		{
+			auto p = RenderBudgetGovernor::getPolicyFromName(v.toString());
+
+			if (p == RenderBudgetGovernor::Policy::numPolicies)
+				reportScriptError("Unknown policy: " + v.toString());
+
+			order.addIfNotAlreadyThere(p);
+		}
+
+		if (order.size() != RenderBudgetGovernor::NumLevels)
+			reportScriptError("You need to specify every policy");
+
+		getGovernor().setPolicyOrder(order);
+	}
+	else
+		reportScriptError("You need to pass in an array of policy names");
+}
+
+void ScriptingObjects::ScriptRenderBudgetGovernor::setReleaseBehaviour(double hysteresis, double holdTimeSeconds)
+{
+	getGovernor().setReleaseBehaviour((float)hysteresis, holdTimeSeconds);
+}
+
+void ScriptingObjects::ScriptRenderBudgetGovernor::setEscalationHoldTime(double holdTimeSeconds)
+{
+	getGovernor().setEscalationHoldTime(holdTimeSeconds);
+}
+
+void ScriptingObjects::ScriptRenderBudgetGovernor::setOptionalEffect(String effectId, bool isOptional)
+{
+	auto p = ProcessorHelpers::getFirstProcessorWithName(getScriptProcessor()->getMainController_()->getMainSynthChain(), effectId);
+
+	if (dynamic_cast<MasterEffectProcessor*>(p) == nullptr)
+		reportScriptError(effectId + " is not a master effect");
+
+	getGovernor().setOptionalEffect(p, isOptional);
+}
+
+var ScriptingObjects::ScriptRenderBudgetGovernor::getState()
+{
+	return getGovernor().getStateObject();
+}
+
+void ScriptingObjects::ScriptRenderBudgetGovernor::setLevelChangeCallback(var callback)
+{
+	if (HiseJavascriptEngine::isJavascriptFunction(callback))
+	{
+		levelChangeCallback = WeakCallbackHolder(getScriptProcessor(), this, callback, 1);
+		levelChangeCallback.incRefCount();
+		levelChangeCallback.addAsSource(this, "onRenderBudgetLevelChange");
+		levelChangeCallback.setThisObject(this);
+
+		// Make sure that calling this method multiple times doesn't register the listener again
+		getGovernor().levelBroadcaster.removeListener(*this);
+
+		getGovernor().levelBroadcaster.addListener(*this, [](ScriptRenderBudgetGovernor& g, int newLevel)
+		{
+			g.onLevelChange(newLevel);
+		}, false);
+	}
+}
+
+void ScriptingObjects::ScriptRenderBudgetGovernor::onLevelChange(int)
+{
+	if (levelChangeCallback)
+		levelChangeCallback.call1(getState());
+}
+
 struct ScriptingObjects::ScriptedMidiAutomationHandler::Wrapper
 {
 	API_METHOD_WRAPPER_0(ScriptedMidiAutomationHandler, getAutomationDataObject);
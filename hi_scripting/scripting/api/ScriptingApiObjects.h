@@ -2211,6 +2211,9 @@ namespace ScriptingObjects
 		/** Returns a reference to the routing matrix object of the sound generator. */
 		var getRoutingMatrix();
 
+		/** Returns the memory usage of the global envelope voice storage (and how often a voice didn't get a slot) or undefined if the synth isn't a global modulator container. */
+		var getEnvelopeMemoryReport();
+
 		// ============================================================================================================ 
 
 		struct Wrapper;
@@ -2684,11 +2687,12 @@ namespace ScriptingObjects
 
 		struct Wrapper;
 
-		struct InternalTimer : public Timer
+		struct InternalTimer : public TimingWheel::Client
 		{
 		public:
 
-			InternalTimer(TimerObject* parent_):
+			InternalTimer(TimerObject* parent_, TimingWheel& wheel):
+				Client(&wheel),
 				parent(parent_)
 			{
 				
@@ -2784,6 +2788,58 @@ namespace ScriptingObjects
 		
 	};
 
+	class ScriptRenderBudgetGovernor : public ConstScriptingObject
+	{
+	public:
+
+		ScriptRenderBudgetGovernor(ProcessorWithScriptingContent* sp);
+
+		~ScriptRenderBudgetGovernor() override;
+
+		static Identifier getClassName() { RETURN_STATIC_IDENTIFIER("RenderBudgetGovernor"); };
+
+		Identifier getObjectName() const override { return getClassName(); }
+
+		// ============================================================================================================ API Methods
+
+		/** Enables or disables the render budget governor. */
+		void setEnabled(bool shouldBeEnabled);
+
+		/** Sets the CPU load thresholds (render time / buffer duration) for each level as array, eg. [0.75, 0.85, 0.95]. */
+		void setLevelThresholds(var thresholdArray);
+
+		/** Sets the order in which the policies are activated as array of policy names. */
+		void setPolicyOrder(var policyNames);
+
+		/** Sets the load amount that the load must drop below the threshold and the time in seconds it needs to stay there to deactivate a level. */
+		void setReleaseBehaviour(double hysteresis, double holdTimeSeconds);
+
+		/** Sets the time in seconds that the load needs to stay above the threshold to activate the next level. */
+		void setEscalationHoldTime(double holdTimeSeconds);
+
+		/** Marks the master effect with the given ID as optional so that it will be bypassed under pressure. */
+		void setOptionalEffect(String effectId, bool isOptional);
+
+		/** Returns an object with the current state of the governor. */
+		var getState();
+
+		/** Sets a callback with one argument (the state object) that will be executed whenever the level changes. */
+		void setLevelChangeCallback(var callback);
+
+		// ============================================================================================================
+
+	private:
+
+		void onLevelChange(int newLevel);
+
+		RenderBudgetGovernor& getGovernor();
+
+		struct Wrapper;
+		WeakCallbackHolder levelChangeCallback;
+
+		JUCE_DECLARE_WEAK_REFERENCEABLE(ScriptRenderBudgetGovernor);
+	};
+
 	class ScriptedMidiAutomationHandler : public ConstScriptingObject,
 									      public SafeChangeListener
 	{
@@ -880,7 +880,8 @@ Result ScriptingObjects::ScriptShader::processErrorMessage(const Result& r)
 }
 
 ScriptingObjects::SVGObject::SVGObject(ProcessorWithScriptingContent* p, const String& b64):
-  ConstScriptingObject(p, 0)
+  ConstScriptingObject(p, 0),
+  contentHash((uint64)b64.hashCode64())
 {
     zstd::ZDefaultCompressor comp;
     
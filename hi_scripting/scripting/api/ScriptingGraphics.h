@@ -239,8 +239,12 @@ namespace ScriptingObjects
         
         void draw(Graphics& g, Rectangle<float> r, float opacity=1.0f);
 
+        /** Returns a hash of the SVG data that is used by the draw action cache. */
+        uint64 getContentHash() const { return contentHash; }
+
     private:
         
+        const uint64 contentHash;
         Rectangle<float> currentBounds;
         std::unique_ptr<Drawable> svg;
 
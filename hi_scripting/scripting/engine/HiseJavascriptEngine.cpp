@@ -808,11 +808,15 @@ Result HiseJavascriptEngine::execute(const String& javascriptCode, bool allowCon
             loc.location = loc.program.getCharPointer() + ok.getErrorMessage().getIntValue();
             loc.throwError(ok.getErrorMessage().fromFirstOccurrenceOf(":", false, false));
         }
-#else
-        auto& copy = javascriptCode;
-#endif
 
 		root->execute(copy, allowConstDeclarations);
+#else
+		// Cache the tokens so that other instances of the plugin don't have to tokenise the callbacks again
+		String cacheKey = dynamic_cast<Processor*>(root->hiseSpecialData.processor)->getId();
+		cacheKey << "." << callbackIdTouse.toString();
+
+		root->execute(javascriptCode, allowConstDeclarations, cacheKey);
+#endif
 	}
 	catch (String &error)
 	{
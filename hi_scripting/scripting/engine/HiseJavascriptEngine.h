@@ -65,6 +65,99 @@ public:
 #endif
 };
 
+/** A cache for the tokens of included script files.
+
+	The included files are tokenised on worker threads while the engine scans the script for namespaces and
+	const declarations, so the parser just has to replay the tokens. The entries are keyed by the file name and
+	stay valid as long as the (preprocessed) content doesn't change, so a recompile with unchanged include files
+	(or another script processor that includes the same files) doesn't need to tokenise them again. Since the
+	content after the preprocessor is used as key, changing a preprocessor definition will invalidate the entry.
+
+	Every JavascriptProcessor holds a reference to the cache so that it stays alive between compilations.
+*/
+class HiseJavascriptTokenCache
+{
+public:
+
+	struct Token
+	{
+		const char* type;
+		String::CharPointerType location;
+		var value;
+		String comment;
+		bool hasValue;
+		bool hasComment;
+	};
+
+	/** The tokens of a file. They point directly into the code string of the entry, so the parser must use this string when it replays the tokens. */
+	struct Entry : public ReferenceCountedObject
+	{
+		using Ptr = ReferenceCountedObjectPtr<Entry>;
+
+		Entry(const String& code_, const String& fileName_);
+
+		/** Checks whether the entry was created from the given code. Pass in the hash code of the string so that it's only calculated once per lookup. */
+		bool matches(const String& otherCode, int64 otherHash) const;
+
+		/** Tokenises the code. If the code can't be tokenised, the parser will throw the error at the correct position. */
+		void tokenise();
+
+		/** Tokenises the code unless another thread has already started it and waits until the tokens are available. */
+		void tokeniseOrWait();
+
+		/** Writes the tokens into a binary snapshot (the token locations are stored as byte offsets into the code). */
+		MemoryBlock createSnapshot() const;
+
+		/** Restores the tokens from a snapshot. Returns nullptr if the snapshot doesn't belong to the code. */
+		static Ptr createFromSnapshot(const String& code, const String& fileName, const MemoryBlock& snapshot);
+
+		const String code;
+		const String fileName;
+		const int64 hash;
+
+		std::vector<Token> tokens;
+		bool ok = false;
+		double tokeniseTimeMs = 0.0;
+		std::atomic<int> numUses = { 0 };
+
+		std::atomic<bool> started = { false };
+		WaitableEvent done;
+	};
+
+	HiseJavascriptTokenCache();
+
+	~HiseJavascriptTokenCache();
+
+	/** Starts tokenising the file on a worker thread unless the code is already cached. */
+	void prefetch(const String& fileName, const String& code);
+
+	/** Returns the tokens for the code (waiting for the worker thread if necessary) or nullptr if the code can't be tokenised. */
+	Entry::Ptr getTokens(const String& fileName, const String& code);
+
+	/** Returns the tokens for the code if they are already available without tokenising or waiting. */
+	Entry::Ptr getReadyTokens(const String& fileName, const String& code);
+
+	/** Adds the token snapshot of every script in the ExternalScripts tree that is embedded into the exported plugin. */
+	static void addSnapshotToScripts(ValueTree externalScripts);
+
+	/** Restores the token snapshots of the embedded scripts. Returns the number of restored files. */
+	int restoreSnapshot(const ValueTree& externalScripts);
+
+private:
+
+	struct TokeniseJob;
+
+	/** Returns the entry with the given code (either by its file name or by a restored snapshot). Call this with the lock held. */
+	Entry::Ptr findEntry(const String& fileName, const String& code);
+
+	CriticalSection lock;
+	HashMap<String, Entry::Ptr> entries;
+	ReferenceCountedArray<Entry> snapshotEntries;
+	SharedResourcePointer<SharedWorkerPool> workerPool;
+
+	JUCE_DECLARE_NON_COPYABLE(HiseJavascriptTokenCache);
+};
+
 /** The HISE Javascript Engine.
  *
  *	This class is a modified version of the original Javascript engine found in JUCE.
@@ -408,7 +501,8 @@ public:
 
 		// HISE special storage
 
-		void execute(const String& code, bool allowConstDeclarations);
+		/** Parses and executes the code. If the cache key is not empty, the tokens of the code will be cached. */
+		void execute(const String& code, bool allowConstDeclarations, const String& cacheKey=String());
 		var evaluate(const String& code);
 
 		//==============================================================================
@@ -586,6 +680,7 @@ public:
 		// Parser classes
 
 		struct TokenIterator;
+		struct TokenCache;
 		struct ExpressionTreeBuilder;
 
 		//==============================================================================
@@ -815,6 +910,10 @@ public:
 
 			OwnedArray<OptimizationPass> optimizations;
 
+			/** If enabled, the parse time of every included file and the duration of each optimisation pass will be reported after the compilation. */
+			bool collectCompileTimings = false;
+			StringArray compileTimings;
+
 			DynamicObject::Ptr globals;
 
 			DynamicObject::Ptr preparsedconstVariableNames;
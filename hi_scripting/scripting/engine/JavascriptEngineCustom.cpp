@@ -1142,6 +1142,8 @@ void HiseJavascriptEngine::RootObject::HiseSpecialData::registerOptimisationPass
 	
 	shouldOptimize = enable == "1";
 
+	collectCompileTimings = GET_HISE_SETTING(processor->mainController->getMainSynthChain(), HiseSettings::Scripting::ShowCompileTimings).toString() == "1";
+
 	optimizations.add(new LocationInjector());
 
 #endif
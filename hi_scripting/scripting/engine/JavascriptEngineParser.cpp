@@ -5,6 +5,15 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 {
 	TokenIterator(const String& code, const String &externalFile) : location(code, externalFile), p(code.getCharPointer()) { skip(); }
 
+	/** Creates an iterator that replays the tokens of the cache entry instead of parsing the code. */
+	TokenIterator(HiseJavascriptTokenCache::Entry::Ptr cachedTokens_, const String& externalFile) :
+		location(cachedTokens_->code, externalFile),
+		p(cachedTokens_->code.getCharPointer()),
+		cachedTokens(cachedTokens_)
+	{
+		skip();
+	}
+
 	DebugableObject::Location createDebugLocation()
 	{
 		DebugableObject::Location loc;
@@ -17,6 +26,12 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 
 	void skip()
 	{
+		if (cachedTokens != nullptr)
+		{
+			replayNextToken();
+			return;
+		}
+
 		skipWhitespaceAndComments();
 		location.location = p;
 		currentType = matchNextToken();
@@ -60,6 +75,12 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 
 	String lastComment;
 
+	/** Will be set when a comment was skipped (the tokeniser of the TokenCache uses this). */
+	bool foundComment = false;
+
+	/** Returns the cache entry if this iterator replays cached tokens. */
+	HiseJavascriptTokenCache::Entry::Ptr getCachedTokens() const { return cachedTokens; }
+
     Identifier parseIdentifier()
     {
         Identifier i;
@@ -108,6 +129,7 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 					location.location = p;
 
 					lastComment = String(p).upToFirstOccurrenceOf("*/", false, false).fromFirstOccurrenceOf("/**", false, false).trim();
+					foundComment = true;
 
 					p = CharacterFunctions::find(p + 2, CharPointer_ASCII("*/"));
 
@@ -124,6 +146,24 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 private:
 	String::CharPointerType p;
 
+	HiseJavascriptTokenCache::Entry::Ptr cachedTokens;
+	size_t tokenIndex = 0;
+
+	void replayNextToken()
+	{
+		const auto& t = cachedTokens->tokens[jmin(tokenIndex++, cachedTokens->tokens.size() - 1)];
+
+		location.location = t.location;
+		currentType = t.type;
+
+		// keywords and operators don't change the current value
+		if (t.hasValue)
+			currentValue = t.value;
+
+		if (t.hasComment)
+			lastComment = t.comment;
+	}
+
 	static bool isIdentifierStart(const juce_wchar c) noexcept{ return CharacterFunctions::isLetter(c) || c == '_'; }
 	static bool isIdentifierBody(const juce_wchar c) noexcept{ return CharacterFunctions::isLetterOrDigit(c) || c == '_'; }
 
@@ -265,6 +305,355 @@ private:
 	}
 };
 
+HiseJavascriptTokenCache::Entry::Entry(const String& code_, const String& fileName_) :
+	code(code_),
+	fileName(fileName_),
+	hash(code_.hashCode64()),
+	done(true)
+{}
+
+bool HiseJavascriptTokenCache::Entry::matches(const String& otherCode, int64 otherHash) const
+{
+	return hash == otherHash && code == otherCode;
+}
+
+void HiseJavascriptTokenCache::Entry::tokenise()
+{
+	auto start = Time::getMillisecondCounterHiRes();
+
+	try
+	{
+		HiseJavascriptEngine::RootObject::TokenIterator it(code, fileName);
+
+		for (;;)
+		{
+			const bool hasValue = it.currentType == TokenTypes::identifier || it.currentType == TokenTypes::literal;
+			const bool hasComment = it.foundComment;
+
+			tokens.push_back({ it.currentType, it.location.location,
+							   hasValue ? it.currentValue : var(),
+							   hasComment ? it.lastComment : String(),
+							   hasValue, hasComment });
+
+			if (it.currentType == TokenTypes::eof)
+				break;
+
+			it.foundComment = false;
+			it.skip();
+		}
+
+		ok = true;
+	}
+	catch (...)
+	{
+		tokens.clear();
+		ok = false;
+	}
+
+	tokeniseTimeMs = Time::getMillisecondCounterHiRes() - start;
+	done.signal();
+}
+
+namespace TokenSnapshot
+{
+	// Bump this whenever the token types or the tokeniser change so that old snapshots are discarded
+	static constexpr int Version = 1;
+
+	enum Flags
+	{
+		HasValue = 1,
+		HasComment = 2
+	};
+
+	static const Array<const char*>& getTokenTypes()
+	{
+		static Array<const char*> types;
+
+		if (types.isEmpty())
+		{
+#define JUCE_ADD_JS_TOKEN(name, str) types.add(TokenTypes::name);
+			JUCE_JS_KEYWORDS(JUCE_ADD_JS_TOKEN)
+			JUCE_JS_OPERATORS(JUCE_ADD_JS_TOKEN)
+			JUCE_ADD_JS_TOKEN(eof, "$eof")
+			JUCE_ADD_JS_TOKEN(literal, "$literal")
+			JUCE_ADD_JS_TOKEN(identifier, "$identifier")
+#undef JUCE_ADD_JS_TOKEN
+		}
+
+		return types;
+	}
+}
+
+MemoryBlock HiseJavascriptTokenCache::Entry::createSnapshot() const
+{
+	jassert(ok);
+
+	MemoryOutputStream mos;
+
+	const auto& types = TokenSnapshot::getTokenTypes();
+	auto start = code.getCharPointer().getAddress();
+
+	mos.writeInt(TokenSnapshot::Version);
+	mos.writeInt64(hash);
+	mos.writeInt((int)tokens.size());
+
+	for (const auto& t : tokens)
+	{
+		uint8 flags = 0;
+
+		if (t.hasValue) flags |= TokenSnapshot::HasValue;
+		if (t.hasComment) flags |= TokenSnapshot::HasComment;
+
+		mos.writeByte((char)types.indexOf(t.type));
+		mos.writeInt((int)(t.location.getAddress() - start));
+		mos.writeByte((char)flags);
+
+		if (t.hasValue)
+			t.value.writeToStream(mos);
+
+		if (t.hasComment)
+			mos.writeString(t.comment);
+	}
+
+	return mos.getMemoryBlock();
+}
+
+HiseJavascriptTokenCache::Entry::Ptr HiseJavascriptTokenCache::Entry::createFromSnapshot(const String& code, const String& fileName, const MemoryBlock& snapshot)
+{
+	MemoryInputStream mis(snapshot, false);
+
+	Ptr e = new Entry(code, fileName);
+
+	if (mis.readInt() != TokenSnapshot::Version || mis.readInt64() != e->hash)
+		return nullptr;
+
+	const auto& types = TokenSnapshot::getTokenTypes();
+	auto numTokens = mis.readInt();
+	auto start = e->code.getCharPointer().getAddress();
+	auto numBytes = (int)e->code.getNumBytesAsUTF8();
+
+	if (numTokens <= 0)
+		return nullptr;
+
+	e->tokens.reserve((size_t)numTokens);
+
+	for (int i = 0; i < numTokens; i++)
+	{
+		// type index, offset & flags
+		if (mis.getNumBytesRemaining() < 6)
+			return nullptr;
+
+		auto typeIndex = (int)(uint8)mis.readByte();
+		auto offset = mis.readInt();
+		auto flags = (uint8)mis.readByte();
+
+		if (!isPositiveAndBelow(typeIndex, types.size()) || !isPositiveAndNotGreaterThan(offset, numBytes))
+			return nullptr;
+
+		const bool hasValue = (flags & TokenSnapshot::HasValue) != 0;
+		const bool hasComment = (flags & TokenSnapshot::HasComment) != 0;
+
+		var value;
+		String comment;
+
+		if (hasValue)
+			value = var::readFromStream(mis);
+
+		if (hasComment)
+			comment = mis.readString();
+
+		e->tokens.push_back({ types[typeIndex], String::CharPointerType(start + offset), value, comment, hasValue, hasComment });
+	}
+
+	if (e->tokens.back().type != TokenTypes::eof)
+		return nullptr;
+
+	e->ok = true;
+	e->started = true;
+	e->done.signal();
+
+	return e;
+}
+
+void HiseJavascriptTokenCache::Entry::tokeniseOrWait()
+{
+	if (!started.exchange(true))
+		tokenise();
+	else
+		done.wait();
+}
+
+/** Tokenises an entry on the shared worker pool. The job only holds a reference to the entry, so it doesn't depend on the lifetime of the cache. */
+struct HiseJavascriptTokenCache::TokeniseJob : public ThreadPoolJob
+{
+	TokeniseJob(HiseJavascriptTokenCache& parent_, Entry::Ptr e_) :
+		ThreadPoolJob("Tokenise " + e_->fileName),
+		parent(parent_),
+		e(e_)
+	{}
+
+	JobStatus runJob() override
+	{
+		// if the parser needs the tokens before this job was started, it will tokenise the file itself
+		if (!e->started.exchange(true))
+			e->tokenise();
+
+		return jobHasFinished;
+	}
+
+	struct Selector : public ThreadPool::JobSelector
+	{
+		Selector(HiseJavascriptTokenCache& parent_) : parent(parent_) {}
+
+		bool isJobSuitable(ThreadPoolJob* job) override
+		{
+			if (auto tj = dynamic_cast<TokeniseJob*>(job))
+				return &tj->parent == &parent;
+
+			return false;
+		}
+
+		HiseJavascriptTokenCache& parent;
+	};
+
+	HiseJavascriptTokenCache& parent;
+	Entry::Ptr e;
+};
+
+HiseJavascriptTokenCache::HiseJavascriptTokenCache()
+{}
+
+HiseJavascriptTokenCache::~HiseJavascriptTokenCache()
+{
+	// the worker pool is shared, so we only remove the jobs that haven't been started yet
+	TokeniseJob::Selector selector(*this);
+	workerPool->getThreadPool().removeAllJobs(false, 2000, &selector);
+}
+
+HiseJavascriptTokenCache::Entry::Ptr HiseJavascriptTokenCache::findEntry(const String& fileName, const String& code)
+{
+	auto e = entries[fileName];
+	auto hash = code.hashCode64();
+
+	if (e != nullptr && e->matches(code, hash))
+		return e;
+
+	// The file name in the snapshot might differ from the one in the script (eg. because of the {DEVICE} wildcard)
+	for (auto s : snapshotEntries)
+	{
+		if (s->matches(code, hash))
+		{
+			entries.set(fileName, s);
+			return s;
+		}
+	}
+
+	return nullptr;
+}
+
+void HiseJavascriptTokenCache::prefetch(const String& fileName, const String& code)
+{
+	Entry::Ptr e;
+
+	{
+		ScopedLock sl(lock);
+
+		if (findEntry(fileName, code) != nullptr)
+			return;
+
+		e = new Entry(code, fileName);
+		entries.set(fileName, e);
+	}
+
+	workerPool->getThreadPool().addJob(new TokeniseJob(*this, e), true);
+}
+
+HiseJavascriptTokenCache::Entry::Ptr HiseJavascriptTokenCache::getTokens(const String& fileName, const String& code)
+{
+	Entry::Ptr e;
+
+	{
+		ScopedLock sl(lock);
+
+		e = findEntry(fileName, code);
+
+		if (e == nullptr)
+		{
+			e = new Entry(code, fileName);
+			entries.set(fileName, e);
+		}
+	}
+
+	e->tokeniseOrWait();
+
+	e->numUses++;
+
+	return e->ok ? e : nullptr;
+}
+
+HiseJavascriptTokenCache::Entry::Ptr HiseJavascriptTokenCache::getReadyTokens(const String& fileName, const String& code)
+{
+	ScopedLock sl(lock);
+
+	auto e = findEntry(fileName, code);
+
+	if (e != nullptr && e->done.wait(0) && e->ok)
+		return e;
+
+	return nullptr;
+}
+
+void HiseJavascriptTokenCache::addSnapshotToScripts(ValueTree externalScripts)
+{
+	for (auto s : externalScripts)
+	{
+		if (!s.hasProperty("Content"))
+			continue;
+
+		Entry e(s["Content"].toString(), s["FileName"].toString());
+		e.tokenise();
+
+		if (e.ok)
+			s.setProperty("Tokens", e.createSnapshot(), nullptr);
+		else
+			s.removeProperty("Tokens", nullptr);
+	}
+}
+
+int HiseJavascriptTokenCache::restoreSnapshot(const ValueTree& externalScripts)
+{
+	int numRestored = 0;
+
+	for (auto s : externalScripts)
+	{
+		auto mb = s["Tokens"].getBinaryData();
+
+		if (mb == nullptr)
+			continue;
+
+		auto fileName = s["FileName"].toString().replace("\\", "/");
+		auto code = s["Content"].toString();
+
+		{
+			ScopedLock sl(lock);
+
+			if (findEntry(fileName, code) != nullptr)
+				continue;
+		}
+
+		// If the snapshot doesn't match, the file will be tokenised when it's included
+		if (auto e = Entry::createFromSnapshot(code, fileName, *mb))
+		{
+			ScopedLock sl(lock);
+			entries.set(fileName, e);
+			snapshotEntries.add(e);
+			numRestored++;
+		}
+	}
+
+	return numRestored;
+}
+
 //==============================================================================
 struct HiseJavascriptEngine::RootObject::ExpressionTreeBuilder : private TokenIterator
 {
@@ -280,6 +669,19 @@ struct HiseJavascriptEngine::RootObject::ExpressionTreeBuilder : private TokenIt
 #endif
 	}
 
+	/** Creates a builder that parses the cached tokens of an included file. */
+	ExpressionTreeBuilder(HiseJavascriptTokenCache::Entry::Ptr cachedTokens, const String externalFile, HiseJavascriptPreprocessor::Ptr preprocessor_) :
+		TokenIterator(cachedTokens, externalFile),
+		preprocessor(preprocessor_)
+	{
+#if ENABLE_SCRIPTING_BREAKPOINTS
+		if (externalFile.isNotEmpty())
+		{
+			fileId = Identifier("File_" + File(externalFile).getFileNameWithoutExtension());
+		}
+#endif
+	}
+
     HiseJavascriptPreprocessor::Ptr preprocessor;
 
 	void setupApiData(HiseSpecialData &data, const String& codeToPreprocess)
@@ -307,10 +709,10 @@ struct HiseJavascriptEngine::RootObject::ExpressionTreeBuilder : private TokenIt
 #endif
 
 		if(codeToPreprocess.isNotEmpty())
-			preprocessCode(codeToPreprocess);
+			preprocessCode(codeToPreprocess, String(), getCachedTokens());
 	}
 
-	void preprocessCode(const String& codeToPreprocess, const String& externalFileName="");
+	void preprocessCode(const String& codeToPreprocess, const String& externalFileName="", HiseJavascriptTokenCache::Entry::Ptr cachedTokens=nullptr);
 
 	BlockStatement* parseStatementList()
 	{
@@ -928,8 +1330,20 @@ private:
                     loc.location = loc.program.getCharPointer() + (ok.getErrorMessage().getIntValue()-1);
                     loc.throwError(ok.getErrorMessage().fromFirstOccurrenceOf(":", false, false));
                 }
-                
-				ExpressionTreeBuilder ftb(fileContent, refFileName, preprocessor);
+
+				auto parseStart = Time::getMillisecondCounterHiRes();
+
+				SharedResourcePointer<HiseJavascriptTokenCache> tokenCache;
+				auto cachedTokens = tokenCache->getTokens(refFileName, fileContent);
+
+				ScopedPointer<ExpressionTreeBuilder> ftbPtr;
+
+				if (cachedTokens != nullptr)
+					ftbPtr = new ExpressionTreeBuilder(cachedTokens, refFileName, preprocessor);
+				else
+					ftbPtr = new ExpressionTreeBuilder(fileContent, refFileName, preprocessor);
+
+				auto& ftb = *ftbPtr;
 
 #if ENABLE_SCRIPTING_BREAKPOINTS
 				ftb.breakpoints.addArray(breakpoints);
@@ -944,6 +1358,21 @@ private:
                 
 				ScopedPointer<BlockStatement> s = ftb.parseStatementList();
 
+				if (hiseSpecialData->collectCompileTimings)
+				{
+					String t;
+					t << File(refFileName).getFileName() << ": " << String(Time::getMillisecondCounterHiRes() - parseStart, 2) << "ms";
+
+					if (cachedTokens == nullptr)
+						t << " (not tokenised)";
+					else if (cachedTokens->numUses > 1)
+						t << " (cached tokens)";
+					else
+						t << " (tokenised in " << String(cachedTokens->tokeniseTimeMs, 2) << "ms)";
+
+					hiseSpecialData->compileTimings.add(t);
+				}
+
 				match(TokenTypes::literal);
 				match(TokenTypes::closeParen);
 				match(TokenTypes::semicolon);
@@ -2447,7 +2876,7 @@ private:
 };
 
 
-void HiseJavascriptEngine::RootObject::ExpressionTreeBuilder::preprocessCode(const String& codeToPreprocess, const String& externalFileName)
+void HiseJavascriptEngine::RootObject::ExpressionTreeBuilder::preprocessCode(const String& codeToPreprocess, const String& externalFileName, HiseJavascriptTokenCache::Entry::Ptr cachedTokens)
 {
 	if (codeToPreprocess.isEmpty()) return;
 
@@ -2459,7 +2888,8 @@ void HiseJavascriptEngine::RootObject::ExpressionTreeBuilder::preprocessCode(con
 
 	JavascriptNamespace* rootNamespace = hiseSpecialData;
 	JavascriptNamespace* cns = rootNamespace;
-	TokenIterator it(codeToPreprocess, externalFileName);
+	TokenIterator it = cachedTokens != nullptr ? TokenIterator(cachedTokens, externalFileName) :
+												 TokenIterator(codeToPreprocess, externalFileName);
 
 	int braceLevel = 0;
 
@@ -2509,10 +2939,29 @@ void HiseJavascriptEngine::RootObject::ExpressionTreeBuilder::preprocessCode(con
 			it.match(TokenTypes::openParen);
 			String fileName = it.currentValue.toString();
 			String externalCode = getFileContent(it.currentValue.toString(), fileName);
-			
-            
-            
-			preprocessCode(externalCode, fileName);
+
+			HiseJavascriptTokenCache::Entry::Ptr cachedTokens;
+
+			// parseExternalFile() looks up the tokens of the preprocessed code, so we need to use the
+			// same text here. If it fails, the error will be thrown when the file is parsed.
+			bool useTokenCache = externalCode.isNotEmpty();
+
+			if (useTokenCache && preprocessor != nullptr)
+				useTokenCache = preprocessor->process(externalCode, fileName).wasOk();
+
+			if (useTokenCache)
+			{
+				SharedResourcePointer<HiseJavascriptTokenCache> tokenCache;
+
+				// Use the tokens if they are already available (eg. from the embedded snapshot),
+				// otherwise tokenise the file on a worker thread while we're scanning the rest of the script
+				cachedTokens = tokenCache->getReadyTokens(fileName, externalCode);
+
+				if (cachedTokens == nullptr)
+					tokenCache->prefetch(fileName, externalCode);
+			}
+
+			preprocessCode(externalCode, fileName, cachedTokens);
 
 			continue;
 		}
@@ -2719,16 +3168,37 @@ bool HiseJavascriptEngine::RootObject::areTypeEqual(const var& a, const var& b)
 		&& (((a.isUndefined() || a.isVoid()) && (b.isUndefined() || b.isVoid())) || a == b);
 }
 
-void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowConstDeclarations)
+void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowConstDeclarations, const String& cacheKey)
 {
-	ExpressionTreeBuilder tb(code, String(), preprocessor);
+	HiseJavascriptTokenCache::Entry::Ptr cachedTokens;
+
+	if (cacheKey.isNotEmpty())
+		cachedTokens = SharedResourcePointer<HiseJavascriptTokenCache>()->getTokens(cacheKey, code);
+
+	ScopedPointer<ExpressionTreeBuilder> tbPtr;
+
+	if (cachedTokens != nullptr)
+		tbPtr = new ExpressionTreeBuilder(cachedTokens, String(), preprocessor);
+	else
+		tbPtr = new ExpressionTreeBuilder(code, String(), preprocessor);
+
+	auto& tb = *tbPtr;
 
 #if ENABLE_SCRIPTING_BREAKPOINTS
 	tb.breakpoints.swapWith(breakpoints);
 #endif
 
+	// only report the timings of the onInit callback (the other callbacks can't include files)
+	const bool reportTimings = hiseSpecialData.collectCompileTimings && allowConstDeclarations;
+
+	hiseSpecialData.compileTimings.clear();
+
+	auto preprocessStart = Time::getMillisecondCounterHiRes();
+
 	tb.setupApiData(hiseSpecialData, allowConstDeclarations ? code : String());
 
+	auto parseStart = Time::getMillisecondCounterHiRes();
+
 	ScopedPointer<BlockStatement> sl;
 
 	{
@@ -2740,6 +3210,8 @@ void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowCon
 	if(shouldUseCycleCheck)
 		prepareCycleReferenceCheck();
 
+	auto initStart = Time::getMillisecondCounterHiRes();
+
 	{
 		TRACE_SCRIPTING("run onInit callback");
 		sl->perform(Scope(nullptr, this, this), nullptr);
@@ -2748,30 +3220,59 @@ void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowCon
 	
 
 	Array<OptimizationPass::OptimizationResult> results;
+	StringArray passTimings;
 
-	auto before = Time::getMillisecondCounter();
+	auto before = Time::getMillisecondCounterHiRes();
 
 	for (auto o : hiseSpecialData.optimizations)
 	{
-		if(auto or_ = hiseSpecialData.runOptimisation(o))
+		auto passStart = Time::getMillisecondCounterHiRes();
+
+		auto or_ = hiseSpecialData.runOptimisation(o);
+
+		if (reportTimings)
+			passTimings.add(o->getPassName() + ": " + String(Time::getMillisecondCounterHiRes() - passStart, 2) + "ms");
+
+		if(or_)
 			results.add(or_);
 	}
 	
-	auto after = Time::getMillisecondCounter();
+	auto after = Time::getMillisecondCounterHiRes();
 	
-	auto optimisationTimeMs = after - before;
+	auto optimisationTimeMs = roundToInt(after - before);
 	
+	String s;
+
 	if (!results.isEmpty())
 	{
-		String s;
-
 		for (auto r : results)
 			s << r.passName << ": " << String(r.numOptimizedStatements) << "\n";
 
 		s << "Optimization Duration: " << String(optimisationTimeMs) << "ms";
+	}
 
-		hiseSpecialData.processor->setOptimisationReport(s);
+	if (reportTimings)
+	{
+		if (s.isNotEmpty())
+			s << "\n";
+
+		s << "Compile timings:\n";
+		s << "Preprocessing: " << String(parseStart - preprocessStart, 2) << "ms\n";
+		s << "Parsing: " << String(initStart - parseStart, 2) << "ms\n";
+
+		for (const auto& t : hiseSpecialData.compileTimings)
+			s << "  " << t << "\n";
+
+		s << "onInit: " << String(before - initStart, 2) << "ms\n";
+
+		for (const auto& t : passTimings)
+			s << "Pass " << t << "\n";
+
+		s << "Total: " << String(after - preprocessStart, 2) << "ms";
 	}
+
+	if (s.isNotEmpty())
+		hiseSpecialData.processor->setOptimisationReport(s);
 }
 
 HiseJavascriptEngine::RootObject::FunctionObject::FunctionObject(const FunctionObject& other) : DynamicObject(), functionCode(other.functionCode)
@@ -2781,4 +3282,216 @@ HiseJavascriptEngine::RootObject::FunctionObject::FunctionObject(const FunctionO
 	tb.parseFunctionParamsAndBody(*this);
 }
 
+#if HI_RUN_UNIT_TESTS
+
+/** Checks that the parser gets the same tokens from the token cache as from the tokeniser. */
+class TokenCacheTests : public UnitTest
+{
+public:
+
+	TokenCacheTests() :
+		UnitTest("Testing the script token cache")
+	{};
+
+	void runTest() override
+	{
+		testReplayMatchesTokeniser();
+		testCacheLookup();
+		testSnapshotRoundTrip();
+		testSnapshotMismatch();
+	}
+
+private:
+
+	using TokenIterator = HiseJavascriptEngine::RootObject::TokenIterator;
+	using Entry = HiseJavascriptTokenCache::Entry;
+
+	static String getTestCode()
+	{
+		return "/** A namespace with a doc comment. */\n"
+			   "namespace Test\n"
+			   "{\n"
+			   "\tconst var x = 12.5; // a line comment\n"
+			   "\treg s = \"some \\\"string\\\"\";\n"
+			   "\t/** The function comment. */\n"
+			   "\tinline function f(a, b) { return a >>> 2 != b ? [a, b] : {\"k\": 0x1F}; }\n"
+			   "}\n"
+			   "/* trailing comment */";
+	}
+
+	/** Compares the iterator state after every token. */
+	void expectSameTokens(TokenIterator& expected, TokenIterator& actual, const String& code)
+	{
+		auto start = code.getCharPointer();
+		int numTokens = 0;
+
+		for (;;)
+		{
+			auto msg = "token " + String(numTokens);
+
+			expect(expected.currentType == actual.currentType, "type mismatch at " + msg);
+			expectEquals((int)(actual.location.location - start), (int)(expected.location.location - start), "location mismatch at " + msg);
+			expect(expected.currentValue == actual.currentValue, "value mismatch at " + msg);
+			expectEquals(actual.lastComment, expected.lastComment, "comment mismatch at " + msg);
+
+			if (expected.currentType == TokenTypes::eof || actual.currentType == TokenTypes::eof)
+				break;
+
+			expected.skip();
+			actual.skip();
+			numTokens++;
+		}
+
+		expect(expected.currentType == actual.currentType, "different number of tokens");
+	}
+
+	void testReplayMatchesTokeniser()
+	{
+		beginTest("Testing the replay of cached tokens");
+
+		auto code = getTestCode();
+
+		Entry::Ptr e = new Entry(code, "Test.js");
+		e->tokenise();
+
+		expect(e->ok, "tokenising failed");
+
+		TokenIterator fresh(code, "Test.js");
+		TokenIterator replay(e, "Test.js");
+
+		expectSameTokens(fresh, replay, code);
+	}
+
+	void testCacheLookup()
+	{
+		beginTest("Testing the token cache lookup");
+
+		HiseJavascriptTokenCache cache;
+
+		auto code = getTestCode();
+		auto changedCode = code.replace("12.5", "13.5");
+
+		cache.prefetch("Test.js", code);
+
+		auto e = cache.getTokens("Test.js", code);
+
+		expect(e != nullptr, "no tokens for the prefetched code");
+		expect(cache.getReadyTokens("Test.js", code) == e, "the entry was tokenised twice");
+		expect(cache.getReadyTokens("Test.js", changedCode) == nullptr, "the changed code uses the old tokens");
+
+		auto changed = cache.getTokens("Test.js", changedCode);
+
+		expect(changed != nullptr && changed != e, "the changed code wasn't tokenised");
+
+		TokenIterator fresh(changedCode, "Test.js");
+		TokenIterator replay(changed, "Test.js");
+
+		expectSameTokens(fresh, replay, changedCode);
+	}
+
+	static ValueTree createExternalScripts(const String& code)
+	{
+		ValueTree scripts("ExternalScripts");
+		ValueTree s("Script");
+		s.setProperty("FileName", "{PROJECT_FOLDER}Test.js", nullptr);
+		s.setProperty("Content", code, nullptr);
+		scripts.addChild(s, -1, nullptr);
+
+		HiseJavascriptTokenCache::addSnapshotToScripts(scripts);
+
+		return scripts;
+	}
+
+	void testSnapshotRoundTrip()
+	{
+		beginTest("Testing the token snapshot round trip");
+
+		auto code = getTestCode();
+
+		Entry::Ptr e = new Entry(code, "Test.js");
+		e->tokenise();
+
+		auto restored = Entry::createFromSnapshot(code, "Test.js", e->createSnapshot());
+
+		expect(restored != nullptr, "the snapshot couldn't be restored");
+
+		if (restored == nullptr)
+			return;
+
+		expectEquals((int)restored->tokens.size(), (int)e->tokens.size(), "wrong number of restored tokens");
+
+		{
+			TokenIterator fresh(code, "Test.js");
+			TokenIterator replay(restored, "Test.js");
+			expectSameTokens(fresh, replay, code);
+		}
+
+		// export -> restore -> lookup with the name that is used in the script
+		auto scripts = createExternalScripts(code);
+
+		expect(scripts.getChild(0)["Tokens"].isBinaryData(), "the snapshot wasn't embedded");
+
+		HiseJavascriptTokenCache cache;
+
+		expectEquals(cache.restoreSnapshot(scripts), 1, "the snapshot wasn't restored");
+
+		auto cached = cache.getReadyTokens("{PROJECT_FOLDER}Other.js", code);
+
+		expect(cached != nullptr, "the restored snapshot wasn't found by its content");
+
+		if (cached != nullptr)
+		{
+			TokenIterator fresh(code, "Test.js");
+			TokenIterator replay(cached, "Test.js");
+			expectSameTokens(fresh, replay, code);
+		}
+	}
+
+	void testSnapshotMismatch()
+	{
+		beginTest("Testing the fallback for outdated token snapshots");
+
+		auto code = getTestCode();
+		auto changedCode = code.replace("Test", "Changed");
+
+		auto snapshot = *createExternalScripts(code).getChild(0)["Tokens"].getBinaryData();
+
+		expect(Entry::createFromSnapshot(changedCode, "Test.js", snapshot) == nullptr, "the snapshot was used for other code");
+
+		// a snapshot from another tokeniser version must be discarded
+		MemoryBlock wrongVersion(snapshot);
+		wrongVersion[0] = (char)(wrongVersion[0] + 1);
+		expect(Entry::createFromSnapshot(code, "Test.js", wrongVersion) == nullptr, "the snapshot version wasn't checked");
+
+		// a truncated snapshot must be discarded
+		MemoryBlock truncated(snapshot.getData(), snapshot.getSize() / 2);
+		expect(Entry::createFromSnapshot(code, "Test.js", truncated) == nullptr, "the truncated snapshot was used");
+
+		// the script content was changed after the snapshot was created
+		auto scripts = createExternalScripts(code);
+		scripts.getChild(0).setProperty("Content", changedCode, nullptr);
+
+		HiseJavascriptTokenCache cache;
+
+		expectEquals(cache.restoreSnapshot(scripts), 0, "the outdated snapshot was restored");
+		expect(cache.getReadyTokens("{PROJECT_FOLDER}Test.js", changedCode) == nullptr, "the outdated snapshot was used");
+
+		// the file is tokenised when it's included
+		auto e = cache.getTokens("{PROJECT_FOLDER}Test.js", changedCode);
+
+		expect(e != nullptr, "the fallback didn't tokenise the file");
+
+		if (e != nullptr)
+		{
+			TokenIterator fresh(changedCode, "Test.js");
+			TokenIterator replay(e, "Test.js");
+			expectSameTokens(fresh, replay, changedCode);
+		}
+	}
+};
+
+static TokenCacheTests tokenCacheTests;
+
+#endif
+
 } // namespace hise
@@ -271,8 +271,129 @@ struct ScriptNodeTests : public juce::UnitTest
 		testRangeTemplates();
 		testParameters();
 		testModWrapper();
+
+#if HISE_INCLUDE_SNEX
+		testJitFreezeThread();
+#endif
+	}
+
+#if HISE_INCLUDE_SNEX
+	static String createJitTestCode(float gain)
+	{
+		String code;
+		code << "struct jit_test\n{\n";
+		code << "	SNEX_NODE(jit_test);\n";
+		code << "	float gain = " << String(gain, 2) << "f;\n";
+		code << "	void prepare(PrepareSpecs ps) {}\n";
+		code << "	void reset() {}\n";
+		code << "	void handleHiseEvent(HiseEvent& e) {}\n";
+		code << "	template <typename ProcessDataType> void process(ProcessDataType& data)\n";
+		code << "	{\n";
+		code << "		for(auto ch: data)\n";
+		code << "		{\n";
+		code << "			for(auto& s: data.toChannelData(ch))\n";
+		code << "				s *= gain;\n";
+		code << "		}\n";
+		code << "	}\n";
+		code << "	template <int C> void processFrame(span<float, C>& data) { for(auto& s: data) s *= gain; }\n";
+		code << "	void setExternalData(const ExternalData& d, int index) {}\n";
+		code << "	template <int P> void setParameter(double v) {}\n";
+		code << "};\n";
+		return code;
 	}
 
+	void testJitFreezeThread()
+	{
+		beginTest("Testing the compile / swap cycle of the JIT freeze thread");
+
+		CriticalSection resultLock;
+		WaitableEvent resultEvent;
+		snex::jit::JitCompiledNode::Ptr result;
+		int resultGeneration = -1;
+		int numResults = 0;
+
+		JitFreezeThread t([&](snex::jit::JitCompiledNode::Ptr n, int g)
+		{
+			{
+				ScopedLock sl(resultLock);
+				result = n;
+				resultGeneration = g;
+				numResults++;
+			}
+
+			resultEvent.signal();
+		});
+
+		// The second request must replace the first one
+		t.compile(createJitTestCode(0.5f), Identifier("jit_test"), 1);
+		auto lastGeneration = t.compile(createJitTestCode(0.25f), Identifier("jit_test"), 1);
+
+		expect(t.isCurrent(lastGeneration), "last request isn't current");
+
+		while (t.isBusy())
+			resultEvent.wait(100);
+
+		{
+			ScopedLock sl(resultLock);
+
+			expect(result != nullptr, "no node was delivered");
+			expectEquals(resultGeneration, lastGeneration, "stale node was delivered");
+			expect(numResults <= 2, "too many results");
+		}
+
+		if (result == nullptr)
+			return;
+
+		expect(result->r.wasOk(), result->r.getErrorMessage());
+
+		if (!result->r.wasOk())
+			return;
+
+		PrepareSpecs ps;
+		ps.numChannels = 1;
+		ps.blockSize = 16;
+		ps.sampleRate = 44100.0;
+		ps.voiceIndex = nullptr;
+
+		result->prepare(ps);
+
+		heap<float> buffer;
+		buffer.setSize(16);
+
+		for (auto& s : buffer)
+			s = 1.0f;
+
+		float* channels[1] = { buffer.begin() };
+		ProcessDataDyn pd(channels, 16, 1);
+		result->process(pd);
+
+		for (auto& s : buffer)
+			expectWithinAbsoluteError(s, 0.25f, 0.0001f, "wrong node was swapped in");
+
+		beginTest("Testing that a cancelled compilation is discarded");
+
+		{
+			ScopedLock sl(resultLock);
+			result = nullptr;
+			numResults = 0;
+		}
+
+		resultEvent.reset();
+
+		auto cancelledGeneration = t.compile(createJitTestCode(0.125f), Identifier("jit_test"), 1);
+		t.cancel();
+
+		expect(!t.isCurrent(cancelledGeneration), "cancelled request is still current");
+
+		while (t.isBusy())
+			Thread::sleep(10);
+
+		ScopedLock sl(resultLock);
+		expectEquals(numResults, 0, "cancelled node was delivered");
+		expect(result == nullptr, "cancelled node was delivered");
+	}
+#endif
+
 	struct Dummy
 	{
 		enum Parameters
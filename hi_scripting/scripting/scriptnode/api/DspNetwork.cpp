@@ -65,6 +65,9 @@ DspNetwork::DspNetwork(hise::ProcessorWithScriptingContent* p, ValueTree data_,
 #endif
 	parentHolder(dynamic_cast<Holder*>(p)),
 	projectNodeHolder(*this)
+#if HISE_INCLUDE_SNEX
+	, jitNodeHolder(*this)
+#endif
 {
 	jassert(data.getType() == PropertyIds::Network);
 
@@ -242,6 +245,9 @@ DspNetwork::DspNetwork(hise::ProcessorWithScriptingContent* p, ValueTree data_,
 
 DspNetwork::~DspNetwork()
 {
+	// Clear the weak references first so that a pending JIT compilation result will be discarded
+	masterReference.clear();
+
 	stopTimer();
 
 	root = nullptr;
@@ -505,6 +511,10 @@ void DspNetwork::reset()
 	
 	if (projectNodeHolder.isActive())
 		projectNodeHolder.n.reset();
+#if HISE_INCLUDE_SNEX
+	else if (jitNodeHolder.isActive())
+		jitNodeHolder.callWithNode([](snex::jit::JitCompiledNode& n) { n.reset(); });
+#endif
 	else if (auto rn = getRootNode())
 		rn->reset();
 }
@@ -513,6 +523,10 @@ void DspNetwork::handleHiseEvent(HiseEvent& e)
 {
 	if (projectNodeHolder.isActive())
 		projectNodeHolder.n.handleHiseEvent(e);
+#if HISE_INCLUDE_SNEX
+	else if (jitNodeHolder.isActive())
+		jitNodeHolder.callWithNode([&e](snex::jit::JitCompiledNode& n) { n.handleHiseEvent(e); });
+#endif
 	else
 		getRootNode()->handleHiseEvent(e);
 }
@@ -540,6 +554,14 @@ void DspNetwork::process(ProcessDataDyn& data)
 
 	if (auto s = SimpleReadWriteLock::ScopedTryReadLock(getConnectionLock()))
 	{
+#if HISE_INCLUDE_SNEX
+		if (jitNodeHolder.isActive())
+		{
+			jitNodeHolder.process(data);
+			return;
+		}
+#endif
+
 		if (exceptionHandler.isOk())
 			getRootNode()->process(data);
 	}
@@ -557,7 +579,7 @@ bool DspNetwork::isSuspendedOnSilence() const
 
 bool DspNetwork::handleModulation(double& v)
 {
-	if (isFrozen())
+	if (projectNodeHolder.isActive())
 		return projectNodeHolder.handleModulation(v);
 	else
 		return networkModValue.getChangedValue(v);
@@ -605,6 +627,11 @@ void DspNetwork::prepareToPlay(double sampleRate, double blockSize)
 
 				if (projectNodeHolder.isActive())
 					projectNodeHolder.prepare(currentSpecs);
+
+#if HISE_INCLUDE_SNEX
+				if (jitNodeHolder.isActive())
+					jitNodeHolder.prepare(currentSpecs);
+#endif
 			}
             
             initialised = true;
@@ -1269,6 +1296,38 @@ bool DspNetwork::hashMatches()
 	return projectNodeHolder.hashMatches;
 }
 
+void DspNetwork::setUseJitFrozenNode(bool shouldBeEnabled)
+{
+#if HISE_INCLUDE_SNEX
+	if (shouldBeEnabled && !canBeJitFrozen())
+		return;
+
+	jitNodeHolder.setEnabled(shouldBeEnabled);
+#else
+	ignoreUnused(shouldBeEnabled);
+#endif
+}
+
+bool DspNetwork::canBeJitFrozen() const
+{
+#if HISE_INCLUDE_SNEX
+	// The JIT compiled node uses its own voice index, so we can't
+	// freeze polyphonic networks
+	return !isPolyphonic() && !projectNodeHolder.isActive();
+#else
+	return false;
+#endif
+}
+
+bool DspNetwork::isJitFrozen() const
+{
+#if HISE_INCLUDE_SNEX
+	return jitNodeHolder.isActive();
+#else
+	return false;
+#endif
+}
+
 void DspNetwork::setExternalData(const snex::ExternalData& d, int index)
 {
 	projectNodeHolder.n.setExternalData(d, index);
@@ -1278,6 +1337,10 @@ hise::ScriptParameterHandler* DspNetwork::getCurrentParameterHandler()
 {
 	if (projectNodeHolder.isActive())
 		return &projectNodeHolder;
+#if HISE_INCLUDE_SNEX
+	else if (jitNodeHolder.isActive())
+		return &jitNodeHolder;
+#endif
 	else
 		return &networkParameterHandler;
 }
@@ -2410,6 +2473,302 @@ void DspNetwork::ProjectNodeHolder::init(dll::StaticLibraryHostFactory* staticLi
 	}
 }
 
+#if HISE_INCLUDE_SNEX
+JitFreezeThread::JitFreezeThread(const ResultFunction& f) :
+	Thread("JIT Freeze"),
+	resultFunction(f)
+{}
+
+JitFreezeThread::~JitFreezeThread()
+{
+	cancel();
+	signalThreadShouldExit();
+	notify();
+
+	// The compiler can't be interrupted, so we need to wait until it's done (killing
+	// the thread would leak the compiler state)
+	stopThread(-1);
+}
+
+int JitFreezeThread::compile(const String& code, const Identifier& classId, int numChannels)
+{
+	int thisGeneration;
+
+	{
+		ScopedLock sl(requestLock);
+
+		thisGeneration = ++generation;
+
+		pendingRequest.code = code;
+		pendingRequest.classId = classId;
+		pendingRequest.numChannels = numChannels;
+		pendingRequest.generation = thisGeneration;
+		hasPendingRequest = true;
+	}
+
+	// The thread only stops in the destructor, so we don't need to wait for it here
+	if (!isThreadRunning())
+		startThread(4);
+	else
+		notify();
+
+	return thisGeneration;
+}
+
+bool JitFreezeThread::isBusy() const
+{
+	ScopedLock sl(requestLock);
+	return compiling || (hasPendingRequest && isCurrent(pendingRequest.generation));
+}
+
+void JitFreezeThread::run()
+{
+	while (!threadShouldExit())
+	{
+		Request r;
+
+		{
+			ScopedLock sl(requestLock);
+
+			if (hasPendingRequest)
+			{
+				r = pendingRequest;
+				hasPendingRequest = false;
+				compiling = true;
+			}
+		}
+
+		if (!compiling)
+		{
+			wait(-1);
+			continue;
+		}
+
+		if (isCurrent(r.generation))
+		{
+			snex::jit::Compiler::Ptr cc = new snex::jit::Compiler(scope);
+			snex::jit::JitCompiledNode::Ptr newNode = new snex::jit::JitCompiledNode(*cc, r.code, r.classId.toString(), r.numChannels);
+
+			// Discard the result if there was an edit or a newer request during the compilation
+			if (!threadShouldExit() && isCurrent(r.generation))
+				resultFunction(newNode, r.generation);
+		}
+
+		compiling = false;
+	}
+}
+
+DspNetwork::JitNodeHolder::JitNodeHolder(DspNetwork& parent):
+	AnyListener(valuetree::AsyncMode::Synchronously),
+	lastResult(Result::ok()),
+	network(parent),
+	compileThread([this](snex::jit::JitCompiledNode::Ptr newNode, int generation)
+	{
+		// The network might be destroyed already, so we must not create a weak reference on this thread
+		WeakReference<DspNetwork> safeNetwork(this->safeNetwork);
+
+		// Swap the node on the message thread so that it can't interfere with edits
+		MessageManager::callAsync([safeNetwork, newNode, generation]()
+		{
+			if (safeNetwork != nullptr)
+				safeNetwork->jitNodeHolder.compilationFinished(newNode, generation);
+		});
+	})
+{
+	memset(parameterValues, 0, sizeof(parameterValues));
+
+	setPropertyCondition(isEditProperty);
+	setRootValueTree(network.getValueTree());
+}
+
+DspNetwork::JitNodeHolder::~JitNodeHolder()
+{
+	compileThread.cancel();
+
+	forwardToNode = false;
+	node = nullptr;
+}
+
+Identifier DspNetwork::JitNodeHolder::getParameterId(int index) const
+{ return network.networkParameterHandler.getParameterId(index); }
+
+int DspNetwork::JitNodeHolder::getNumParameters() const
+{ return parameters.size(); }
+
+void DspNetwork::JitNodeHolder::setParameter(int index, float newValue)
+{
+	if (isPositiveAndBelow(index, jmin(parameters.size(), OpaqueNode::NumMaxParameters)))
+	{
+		parameterValues[index] = newValue;
+		parameters.getReference(index).callback.call((double)newValue);
+	}
+}
+
+float DspNetwork::JitNodeHolder::getParameter(int index) const
+{
+	if (isPositiveAndBelow(index, OpaqueNode::NumMaxParameters))
+		return parameterValues[index];
+
+	return 0.0f;
+}
+
+void DspNetwork::JitNodeHolder::prepare(PrepareSpecs ps)
+{
+	if (node != nullptr)
+		node->prepare(ps);
+}
+
+void DspNetwork::JitNodeHolder::process(ProcessDataDyn& data)
+{
+	NodeProfiler np(network.getRootNode(), data.getNumSamples());
+
+	node->process(data);
+}
+
+void DspNetwork::JitNodeHolder::compile()
+{
+	// Create the code from a copy so that the builder can't fire the edit listener
+	auto rootTree = network.getValueTree().createCopy().getChild(0);
+
+	snex::cppgen::ValueTreeBuilder vb(rootTree, snex::cppgen::ValueTreeBuilder::Format::JitCompiledInstance);
+	vb.setOutputFormat(snex::cppgen::ValueTreeBuilder::Format::JitCompiledInstance);
+	auto br = vb.createCppCode();
+
+	lastResult = br.r;
+
+	if (lastResult.failed())
+	{
+		compileThread.cancel();
+
+#if USE_BACKEND
+		debugError(dynamic_cast<Processor*>(network.getScriptProcessor()), "JIT freeze failed: " + lastResult.getErrorMessage());
+#endif
+		return;
+	}
+
+	// The network is fully constructed at this point (and this runs on the message thread)
+	if (safeNetwork == nullptr)
+		safeNetwork = &network;
+
+	compileThread.compile(br.code, Identifier(rootTree[PropertyIds::ID].toString()), snex::cppgen::ValueTreeBuilder::getRootChannelAmount(rootTree));
+}
+
+void DspNetwork::JitNodeHolder::setEnabled(bool shouldBeEnabled)
+{
+	if (shouldBeEnabled)
+	{
+		compile();
+	}
+	else
+	{
+		// This doesn't wait for a running compilation, its result will just be discarded
+		compileThread.cancel();
+
+		if (isActive())
+			swapNode(nullptr);
+	}
+}
+
+void DspNetwork::JitNodeHolder::compilationFinished(snex::jit::JitCompiledNode::Ptr newNode, int generation)
+{
+	if (!compileThread.isCurrent(generation))
+		return;
+
+	if (newNode->r.failed())
+	{
+		lastResult = newNode->r;
+#if USE_BACKEND
+		debugError(dynamic_cast<Processor*>(network.getScriptProcessor()), "JIT freeze failed: " + lastResult.getErrorMessage());
+#endif
+		return;
+	}
+
+	swapNode(newNode);
+}
+
+void DspNetwork::JitNodeHolder::swapNode(snex::jit::JitCompiledNode::Ptr newNode)
+{
+	auto nh = static_cast<ScriptParameterHandler*>(&network.networkParameterHandler);
+
+	ParameterDataList newParameters;
+
+	if (newNode != nullptr)
+	{
+		newParameters = newNode->getParameterList();
+
+		if (auto h = network.getExternalDataHolder())
+		{
+			ExternalData::forEachType([&](ExternalData::DataType dt)
+			{
+				for (int i = 0; i < newNode->getNumRequiredDataObjects(dt); i++)
+					newNode->setExternalData(h->getData(dt, i), i);
+			});
+		}
+
+		if (network.currentSpecs)
+			newNode->prepare(network.currentSpecs);
+
+		for (int i = 0; i < jmin(newParameters.size(), OpaqueNode::NumMaxParameters); i++)
+		{
+			parameterValues[i] = nh->getParameter(i);
+			newParameters.getReference(i).callback.call((double)parameterValues[i]);
+		}
+	}
+
+	auto wasActive = isActive();
+
+	{
+		SimpleReadWriteLock::ScopedWriteLock sl(network.getConnectionLock());
+
+		std::swap(node, newNode);
+		std::swap(parameters, newParameters);
+		forwardToNode = node != nullptr;
+	}
+
+	if (wasActive && !isActive())
+	{
+		for (int i = 0; i < jmin(nh->getNumParameters(), newParameters.size(), OpaqueNode::NumMaxParameters); i++)
+			nh->setParameter(i, parameterValues[i]);
+
+		network.reset();
+	}
+}
+
+void DspNetwork::JitNodeHolder::anythingChanged(CallbackType)
+{
+	if (isActive() || compileThread.isBusy())
+	{
+		setEnabled(false);
+#if USE_BACKEND
+		debugToConsole(dynamic_cast<Processor*>(network.getScriptProcessor()), "Network was edited, removing JIT compiled node");
+#endif
+	}
+	else
+	{
+		compileThread.cancel();
+	}
+}
+
+bool DspNetwork::JitNodeHolder::isEditProperty(const ValueTree& v, const Identifier& id)
+{
+	static const Array<Identifier> uiIds = { PropertyIds::Folded, PropertyIds::NodeColour, PropertyIds::Comment, 
+		                                     PropertyIds::Locked, PropertyIds::ShowParameters, PropertyIds::ShowClones, 
+		                                     PropertyIds::Frozen };
+
+	if (uiIds.contains(id))
+		return false;
+
+	// The root parameters and automated parameters are not baked into the compiled code
+	if (v.getType() == PropertyIds::Parameter && id == PropertyIds::Value)
+	{
+		auto isRootParameter = v.getParent().getParent().getParent().getType() == PropertyIds::Network;
+		return !isRootParameter && !(bool)v[PropertyIds::Automated];
+	}
+
+	return true;
+}
+#endif
+
 int HostHelpers::getNumMaxDataObjects(const ValueTree& v, snex::ExternalData::DataType t)
 {
 	auto id = Identifier(snex::ExternalData::getDataTypeName(t, false));
@@ -2879,7 +3238,8 @@ bool DspNetworkListeners::PatchAutosaver::stripValueTree(ValueTree& v)
 	// Remove all properties with the default value
 	for (int i = 0; i < propChild.getNumChildren(); i++)
 	{
-		if (removePropIfDefault(propChild.getChild(i), PropertyIds::IsVertical, 1))
+		if (removePropIfDefault(propChild.getChild(i), PropertyIds::IsVertical, 1) ||
+			removePropIfDefault(propChild.getChild(i), PropertyIds::ProcessInParallel, 0))
 			propChild.removeChild(i--, nullptr);
 	}
 
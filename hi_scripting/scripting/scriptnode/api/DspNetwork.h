@@ -113,8 +113,61 @@ private:
 
 class SnexSource;
 
+#if HISE_INCLUDE_SNEX
+
+/** Compiles the SNEX code of a frozen network on a background thread.
+
+	The SNEX compiler can't be interrupted, so a new request never waits for the running compilation:
+	it bumps the generation counter and the thread picks up the latest request when it's done. The result
+	of an outdated request will be discarded and the result function is only called for the current generation.
+*/
+struct JitFreezeThread : public Thread
+{
+	/** This is called on the background thread with the compiled node and the generation of its request. */
+	using ResultFunction = std::function<void(snex::jit::JitCompiledNode::Ptr, int)>;
+
+	JitFreezeThread(const ResultFunction& f);
 
+	/** Waits until the current compilation is finished. */
+	~JitFreezeThread();
 
+	/** Queues the code for compilation and returns the generation of this request. */
+	int compile(const String& code, const Identifier& classId, int numChannels);
+
+	/** Discards the pending request and the result of the running compilation. */
+	void cancel() { generation++; }
+
+	/** Returns true if the generation belongs to the last request and wasn't cancelled. */
+	bool isCurrent(int g) const { return generation.load() == g; }
+
+	/** Returns true if a request is waiting or being compiled. */
+	bool isBusy() const;
+
+	void run() override;
+
+private:
+
+	struct Request
+	{
+		String code;
+		Identifier classId;
+		int numChannels = 2;
+		int generation = 0;
+	};
+
+	CriticalSection requestLock;
+	Request pendingRequest;
+	bool hasPendingRequest = false;
+	std::atomic<bool> compiling = { false };
+	std::atomic<int> generation = { 0 };
+
+	snex::jit::GlobalScope scope;
+	ResultFunction resultFunction;
+
+	JUCE_DECLARE_NON_COPYABLE(JitFreezeThread);
+};
+
+#endif
 
 /** A network of multiple DSP objects that are connected using a graph. */
 class DspNetwork : public ConstScriptingObject,
@@ -701,10 +754,23 @@ public:
 
 	bool canBeFrozen() const { return projectNodeHolder.loaded; }
 
-	bool isFrozen() const { return projectNodeHolder.isActive(); }
+	bool isFrozen() const { return projectNodeHolder.isActive() || isJitFrozen(); }
 
 	bool hashMatches();
 
+	/** Compiles the network with the SNEX JIT compiler and processes the compiled instance instead of the node graph.
+
+		The code generation happens synchronously, but the compilation runs on a background thread and the
+		compiled node will be swapped in when it's ready. Any edit to the network will remove the compiled node.
+	*/
+	void setUseJitFrozenNode(bool shouldBeEnabled);
+
+	/** Returns true if the network can be compiled by the SNEX JIT compiler (only monophonic networks are supported). */
+	bool canBeJitFrozen() const;
+
+	/** Returns true if the network is currently processed by the JIT compiled node. */
+	bool isJitFrozen() const;
+
 	void setExternalData(const snex::ExternalData & d, int index);
 
 	ScriptParameterHandler* getCurrentParameterHandler();
@@ -737,6 +803,16 @@ public:
 
 
     bool isSignalDisplayEnabled() const { return signalDisplayEnabled; }
+
+	/** Returns true if the parallel containers can process their children on the realtime worker pool.
+
+		The voice index of the PolyHandler is bound to the audio thread and the node profiler and signal
+		display expect the serial order, so the containers fall back to serial processing in these cases.
+	*/
+	bool canProcessOnWorkerThreads() const
+	{
+		return !isPolyphonic() && !enableCpuProfiling && !signalDisplayEnabled;
+	}
     
     void setSignalDisplayEnabled(bool shouldBeEnabled)
     {
@@ -882,6 +958,85 @@ private:
 		bool loaded = false;
 		bool forwardToNode = false;
 	} projectNodeHolder;
+
+#if HISE_INCLUDE_SNEX
+	struct JitNodeHolder: public hise::ScriptParameterHandler,
+						  public valuetree::AnyListener
+	{
+		JitNodeHolder(DspNetwork& parent);
+
+		~JitNodeHolder();
+
+		Identifier getParameterId(int index) const override;
+
+		int getParameterIndexForIdentifier(const Identifier& id) const override
+		{
+			return network.networkParameterHandler.getParameterIndexForIdentifier(id);
+		}
+
+		int getNumParameters() const override;
+
+		void setParameter(int index, float newValue) override;
+
+		float getParameter(int index) const override;
+
+		bool isActive() const { return forwardToNode; }
+
+		void prepare(PrepareSpecs ps);
+
+		void process(ProcessDataDyn& data);
+
+		/** Creates the SNEX code and starts the compilation. */
+		void compile();
+
+		/** Calls the function with the compiled node under the connection lock. Returns false if the node is being swapped. */
+		template <typename F> bool callWithNode(const F& f)
+		{
+			if (auto sl = SimpleReadWriteLock::ScopedTryReadLock(network.getConnectionLock()))
+			{
+				if (node != nullptr)
+				{
+					f(*node);
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/** Starts the compilation or removes the compiled node. */
+		void setEnabled(bool shouldBeEnabled);
+
+		/** Swaps the compiled node in or out. This must be called on the message thread. */
+		void swapNode(snex::jit::JitCompiledNode::Ptr newNode);
+
+		/** Called on the message thread when the compilation of the given generation is finished. */
+		void compilationFinished(snex::jit::JitCompiledNode::Ptr newNode, int generation);
+
+		/** Removes the compiled node when the network is edited. */
+		void anythingChanged(CallbackType cb) override;
+
+		static bool isEditProperty(const ValueTree& v, const Identifier& id);
+
+		Result lastResult;
+
+		ParameterDataList parameters;
+		float parameterValues[OpaqueNode::NumMaxParameters];
+		DspNetwork& network;
+
+		/** Created on the message thread before the first compilation, the compile thread only copies it.
+		
+			It must be declared before the thread so that it outlives it.
+		*/
+		WeakReference<DspNetwork> safeNetwork;
+
+		/** Every edit cancels the request of this thread so that a pending compilation will not be swapped in. */
+		JitFreezeThread compileThread;
+
+		snex::jit::JitCompiledNode::Ptr node;
+		std::atomic<bool> forwardToNode = { false };
+	} jitNodeHolder;
+#endif
     
 	JUCE_DECLARE_WEAK_REFERENCEABLE(DspNetwork);
 };
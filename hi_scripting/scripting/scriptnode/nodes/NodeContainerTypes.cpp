@@ -99,9 +99,13 @@ void ChainNode::handleHiseEvent(HiseEvent& e)
 }
 
 SplitNode::SplitNode(DspNetwork* root, ValueTree data) :
-	ParallelNode(root, data)
+	ParallelNode(root, data),
+	processInParallel(PropertyIds::ProcessInParallel, false)
 {
 	initListeners();
+
+	processInParallel.initialise(this);
+	processInParallel.setAdditionalCallback(BIND_MEMBER_FUNCTION_2(SplitNode::updateProcessInParallel), true);
 }
 
 void SplitNode::prepare(PrepareSpecs ps)
@@ -114,6 +118,56 @@ void SplitNode::prepare(PrepareSpecs ps)
 		DspHelpers::increaseBuffer(original, ps, false);
 		DspHelpers::increaseBuffer(workBuffer, ps, false);
 	}
+
+	activeNodes.ensureStorageAllocated(nodes.size());
+
+	if (forkJoin.isEnabled() && ps.blockSize > 1 && nodes.size() > 1)
+		branchBuffer.setSize((nodes.size() - 1) * ps.numChannels * ps.blockSize);
+	else
+		branchBuffer.setSize(0);
+}
+
+void SplitNode::updateProcessInParallel(Identifier, var newValue)
+{
+	if (forkJoin.isEnabled() == (bool)newValue)
+		return;
+
+	forkJoin.setEnabled((bool)newValue);
+
+	if (lastSpecs)
+	{
+		SimpleReadWriteLock::ScopedWriteLock sl(getRootNetwork()->getConnectionLock());
+		prepare(lastSpecs);
+	}
+}
+
+void SplitNode::processBranchStatic(void* obj, int branchIndex)
+{
+	auto& s = *static_cast<SplitNode*>(obj);
+	auto& data = *s.currentData;
+	auto n = s.activeNodes.getUnchecked(branchIndex);
+
+	if (branchIndex == 0)
+	{
+		n->process(data);
+		return;
+	}
+
+	auto numSamples = data.getNumSamples();
+	auto numChannels = data.getNumChannels();
+	auto b = s.branchBuffer.begin() + (branchIndex - 1) * numChannels * numSamples;
+
+	float* ptrs[NUM_MAX_CHANNELS];
+
+	for (int i = 0; i < numChannels; i++)
+	{
+		ptrs[i] = b + i * numSamples;
+		FloatVectorOperations::copy(ptrs[i], s.original.begin() + i * numSamples, numSamples);
+	}
+
+	ProcessDataDyn cp(ptrs, numSamples, numChannels);
+	cp.copyNonAudioDataFrom(data);
+	n->process(cp);
 }
 
 void SplitNode::handleHiseEvent(HiseEvent& e)
@@ -154,6 +208,43 @@ void SplitNode::process(ProcessDataDyn& data)
 		}
 	}
 	
+	if (forkJoin.isEnabled())
+	{
+		forkJoin.setSuspended(!getRootNetwork()->canProcessOnWorkerThreads());
+
+		activeNodes.clearQuick();
+
+		for (auto n : nodes)
+		{
+			if (!n->isBypassed())
+				activeNodes.add(n);
+		}
+
+		auto numBranches = activeNodes.size();
+		auto numChannels = data.getNumChannels();
+
+		if (numBranches > 1 && (numBranches - 1) * numChannels * numSamples <= branchBuffer.size())
+		{
+			currentData = &data;
+			forkJoin.process(this, processBranchStatic, numBranches);
+			currentData = nullptr;
+
+			// sum the branches in the original order so that the result doesn't depend on the scheduling
+			const float* b = branchBuffer.begin();
+
+			for (int i = 1; i < numBranches; i++)
+			{
+				for (auto& c : data)
+				{
+					FloatVectorOperations::add(c.getRawWritePointer(), b, numSamples);
+					b += numSamples;
+				}
+			}
+
+			return;
+		}
+	}
+
 	int channelCounter = 0;
 
 	for (auto n : nodes)
@@ -484,9 +575,45 @@ template class FixedBlockNode<128>;
 template class FixedBlockNode<256>;
 
 MultiChannelNode::MultiChannelNode(DspNetwork* root, ValueTree data) :
-	ParallelNode(root, data)
+	ParallelNode(root, data),
+	processInParallel(PropertyIds::ProcessInParallel, false)
 {
 	initListeners();
+
+	processInParallel.initialise(this);
+	processInParallel.setAdditionalCallback(BIND_MEMBER_FUNCTION_2(MultiChannelNode::updateProcessInParallel), true);
+}
+
+void MultiChannelNode::updateProcessInParallel(Identifier, var newValue)
+{
+	forkJoin.setEnabled((bool)newValue);
+}
+
+void MultiChannelNode::processBranchStatic(void* obj, int branchIndex)
+{
+	auto& m = *static_cast<MultiChannelNode*>(obj);
+	auto& d = *m.currentData;
+	auto n = m.nodes[branchIndex];
+
+	int startChannel = 0;
+
+	for (int i = 0; i < branchIndex; i++)
+		startChannel += m.nodes[i]->getCurrentChannelAmount();
+
+	auto numChannelsThisTime = n->getCurrentChannelAmount();
+
+	if (startChannel + numChannelsThisTime > d.getNumChannels())
+		return;
+
+	// use a local channel array because the member array is shared between the branches
+	float* channels[NUM_MAX_CHANNELS];
+
+	for (int i = 0; i < numChannelsThisTime; i++)
+		channels[i] = d[startChannel + i].data;
+
+	ProcessDataDyn td(channels, d.getNumSamples(), numChannelsThisTime);
+	td.copyNonAudioDataFrom(d);
+	n->process(td);
 }
 
 void MultiChannelNode::channelLayoutChanged(NodeBase* nodeThatCausedLayoutChange)
@@ -579,6 +706,16 @@ void MultiChannelNode::process(ProcessDataDyn& d)
 	NodeProfiler np(this, d.getNumSamples());
     ProcessDataPeakChecker pd(this, d);
     TRACE_DSP();
+
+	if (forkJoin.isEnabled())
+	{
+		forkJoin.setSuspended(!getRootNetwork()->canProcessOnWorkerThreads());
+
+		currentData = &d;
+		forkJoin.process(this, processBranchStatic, jmin(NUM_MAX_CHANNELS, nodes.size()));
+		currentData = nullptr;
+		return;
+	}
     
 	int channelIndex = 0;
 
@@ -1041,7 +1178,8 @@ void CloneNode::CloneIterator::resetError()
 }
 
 CloneNode::CloneNode(DspNetwork* n, ValueTree d) :
-	SerialNode(n, d)
+	SerialNode(n, d),
+	processInParallel(PropertyIds::ProcessInParallel, false)
 {
     obj.cloneData.setCloneNode(this);
     
@@ -1084,6 +1222,9 @@ CloneNode::CloneNode(DspNetwork* n, ValueTree d) :
 	displayCloneRangeListener.setCallback(d, { PropertyIds::DisplayedClones }, valuetree::AsyncMode::Synchronously, BIND_MEMBER_FUNCTION_2(CloneNode::updateDisplayedClones));
     
     complexDataSyncer.setCallback(getNodeTree(), { PropertyIds::Index, PropertyIds::EmbeddedData }, valuetree::AsyncMode::Synchronously, BIND_MEMBER_FUNCTION_2(CloneNode::syncCloneProperty));
+
+	processInParallel.initialise(this);
+	processInParallel.setAdditionalCallback(BIND_MEMBER_FUNCTION_2(CloneNode::updateProcessInParallel), true);
     
     if(getNodeTree().getNumChildren() == 0)
     {
@@ -1132,7 +1273,10 @@ void CloneNode::process(ProcessDataDyn& data) noexcept
 	if (isBypassed() && !nodes.isEmpty())
 		nodes.getFirst()->process(data);
 	else
+	{
+		obj.getForkJoin().setSuspended(!getRootNetwork()->canProcessOnWorkerThreads());
         obj.process(data);
+	}
 }
 
 void CloneNode::prepare(PrepareSpecs ps)
@@ -1143,6 +1287,11 @@ void CloneNode::prepare(PrepareSpecs ps)
     obj.prepare(ps);
 }
 
+void CloneNode::updateProcessInParallel(Identifier, var newValue)
+{
+	obj.setProcessInParallel((bool)newValue);
+}
+
 void CloneNode::handleHiseEvent(HiseEvent& e)
 {
     obj.handleHiseEvent(e);
@@ -375,6 +375,10 @@ private:
 
     void updateDisplayedClones(const Identifier&, const var& v);
 
+	void updateProcessInParallel(Identifier, var newValue);
+
+	NodePropertyT<bool> processInParallel;
+
 	BigInteger displayedCloneState;
 
 	static bool sameNodes(const ValueTree& n1, const ValueTree& n2);
@@ -820,7 +824,19 @@ public:
 	void processStereoFrame(StereoFrameType& data) final override;
 
 	heap<float> original, workBuffer;
-	
+
+private:
+
+	void updateProcessInParallel(Identifier, var newValue);
+
+	static void processBranchStatic(void* obj, int branchIndex);
+
+	NodePropertyT<bool> processInParallel;
+	parallel::fork_join forkJoin;
+
+	heap<float> branchBuffer;
+	Array<NodeBase*> activeNodes;
+	ProcessDataDyn* currentData = nullptr;
 };
 
 
@@ -844,6 +860,16 @@ public:
 
 	float* currentChannelData[NUM_MAX_CHANNELS];
 	Range<int> channelRanges[NUM_MAX_CHANNELS];
+
+private:
+
+	void updateProcessInParallel(Identifier, var newValue);
+
+	static void processBranchStatic(void* obj, int branchIndex);
+
+	NodePropertyT<bool> processInParallel;
+	parallel::fork_join forkJoin;
+	ProcessDataDyn* currentData = nullptr;
 };
 
 class BranchNode : public ParallelNode
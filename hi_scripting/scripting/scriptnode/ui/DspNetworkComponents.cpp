@@ -1776,6 +1776,8 @@ bool DspNetworkGraph::Actions::toggleFreeze(DspNetworkGraph& g)
 	{
 		if (g.network->canBeFrozen())
 			g.network->setUseFrozenNode(!g.network->isFrozen());
+		else if (g.network->canBeJitFrozen())
+			g.network->setUseJitFrozenNode(!g.network->isJitFrozen());
 
 		g.repaint();
 
@@ -3209,7 +3211,7 @@ void DspNetworkGraph::WrapperWithMenuBar::rebuildAfterContentChange()
 
     //addButton("debug");
     
-	if(n->canBeFrozen())
+	if(n->canBeFrozen() || n->canBeJitFrozen())
 		addButton("export");
 
 	addButton("zoom");
@@ -3350,7 +3352,7 @@ void DspNetworkGraph::WrapperWithMenuBar::addButton(const String& name)
 			auto s = g.network->getSelection();
 
 			if (s.isEmpty())
-				return g.network->canBeFrozen();
+				return g.network->canBeFrozen() || g.network->canBeJitFrozen();
 			else
 			{
 				if (auto fn = s.getFirst()->getEmbeddedNetwork())
@@ -435,14 +435,31 @@ Node::Ptr ValueTreeBuilder::getNode(const NamespacedIdentifier& id, bool allowZe
 
 
 
+bool ValueTreeBuilder::canProcessInParallel(const ValueTree& n) const
+{
+	if (outputFormat != Format::CppDynamicLibrary || !(bool)ValueTreeIterator::getNodeProperty(n, PropertyIds::ProcessInParallel))
+		return false;
+
+	// The voice index of the PolyHandler only works on the audio thread, so polyphonic children stay serial
+	return !ValueTreeIterator::hasChildNodeWithProperty(n, PropertyIds::IsPolyphonic);
+}
+
 Node::Ptr ValueTreeBuilder::parseNode(const ValueTree& n)
 {
 	if (auto existing = getNode(n, true))
 		return existing;
 
 	auto typeId = getNodeId(n);
+	auto nodePath = getNodePath(n).toString();
 
-	Node::Ptr newNode = createNode(n, typeId.getIdentifier(), getNodePath(n).toString());
+	// The parallel containers need the worker pool of the dll, so we only use them in the C++ export
+	if (canProcessInParallel(n))
+	{
+		if (nodePath == "container::split" || nodePath == "container::multi")
+			nodePath << "_parallel";
+	}
+
+	Node::Ptr newNode = createNode(n, typeId.getIdentifier(), nodePath);
 
 	if (newNode->hasProperty(PropertyIds::UncompileableNode, false))
 	{
@@ -990,6 +1007,9 @@ Node::Ptr ValueTreeBuilder::parseCloneContainer(Node::Ptr u)
     
     cloneClassId << "clone";
     cloneClassId << names[(int)processType];
+
+    if (processType != CloneProcessType::Serial && canProcessInParallel(ct))
+        cloneClassId << "_parallel";
     
     u->setTemplateId(NamespacedIdentifier("wrap").getChildId(cloneClassId));
     
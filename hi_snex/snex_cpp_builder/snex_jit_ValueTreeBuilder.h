@@ -552,7 +552,12 @@ struct ValueTreeBuilder: public Base
 		return c;
 	}
 
-	ValueTreeBuilder(const ValueTree& data, Format outputFormatToUse) :
+	/** Creates a builder for the given network tree.
+	
+		The constructor always uses the CppDynamicLibrary format (the existing callers rely on this), so
+		call setOutputFormat() if you need another format.
+	*/
+	ValueTreeBuilder(const ValueTree& data, Format /*outputFormatToUse*/) :
 		Base(Base::OutputType::AddTabs),
 		v(data),
 		outputFormat(Format::CppDynamicLibrary),
@@ -569,6 +574,13 @@ struct ValueTreeBuilder: public Base
 		setHeaderForFormat();
 	}
 
+	/** Changes the output format. Call this before createCppCode(). */
+	void setOutputFormat(Format newFormat)
+	{
+		outputFormat = newFormat;
+		setHeaderForFormat();
+	}
+
 	BuildResult createCppCode()
 	{
 		rebuild();
@@ -844,6 +856,9 @@ private:
 	Node::Ptr parseSnexNode(Node::Ptr u);
 
 	Node::Ptr parseNode(const ValueTree& n);
+
+	/** Returns true if the container should use the parallel template in the C++ export. */
+	bool canProcessInParallel(const ValueTree& n) const;
 	
 	Node::Ptr parseContainer(Node::Ptr u);
 
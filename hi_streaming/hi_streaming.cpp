@@ -4,6 +4,7 @@
 
 #include "hi_streaming/SampleThreadPool.cpp"
 #include "hi_streaming/MonolithAudioFormat.cpp"
+#include "hi_streaming/SharedPreloadBuffer.cpp"
 #include "hi_streaming/StreamingSampler.cpp"
 #include "hi_streaming/StreamingSamplerSound.cpp"
 #include "hi_streaming/StreamingSamplerVoice.cpp"
@@ -102,6 +102,15 @@ Set this to false to disable the release start feature.
 #define HISE_SAMPLER_ALLOW_RELEASE_START 1
 #endif
 
+/** Config: HISE_SHARE_PRELOAD_BUFFERS
+
+If enabled, the preload buffers of samples that are loaded with the same settings will be shared across all
+plugin instances in the process instead of being allocated for every instance.
+*/
+#ifndef HISE_SHARE_PRELOAD_BUFFERS
+#define HISE_SHARE_PRELOAD_BUFFERS 1
+#endif
+
 
 #include "hi_streaming/lockfree_fifo/readerwriterqueue.h"
 #include "hi_streaming/lockfree_fifo/concurrentqueue.h"
@@ -110,6 +119,7 @@ Set this to false to disable the release start feature.
 
 #include "hi_streaming/SampleThreadPool.h"
 #include "hi_streaming/MonolithAudioFormat.h"
+#include "hi_streaming/SharedPreloadBuffer.h"
 #include "hi_streaming/StreamingSampler.h"
 #include "hi_streaming/StreamingSamplerSound.h"
 #include "hi_streaming/StreamingSamplerVoice.h"
@@ -0,0 +1,203 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise { using namespace juce;
+
+SharedPreloadBuffer::SharedPreloadBuffer(const String& key_, hlac::HiseSampleBuffer&& source) :
+	key(key_),
+	buffer(std::move(source))
+{
+	
+}
+
+size_t SharedPreloadBuffer::getNumBytes() const noexcept
+{
+	auto bytesPerSample = buffer.isFloatingPoint() ? sizeof(float) : sizeof(int16);
+	return (size_t)buffer.getNumSamples() * (size_t)buffer.getNumChannels() * bytesPerSample;
+}
+
+String SharedPreloadBufferStore::Statistics::toString() const
+{
+	String s;
+
+	s << String(numBuffers) << " shared buffers, ";
+	s << String((double)numBytesUsed / 1024.0 / 1024.0, 2) << "MB used, ";
+	s << String((double)numBytesSaved / 1024.0 / 1024.0, 2) << "MB saved";
+
+	return s;
+}
+
+SharedPreloadBufferStore::SharedPreloadBufferStore()
+{
+
+}
+
+SharedPreloadBufferStore::~SharedPreloadBufferStore()
+{
+	// All sounds must have released their buffers...
+	jassert(buffers.size() == 0);
+}
+
+SharedPreloadBuffer::Ptr SharedPreloadBufferStore::getBuffer(const String& key)
+{
+	ScopedLock sl(lock);
+	return buffers[key];
+}
+
+SharedPreloadBuffer::Ptr SharedPreloadBufferStore::addBuffer(const String& key, hlac::HiseSampleBuffer&& source)
+{
+	ScopedLock sl(lock);
+
+	if (auto existing = buffers[key])
+		return existing;
+
+	SharedPreloadBuffer::Ptr newBuffer = new SharedPreloadBuffer(key, std::move(source));
+	buffers.set(key, newBuffer);
+	return newBuffer;
+}
+
+void SharedPreloadBufferStore::releaseBuffer(SharedPreloadBuffer::Ptr& b)
+{
+	if (b == nullptr)
+		return;
+
+	ScopedLock sl(lock);
+
+	SharedPreloadBuffer::Ptr toRelease = b;
+	b = nullptr;
+
+	// one reference for the hash map and one for toRelease
+	if (toRelease->getReferenceCount() == 2)
+		buffers.remove(toRelease->key);
+}
+
+SharedPreloadBufferStore::Statistics SharedPreloadBufferStore::getStatistics() const
+{
+	ScopedLock sl(lock);
+
+	Statistics s;
+
+	for (HashMap<String, SharedPreloadBuffer::Ptr>::Iterator i(buffers); i.next();)
+	{
+		auto b = i.getValue();
+
+		// the hash map and the local pointer hold a reference
+		auto numUsers = b->getReferenceCount() - 2;
+		auto numBytes = (int64)b->getNumBytes();
+
+		s.numBuffers++;
+		s.numReferences += numUsers;
+		s.numBytesUsed += numBytes;
+		s.numBytesSaved += jmax(0, numUsers - 1) * numBytes;
+	}
+
+	return s;
+}
+
+#if HI_RUN_UNIT_TESTS
+
+/** Checks that sounds which load the same sample region share one preload buffer. */
+class SharedPreloadBufferTests : public UnitTest
+{
+public:
+
+	SharedPreloadBufferTests() :
+		UnitTest("Testing shared preload buffers")
+	{};
+
+	void runTest() override
+	{
+#if HISE_SHARE_PRELOAD_BUFFERS
+		beginTest("Testing identical samples");
+
+		TemporaryFile tempFile(".wav");
+		writeTestFile(tempFile.getFile());
+
+		SharedResourcePointer<SharedPreloadBufferStore> store;
+		StreamingSamplerSoundPool pool;
+
+		auto numBuffersBefore = store->getStatistics().numBuffers;
+
+		{
+			auto path = tempFile.getFile().getFullPathName();
+
+			StreamingSamplerSound s1(path, &pool);
+			StreamingSamplerSound s2(path, &pool);
+			StreamingSamplerSound s3(path, &pool);
+
+			s3.setSampleStart(1000);
+
+			for (auto s : { &s1, &s2, &s3 })
+				s->setPreloadSize(4096, true);
+
+			expect(s1.isPreloadBufferShared(), "first sound isn't shared");
+			expect(s2.isPreloadBufferShared(), "second sound isn't shared");
+
+			expect(s1.getPreloadBuffer().getReadPointer(0) == s2.getPreloadBuffer().getReadPointer(0), "identical samples don't share the data");
+			expect(s1.getPreloadBuffer().getReadPointer(0) != s3.getPreloadBuffer().getReadPointer(0), "different sample start shares the data");
+
+			auto stats = store->getStatistics();
+
+			expectEquals(stats.numBuffers - numBuffersBefore, 2, "buffer amount mismatch");
+
+			auto data = static_cast<const float*>(s2.getPreloadBuffer().getReadPointer(0));
+			expectEquals(data[100], 100.0f / (float)NumSamples, "preload data mismatch");
+		}
+
+		expectEquals(store->getStatistics().numBuffers, numBuffersBefore, "buffers were not released");
+#endif
+	}
+
+private:
+
+	static constexpr int NumSamples = 8192;
+
+	void writeTestFile(const File& f)
+	{
+		AudioSampleBuffer b(1, NumSamples);
+
+		for (int i = 0; i < NumSamples; i++)
+			b.setSample(0, i, (float)i / (float)NumSamples);
+
+		WavAudioFormat wav;
+
+		if (auto writer = std::unique_ptr<AudioFormatWriter>(wav.createWriterFor(new FileOutputStream(f), 44100.0, 1, 32, {}, 0)))
+			writer->writeFromAudioSampleBuffer(b, 0, NumSamples);
+	}
+};
+
+static SharedPreloadBufferTests sharedPreloadBufferTests;
+
+#endif
+
+} // namespace hise
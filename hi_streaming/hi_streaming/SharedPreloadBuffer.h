@@ -0,0 +1,123 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#ifndef SHAREDPRELOADBUFFER_H_INCLUDED
+#define SHAREDPRELOADBUFFER_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A read-only preload buffer that is shared by all StreamingSamplerSounds in the process which load the same sample
+	region with the same settings.
+	@ingroup sampler
+
+	The buffer is created and released by the SharedPreloadBufferStore, the sounds only keep a reference to it and
+	refer to its data using HiseSampleBuffer::referToData().
+*/
+class SharedPreloadBuffer : public ReferenceCountedObject
+{
+public:
+
+	using Ptr = ReferenceCountedObjectPtr<SharedPreloadBuffer>;
+
+	/** Returns the sample data. */
+	const hlac::HiseSampleBuffer& getBuffer() const noexcept { return buffer; }
+
+	/** Returns the size of the sample data in bytes. */
+	size_t getNumBytes() const noexcept;
+
+private:
+
+	friend class SharedPreloadBufferStore;
+
+	SharedPreloadBuffer(const String& key, hlac::HiseSampleBuffer&& source);
+
+	const String key;
+	hlac::HiseSampleBuffer buffer;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedPreloadBuffer);
+};
+
+/** The process wide storage for SharedPreloadBuffers.
+	@ingroup sampler
+
+	If multiple plugin instances load the same instrument, every StreamingSamplerSound would allocate its own
+	preload buffer with identical data. Instead, the sounds look up their preload buffer in this store using
+	a key that contains the file identity, the sample range and the format, and share the data read-only.
+
+	Use it with a SharedResourcePointer. All reference counting of the SharedPreloadBuffers is done with the
+	lock of this store, so always use getBuffer(), addBuffer() and releaseBuffer() to manage the references.
+*/
+class SharedPreloadBufferStore
+{
+public:
+
+	struct Statistics
+	{
+		String toString() const;
+
+		int numBuffers = 0;			///< the number of buffers in the store
+		int numReferences = 0;		///< the number of sounds that use a shared buffer
+		int64 numBytesUsed = 0;		///< the memory used by the shared buffers
+		int64 numBytesSaved = 0;	///< the memory that would be used additionally without sharing
+	};
+
+	SharedPreloadBufferStore();
+	~SharedPreloadBufferStore();
+
+	/** Returns the buffer for the given key or nullptr if it hasn't been added yet. */
+	SharedPreloadBuffer::Ptr getBuffer(const String& key);
+
+	/** Moves the data into a new shared buffer for the given key.
+	*
+	*	If the key was added in the meantime by another thread, the existing buffer will be returned
+	*	and the source is left untouched.
+	*/
+	SharedPreloadBuffer::Ptr addBuffer(const String& key, hlac::HiseSampleBuffer&& source);
+
+	/** Releases the reference and removes the buffer from the store if it's not used anymore. */
+	void releaseBuffer(SharedPreloadBuffer::Ptr& b);
+
+	/** Returns the memory statistics of all shared buffers. */
+	Statistics getStatistics() const;
+
+private:
+
+	CriticalSection lock;
+	HashMap<String, SharedPreloadBuffer::Ptr> buffers;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedPreloadBufferStore);
+};
+
+} // namespace hise
+
+#endif  // SHAREDPRELOADBUFFER_H_INCLUDED
@@ -82,6 +82,8 @@ StreamingSamplerSound::StreamingSamplerSound(HlacMonolithInfo::Ptr info, int cha
 
 StreamingSamplerSound::~StreamingSamplerSound()
 {
+	preloadBuffer = hlac::HiseSampleBuffer();
+	releaseSharedPreloadBuffer();
 	fileReader.closeFileHandles();
 }
 
@@ -170,6 +172,7 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 		entireSampleLoaded = false;
 		preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
+		releaseSharedPreloadBuffer();
 
 		return;
 	}
@@ -209,7 +212,44 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 	auto sampleStartToUse = isReversed() ? 0 : sampleStart;
 
+	if (sampleRate <= 0.0)
+	{
+		if (AudioFormatReader *reader = fileReader.getReader())
+		{
+			sampleRate = reader->sampleRate;
+			sampleEnd = jmin<int>(sampleEnd, (int)reader->lengthInSamples);
+			sampleLength = jmax<int>(0, sampleEnd - sampleStart);
+			loopEnd = jmin(loopEnd, sampleEnd);
+		}
+	}
+
 	preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
+	releaseSharedPreloadBuffer();
+
+#if HISE_SHARE_PRELOAD_BUFFERS
+	auto sharedKey = getSharedPreloadKey(sampleStartToUse);
+
+	if (sharedKey.isNotEmpty())
+	{
+		sharedPreload = preloadStore->getBuffer(sharedKey);
+
+		if (sharedPreload != nullptr)
+		{
+			// Another sound has already loaded the exact same data, so we just need
+			// to refer to it and rebuild the (small) loop and release buffers.
+			preloadBuffer.referToData(sharedPreload->getBuffer());
+
+			rebuildCrossfadeBuffer();
+
+#if HISE_SAMPLER_ALLOW_RELEASE_START
+			rebuildReleaseStartBuffer();
+#endif
+
+			applyCrossfadeToInternalBuffers();
+			return;
+		}
+	}
+#endif
 
 	try
 	{
@@ -229,17 +269,6 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 	preloadBuffer.clear();
 	preloadBuffer.allocateNormalisationTables(sampleStartToUse);
-
-	if (sampleRate <= 0.0)
-	{
-		if (AudioFormatReader *reader = fileReader.getReader())
-		{
-			sampleRate = reader->sampleRate;
-			sampleEnd = jmin<int>(sampleEnd, (int)reader->lengthInSamples);
-			sampleLength = jmax<int>(0, sampleEnd - sampleStart);
-			loopEnd = jmin(loopEnd, sampleEnd);
-		}
-	}
 	
 	bool applyLoopToPreloadBuffer = ((loopEnd - sampleStart) < internalPreloadSize) && !isReleaseStartEnabled();
 	
@@ -308,9 +337,51 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 #endif
 
 	applyCrossfadeToInternalBuffers();
+
+#if HISE_SHARE_PRELOAD_BUFFERS
+	if (sharedKey.isNotEmpty())
+	{
+		// the data is moved into the store, so a new buffer doesn't need to be copied
+		sharedPreload = preloadStore->addBuffer(sharedKey, std::move(preloadBuffer));
+		preloadBuffer.referToData(sharedPreload->getBuffer());
+	}
+#endif
+}
+
+String StreamingSamplerSound::getSharedPreloadKey(int sampleStartToUse) const
+{
+	auto fileId = fileReader.getSharedIdentifier();
+
+	if (fileId.isEmpty())
+		return {};
+
+	String key;
+
+	key << fileId << ";";
+	key << (fileReader.isMonolithic() ? "int16" : "float") << ";";
+	key << (fileReader.isStereo() ? 2 : 1) << ";";
+	key << sampleStartToUse << ";" << sampleEnd << ";" << sampleLength << ";";
+	key << internalPreloadSize << ";";
+	key << (isReversed() ? "reversed" : "normal") << ";";
+
+	if (loopEnabled)
+		key << "loop:" << loopStart << ":" << loopEnd << ":" << crossfadeLength << ":" << crossfadeGamma << ";";
+
+	key << (isReleaseStartEnabled() ? "release" : "norelease");
+
+	return key;
 }
 
+void StreamingSamplerSound::releaseSharedPreloadBuffer()
+{
+	if (sharedPreload != nullptr)
+	{
+		// the preload buffer must not refer to the shared data anymore
+		jassert(preloadBuffer.getNumSamples() == 0);
 
+		preloadStore->releaseBuffer(sharedPreload);
+	}
+}
 
 size_t StreamingSamplerSound::getActualPreloadSize() const
 {
@@ -615,7 +686,8 @@ void StreamingSamplerSound::applyCrossfadeToInternalBuffers()
 
 		auto numInBuffer = preloadBuffer.getNumSamples();
 		
-		if (fadePos < numInBuffer && !isReleaseStartEnabled())
+		// a shared preload buffer already contains the crossfade
+		if (fadePos < numInBuffer && !isReleaseStartEnabled() && sharedPreload == nullptr)
 		{
 			preloadBuffer.burnNormalisation();
 
@@ -666,10 +738,13 @@ void StreamingSamplerSound::loopChanged()
 		if (isReversed())
 			preloadContainsLoop = getLoopEnd(true) <= preloadBuffer.getNumSamples();
 
+		bool preloadWasRebuilt = false;
+
 		if (preloadContainsLoop)
 		{
 			smallLoopBuffer = nullptr;
 			setPreloadSize(preloadSize, true);
+			preloadWasRebuilt = true;
 		}
 		else if (getLoopLength() < 8192)
 		{
@@ -682,10 +757,19 @@ void StreamingSamplerSound::loopChanged()
 			smallLoopBuffer = nullptr;
 		}
 
-        if(crossfadeLength != 0)
+        // setPreloadSize() already rebuilt the crossfade
+        if(crossfadeLength != 0 && !preloadWasRebuilt)
         {
-            rebuildCrossfadeBuffer();
-            applyCrossfadeToInternalBuffers();
+			if (sharedPreload != nullptr)
+			{
+				// the shared buffer can't be modified, so we need to fetch the one with the new loop settings
+				setPreloadSize(preloadSize, true);
+			}
+			else
+			{
+				rebuildCrossfadeBuffer();
+				applyCrossfadeToInternalBuffers();
+			}
         }
 	}
 	else
@@ -1103,6 +1187,30 @@ String StreamingSamplerSound::FileReader::getFileName(bool getFullPath)
 	else return getFullPath ? loadedFile.getFullPathName() : loadedFile.getFileName();
 }
 
+String StreamingSamplerSound::FileReader::getSharedIdentifier() const
+{
+	if (missing)
+		return {};
+
+	if (monolithicInfo != nullptr)
+	{
+		auto mf = monolithicInfo->getFile(monolithicChannelIndex, monolithicIndex);
+
+		String id;
+		id << mf.getFullPathName() << ":" << mf.getLastModificationTime().toMilliseconds() << ":" << getMonolithOffset();
+		return id;
+	}
+
+	if (loadedFile.existsAsFile())
+	{
+		String id;
+		id << loadedFile.getFullPathName() << ":" << loadedFile.getLastModificationTime().toMilliseconds() << ":" << loadedFile.getSize();
+		return id;
+	}
+
+	return {};
+}
+
 void StreamingSamplerSound::FileReader::checkFileReference()
 {
 	if (monolithicInfo != nullptr) return;
@@ -252,6 +252,12 @@ public:
 	*/
 	void loadEntireSample();
 
+	/** Checks if the preload buffer is shared with other sounds that load the same sample with the same settings.
+	*
+	*	@see SharedPreloadBufferStore
+	*/
+	bool isPreloadBufferShared() const noexcept { return sharedPreload != nullptr; }
+
 	/** increases the voice counter. */
 	void increaseVoiceCount() const;
 
@@ -370,6 +376,9 @@ private:
 		void checkFileReference();
 		int64 getHashCode() { return hashCode; };
 
+		/** Returns a string that identifies the sample data of this file (or the part of the monolith) across all instances. */
+		String getSharedIdentifier() const;
+
 		/** Refreshes the information about the file (if it is missing, if it supports memory-mapping). */
 		void refreshFileInformation();
 
@@ -517,6 +526,11 @@ private:
 	void loopChanged();
 	void lengthChanged();
 
+	/** Creates the key for the SharedPreloadBufferStore from the file and all properties that change the preload buffer. */
+	String getSharedPreloadKey(int sampleStartToUse) const;
+
+	void releaseSharedPreloadBuffer();
+
 	void calculateCrossfadeArea();
     void rebuildCrossfadeBuffer();
 	void applyCrossfadeToInternalBuffers();
@@ -546,6 +560,10 @@ private:
 	hlac::HiseSampleBuffer preloadBuffer;
 	double sampleRate;
 
+	// if this is not nullptr, the preload buffer refers to its data
+	SharedPreloadBuffer::Ptr sharedPreload;
+	SharedResourcePointer<SharedPreloadBufferStore> preloadStore;
+
 	int preloadSize;
 	int internalPreloadSize;
 
@@ -7,8 +7,11 @@
 
 namespace gin {
 
-#if JUCE_INTEL
+// On ARM the SSE2 intrinsics are mapped to NEON by sse2neon.h
+#if JUCE_INTEL || JUCE_ARM
  #define GIN_USE_SSE 1
+#else
+ #define GIN_USE_SSE 0
 #endif
 
 //==============================================================================
@@ -25,25 +28,15 @@ void multiThreadedFor(int start, int end, int interval, juce::ThreadPool* thread
 	}
 	else
 	{
-		int num = threadPool->getNumThreads();
-
-		juce::WaitableEvent wait;
-		juce::Atomic<int> threadsRunning(num);
-
-		for (int i = 0; i < num; i++)
-		{
-			threadPool->addJob([i, &callback, &wait, &threadsRunning, start, end, interval, num]
-				{
-					for (int j = start + interval * i; j < end; j += interval * num)
-						callback(j);
-
-					int stillRunning = --threadsRunning;
-					if (stillRunning == 0)
-						wait.signal();
-				});
-		}
-
-		wait.wait();
+		// The calling thread takes part and doesn't wait for jobs that haven't started, so this
+		// doesn't block if the pool is busy (or if it's called from a job of the same pool).
+		std::atomic<int> next { start };
+
+		hise::SharedWorkerPool::runOnWorkers(*threadPool, [&] (int)
+			{
+				for (int j = next.fetch_add (interval); j < end; j = next.fetch_add (interval))
+					callback(j);
+			});
 	}
 }
 
@@ -89,6 +82,89 @@ inline T2 convert (const T1& in)
     return out;
 }
 
+// Returns true if the SIMD kernels can process the rows of this bitmap (4 byte BGRA pixels).
+template <class T>
+inline bool canUseSimdKernels (const juce::Image::BitmapData& data)
+{
+   #if GIN_USE_SSE
+    return std::is_same<T, juce::PixelARGB>::value && data.pixelStride == 4;
+   #else
+    juce::ignoreUnused (data);
+    return false;
+   #endif
+}
+
+#if GIN_USE_SSE
+// A mask that selects the alpha bytes of four BGRA pixels
+inline __m128i getAlphaMask()
+{
+    return _mm_set1_epi32 ((int)0xFF000000);
+}
+
+// Computes 5 * c - u - d - l - r for four pixels and keeps the alpha of the center pixel
+inline void sharpenFourPixels (uint8_t* dst, const uint8_t* c, const uint8_t* u, const uint8_t* d, const uint8_t* l, const uint8_t* r)
+{
+    auto zero = _mm_setzero_si128();
+
+    auto cv = _mm_loadu_si128 ((const __m128i*)c);
+    auto uv = _mm_loadu_si128 ((const __m128i*)u);
+    auto dv = _mm_loadu_si128 ((const __m128i*)d);
+    auto lv = _mm_loadu_si128 ((const __m128i*)l);
+    auto rv = _mm_loadu_si128 ((const __m128i*)r);
+
+    auto sharpenHalf = [&] (__m128i c16, __m128i u16, __m128i d16, __m128i l16, __m128i r16)
+    {
+        auto v = _mm_add_epi16 (_mm_slli_epi16 (c16, 2), c16);
+        v = _mm_sub_epi16 (v, _mm_add_epi16 (u16, d16));
+        return _mm_sub_epi16 (v, _mm_add_epi16 (l16, r16));
+    };
+
+    auto lo = sharpenHalf (_mm_unpacklo_epi8 (cv, zero), _mm_unpacklo_epi8 (uv, zero), _mm_unpacklo_epi8 (dv, zero),
+                           _mm_unpacklo_epi8 (lv, zero), _mm_unpacklo_epi8 (rv, zero));
+    auto hi = sharpenHalf (_mm_unpackhi_epi8 (cv, zero), _mm_unpackhi_epi8 (uv, zero), _mm_unpackhi_epi8 (dv, zero),
+                           _mm_unpackhi_epi8 (lv, zero), _mm_unpackhi_epi8 (rv, zero));
+
+    // packus clamps to 0...255 just like toByte()
+    auto result = _mm_packus_epi16 (lo, hi);
+
+    auto alphaMask = getAlphaMask();
+    result = _mm_or_si128 (_mm_andnot_si128 (alphaMask, result), _mm_and_si128 (alphaMask, cv));
+
+    _mm_storeu_si128 ((__m128i*)dst, result);
+}
+
+// Averages the 3x3 neighbourhood of four pixels and keeps the alpha of the center pixel
+inline void softenFourPixels (uint8_t* dst, const uint8_t* above, const uint8_t* row, const uint8_t* below)
+{
+    auto zero = _mm_setzero_si128();
+    auto sumLo = _mm_setzero_si128();
+    auto sumHi = _mm_setzero_si128();
+
+    for (auto line : { above, row, below })
+    {
+        for (int offset = -4; offset <= 4; offset += 4)
+        {
+            auto v = _mm_loadu_si128 ((const __m128i*)(line + offset));
+            sumLo = _mm_add_epi16 (sumLo, _mm_unpacklo_epi8 (v, zero));
+            sumHi = _mm_add_epi16 (sumHi, _mm_unpackhi_epi8 (v, zero));
+        }
+    }
+
+    // (sum * 7282) >> 16 == sum / 9 for all sums up to 9 * 255
+    auto divideByNine = _mm_set1_epi16 (7282);
+    sumLo = _mm_mulhi_epu16 (sumLo, divideByNine);
+    sumHi = _mm_mulhi_epu16 (sumHi, divideByNine);
+
+    auto result = _mm_packus_epi16 (sumLo, sumHi);
+
+    auto alphaMask = getAlphaMask();
+    auto cv = _mm_loadu_si128 ((const __m128i*)row);
+    result = _mm_or_si128 (_mm_andnot_si128 (alphaMask, result), _mm_and_si128 (alphaMask, cv));
+
+    _mm_storeu_si128 ((__m128i*)dst, result);
+}
+#endif
+
 //==============================================================================
 template <class T>
 void applyVignette (juce::Image& img, float amountIn, float radiusIn, float fallOff, juce::ThreadPool* threadPool)
@@ -224,6 +300,15 @@ void applyGreyScale (juce::Image& img, juce::ThreadPool* threadPool)
 
     juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
 
+    uint8_t redTable[256], greenTable[256], blueTable[256];
+
+    for (int i = 0; i < 256; i++)
+    {
+        redTable[i]   = toByte (i * 0.30 + 0.5);
+        greenTable[i] = toByte (i * 0.59 + 0.5);
+        blueTable[i]  = toByte (i * 0.11 + 0.5);
+    }
+
     multiThreadedFor(0, h, 1, threadPool, [&] (int y)
     {
         uint8_t* p = data.getLinePointer (y);
@@ -232,19 +317,10 @@ void applyGreyScale (juce::Image& img, juce::ThreadPool* threadPool)
         {
             T* s = (T*)p;
 
-            uint8_t r = s->getRed();
-            uint8_t g = s->getGreen();
-            uint8_t b = s->getBlue();
             uint8_t a = s->getAlpha();
+            auto grey = toByte (redTable[s->getRed()] + greenTable[s->getGreen()] + blueTable[s->getBlue()]);
 
-            uint8_t ro = toByte (r * 0.30 + 0.5);
-            uint8_t go = toByte (g * 0.59 + 0.5);
-            uint8_t bo = toByte (b * 0.11 + 0.5);
-
-            s->setARGB (a,
-                        toByte (ro + go + bo),
-                        toByte (ro + go + bo),
-                        toByte (ro + go + bo));
+            s->setARGB (a, grey, grey, grey);
 
             p += data.pixelStride;
         }
@@ -270,9 +346,11 @@ void applySoften (juce::Image& img, juce::ThreadPool* threadPool)
     juce::Image::BitmapData srcData (img, juce::Image::BitmapData::readOnly);
     juce::Image::BitmapData dstData (dst, juce::Image::BitmapData::writeOnly);
 
+    const bool useSimd = canUseSimdKernels<T> (srcData) && dstData.pixelStride == 4;
+
     multiThreadedFor(0, h, 1, threadPool, [&] (int y)
     {
-        for (int x = 0; x < w; x++)
+        auto softenPixel = [&] (int x)
         {
             int ro = 0, go = 0, bo = 0;
             uint8_t a = 0;
@@ -298,7 +376,28 @@ void applySoften (juce::Image& img, juce::ThreadPool* threadPool)
             T* d = (T*) dstData.getPixelPointer (x, y);
 
             d->setARGB (a, toByte (ro / 9), toByte (go / 9), toByte (bo / 9));
+        };
+
+        int x = 0;
+
+       #if GIN_USE_SSE
+        // the interior pixels don't need the edge clamping
+        if (useSimd && y > 0 && y < h - 1)
+        {
+            softenPixel (x++);
+
+            auto above = srcData.getLinePointer (y - 1);
+            auto row   = srcData.getLinePointer (y);
+            auto below = srcData.getLinePointer (y + 1);
+            auto d     = dstData.getLinePointer (y);
+
+            for (; x + 4 <= w - 1; x += 4)
+                softenFourPixels (d + x * 4, above + x * 4, row + x * 4, below + x * 4);
         }
+       #endif
+
+        for (; x < w; x++)
+            softenPixel (x);
     });
     img = dst;
 }
@@ -322,9 +421,11 @@ void applySharpen (juce::Image& img, juce::ThreadPool* threadPool)
     juce::Image::BitmapData srcData (img, juce::Image::BitmapData::readOnly);
     juce::Image::BitmapData dstData (dst, juce::Image::BitmapData::writeOnly);
 
+    const bool useSimd = canUseSimdKernels<T> (srcData) && dstData.pixelStride == 4;
+
     multiThreadedFor(0, h, 1, threadPool, [&] (int y)
     {
-        for (int x = 0; x < w; x++)
+        auto sharpenPixel = [&] (int x)
         {
             auto getPixelPointer = [&] (int cx, int cy) -> T*
             {
@@ -367,7 +468,28 @@ void applySharpen (juce::Image& img, juce::ThreadPool* threadPool)
             T* d = (T*) dstData.getPixelPointer (x, y);
 
             d->setARGB (ao, toByte (ro), toByte (go), toByte (bo));
+        };
+
+        int x = 0;
+
+       #if GIN_USE_SSE
+        // the interior pixels don't need the edge clamping
+        if (useSimd && y > 0 && y < h - 1)
+        {
+            sharpenPixel (x++);
+
+            auto above = srcData.getLinePointer (y - 1);
+            auto row   = srcData.getLinePointer (y);
+            auto below = srcData.getLinePointer (y + 1);
+            auto d     = dstData.getLinePointer (y);
+
+            for (; x + 4 <= w - 1; x += 4)
+                sharpenFourPixels (d + x * 4, row + x * 4, above + x * 4, below + x * 4, row + (x - 1) * 4, row + (x + 1) * 4);
         }
+       #endif
+
+        for (; x < w; x++)
+            sharpenPixel (x);
     });
     img = dst;
 }
@@ -388,6 +510,12 @@ void applyGamma (juce::Image& img, float gamma, juce::ThreadPool* threadPool)
 
     juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
 
+    // There are only 256 possible input values, so we calculate the pow() once for each of them
+    uint8_t gammaTable[256];
+
+    for (int i = 0; i < 256; i++)
+        gammaTable[i] = toByte (std::pow (i / 255.0, gamma) * 255.0 + 0.5);
+
     multiThreadedFor(0, h, 1, threadPool, [&] (int y)
     {
         uint8_t* p = data.getLinePointer (y);
@@ -396,16 +524,7 @@ void applyGamma (juce::Image& img, float gamma, juce::ThreadPool* threadPool)
         {
             T* s = (T*)p;
 
-            uint8_t r = s->getRed();
-            uint8_t g = s->getGreen();
-            uint8_t b = s->getBlue();
-            uint8_t a = s->getAlpha();
-
-            uint8_t ro = toByte (std::pow (r / 255.0, gamma) * 255.0 + 0.5);
-            uint8_t go = toByte (std::pow (g / 255.0, gamma) * 255.0 + 0.5);
-            uint8_t bo = toByte (std::pow (b / 255.0, gamma) * 255.0 + 0.5);
-
-            s->setARGB (a, ro, go, bo);
+            s->setARGB (s->getAlpha(), gammaTable[s->getRed()], gammaTable[s->getGreen()], gammaTable[s->getBlue()]);
 
             p += data.pixelStride;
         }
@@ -428,11 +547,28 @@ void applyInvert (juce::Image& img, juce::ThreadPool* threadPool)
 
     juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
 
+    const bool useSimd = canUseSimdKernels<T> (data);
+
     multiThreadedFor(0, h, 1, threadPool, [&] (int y)
     {
         uint8_t* p = data.getLinePointer (y);
+        int x = 0;
 
-        for (int x = 0; x < w; x++)
+       #if GIN_USE_SSE
+        if (useSimd)
+        {
+            auto colourMask = _mm_set1_epi32 (0x00FFFFFF);
+
+            for (; x + 4 <= w; x += 4)
+            {
+                auto v = _mm_loadu_si128 ((const __m128i*)p);
+                _mm_storeu_si128 ((__m128i*)p, _mm_xor_si128 (v, colourMask));
+                p += 16;
+            }
+        }
+       #endif
+
+        for (; x < w; x++)
         {
             T* s = (T*)p;
 
@@ -471,6 +607,19 @@ void applyContrast (juce::Image& img, float contrast, juce::ThreadPool* threadPo
 
     juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
 
+    uint8_t contrastTable[256];
+
+    for (int i = 0; i < 256; i++)
+    {
+        double v = (double) i / 255.0;
+        v = v - 0.5;
+        v = v * contrast;
+        v = v + 0.5;
+        v = v * 255.0;
+
+        contrastTable[i] = toByte (v);
+    }
+
     multiThreadedFor(0, h, 1, threadPool, [&] (int y)
     {
         uint8_t* p = data.getLinePointer (y);
@@ -479,34 +628,7 @@ void applyContrast (juce::Image& img, float contrast, juce::ThreadPool* threadPo
         {
             T* s = (T*)p;
 
-            uint8_t r = s->getRed();
-            uint8_t g = s->getGreen();
-            uint8_t b = s->getBlue();
-            uint8_t a = s->getAlpha();
-
-            double ro = (double) r / 255.0;
-            ro = ro - 0.5;
-            ro = ro * contrast;
-            ro = ro + 0.5;
-            ro = ro * 255.0;
-
-            double go = (double) g / 255.0;
-            go = go - 0.5;
-            go = go * contrast;
-            go = go + 0.5;
-            go = go * 255.0;
-
-            double bo = (double) b / 255.0;
-            bo = bo - 0.5;
-            bo = bo * contrast;
-            bo = bo + 0.5;
-            bo = bo * 255.0;
-
-            ro = toByte (ro);
-            go = toByte (go);
-            bo = toByte (bo);
-
-            s->setARGB (a, toByte (ro), toByte (go), toByte (bo));
+            s->setARGB (s->getAlpha(), contrastTable[s->getRed()], contrastTable[s->getGreen()], contrastTable[s->getBlue()]);
 
             p += data.pixelStride;
         }
@@ -776,6 +898,21 @@ void applyGradientMap (juce::Image& img, const juce::ColourGradient& gradient, j
 
     juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
 
+    uint8_t redTable[256], greenTable[256], blueTable[256];
+
+    for (int i = 0; i < 256; i++)
+    {
+        redTable[i]   = toByte (i * 0.30 + 0.5);
+        greenTable[i] = toByte (i * 0.59 + 0.5);
+        blueTable[i]  = toByte (i * 0.11 + 0.5);
+    }
+
+    // The weighted sum of the channels can't exceed 255, so we can look up the gradient colours
+    juce::uint32 gradientTable[256];
+
+    for (int i = 0; i < 256; i++)
+        gradientTable[i] = gradient.getColourAtPosition (float (i) / 256.0f).getARGB();
+
     multiThreadedFor (0, h, 1, threadPool, [&] (int y)
                            {
                                uint8_t* p = data.getLinePointer (y);
@@ -784,18 +921,11 @@ void applyGradientMap (juce::Image& img, const juce::ColourGradient& gradient, j
                                {
                                    T* s = (T*)p;
 
-                                   uint8_t r = s->getRed();
-                                   uint8_t g = s->getGreen();
-                                   uint8_t b = s->getBlue();
                                    uint8_t a = s->getAlpha();
 
-                                   uint8_t ro = toByte (r * 0.30 + 0.5);
-                                   uint8_t go = toByte (g * 0.59 + 0.5);
-                                   uint8_t bo = toByte (b * 0.11 + 0.5);
-
-                                   float proportion = float (ro + go + bo) / 256.0f;
+                                   int intensity = redTable[s->getRed()] + greenTable[s->getGreen()] + blueTable[s->getBlue()];
 
-                                   auto c = gradient.getColourAtPosition (proportion);
+                                   auto c = juce::Colour (gradientTable[intensity]);
 
                                    s->setARGB (a,
                                                c.getRed(),
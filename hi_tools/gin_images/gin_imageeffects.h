@@ -62,7 +62,7 @@ void applyHueSaturationLightness (juce::Image& img, float hue, float saturation,
  *
  \param radius from 2 to 254
  */
-void applyStackBlur (juce::Image& img, int radius);
+void applyStackBlur (juce::Image& img, int radius, juce::ThreadPool* threadPool = nullptr);
 
 /** A very high quality image resize using a bank of sinc
  *  function-based fractional delay filters */
@@ -444,18 +444,13 @@ static void applyStackBlurRGB (juce::Image& img, unsigned int radius)
     }
 }
 
-static void applyStackBlurARGB (juce::Image& img, unsigned int radius)
+// Blurs a single line of ARGB pixels in place. The step is the distance in bytes between two
+// neighbouring pixels so this can be used for both the horizontal and the vertical pass.
+static void applyStackBlurLineARGB (unsigned char* line, unsigned int length, unsigned int step, unsigned int radius)
 {
-    const unsigned int w = (unsigned int)img.getWidth();
-    const unsigned int h = (unsigned int)img.getHeight();
-
-    juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
-
-    radius = juce::jlimit (2u, 254u, radius);
+    unsigned char stack[(254 * 2 + 1) * 4];
 
-    unsigned char    stack[(254 * 2 + 1) * 4];
-
-    unsigned int x, y, xp, yp, i, sp, stack_start;
+    unsigned int i, xp, sp, stack_start;
 
     unsigned char* stack_ptr = nullptr;
     unsigned char* src_ptr = nullptr;
@@ -464,241 +459,152 @@ static void applyStackBlurARGB (juce::Image& img, unsigned int radius)
     unsigned long sum_r, sum_g, sum_b, sum_a, sum_in_r, sum_in_g, sum_in_b, sum_in_a,
     sum_out_r, sum_out_g, sum_out_b, sum_out_a;
 
-    unsigned int wm = w - 1;
-    unsigned int hm = h - 1;
-    unsigned int w4 = (unsigned int) data.lineStride;
+    unsigned int lm = length - 1;
     unsigned int div = (unsigned int)(radius * 2) + 1;
     unsigned int mul_sum = stackblur_mul[radius];
     unsigned char shr_sum = stackblur_shr[radius];
 
-    for (y = 0; y < h; ++y)
-    {
-        sum_r = sum_g = sum_b = sum_a =
-        sum_in_r = sum_in_g = sum_in_b = sum_in_a =
-        sum_out_r = sum_out_g = sum_out_b = sum_out_a = 0;
-
-        src_ptr = data.getLinePointer (int (y));
-
-        for (i = 0; i <= radius; ++i)
-        {
-            stack_ptr    = &stack[4 * i];
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
-            sum_r += src_ptr[0] * (i + 1);
-            sum_g += src_ptr[1] * (i + 1);
-            sum_b += src_ptr[2] * (i + 1);
-            sum_a += src_ptr[3] * (i + 1);
-            sum_out_r += src_ptr[0];
-            sum_out_g += src_ptr[1];
-            sum_out_b += src_ptr[2];
-            sum_out_a += src_ptr[3];
-        }
-
-        for (i = 1; i <= radius; ++i)
-        {
-            if (i <= wm)
-                src_ptr += 4;
-
-            stack_ptr = &stack[4 * (i + radius)];
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
-            sum_r += src_ptr[0] * (radius + 1 - i);
-            sum_g += src_ptr[1] * (radius + 1 - i);
-            sum_b += src_ptr[2] * (radius + 1 - i);
-            sum_a += src_ptr[3] * (radius + 1 - i);
-            sum_in_r += src_ptr[0];
-            sum_in_g += src_ptr[1];
-            sum_in_b += src_ptr[2];
-            sum_in_a += src_ptr[3];
-        }
-
-        sp = radius;
-        xp = radius;
-        if (xp > wm)
-            xp = wm;
-
-        src_ptr = data.getLinePointer (int (y)) + (unsigned int)data.pixelStride * xp;
-        dst_ptr = data.getLinePointer (int (y));
+    sum_r = sum_g = sum_b = sum_a =
+    sum_in_r = sum_in_g = sum_in_b = sum_in_a =
+    sum_out_r = sum_out_g = sum_out_b = sum_out_a = 0;
 
-        for (x = 0; x < w; ++x)
-        {
-            dst_ptr[0] = (unsigned char)((sum_r * mul_sum) >> shr_sum);
-            dst_ptr[1] = (unsigned char)((sum_g * mul_sum) >> shr_sum);
-            dst_ptr[2] = (unsigned char)((sum_b * mul_sum) >> shr_sum);
-            dst_ptr[3] = (unsigned char)((sum_a * mul_sum) >> shr_sum);
-            dst_ptr += 4;
+    src_ptr = line;
 
-            sum_r -= sum_out_r;
-            sum_g -= sum_out_g;
-            sum_b -= sum_out_b;
-            sum_a -= sum_out_a;
-
-            stack_start = sp + div - radius;
-
-            if (stack_start >= div)
-                stack_start -= div;
-
-            stack_ptr = &stack[4 * stack_start];
-
-            sum_out_r -= stack_ptr[0];
-            sum_out_g -= stack_ptr[1];
-            sum_out_b -= stack_ptr[2];
-            sum_out_a -= stack_ptr[3];
-
-            if (xp < wm)
-            {
-                src_ptr += 4;
-                ++xp;
-            }
-
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
-
-            sum_in_r += src_ptr[0];
-            sum_in_g += src_ptr[1];
-            sum_in_b += src_ptr[2];
-            sum_in_a += src_ptr[3];
-            sum_r    += sum_in_r;
-            sum_g    += sum_in_g;
-            sum_b    += sum_in_b;
-            sum_a    += sum_in_a;
+    for (i = 0; i <= radius; ++i)
+    {
+        stack_ptr    = &stack[4 * i];
+        stack_ptr[0] = src_ptr[0];
+        stack_ptr[1] = src_ptr[1];
+        stack_ptr[2] = src_ptr[2];
+        stack_ptr[3] = src_ptr[3];
+        sum_r += src_ptr[0] * (i + 1);
+        sum_g += src_ptr[1] * (i + 1);
+        sum_b += src_ptr[2] * (i + 1);
+        sum_a += src_ptr[3] * (i + 1);
+        sum_out_r += src_ptr[0];
+        sum_out_g += src_ptr[1];
+        sum_out_b += src_ptr[2];
+        sum_out_a += src_ptr[3];
+    }
 
-            ++sp;
-            if (sp >= div)
-                sp = 0;
+    for (i = 1; i <= radius; ++i)
+    {
+        if (i <= lm)
+            src_ptr += step;
+
+        stack_ptr = &stack[4 * (i + radius)];
+        stack_ptr[0] = src_ptr[0];
+        stack_ptr[1] = src_ptr[1];
+        stack_ptr[2] = src_ptr[2];
+        stack_ptr[3] = src_ptr[3];
+        sum_r += src_ptr[0] * (radius + 1 - i);
+        sum_g += src_ptr[1] * (radius + 1 - i);
+        sum_b += src_ptr[2] * (radius + 1 - i);
+        sum_a += src_ptr[3] * (radius + 1 - i);
+        sum_in_r += src_ptr[0];
+        sum_in_g += src_ptr[1];
+        sum_in_b += src_ptr[2];
+        sum_in_a += src_ptr[3];
+    }
 
-            stack_ptr = &stack[sp*4];
+    sp = radius;
+    xp = radius;
+    if (xp > lm)
+        xp = lm;
 
-            sum_out_r += stack_ptr[0];
-            sum_out_g += stack_ptr[1];
-            sum_out_b += stack_ptr[2];
-            sum_out_a += stack_ptr[3];
-            sum_in_r  -= stack_ptr[0];
-            sum_in_g  -= stack_ptr[1];
-            sum_in_b  -= stack_ptr[2];
-            sum_in_a  -= stack_ptr[3];
-        }
-    }
+    src_ptr = line + step * xp;
+    dst_ptr = line;
 
-    for (x = 0; x < w; ++x)
+    for (i = 0; i < length; ++i)
     {
-        sum_r =    sum_g =    sum_b =    sum_a =
-        sum_in_r = sum_in_g = sum_in_b = sum_in_a =
-        sum_out_r = sum_out_g = sum_out_b = sum_out_a = 0;
+        dst_ptr[0] = (unsigned char)((sum_r * mul_sum) >> shr_sum);
+        dst_ptr[1] = (unsigned char)((sum_g * mul_sum) >> shr_sum);
+        dst_ptr[2] = (unsigned char)((sum_b * mul_sum) >> shr_sum);
+        dst_ptr[3] = (unsigned char)((sum_a * mul_sum) >> shr_sum);
+        dst_ptr += step;
 
-        src_ptr = data.getLinePointer (0) + (unsigned int)data.pixelStride * x;
+        sum_r -= sum_out_r;
+        sum_g -= sum_out_g;
+        sum_b -= sum_out_b;
+        sum_a -= sum_out_a;
 
-        for (i = 0; i <= radius; ++i)
-        {
-            stack_ptr    = &stack[i * 4];
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
-            sum_r           += src_ptr[0] * (i + 1);
-            sum_g           += src_ptr[1] * (i + 1);
-            sum_b           += src_ptr[2] * (i + 1);
-            sum_a           += src_ptr[3] * (i + 1);
-            sum_out_r       += src_ptr[0];
-            sum_out_g       += src_ptr[1];
-            sum_out_b       += src_ptr[2];
-            sum_out_a       += src_ptr[3];
-        }
+        stack_start = sp + div - radius;
 
-        for (i = 1; i <= radius; ++i)
-        {
-            if (i <= hm)
-                src_ptr += w4;
-
-            stack_ptr = &stack[4 * (i + radius)];
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
-            sum_r += src_ptr[0] * (radius + 1 - i);
-            sum_g += src_ptr[1] * (radius + 1 - i);
-            sum_b += src_ptr[2] * (radius + 1 - i);
-            sum_a += src_ptr[3] * (radius + 1 - i);
-            sum_in_r += src_ptr[0];
-            sum_in_g += src_ptr[1];
-            sum_in_b += src_ptr[2];
-            sum_in_a += src_ptr[3];
-        }
+        if (stack_start >= div)
+            stack_start -= div;
 
-        sp = radius;
-        yp = radius;
-        if (yp > hm)
-            yp = hm;
+        stack_ptr = &stack[4 * stack_start];
 
-        src_ptr = data.getLinePointer (int (yp)) + (unsigned int)data.pixelStride * x;
-        dst_ptr = data.getLinePointer (0) + (unsigned int)data.pixelStride * x;
+        sum_out_r -= stack_ptr[0];
+        sum_out_g -= stack_ptr[1];
+        sum_out_b -= stack_ptr[2];
+        sum_out_a -= stack_ptr[3];
 
-        for (y = 0; y < h; ++y)
+        if (xp < lm)
         {
-            dst_ptr[0] = (unsigned char)((sum_r * mul_sum) >> shr_sum);
-            dst_ptr[1] = (unsigned char)((sum_g * mul_sum) >> shr_sum);
-            dst_ptr[2] = (unsigned char)((sum_b * mul_sum) >> shr_sum);
-            dst_ptr[3] = (unsigned char)((sum_a * mul_sum) >> shr_sum);
-            dst_ptr += w4;
-
-            sum_r -= sum_out_r;
-            sum_g -= sum_out_g;
-            sum_b -= sum_out_b;
-            sum_a -= sum_out_a;
+            src_ptr += step;
+            ++xp;
+        }
 
-            stack_start = sp + div - radius;
-            if (stack_start >= div)
-                stack_start -= div;
+        stack_ptr[0] = src_ptr[0];
+        stack_ptr[1] = src_ptr[1];
+        stack_ptr[2] = src_ptr[2];
+        stack_ptr[3] = src_ptr[3];
+
+        sum_in_r += src_ptr[0];
+        sum_in_g += src_ptr[1];
+        sum_in_b += src_ptr[2];
+        sum_in_a += src_ptr[3];
+        sum_r    += sum_in_r;
+        sum_g    += sum_in_g;
+        sum_b    += sum_in_b;
+        sum_a    += sum_in_a;
+
+        ++sp;
+        if (sp >= div)
+            sp = 0;
+
+        stack_ptr = &stack[sp*4];
+
+        sum_out_r += stack_ptr[0];
+        sum_out_g += stack_ptr[1];
+        sum_out_b += stack_ptr[2];
+        sum_out_a += stack_ptr[3];
+        sum_in_r  -= stack_ptr[0];
+        sum_in_g  -= stack_ptr[1];
+        sum_in_b  -= stack_ptr[2];
+        sum_in_a  -= stack_ptr[3];
+    }
+}
 
-            stack_ptr = &stack[4 * stack_start];
+static void applyStackBlurARGB (juce::Image& img, unsigned int radius, juce::ThreadPool* threadPool = nullptr)
+{
+    const int w = img.getWidth();
+    const int h = img.getHeight();
+    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
 
-            sum_out_r -= stack_ptr[0];
-            sum_out_g -= stack_ptr[1];
-            sum_out_b -= stack_ptr[2];
-            sum_out_a -= stack_ptr[3];
+    if (w == 0 || h == 0)
+        return;
 
-            if (yp < hm)
-            {
-                src_ptr += w4;
-                ++yp;
-            }
+    juce::Image::BitmapData data (img, juce::Image::BitmapData::readWrite);
 
-            stack_ptr[0] = src_ptr[0];
-            stack_ptr[1] = src_ptr[1];
-            stack_ptr[2] = src_ptr[2];
-            stack_ptr[3] = src_ptr[3];
+    radius = juce::jlimit (2u, 254u, radius);
 
-            sum_in_r += src_ptr[0];
-            sum_in_g += src_ptr[1];
-            sum_in_b += src_ptr[2];
-            sum_in_a += src_ptr[3];
-            sum_r    += sum_in_r;
-            sum_g    += sum_in_g;
-            sum_b    += sum_in_b;
-            sum_a    += sum_in_a;
+    multiThreadedFor (0, h, 1, threadPool, [&] (int y)
+    {
+        applyStackBlurLineARGB (data.getLinePointer (y), (unsigned int)w, 4, radius);
+    });
 
-            ++sp;
-            if (sp >= div)
-                sp = 0;
+    // Each job processes a block of adjacent columns so that the threads don't write into the same cache lines
+    static constexpr int NumColumnsPerJob = 16;
 
-            stack_ptr = &stack[sp * 4];
+    multiThreadedFor (0, w, NumColumnsPerJob, threadPool, [&] (int x)
+    {
+        auto end = juce::jmin (w, x + NumColumnsPerJob);
 
-            sum_out_r += stack_ptr[0];
-            sum_out_g += stack_ptr[1];
-            sum_out_b += stack_ptr[2];
-            sum_out_a += stack_ptr[3];
-            sum_in_r  -= stack_ptr[0];
-            sum_in_g  -= stack_ptr[1];
-            sum_in_b  -= stack_ptr[2];
-            sum_in_a  -= stack_ptr[3];
-        }
-    }
+        for (; x < end; x++)
+            applyStackBlurLineARGB (data.getLinePointer (0) + data.pixelStride * x, (unsigned int)h, (unsigned int)data.lineStride, radius);
+    });
 }
 
 // The Stack Blur Algorithm was invented by Mario Klingemann,
@@ -711,9 +617,9 @@ static void applyStackBlurARGB (juce::Image& img, unsigned int radius)
 // C++ implemenation base from:
 // https://gist.github.com/benjamin9999/3809142
 // http://www.antigrain.com/__code/include/agg_blur.h.html
-void applyStackBlur (juce::Image& img, int radius)
+void applyStackBlur (juce::Image& img, int radius, juce::ThreadPool* threadPool)
 {
-    if (img.getFormat() == juce::Image::ARGB)          applyStackBlurARGB (img, (unsigned int)radius);
+    if (img.getFormat() == juce::Image::ARGB)          applyStackBlurARGB (img, (unsigned int)radius, threadPool);
     if (img.getFormat() == juce::Image::RGB)           applyStackBlurRGB (img, (unsigned int)radius);
     if (img.getFormat() == juce::Image::SingleChannel) applyStackBlurBW (img, (unsigned int)radius);
 }
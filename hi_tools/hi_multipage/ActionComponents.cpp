@@ -2225,6 +2225,9 @@ Result HlacDecoder::performTaskStatic(WaitJob& t)
 	data.debugLogMode = false;
 	data.partProgress = &unused1;
 
+	SharedResourcePointer<SharedWorkerPool> workerPool;
+	data.threadPool = &workerPool->getThreadPool();
+
     if(!data.targetDirectory.isDirectory())
         data.targetDirectory.createDirectory();
     
@@ -83,6 +83,68 @@ void LorisManager::CustomPOD::writeJSON(const var& obj_)
 	bandwidth = obj->getProperty("bandwidth");
 }
 
+var LorisManager::CustomBatchPOD::toJSON() const
+{
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	obj->setProperty("channelIndex", channelIndex);
+	obj->setProperty("partialIndex", partialIndex);
+	obj->setProperty("sampleRate", sampleRate);
+	obj->setProperty("rootFrequency", rootFrequency);
+
+	auto createArray = [&](const double* data)
+	{
+		Array<var> list;
+		list.ensureStorageAllocated(numBreakpoints);
+
+		for (int i = 0; i < numBreakpoints; i++)
+			list.add(data[i]);
+
+		return var(list);
+	};
+
+	obj->setProperty("time", createArray(time));
+	obj->setProperty("frequency", createArray(frequency));
+	obj->setProperty("phase", createArray(phase));
+	obj->setProperty("gain", createArray(gain));
+	obj->setProperty("bandwidth", createArray(bandwidth));
+
+	return var(obj.get());
+}
+
+void LorisManager::CustomBatchPOD::writeJSON(const var& obj_)
+{
+	auto obj = obj_.getDynamicObject();
+
+	auto writeArray = [&](const Identifier& id, double* data)
+	{
+		if (auto list = obj->getProperty(id).getArray())
+		{
+			auto numToWrite = jmin(numBreakpoints, list->size());
+
+			for (int i = 0; i < numToWrite; i++)
+				data[i] = (double)list->getUnchecked(i);
+		}
+	};
+
+	writeArray("frequency", frequency);
+	writeArray("phase", phase);
+	writeArray("gain", gain);
+	writeArray("bandwidth", bandwidth);
+}
+
+bool LorisManager::hasFunction(const String& name) const
+{
+#if HISE_USE_LORIS_DLL
+	return dll != nullptr && dll->getFunction(name) != nullptr;
+#elif HISE_INCLUDE_LORIS
+	return true;
+#else
+	ignoreUnused(name);
+	return false;
+#endif
+}
+
 void* LorisManager::getFunction(const String& name) const
 {
 #if HISE_USE_LORIS_DLL
@@ -116,8 +178,10 @@ void* LorisManager::getFunction(const String& name) const
 	RETURN_STATIC_FUNCTION(getLibraryVersion);
 	RETURN_STATIC_FUNCTION(getLorisVersion);
 	RETURN_STATIC_FUNCTION(loris_analyze);
+	RETURN_STATIC_FUNCTION(loris_analyze_multiple);
 	RETURN_STATIC_FUNCTION(loris_process);
 	RETURN_STATIC_FUNCTION(loris_process_custom);
+	RETURN_STATIC_FUNCTION(loris_process_custom_batch);
 	RETURN_STATIC_FUNCTION(loris_set);
 	RETURN_STATIC_FUNCTION(loris_get);
 	RETURN_STATIC_FUNCTION(getRequiredBytes);
@@ -129,6 +193,7 @@ void* LorisManager::getFunction(const String& name) const
 	RETURN_STATIC_FUNCTION(getIdList);
 	RETURN_STATIC_FUNCTION(getLastError);
 	RETURN_STATIC_FUNCTION(setThreadController);
+	RETURN_STATIC_FUNCTION(loris_set_executor);
     jassertfalse;
 
 #undef RETURN_STATIC_FUNCTION
@@ -205,6 +270,25 @@ LorisManager::LorisManager(const File& hiseRoot_, const std::function<void(Strin
     errorFunction("Loris is disabled");
 
 #endif
+
+	// Older DLLs don't have this function and will process everything on the calling thread
+	if(state != nullptr && hasFunction("loris_set_executor"))
+	{
+		if(auto f = (LorisSetExecutorFunction)getFunction("loris_set_executor"))
+			f(state, this, (void*)LorisManager::runOnWorkersStatic);
+	}
+}
+
+void LorisManager::runOnWorkersStatic(void* executor, void* obj, LorisJobFunction job, int maxNumThreads)
+{
+	auto typed = static_cast<LorisManager*>(executor);
+
+	jassert(typed != nullptr);
+
+	typed->workerPool->runOnWorkers([obj, job](int threadIndex)
+	{
+		job(obj, threadIndex);
+	}, maxNumThreads);
 }
 
 File LorisManager::getRedirectedFolder() const
@@ -269,6 +353,28 @@ StringArray LorisManager::getList(bool getOptions)
 
 void LorisManager::analyse(const Array<AnalyseData>& data)
 {
+	// Analyse multiple files in parallel if the library supports it
+	if(data.size() > 1 && hasFunction("loris_analyze_multiple"))
+	{
+		if(auto f = (LorisAnalyseMultipleFunction)getFunction("loris_analyze_multiple"))
+		{
+			StringArray files;
+			Array<double> rootFrequencies;
+
+			for(const auto& ad: data)
+			{
+				files.add(ad.file.getFullPathName());
+				rootFrequencies.add(ad.rootFrequency);
+			}
+
+			auto fileList = files.joinIntoString("\n");
+
+			f(state, fileList.getCharPointer().getAddress(), rootFrequencies.getRawDataPointer(), data.size());
+			checkError();
+			return;
+		}
+	}
+
 	if(auto f = (LorisAnalyseFunction)getFunction("loris_analyze"))
 	{
 		for(const auto& ad: data)
@@ -336,6 +442,36 @@ bool LorisManager::processCustom(const File& audioFile, const CustomPOD::Functio
         
 }
 
+bool LorisManager::processCustomBatchStatic(CustomBatchPOD& data)
+{
+	auto typed = static_cast<LorisManager*>(data.obj);
+
+	jassert(typed != nullptr);
+	jassert(typed->customBatchFunction);
+
+	return typed->customBatchFunction(data);
+}
+
+bool LorisManager::processCustomBatch(const File& audioFile, const CustomBatchPOD::Function& cf)
+{
+	customBatchFunction = cf;
+
+	if(hasFunction("loris_process_custom_batch"))
+	{
+		if(auto f = (LorisCustomFunction)getFunction("loris_process_custom_batch"))
+		{
+			auto f2 = audioFile.getFullPathName();
+			auto file = f2.getCharPointer().getAddress();
+
+			f(state, file, this, (void*)LorisManager::processCustomBatchStatic);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
 bool LorisManager::process(const File& audioFile, String command, const String& jsonData)
 {
 	if(command.isEmpty())
@@ -33,11 +33,38 @@ struct LorisManager: public ReferenceCountedObject
 
         void writeJSON(const var& obj_);
     };
+
+    /** The batch version of CustomPOD that contains the data of all breakpoints of a partial. */
+    struct CustomBatchPOD
+    {
+        using FunctionType = bool(*)(CustomBatchPOD&);
+        using Function = std::function<bool(CustomBatchPOD&)>;
+        
+        // Constants
+        int channelIndex = 0;
+        int partialIndex = 0;
+        double sampleRate = 44100.0;
+        double rootFrequency = 0.0;
+        void* obj = nullptr;
+        int numBreakpoints = 0;
+        
+        // Breakpoint arrays
+        const double* time = nullptr;
+        double* frequency = nullptr;
+        double* phase = nullptr;
+        double* gain = nullptr;
+        double* bandwidth = nullptr;
+        
+        var toJSON() const;
+
+        void writeJSON(const var& obj_);
+    };
     
     using Ptr = ReferenceCountedObjectPtr<LorisManager>;
     
     using GetLorisVersion = char*(*)();
     using LorisAnalyseFunction = bool(*)(void*, char*, double);
+    using LorisAnalyseMultipleFunction = bool(*)(void*, const char*, const double*, int);
     using LorisCreateFunction = void*(*)(void);
     using LorisDestroyFunction = void(*)(void*);
     using LorisErrorFunction = char*(*)(void*);
@@ -52,6 +79,8 @@ struct LorisManager: public ReferenceCountedObject
     using LorisCustomFunction = void(*)(void*, const char*, void*, void*);
     using LorisGetSnapshot = bool(*)(void*, const char*, double,const char*,double*,int&,int&);
 	using LorisSetThreadController = void(*)(void*, void*);
+	using LorisSetExecutorFunction = void(*)(void*, void*, void*);
+	using LorisJobFunction = void(*)(void*, int);
 
     struct AnalyseData
     {
@@ -61,6 +90,9 @@ struct LorisManager: public ReferenceCountedObject
     
     void* getFunction(const String& name) const;
 
+    /** Checks whether the function exists without reporting an error (for functions that older DLLs might not have). */
+    bool hasFunction(const String& name) const;
+
     LorisManager(const File& hiseRoot_, const std::function<void(String)>& errorFunction_);
 
     File getRedirectedFolder() const;
@@ -88,6 +120,13 @@ struct LorisManager: public ReferenceCountedObject
 
     bool processCustom(const File& audioFile, const CustomPOD::Function& cf);
 
+    static bool processCustomBatchStatic(CustomBatchPOD& data);
+
+    /** Runs the parallel tasks of the Loris library on the shared worker pool. */
+    static void runOnWorkersStatic(void* executor, void* obj, LorisJobFunction job, int maxNumThreads);
+
+    bool processCustomBatch(const File& audioFile, const CustomBatchPOD::Function& cf);
+
     bool process(const File& audioFile, String command, const String& jsonData);
 
     Array<var> synthesise(const File& audioFile);
@@ -108,6 +147,8 @@ struct LorisManager: public ReferenceCountedObject
     
 	mutable ThreadController::Ptr threadController;
 
+    SharedResourcePointer<SharedWorkerPool> workerPool;
+
     std::function<void(String)> lf;
     std::function<void(String)> errorFunction;
     
@@ -115,6 +156,7 @@ struct LorisManager: public ReferenceCountedObject
     StringArray notifications;
     
     CustomPOD::Function customFunction;
+    CustomBatchPOD::Function customBatchFunction;
     
     ScopedPointer<DynamicLibrary> dll;
     
@@ -1296,15 +1296,344 @@ void TopLevelWindowWithOptionalOpenGL::removeChildComponentWithOpenGLRenderer(Co
 
 #endif
 
+void TimingWheel::List::add(Client* c)
+{
+	jassert(c->currentList == nullptr);
+
+	c->currentList = this;
+	c->prev = nullptr;
+	c->next = head;
+
+	if (head != nullptr)
+		head->prev = c;
+
+	head = c;
+}
+
+void TimingWheel::List::remove(Client* c)
+{
+	jassert(c->currentList == this);
+
+	if (c->prev != nullptr)
+		c->prev->next = c->next;
+	else
+		head = c->next;
+
+	if (c->next != nullptr)
+		c->next->prev = c->prev;
+
+	c->currentList = nullptr;
+	c->prev = nullptr;
+	c->next = nullptr;
+}
+
+TimingWheel::Client* TimingWheel::List::pop()
+{
+	auto c = head;
+
+	if (c != nullptr)
+		remove(c);
+
+	return c;
+}
+
+TimingWheel::Client::Client(TimingWheel* wheel_):
+	wheel(wheel_)
+{}
+
+TimingWheel::Client::~Client()
+{
+	stopTimer();
+}
+
+void TimingWheel::Client::setTimingWheel(TimingWheel* newWheel)
+{
+	if (newWheel != wheel.get())
+	{
+		auto interval = intervalMilliseconds;
+		auto wasRunning = isTimerRunning();
+
+		stopTimer();
+		wheel = newWheel;
+
+		if (wasRunning)
+			startTimer(interval);
+	}
+}
+
+void TimingWheel::Client::startTimer(int intervalInMilliseconds)
+{
+	if (auto w = wheel.get())
+	{
+		w->startClient(this, intervalInMilliseconds, Time::getMillisecondCounter());
+	}
+	else
+	{
+		// You need to set a wheel before starting the timer
+		jassertfalse;
+	}
+}
+
+void TimingWheel::Client::stopTimer()
+{
+	if (auto w = wheel.get())
+	{
+		ScopedLock sl(w->lock);
+
+		running = false;
+
+		if (currentList != nullptr)
+			w->unschedule(this);
+	}
+	else
+	{
+		running = false;
+		currentList = nullptr;
+	}
+}
+
+var TimingWheel::Statistics::toJSON() const
+{
+	auto obj = new DynamicObject();
+
+	obj->setProperty("NumActiveTimers", numActiveTimers);
+	obj->setProperty("NumCallbacksPerSecond", numCallbacksPerSecond);
+	obj->setProperty("CallbackTimePerSecond", callbackTimePerSecond);
+	obj->setProperty("MaxCallbackTime", maxCallbackTime);
+	obj->setProperty("MaxCallbacksPerTick", maxCallbacksPerTick);
+
+	return var(obj);
+}
+
+TimingWheel::TimingWheel(int tickIntervalMilliseconds):
+	tickInterval(jmax(1, tickIntervalMilliseconds)),
+	startTime(Time::getMillisecondCounter())
+{
+	lastStatisticsTime = startTime;
+}
+
+TimingWheel::~TimingWheel()
+{
+	stopTimer();
+
+	ScopedLock sl(lock);
+
+	// Detach the remaining clients so that they don't access the wheel later
+	auto clear = [](List& l)
+	{
+		while (auto c = l.pop())
+			c->running = false;
+	};
+
+	for (auto& level : levels)
+	{
+		for (auto& slot : level)
+			clear(slot);
+	}
+
+	clear(dueClients);
+	numScheduled = 0;
+
+	masterReference.clear();
+}
+
+TimingWheel::Statistics TimingWheel::getStatistics() const
+{
+	ScopedLock sl(lock);
+	auto s = lastStatistics;
+	s.numActiveTimers = numScheduled;
+	return s;
+}
+
+int64 TimingWheel::getTimeSinceStart(uint32 milliSeconds) const
+{
+	return (int64)(milliSeconds - startTime);
+}
+
+int64 TimingWheel::getTickForTime(uint32 milliSeconds) const
+{
+	return getTimeSinceStart(milliSeconds) / (int64)tickInterval;
+}
+
+int64 TimingWheel::getTickForDeadline(int64 dueTime) const
+{
+	return (dueTime + (int64)tickInterval - 1) / (int64)tickInterval;
+}
+
+void TimingWheel::startClient(Client* c, int intervalInMilliseconds, uint32 now)
+{
+	ScopedLock sl(lock);
+
+	c->intervalMilliseconds = intervalInMilliseconds;
+	c->running = true;
+
+	if (c->currentList != nullptr)
+		unschedule(c);
+
+	if (numScheduled == 0)
+	{
+		// The wheel was idle so we can skip the ticks without any timers
+		currentTick = jmax(currentTick, getTickForTime(now));
+	}
+
+	c->dueTime = getTimeSinceStart(now) + jmax(1, intervalInMilliseconds);
+	schedule(c, getTickForDeadline(c->dueTime));
+}
+
+void TimingWheel::schedule(Client* c, int64 dueTick)
+{
+	if (numScheduled++ == 0)
+		startTimer(tickInterval);
+
+	insert(c, dueTick);
+}
+
+void TimingWheel::insert(Client* c, int64 dueTick)
+{
+	c->dueTick = jmax(dueTick, currentTick);
+
+	auto delta = c->dueTick - currentTick;
+
+	for (int level = 0; level < NumLevels - 1; level++)
+	{
+		auto levelShift = NumBitsPerLevel * level;
+
+		if (delta < ((int64)NumSlotsPerLevel << levelShift))
+		{
+			auto index = (int)((c->dueTick >> levelShift) & (NumSlotsPerLevel - 1));
+			levels[level][index].add(c);
+			return;
+		}
+	}
+
+	// Clamp the timers that are too far away, they will be inserted again when their slot is cascaded
+	auto levelShift = NumBitsPerLevel * (NumLevels - 1);
+	auto maxDelta = ((int64)NumSlotsPerLevel << levelShift) - 1;
+	auto index = (int)(((currentTick + jmin(delta, maxDelta)) >> levelShift) & (NumSlotsPerLevel - 1));
+
+	levels[NumLevels - 1][index].add(c);
+}
+
+void TimingWheel::unschedule(Client* c)
+{
+	c->currentList->remove(c);
+	numScheduled--;
+}
+
+void TimingWheel::cascade(int level, int index)
+{
+	List pending;
+	std::swap(pending.head, levels[level][index].head);
+
+	for (auto c = pending.head; c != nullptr; c = c->next)
+		c->currentList = &pending;
+
+	while (auto c = pending.pop())
+		insert(c, c->dueTick);
+}
+
+void TimingWheel::advance(int64 targetTick)
+{
+	while (currentTick <= targetTick)
+	{
+		auto index = (int)(currentTick & (NumSlotsPerLevel - 1));
+
+		if (index == 0)
+		{
+			// cascade the next level (and the levels above if they wrap too)
+			for (int level = 1; level < NumLevels; level++)
+			{
+				auto levelIndex = (int)((currentTick >> (NumBitsPerLevel * level)) & (NumSlotsPerLevel - 1));
+
+				cascade(level, levelIndex);
+
+				if (levelIndex != 0)
+					break;
+			}
+		}
+
+		while (auto c = levels[0][index].pop())
+			dueClients.add(c);
+
+		currentTick++;
+	}
+}
+
+void TimingWheel::timerCallback()
+{
+	TRACE_DISPATCH("timing wheel");
+	processTick(Time::getMillisecondCounter());
+}
+
+void TimingWheel::processTick(uint32 now)
+{
+	{
+		ScopedLock sl(lock);
+		advance(getTickForTime(now));
+	}
+
+	numCallbacksThisTick = 0;
+
+	for (;;)
+	{
+		Client* c;
+
+		{
+			ScopedLock sl(lock);
+
+			c = dueClients.pop();
+
+			if (c == nullptr)
+				break;
+
+			// Reschedule it before the callback so that it can be stopped from within the callback.
+			// The next deadline is relative to the last one, so the interval doesn't drift...
+			auto interval = (int64)jmax(1, c->intervalMilliseconds);
+			auto nextDueTime = c->dueTime + interval;
+			auto timeSinceStart = getTimeSinceStart(now);
+
+			// ...unless we're behind by more than an entire interval, then we skip the missed callbacks
+			if (nextDueTime < timeSinceStart)
+				nextDueTime = timeSinceStart + interval;
+
+			c->dueTime = nextDueTime;
+			insert(c, getTickForDeadline(nextDueTime));
+		}
+
+		auto before = Time::getHighResolutionTicks();
+		c->timerCallback();
+		auto duration = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - before) * 1000.0;
+
+		currentStatistics.numCallbacksPerSecond++;
+		currentStatistics.callbackTimePerSecond += duration;
+		currentStatistics.maxCallbackTime = jmax(currentStatistics.maxCallbackTime, duration);
+		numCallbacksThisTick++;
+	}
+
+	currentStatistics.maxCallbacksPerTick = jmax(currentStatistics.maxCallbacksPerTick, numCallbacksThisTick);
+
+	if (now - lastStatisticsTime >= 1000)
+	{
+		ScopedLock sl(lock);
+		lastStatistics = currentStatistics;
+		currentStatistics = {};
+		lastStatisticsTime = now;
+
+		if (numScheduled == 0)
+			stopTimer();
+	}
+}
+
 SuspendableTimer::Manager::~Manager()
 {}
 
 SuspendableTimer::SuspendableTimer():
-	internalTimer(*this)
+	internalTimer(*this),
+	wheelTimer(*this)
 {}
 
 SuspendableTimer::~SuspendableTimer()
-{ internalTimer.stopTimer(); }
+{ stopInternal(); }
 
 void SuspendableTimer::startTimer(int milliseconds)
 {
@@ -1312,7 +1641,7 @@ void SuspendableTimer::startTimer(int milliseconds)
 
 #if !HISE_HEADLESS
 	if (!suspended)
-		internalTimer.startTimer(milliseconds);
+		startInternal(milliseconds);
 #endif
 }
 
@@ -1322,12 +1651,12 @@ void SuspendableTimer::stopTimer()
 
 	if (!suspended)
 	{
-		internalTimer.stopTimer();
+		stopInternal();
 	}
 	else
 	{
 		// Must be stopped by suspendTimer
-		jassert(!internalTimer.isTimerRunning());
+		jassert(!internalTimer.isTimerRunning() && !wheelTimer.isTimerRunning());
 	}
 }
 
@@ -1339,9 +1668,9 @@ void SuspendableTimer::suspendTimer(bool shouldBeSuspended)
 
 #if !HISE_HEADLESS
 		if (suspended)
-			internalTimer.stopTimer();
+			stopInternal();
 		else if (lastTimerInterval != -1)
-			internalTimer.startTimer(lastTimerInterval);
+			startInternal(lastTimerInterval);
 #endif
 	}
 }
@@ -1351,6 +1680,33 @@ bool SuspendableTimer::isSuspended()
 	return suspended;
 }
 
+void SuspendableTimer::setTimingWheel(TimingWheel* wheel)
+{
+	stopInternal();
+
+	useWheel = wheel != nullptr;
+	wheelTimer.setTimingWheel(wheel);
+
+#if !HISE_HEADLESS
+	if (!suspended && lastTimerInterval != -1)
+		startInternal(lastTimerInterval);
+#endif
+}
+
+void SuspendableTimer::startInternal(int milliseconds)
+{
+	if (useWheel)
+		wheelTimer.startTimer(milliseconds);
+	else
+		internalTimer.startTimer(milliseconds);
+}
+
+void SuspendableTimer::stopInternal()
+{
+	internalTimer.stopTimer();
+	wheelTimer.stopTimer();
+}
+
 SuspendableTimer::Internal::Internal(SuspendableTimer& parent_):
 	parent(parent_)
 {}
@@ -1358,6 +1714,13 @@ SuspendableTimer::Internal::Internal(SuspendableTimer& parent_):
 void SuspendableTimer::Internal::timerCallback()
 { parent.timerCallback(); }
 
+SuspendableTimer::WheelInternal::WheelInternal(SuspendableTimer& parent_):
+	parent(parent_)
+{}
+
+void SuspendableTimer::WheelInternal::timerCallback()
+{ parent.timerCallback(); }
+
 PooledUIUpdater::PooledUIUpdater():
 	pendingHandlers(8192)
 {
@@ -2224,6 +2587,65 @@ void ScrollbarFader::startFadeOut()
     startTimer(500);
 }
 
+struct SharedWorkerPool::Job : public ThreadPoolJob
+{
+	Job(const std::function<void(int)>& f_, int threadIndex_) :
+		ThreadPoolJob("Shared worker job"),
+		f(f_),
+		threadIndex(threadIndex_)
+	{}
+
+	JobStatus runJob() override
+	{
+		f(threadIndex);
+		return jobHasFinished;
+	}
+
+	const std::function<void(int)>& f;
+	const int threadIndex;
+};
+
+SharedWorkerPool::SharedWorkerPool() :
+	pool(jmax(1, SystemStats::getNumCpus() - 1))
+{}
+
+SharedWorkerPool::~SharedWorkerPool()
+{
+	// All users must remove their jobs before the pool goes out of scope
+	jassert(pool.getNumJobs() == 0);
+	pool.removeAllJobs(true, 2000);
+}
+
+void SharedWorkerPool::runOnWorkers(ThreadPool& pool, const std::function<void(int)>& f, int maxNumThreads)
+{
+	if (maxNumThreads < 0)
+		maxNumThreads = pool.getNumThreads() + 1;
+
+	auto numJobs = jmin(pool.getNumThreads(), maxNumThreads - 1);
+
+	OwnedArray<Job> jobs;
+
+	for (int i = 0; i < numJobs; i++)
+		pool.addJob(jobs.add(new Job(f, i + 1)), false);
+
+	f(0);
+
+	// Jobs that haven't started will find nothing left to do, so we just remove them
+	for (auto j : jobs)
+		pool.removeJob(j, false, -1);
+}
+
+void SharedWorkerPool::forEachParallel(int numItems, const std::function<void(int)>& f)
+{
+	std::atomic<int> nextItem = { 0 };
+
+	runOnWorkers([&](int)
+	{
+		for (int i = nextItem++; i < numItems; i = nextItem++)
+			f(i);
+	}, numItems);
+}
+
 void FFTHelpers::applyWindow(WindowType t, float* data, int s, bool normalise)
 {
     using DspWindowType = juce::dsp::WindowingFunction<float>;
@@ -2525,31 +2947,7 @@ Image Spectrum2D::createSpectrumImage(AudioSampleBuffer& lastBuffer)
 	Image::BitmapData bd(newImage, Image::BitmapData::writeOnly);
 	
 	for(int y = 0; y < lastBuffer.getNumChannels(); y++)
-	{
-		auto src = lastBuffer.getReadPointer(y);
-		
-		for(int x = 0; x < lastBuffer.getNumSamples(); x++)
-		{
-			auto lutValue = parameters->lut->getColouredPixel(src[x]);
-
-			if(useAlphaChannel)
-			{
-				auto r = lutValue.getRed();
-				auto g = lutValue.getGreen();
-				auto b = lutValue.getBlue();
-				auto a = jmax(r, g, b);
-
-				auto pp = (PixelARGB*)(bd.getPixelPointer(x, y));
-				pp->set(PixelARGB(a, r, g, b));
-			}
-			else
-			{
-				auto pp = (PixelRGB*)(bd.getPixelPointer(x, y));
-				pp->set(lutValue);
-			}
-				
-		}
-	}
+		colourLine(*parameters->lut, lastBuffer.getReadPointer(y), lastBuffer.getNumSamples(), bd.getLinePointer(y), bd.pixelStride, useAlphaChannel, 1.0f);
 
 #if 0
     for (int x = 0; x < s2dHalf; x++)
@@ -2576,33 +2974,33 @@ Image Spectrum2D::createSpectrumImage(AudioSampleBuffer& lastBuffer)
     return newImage;
 }
 
-
-
-AudioSampleBuffer Spectrum2D::createSpectrumBuffer()
+void Spectrum2D::colourLine(LookupTable& lut, const float* src, int numValues, uint8* dst, int pixelStride, bool useAlphaChannel, float gain)
 {
-	TRACE_EVENT("scripting", "create spectrum buffer");
-    auto fft = juce::dsp::FFT(parameters->order);
-
-    auto numSamplesToFill = jmax(0, originalSource.getNumSamples() / parameters->Spectrum2DSize * parameters->oversamplingFactor - 1);
-
-    if (numSamplesToFill == 0)
-        return {};
-
-    AudioSampleBuffer b(numSamplesToFill, parameters->Spectrum2DSize / 2);
-    b.clear();
-
-	AudioSampleBuffer out(1, parameters->Spectrum2DSize);
-	AudioSampleBuffer sb(1, parameters->Spectrum2DSize * 2);
-
-	AudioSampleBuffer window(1, parameters->Spectrum2DSize * 2);
-
-	FloatVectorOperations::fill(window.getWritePointer(0), 1.0f, parameters->Spectrum2DSize);
+	for(int x = 0; x < numValues; x++)
+	{
+		auto lutValue = lut.getColouredPixel(src[x] * gain);
 
-	FFTHelpers::applyWindow(parameters->currentWindowType, window);
+		if(useAlphaChannel)
+		{
+			auto r = lutValue.getRed();
+			auto g = lutValue.getGreen();
+			auto b = lutValue.getBlue();
+			auto a = jmax(r, g, b);
 
-	
+			auto pp = (PixelARGB*)(dst + x * pixelStride);
+			pp->set(PixelARGB(a, r, g, b));
+		}
+		else
+		{
+			auto pp = (PixelRGB*)(dst + x * pixelStride);
+			pp->set(lutValue);
+		}
+	}
+}
 
-	auto size = b.getNumSamples();
+HeapBlock<float> Spectrum2D::createBinPositions() const
+{
+	auto size = parameters->Spectrum2DSize / 2;
 
 	HeapBlock<float> positions;
 	positions.calloc(size);
@@ -2614,76 +3012,137 @@ AudioSampleBuffer Spectrum2D::createSpectrumBuffer()
 		positions[i] = skewedProportionY;
 	}
 
+	return positions;
+}
+
+Spectrum2D::ColumnRenderer::ColumnRenderer(Parameters::Ptr p, const float* positions_):
+	parameters(p),
+	positions(positions_),
+	fft(p->order),
+	out(1, p->Spectrum2DSize),
+	sb(1, p->Spectrum2DSize * 2),
+	window(1, p->Spectrum2DSize * 2)
+{
+	window.clear();
+	FloatVectorOperations::fill(window.getWritePointer(0), 1.0f, parameters->Spectrum2DSize);
+	FFTHelpers::applyWindow(parameters->currentWindowType, window);
 
 	auto db = (float)parameters->minDb;
+	minGain = Decibels::decibelsToGain(-1.0f * db, -140.0f);
+}
 
-	auto minGain = Decibels::decibelsToGain(-1.0f * db, -140.0f);
+void Spectrum2D::ColumnRenderer::render(const float* input, int numValid, float* dst)
+{
+	numValid = jmin(numValid, parameters->Spectrum2DSize);
 
-	NormalisableRange<float> gainRange(minGain, 1.0f);
+	{
+		TRACE_EVENT("scripting", "pre FFT");
+		sb.clear();
 
-    for (int i = 0; i < numSamplesToFill; i++)
-    {
-        auto offset = (i * parameters->Spectrum2DSize) / parameters->oversamplingFactor;
+		FloatVectorOperations::copy(sb.getWritePointer(0), input, numValid);
+		FloatVectorOperations::multiply(sb.getWritePointer(0), window.getReadPointer(0), numValid);
+	}
 
-		auto numToCopy = jmin(parameters->Spectrum2DSize, originalSource.getNumSamples() - offset);
+	{
+		TRACE_EVENT("scripting", "perform FFT");
+		fft.performRealOnlyForwardTransform(sb.getWritePointer(0), false);
+	}
 
-        {
-			TRACE_EVENT("scripting", "pre FFT");
-	        sb.clear();
+	{
+		TRACE_EVENT("scripting", "post FFT");
+		FFTHelpers::toFreqSpectrum(sb, out);
+		FFTHelpers::scaleFrequencyOutput(out, false);
+	}
 
-	        FloatVectorOperations::copy(sb.getWritePointer(0), originalSource.getReadPointer(0, offset), numToCopy);
-			FloatVectorOperations::multiply(sb.getWritePointer(0), window.getReadPointer(0), numToCopy);
-        }
+	auto src = out.getReadPointer(0);
+	auto size = parameters->Spectrum2DSize / 2;
+	auto gamma = parameters->getGamma();
+	auto highQuality = parameters->quality == Graphics::highResamplingQuality;
 
-        {
-			TRACE_EVENT("scripting", "perform FFT");
-	        fft.performRealOnlyForwardTransform(sb.getWritePointer(0), false);
-        }
+	TRACE_EVENT("scripting", "scale freq output");
 
-        {
-			TRACE_EVENT("scripting", "post FFT");
-	        FFTHelpers::toFreqSpectrum(sb, out);
-			FFTHelpers::scaleFrequencyOutput(out, false);
-        }
+	auto bitmask = (size-1);
 
+	for(int i = 0; i < size; i++)
+	{
+		auto idx = positions[i] * (float)(size-1);
 
+		auto i1 = (int)(idx) & bitmask;
+		auto i0 = jmax(i1-1, 0);
+		auto i2 = (i1+1) & bitmask;
+		auto i3 = (i1+2) & bitmask;
+		auto alpha = idx - (float)i1;
 
-		FloatVectorOperations::copy(b.getWritePointer(i), out.getReadPointer(0), b.getNumSamples());
+		auto dstIndex = size - (i+1);
 
-		auto src = out.getReadPointer(0);
-		auto dst = b.getWritePointer(i);
+		float value;
 
-		{
-	        TRACE_EVENT("scripting", "scale freq output");
+		if(highQuality)
+			value = Interpolator::interpolateCubic(src[i0], src[i1], src[i2], src[i3], alpha);
+		else
+			value = Interpolator::interpolateLinear<float>(src[i1], src[i2], alpha);
 
-			auto bitmask = (b.getNumSamples()-1);
+		value = jmax<float>(value, minGain) - minGain;
+		
+		value = std::pow(value, gamma);
+		dst[dstIndex] = value;
+	}
+}
 
-			for(int i = 0; i < size; i++)
-			{
-				auto idx = positions[i] * (float)(size-1);
+AudioSampleBuffer Spectrum2D::createSpectrumBuffer()
+{
+	TRACE_EVENT("scripting", "create spectrum buffer");
 
-				auto i1 = (int)(idx) & bitmask;
-				auto i0 = jmax(i1-1, 0);
-				auto i2 = (i1+1) & bitmask;
-				auto i3 = (i1+2) & bitmask;
-				auto alpha = idx - (float)i1;
+    auto numSamplesToFill = jmax(0, originalSource.getNumSamples() / parameters->Spectrum2DSize * parameters->oversamplingFactor - 1);
 
-				auto dstIndex = size - (i+1);
+    if (numSamplesToFill == 0)
+        return {};
 
-				float value;
+    AudioSampleBuffer b(numSamplesToFill, parameters->Spectrum2DSize / 2);
+    b.clear();
 
-				if(parameters->quality == Graphics::highResamplingQuality)
-					value = Interpolator::interpolateCubic(src[i0], src[i1], src[i2], src[i3], alpha);
-				else
-					value = Interpolator::interpolateLinear<float>(src[i1], src[i2], alpha);
+	auto positions = createBinPositions();
 
-				value = jmax<float>(value, minGain) - minGain;
-				
-				value = std::pow(value, parameters->getGamma());
-				dst[dstIndex] = value;
+	auto renderColumn = [&](ColumnRenderer& r, int i)
+	{
+		auto offset = (i * parameters->Spectrum2DSize) / parameters->oversamplingFactor;
+		auto numToCopy = jmin(parameters->Spectrum2DSize, originalSource.getNumSamples() - offset);
+
+		r.render(originalSource.getReadPointer(0, offset), numToCopy, b.getWritePointer(i));
+	};
+
+	if (numSamplesToFill < MinNumColumnsForMultithreading)
+	{
+		ColumnRenderer r(parameters, positions.get());
+
+		for (int i = 0; i < numSamplesToFill; i++)
+			renderColumn(r, i);
+	}
+	else
+	{
+		// The columns are independent, so we split them into chunks that are picked up by
+		// the worker threads and this thread. Every thread uses its own FFT & scratch buffers.
+		SharedResourcePointer<SharedWorkerPool> workerPool;
+
+		static constexpr int NumColumnsPerChunk = 16;
+
+		auto numChunks = (numSamplesToFill + NumColumnsPerChunk - 1) / NumColumnsPerChunk;
+
+		std::atomic<int> nextChunk = { 0 };
+
+		workerPool->runOnWorkers([&](int)
+		{
+			ColumnRenderer r(parameters, positions.get());
+
+			for (int chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+			{
+				auto end = jmin(numSamplesToFill, (chunk + 1) * NumColumnsPerChunk);
+
+				for (int i = chunk * NumColumnsPerChunk; i < end; i++)
+					renderColumn(r, i);
 			}
-        }
-    }
+		}, numChunks);
+	}
 
 	auto thisGain = parameters->getGainFactor();
 
@@ -2700,6 +3159,166 @@ AudioSampleBuffer Spectrum2D::createSpectrumBuffer()
     return b;
 }
 
+Spectrum2D::IncrementalRenderer::IncrementalRenderer(Spectrum2D& parent, int numColumns) :
+	Thread("Spectrum2D renderer"),
+	parameters(new Parameters(*parent.parameters)),
+	useAlphaChannel(parent.useAlphaChannel),
+	fftSize(parameters->Spectrum2DSize),
+	hopSize(jmax(1, parameters->Spectrum2DSize / parameters->oversamplingFactor)),
+	numBins(parameters->Spectrum2DSize / 2),
+	positions(parent.createBinPositions()),
+	columnRenderer(parameters, positions.get()),
+	fifo(jmax(fftSize * 16, (numColumns + 1) * hopSize + fftSize)),
+	fifoBuffer(1, fifo.getTotalSize())
+{
+	frame.calloc(fftSize);
+	column.calloc(numBins);
+
+	ringImage = Image(useAlphaChannel ? Image::ARGB : Image::RGB, numBins, jmax(1, numColumns), true);
+
+	startThread(4);
+}
+
+Spectrum2D::IncrementalRenderer::~IncrementalRenderer()
+{
+	stopThread(1000);
+}
+
+void Spectrum2D::IncrementalRenderer::run()
+{
+	while (!threadShouldExit())
+	{
+		// a notify() while the columns are rendered will make this return immediately
+		wait(-1);
+		renderPendingColumns();
+	}
+}
+
+void Spectrum2D::IncrementalRenderer::pushSamples(const float* data, int numSamples)
+{
+	int start1, size1, start2, size2;
+
+	// If the renderer can't keep up, the samples that don't fit are dropped
+	fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+	if (size1 > 0)
+		FloatVectorOperations::copy(fifoBuffer.getWritePointer(0, start1), data, size1);
+
+	if (size2 > 0)
+		FloatVectorOperations::copy(fifoBuffer.getWritePointer(0, start2), data + size1, size2);
+
+	fifo.finishedWrite(size1 + size2);
+
+	if (fifo.getNumReady() >= hopSize)
+		notify();
+}
+
+void Spectrum2D::IncrementalRenderer::renderPendingColumns()
+{
+	auto fixedGain = parameters->getGainFactor();
+
+	while (!threadShouldExit())
+	{
+		if (resetPending.exchange(false))
+		{
+			// Only the reader side of the fifo is touched here so that the producer can keep pushing
+			fifo.finishedRead(fifo.getNumReady());
+			FloatVectorOperations::clear(frame.get(), fftSize);
+			peakGain = 0.0f;
+
+			ScopedLock sl(imageLock);
+			ringImage.clear(ringImage.getBounds());
+			writeIndex = 0;
+			numColumnsRendered.store(0);
+		}
+
+		if (fifo.getNumReady() < hopSize)
+			break;
+
+		// shift the analysis frame by one hop and append the new samples
+		memmove(frame.get(), frame.get() + hopSize, sizeof(float) * (fftSize - hopSize));
+
+		int start1, size1, start2, size2;
+		fifo.prepareToRead(hopSize, start1, size1, start2, size2);
+
+		auto dst = frame.get() + fftSize - hopSize;
+
+		if (size1 > 0)
+			FloatVectorOperations::copy(dst, fifoBuffer.getReadPointer(0, start1), size1);
+
+		if (size2 > 0)
+			FloatVectorOperations::copy(dst + size1, fifoBuffer.getReadPointer(0, start2), size2);
+
+		fifo.finishedRead(size1 + size2);
+
+		columnRenderer.render(frame.get(), fftSize, column.get());
+
+		auto gain = fixedGain;
+
+		if (gain == 0.0f)
+		{
+			auto range = FloatVectorOperations::findMinAndMax(column.get(), numBins);
+			peakGain = jmax(peakGain, range.getEnd(), std::abs(range.getStart()));
+			gain = peakGain != 0.0f ? 1.0f / peakGain : 0.0f;
+		}
+
+		{
+			ScopedLock sl(imageLock);
+
+			// a reset came in while this column was calculated
+			if (resetPending.load())
+				continue;
+
+			Image::BitmapData bd(ringImage, Image::BitmapData::writeOnly);
+			colourLine(*parameters->lut, column.get(), numBins, bd.getLinePointer(writeIndex), bd.pixelStride, useAlphaChannel, gain);
+			writeIndex = (writeIndex + 1) % ringImage.getHeight();
+		}
+
+		numColumnsRendered++;
+	}
+}
+
+Image Spectrum2D::IncrementalRenderer::getImage()
+{
+	// Reuse the last image unless somebody still holds a reference to it
+	if (displayImage.isNull() || displayImage.getReferenceCount() > 1)
+		displayImage = Image(ringImage.getFormat(), ringImage.getWidth(), ringImage.getHeight(), false);
+
+	ScopedLock sl(imageLock);
+
+	Image::BitmapData src(ringImage, Image::BitmapData::readOnly);
+	Image::BitmapData dst(displayImage, Image::BitmapData::writeOnly);
+
+	auto numLines = ringImage.getHeight();
+	auto numBytes = (size_t)(src.width * src.pixelStride);
+
+	// the line at the write index is the oldest one
+	for (int i = 0; i < numLines; i++)
+		memcpy(dst.getLinePointer(i), src.getLinePointer((writeIndex + i) % numLines), numBytes);
+
+	return displayImage;
+}
+
+void Spectrum2D::IncrementalRenderer::reset()
+{
+	resetPending.store(true);
+	notify();
+}
+
+Spectrum2D::Parameters::Parameters(const Parameters& other):
+	minDb(other.minDb),
+	order(other.order),
+	oversamplingFactor(other.oversamplingFactor),
+	Spectrum2DSize(other.Spectrum2DSize),
+	gainFactorDb(other.gainFactorDb),
+	gammaPercent(other.gammaPercent),
+	quality(other.quality),
+	currentWindowType(other.currentWindowType),
+	lut(new LookupTable(*other.lut))
+{
+
+}
+
 void Spectrum2D::Parameters::set(const Identifier& id, var value, NotificationType n)
 {
 	jassert(getAllIds().contains(id));
@@ -3056,4 +3675,268 @@ double MasterClock::getBpmToUse(double hostBpm, double internalBpm) const
 	return internalBpm;
 }
 
+#if HI_RUN_UNIT_TESTS
+
+/** Checks that the multithreaded and the incremental spectrograms produce the same columns as
+    the sequential calculation. */
+struct Spectrum2DTests : public UnitTest,
+						 public Spectrum2D::Holder
+{
+	Spectrum2DTests() :
+		UnitTest("Testing Spectrum2D")
+	{};
+
+	Spectrum2D::Parameters::Ptr getParameters() const override { return parameters; }
+
+	/** The single threaded calculation that Spectrum2D::createSpectrumBuffer() used before the
+	    columns were split into chunks. */
+	AudioSampleBuffer createSequentialReference(const AudioSampleBuffer& originalSource)
+	{
+		auto fft = juce::dsp::FFT(parameters->order);
+
+		auto numSamplesToFill = jmax(0, originalSource.getNumSamples() / parameters->Spectrum2DSize * parameters->oversamplingFactor - 1);
+
+		AudioSampleBuffer b(numSamplesToFill, parameters->Spectrum2DSize / 2);
+		b.clear();
+
+		AudioSampleBuffer out(1, parameters->Spectrum2DSize);
+		AudioSampleBuffer sb(1, parameters->Spectrum2DSize * 2);
+		AudioSampleBuffer window(1, parameters->Spectrum2DSize * 2);
+
+		window.clear();
+		FloatVectorOperations::fill(window.getWritePointer(0), 1.0f, parameters->Spectrum2DSize);
+		FFTHelpers::applyWindow(parameters->currentWindowType, window);
+
+		auto size = b.getNumSamples();
+
+		HeapBlock<float> positions;
+		positions.calloc(size);
+
+		for (int i = 0; i < size; i++)
+			positions[i] = getYPosition((float)i / (float)size);
+
+		auto minGain = Decibels::decibelsToGain(-1.0f * (float)parameters->minDb, -140.0f);
+
+		for (int c = 0; c < numSamplesToFill; c++)
+		{
+			auto offset = (c * parameters->Spectrum2DSize) / parameters->oversamplingFactor;
+			auto numToCopy = jmin(parameters->Spectrum2DSize, originalSource.getNumSamples() - offset);
+
+			sb.clear();
+			FloatVectorOperations::copy(sb.getWritePointer(0), originalSource.getReadPointer(0, offset), numToCopy);
+			FloatVectorOperations::multiply(sb.getWritePointer(0), window.getReadPointer(0), numToCopy);
+
+			fft.performRealOnlyForwardTransform(sb.getWritePointer(0), false);
+
+			FFTHelpers::toFreqSpectrum(sb, out);
+			FFTHelpers::scaleFrequencyOutput(out, false);
+
+			auto src = out.getReadPointer(0);
+			auto dst = b.getWritePointer(c);
+			auto bitmask = (size - 1);
+
+			for (int i = 0; i < size; i++)
+			{
+				auto idx = positions[i] * (float)(size - 1);
+
+				auto i1 = (int)(idx) & bitmask;
+				auto i0 = jmax(i1 - 1, 0);
+				auto i2 = (i1 + 1) & bitmask;
+				auto i3 = (i1 + 2) & bitmask;
+				auto alpha = idx - (float)i1;
+
+				float value;
+
+				if (parameters->quality == Graphics::highResamplingQuality)
+					value = Interpolator::interpolateCubic(src[i0], src[i1], src[i2], src[i3], alpha);
+				else
+					value = Interpolator::interpolateLinear<float>(src[i1], src[i2], alpha);
+
+				value = jmax<float>(value, minGain) - minGain;
+				dst[size - (i + 1)] = std::pow(value, parameters->getGamma());
+			}
+		}
+
+		b.applyGain(parameters->getGainFactor());
+
+		return b;
+	}
+
+	void runTest() override
+	{
+		parameters = new Spectrum2D::Parameters();
+		parameters->order = 10;
+		parameters->Spectrum2DSize = 1024;
+		parameters->oversamplingFactor = 4;
+
+		// use a fixed gain so that the incremental columns are scaled like the full spectrum
+		parameters->gainFactorDb = 0;
+
+		AudioSampleBuffer signal(1, 1024 * 80);
+		Random r(8);
+
+		for (int i = 0; i < signal.getNumSamples(); i++)
+			signal.setSample(0, i, 0.5f * std::sin((float)i * 0.05f * (1.0f + (float)i / 20000.0f)) + 0.1f * (r.nextFloat() - 0.5f));
+
+		Spectrum2D spectrum(this, signal);
+
+		auto fullBuffer = spectrum.createSpectrumBuffer();
+		auto numColumns = fullBuffer.getNumChannels();
+
+		{
+			beginTest("Testing multithreaded spectrum");
+
+			expect(numColumns >= Spectrum2D::MinNumColumnsForMultithreading, "spectrum isn't long enough");
+
+			auto reference = createSequentialReference(signal);
+
+			expectEquals(reference.getNumChannels(), numColumns, "column amount mismatch");
+			expectEquals(reference.getNumSamples(), fullBuffer.getNumSamples(), "bin amount mismatch");
+
+			int numErrors = 0;
+
+			for (int i = 0; i < numColumns; i++)
+			{
+				for (int j = 0; j < fullBuffer.getNumSamples(); j++)
+				{
+					if (std::abs(reference.getSample(i, j) - fullBuffer.getSample(i, j)) > 1e-6f)
+					{
+						numErrors++;
+						break;
+					}
+				}
+			}
+
+			expectEquals(numErrors, 0, "column mismatch");
+		}
+
+		{
+			beginTest("Testing incremental spectrum");
+
+			static constexpr int NumIncrementalColumns = 32;
+			Spectrum2D::IncrementalRenderer ir(spectrum, NumIncrementalColumns);
+
+			auto hopSize = parameters->Spectrum2DSize / parameters->oversamplingFactor;
+
+			for (int i = 0; i < signal.getNumSamples(); i += 512)
+			{
+				ir.pushSamples(signal.getReadPointer(0, i), 512);
+
+				// give the worker some time so that the fifo doesn't overflow
+				for (int t = 0; t < 500 && (i + 512) - ir.getNumColumnsRendered() * hopSize > 4096; t++)
+					Thread::sleep(1);
+			}
+
+			auto numExpected = signal.getNumSamples() / hopSize;
+
+			for (int i = 0; i < 500 && ir.getNumColumnsRendered() < numExpected; i++)
+				Thread::sleep(10);
+
+			expectEquals(ir.getNumColumnsRendered(), numExpected, "not all columns were rendered");
+
+			// The incremental frame ends at the last pushed sample, the full spectrum starts at the offset,
+			// so column i of the stream equals column i - (fftSize / hopSize - 1) of the full spectrum
+			auto fullImage = spectrum.createSpectrumImage(fullBuffer);
+			auto incrementalImage = ir.getImage();
+
+			auto firstFullColumn = numExpected - NumIncrementalColumns - (parameters->oversamplingFactor - 1);
+
+			Image::BitmapData fd(fullImage, Image::BitmapData::readOnly);
+			Image::BitmapData id(incrementalImage, Image::BitmapData::readOnly);
+
+			int numErrors = 0;
+
+			for (int i = 0; i < NumIncrementalColumns; i++)
+			{
+				if (memcmp(fd.getLinePointer(firstFullColumn + i), id.getLinePointer(i), fd.width * fd.pixelStride) != 0)
+					numErrors++;
+			}
+
+			expectEquals(numErrors, 0, "incremental column mismatch");
+		}
+
+		parameters = nullptr;
+	}
+
+	Spectrum2D::Parameters::Ptr parameters;
+};
+
+static Spectrum2DTests spectrum2DTests;
+
+/** Drives a TimingWheel with simulated ticks and checks that the callbacks follow the exact intervals. */
+struct TimingWheelTests : public UnitTest
+{
+	TimingWheelTests() :
+		UnitTest("Testing TimingWheel")
+	{};
+
+	struct TestClient : public TimingWheel::Client
+	{
+		TestClient(TimingWheel* w) :
+			Client(w)
+		{};
+
+		void timerCallback() override { callbackTimes.add(currentTime); }
+
+		Array<int64> callbackTimes;
+		int64 currentTime = 0;
+	};
+
+	void testInterval(int interval, int numCallbacks)
+	{
+		TimingWheel w(10);
+		TestClient c(&w);
+
+		auto start = w.startTime;
+
+		w.startClient(&c, interval, start);
+
+		// we drive the wheel manually, so the JUCE timer must not interfere
+		w.stopTimer();
+
+		auto tickInterval = w.getTickInterval();
+		// the last callback is at most one tick late, the next one is at least one tick away
+		auto endTime = (int64)interval * numCallbacks + tickInterval - 1;
+
+		for (int64 t = 0; t <= endTime; t += tickInterval)
+		{
+			c.currentTime = t;
+			w.processTick(start + (uint32)t);
+		}
+
+		c.stopTimer();
+
+		expectEquals(c.callbackTimes.size(), numCallbacks, "wrong number of callbacks for " + String(interval) + "ms");
+
+		for (int i = 0; i < c.callbackTimes.size(); i++)
+		{
+			auto deadline = (int64)interval * (i + 1);
+			auto delay = c.callbackTimes[i] - deadline;
+
+			if (delay < 0 || delay >= tickInterval)
+			{
+				expect(false, String(interval) + "ms: callback " + String(i) + " is " + String(delay) + "ms off");
+				return;
+			}
+		}
+	}
+
+	void runTest() override
+	{
+		beginTest("Testing the firing intervals");
+
+		// intervals that aren't multiples of the tick and an interval that is stored in the second level
+		testInterval(10, 100);
+		testInterval(15, 60);
+		testInterval(25, 40);
+		testInterval(33, 30);
+		testInterval(250, 10);
+		testInterval(1500, 5);
+	}
+};
+
+static TimingWheelTests timingWheelTests;
+
+#endif
+
 }
@@ -452,6 +452,141 @@ public:
 };
 #endif
 
+/** A hierarchical timing wheel that drives many low-resolution timers with a single JUCE timer.
+
+	Each client is stored in an intrusive list of a wheel slot so starting and stopping a timer is O(1)
+	no matter how many timers are active. The wheel advances once per tick (a frame) and calls all timers
+	that expired during that tick in one batch on the message thread. Timers that are further away than
+	the first level are stored in the coarser levels and cascaded down when their time comes closer.
+
+	The clients keep their exact deadline in milliseconds and only the slot is derived from the tick, so
+	the intervals are not rounded to the tick interval: a callback is never early and at most one tick late,
+	and the periodic timers are rescheduled relative to their last deadline so that they don't drift. The
+	JUCE timer that drives the wheel is only running if there are active clients.
+*/
+class TimingWheel : private Timer
+{
+	struct List;
+
+public:
+
+	static constexpr int NumBitsPerLevel = 6;
+	static constexpr int NumSlotsPerLevel = 1 << NumBitsPerLevel;
+	static constexpr int NumLevels = 4;
+
+	/** A timer that is scheduled by the TimingWheel. The API mirrors juce::Timer. */
+	class Client
+	{
+	public:
+
+		Client(TimingWheel* wheel_=nullptr);
+		virtual ~Client();
+
+		/** Sets the wheel that drives this timer. If the timer is running, it will be moved to the new wheel. */
+		void setTimingWheel(TimingWheel* newWheel);
+
+		/** Starts the timer. The callback will happen on the first tick of the wheel after the deadline. */
+		void startTimer(int intervalInMilliseconds);
+
+		/** Stops the timer. This can be called from the timer callback. */
+		void stopTimer();
+
+		bool isTimerRunning() const noexcept { return running; }
+
+		int getTimerInterval() const noexcept { return intervalMilliseconds; }
+
+		virtual void timerCallback() = 0;
+
+	private:
+
+		friend class TimingWheel;
+
+		WeakReference<TimingWheel> wheel;
+
+		List* currentList = nullptr;
+		Client* prev = nullptr;
+		Client* next = nullptr;
+
+		// the exact deadline in milliseconds since the start of the wheel and the tick of its slot
+		int64 dueTime = 0;
+		int64 dueTick = 0;
+		int intervalMilliseconds = 0;
+		bool running = false;
+
+		JUCE_DECLARE_NON_COPYABLE(Client);
+	};
+
+	struct Statistics
+	{
+		var toJSON() const;
+
+		int numActiveTimers = 0;
+		int numCallbacksPerSecond = 0;
+		double callbackTimePerSecond = 0.0;
+		double maxCallbackTime = 0.0;
+		int maxCallbacksPerTick = 0;
+	};
+
+	TimingWheel(int tickIntervalMilliseconds=10);
+	~TimingWheel();
+
+	int getTickInterval() const noexcept { return tickInterval; }
+
+	/** Returns the statistics of the last second (the number of callbacks and their cost in milliseconds). */
+	Statistics getStatistics() const;
+
+private:
+
+	struct List
+	{
+		void add(Client* c);
+		void remove(Client* c);
+		Client* pop();
+
+		Client* head = nullptr;
+	};
+
+	void timerCallback() override;
+
+	/** Returns the time in milliseconds since the start of the wheel. */
+	int64 getTimeSinceStart(uint32 milliSeconds) const;
+
+	int64 getTickForTime(uint32 milliSeconds) const;
+
+	/** Returns the first tick that is not before the deadline. */
+	int64 getTickForDeadline(int64 dueTime) const;
+
+	void startClient(Client* c, int intervalInMilliseconds, uint32 now);
+	void processTick(uint32 now);
+
+	void schedule(Client* c, int64 dueTick);
+	void insert(Client* c, int64 dueTick);
+	void unschedule(Client* c);
+	void cascade(int level, int index);
+	void advance(int64 targetTick);
+
+	CriticalSection lock;
+
+	List levels[NumLevels][NumSlotsPerLevel];
+	List dueClients;
+
+	const int tickInterval;
+	const uint32 startTime;
+
+	int64 currentTick = 0;
+	int numScheduled = 0;
+
+	Statistics lastStatistics;
+	Statistics currentStatistics;
+	uint32 lastStatisticsTime = 0;
+	int numCallbacksThisTick = 0;
+
+	friend struct TimingWheelTests;
+
+	JUCE_DECLARE_WEAK_REFERENCEABLE(TimingWheel);
+	JUCE_DECLARE_NON_COPYABLE(TimingWheel);
+};
+
 
 class SuspendableTimer
 {
@@ -478,8 +613,14 @@ public:
 
     bool isSuspended();
 
+	/** Schedules the timer on the given TimingWheel instead of using a dedicated JUCE timer. */
+	void setTimingWheel(TimingWheel* wheel);
+
 private:
 
+	void startInternal(int milliseconds);
+	void stopInternal();
+
 	struct Internal : public Timer
 	{
 		Internal(SuspendableTimer& parent_);;
@@ -489,7 +630,19 @@ private:
 		SuspendableTimer& parent;
 	};
 
+	struct WheelInternal : public TimingWheel::Client
+	{
+		WheelInternal(SuspendableTimer& parent_);;
+
+		void timerCallback() override;;
+
+		SuspendableTimer& parent;
+	};
+
 	Internal internalTimer;
+	WheelInternal wheelTimer;
+
+	bool useWheel = false;
 
 	bool suspended = false;
 
@@ -2162,6 +2315,50 @@ public:
 	virtual void nonRealtimeModeChanged(bool isNonRealtime) = 0;
 };
 
+/** A thread pool for background tasks that is shared by all parallel algorithms of the process.
+
+	Use it with a SharedResourcePointer instead of creating a ThreadPool so that multiple tasks that
+	run at the same time don't oversubscribe the CPU. Jobs that are added from the audio thread must
+	use the RealtimeWorkerPool of the DSP library instead.
+*/
+class SharedWorkerPool
+{
+public:
+
+	SharedWorkerPool();
+	~SharedWorkerPool();
+
+	/** Calls f on the calling thread and on up to maxNumThreads - 1 threads of the pool and returns when all calls are finished.
+
+		The argument is the thread index (the calling thread uses 0, so it's always smaller than maxNumThreads).
+		The function should pick up work items from a shared counter until there are none left: the calling
+		thread doesn't wait for jobs that haven't started yet (they are removed from the queue instead), so
+		this can also be used by a job that runs on the same pool without blocking it.
+
+		If maxNumThreads is -1, it will use all threads of the pool.
+	*/
+	static void runOnWorkers(ThreadPool& pool, const std::function<void(int)>& f, int maxNumThreads=-1);
+
+	/** Calls f on the calling thread and on the threads of this pool. See the static version. */
+	void runOnWorkers(const std::function<void(int)>& f, int maxNumThreads=-1) { runOnWorkers(pool, f, maxNumThreads); }
+
+	/** Calls f(i) for every index from 0 to numItems - 1 using the threads of the pool and the calling thread. */
+	void forEachParallel(int numItems, const std::function<void(int)>& f);
+
+	/** Returns the thread pool (eg. for adding jobs that run asynchronously). Only remove your own jobs from this pool (eg. with a JobSelector). */
+	ThreadPool& getThreadPool() noexcept { return pool; }
+
+	int getNumThreads() const { return pool.getNumThreads(); }
+
+private:
+
+	struct Job;
+
+	ThreadPool pool;
+
+	JUCE_DECLARE_NON_COPYABLE(SharedWorkerPool);
+};
+
 struct FFTHelpers
 {
     enum WindowType
@@ -2270,9 +2467,12 @@ struct Spectrum2D
 		Parameters():
 		  lut(new LookupTable())
 		{
-			
+
 		}
 
+		/** Creates a copy of the values and the lookup table (but not the listeners). */
+		Parameters(const Parameters& other);
+
 		void set(const Identifier& id, var value, NotificationType n);
 
 		var get(const Identifier& id) const;
@@ -2331,6 +2531,93 @@ struct Spectrum2D
     
     Spectrum2D(Holder* h, const AudioSampleBuffer& s);;
 
+	/** Calculates single STFT columns. It holds the FFT and all scratch buffers, so every thread that
+	    renders columns needs its own instance. */
+	struct ColumnRenderer
+	{
+		/** Creates a renderer. The positions are the skewed bin positions from Spectrum2D::createBinPositions(). */
+		ColumnRenderer(Parameters::Ptr p, const float* positions);
+
+		/** Calculates the column from the given samples. If numValid is smaller than the FFT size,
+		    the rest will be treated as silence. The destination must have Spectrum2DSize / 2 elements. */
+		void render(const float* input, int numValid, float* dst);
+
+	private:
+
+		Parameters::Ptr parameters;
+		const float* positions;
+		juce::dsp::FFT fft;
+		AudioSampleBuffer out, sb, window;
+		float minGain;
+	};
+
+	/** Computes the spectrogram of a stream of audio column by column.
+
+	    Push new samples with pushSamples() and the STFT columns will be calculated on a background
+	    thread and written into a ring buffer of coloured lines. getImage() returns the last numColumns
+	    columns in the same layout as createSpectrumImage() so you can draw it with Spectrum2D::draw().
+
+	    The parameters (including the colour lookup table) are copied when you create this object,
+	    so if they change you need to create a new renderer. If the gain factor is set to auto, the
+	    gain follows the peak of all columns so far (the columns that were already rendered will not
+	    be rescaled).
+	*/
+	struct IncrementalRenderer: public Thread
+	{
+		IncrementalRenderer(Spectrum2D& parent, int numColumns);
+
+		~IncrementalRenderer();
+
+		/** Adds new audio samples from a single producer thread. This wakes up the render thread
+		    (which acquires a lock), so don't call it from the audio thread but from a thread that
+		    reads the audio data from a ring buffer (like the analyser popup). */
+		void pushSamples(const float* data, int numSamples);
+
+		/** Returns an image with the last columns (oldest first). Call this from a single consumer thread. */
+		Image getImage();
+
+		/** Returns the number of columns that were rendered since the last reset. You can use this
+		    to check whether you need to repaint. */
+		int getNumColumnsRendered() const { return numColumnsRendered.load(); }
+
+		/** Clears all columns. The pending samples are discarded by the render thread, so this is
+		    safe to call while another thread pushes samples. */
+		void reset();
+
+		/** @internal */
+		void run() override;
+
+	private:
+
+		void renderPendingColumns();
+
+		Parameters::Ptr parameters;
+		const bool useAlphaChannel;
+		const int fftSize;
+		const int hopSize;
+		const int numBins;
+
+		HeapBlock<float> positions;
+		ColumnRenderer columnRenderer;
+
+		AbstractFifo fifo;
+		AudioSampleBuffer fifoBuffer;
+		HeapBlock<float> frame;
+		HeapBlock<float> column;
+		float peakGain = 0.0f;
+
+		std::atomic<bool> resetPending = { false };
+
+		CriticalSection imageLock;
+		Image ringImage;
+		Image displayImage;
+		int writeIndex = 0;
+
+		std::atomic<int> numColumnsRendered = { 0 };
+
+		JUCE_DECLARE_NON_COPYABLE(IncrementalRenderer);
+	};
+
 	static void draw(Graphics& g, const Image& img, Rectangle<int> area, Graphics::ResamplingQuality quality);
 
 	Parameters::Ptr parameters;
@@ -2342,6 +2629,16 @@ struct Spectrum2D
 	bool useAlphaChannel = false;
 
     AudioSampleBuffer createSpectrumBuffer();
+
+	/** Calculates the skewed bin positions for the current parameters using the holder. */
+	HeapBlock<float> createBinPositions() const;
+
+	/** The number of columns that make it worth to split a spectrogram across multiple threads. */
+	static constexpr int MinNumColumnsForMultithreading = 64;
+
+private:
+
+	static void colourLine(LookupTable& lut, const float* src, int numValues, uint8* dst, int pixelStride, bool useAlphaChannel, float gain);
 };
 
 /** A interface class that can attach mouse events to the JSON object provided in the mouse event callback of a broadcaster. */
@@ -47,6 +47,161 @@
 namespace hise {
 using namespace juce;
 
+// The SSE2 intrinsics are mapped to NEON by sse2neon.h on ARM
+#define HISE_USE_SIMD_PIXEL_KERNELS (JUCE_INTEL || JUCE_ARM)
+
+/** The row kernels of the PostGraphicsRenderer. They all expect 4 byte BGRA pixels
+	and produce the same results as the per-pixel code. */
+namespace PixelKernels
+{
+static void desaturate(uint8* p, int numPixels)
+{
+	int x = 0;
+
+#if HISE_USE_SIMD_PIXEL_KERNELS
+	auto zero = _mm_setzero_si128();
+	auto alphaMask = _mm_set1_epi32((int)0xFF000000);
+
+	// (v * 21846) >> 16 == v / 3 for all 8 bit values
+	auto divideByThree = _mm_set1_epi16(21846);
+
+	auto sumColourChannels = [&](__m128i v)
+	{
+		v = _mm_mulhi_epu16(v, divideByThree);
+
+		// rotate the colour channels of each pixel so that each lane adds up all three
+		auto s1 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 0, 2, 1)), _MM_SHUFFLE(3, 0, 2, 1));
+		auto s2 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 1, 0, 2)), _MM_SHUFFLE(3, 1, 0, 2));
+
+		return _mm_add_epi16(_mm_add_epi16(v, s1), s2);
+	};
+
+	for (; x + 4 <= numPixels; x += 4)
+	{
+		auto ptr = reinterpret_cast<__m128i*>(p + x * 4);
+		auto v = _mm_loadu_si128(ptr);
+
+		auto lo = sumColourChannels(_mm_unpacklo_epi8(v, zero));
+		auto hi = sumColourChannels(_mm_unpackhi_epi8(v, zero));
+
+		auto result = _mm_packus_epi16(lo, hi);
+		result = _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(alphaMask, v));
+
+		_mm_storeu_si128(ptr, result);
+	}
+#endif
+
+	for (; x < numPixels; x++)
+	{
+		PostGraphicsRenderer::Pixel px(p + x * 4);
+
+		auto sum = (*px.r / 3 + *px.g / 3 + *px.b / 3);
+		*px.r = sum;
+		*px.g = sum;
+		*px.b = sum;
+	}
+}
+
+static void applyMask(uint8* p, const uint8* mask, int numPixels, const float* alphaTable)
+{
+	int x = 0;
+
+#if HISE_USE_SIMD_PIXEL_KERNELS
+	auto zero = _mm_setzero_si128();
+
+	auto scale = [&](__m128i v16, bool high, int maskIndex)
+	{
+		auto v32 = high ? _mm_unpackhi_epi16(v16, zero) : _mm_unpacklo_epi16(v16, zero);
+		auto f = _mm_mul_ps(_mm_cvtepi32_ps(v32), _mm_set1_ps(alphaTable[mask[maskIndex]]));
+		return _mm_cvttps_epi32(f);
+	};
+
+	for (; x + 4 <= numPixels; x += 4)
+	{
+		auto ptr = reinterpret_cast<__m128i*>(p + x * 4);
+		auto v = _mm_loadu_si128(ptr);
+
+		auto lo = _mm_unpacklo_epi8(v, zero);
+		auto hi = _mm_unpackhi_epi8(v, zero);
+
+		auto p01 = _mm_packs_epi32(scale(lo, false, x), scale(lo, true, x + 1));
+		auto p23 = _mm_packs_epi32(scale(hi, false, x + 2), scale(hi, true, x + 3));
+
+		_mm_storeu_si128(ptr, _mm_packus_epi16(p01, p23));
+	}
+#endif
+
+	for (; x < numPixels; x++)
+	{
+		PostGraphicsRenderer::Pixel px(p + x * 4);
+
+		auto alpha = alphaTable[mask[x]];
+
+		*px.r = (uint8)jlimit(0, 255, (int)((float)*px.r * alpha));
+		*px.g = (uint8)jlimit(0, 255, (int)((float)*px.g * alpha));
+		*px.b = (uint8)jlimit(0, 255, (int)((float)*px.b * alpha));
+		*px.a = (uint8)jlimit(0, 255, (int)((float)*px.a * alpha));
+	}
+}
+
+/** Mixes the seed with the row index (splitmix64) so that neighbouring rows get uncorrelated generators.
+
+	Random is a linear congruential generator, so consecutive seeds would create a visible pattern across the rows. */
+static int64 getRowSeed(int64 seed, int y)
+{
+	auto z = ((uint64)seed ^ (uint64)y) + 0x9e3779b97f4a7c15ULL;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return (int64)(z ^ (z >> 31));
+}
+
+static void addNoise(uint8* p, int numPixels, float noiseAmount, Random& r)
+{
+	auto getNextDelta = [&]()
+	{
+		auto thisNoiseDelta = (r.nextFloat()*2.0f - 1.0f) * noiseAmount;
+
+		// anything beyond this range will be clipped anyway
+		return (int16)jlimit(-255, 255, roundToInt(thisNoiseDelta * 128.0f));
+	};
+
+	int x = 0;
+
+#if HISE_USE_SIMD_PIXEL_KERNELS
+	auto zero = _mm_setzero_si128();
+
+	for (; x + 4 <= numPixels; x += 4)
+	{
+		auto ptr = reinterpret_cast<__m128i*>(p + x * 4);
+		auto v = _mm_loadu_si128(ptr);
+
+		auto d0 = getNextDelta();
+		auto d1 = getNextDelta();
+		auto d2 = getNextDelta();
+		auto d3 = getNextDelta();
+
+		// the alpha channel stays untouched
+		auto lo = _mm_add_epi16(_mm_unpacklo_epi8(v, zero), _mm_set_epi16(0, d1, d1, d1, 0, d0, d0, d0));
+		auto hi = _mm_add_epi16(_mm_unpackhi_epi8(v, zero), _mm_set_epi16(0, d3, d3, d3, 0, d2, d2, d2));
+
+		// packus clips to 0...255
+		_mm_storeu_si128(ptr, _mm_packus_epi16(lo, hi));
+	}
+#endif
+
+	for (; x < numPixels; x++)
+	{
+		PostGraphicsRenderer::Pixel px(p + x * 4);
+
+		auto delta = (int)getNextDelta();
+
+		*px.r = (uint8)jlimit(0, 255, (int)*px.r + delta);
+		*px.g = (uint8)jlimit(0, 255, (int)*px.g + delta);
+		*px.b = (uint8)jlimit(0, 255, (int)*px.b + delta);
+	}
+}
+}
+
 PostGraphicsRenderer::Data::~Data()
 {
 #if USE_IPP
@@ -157,18 +312,12 @@ void PostGraphicsRenderer::reserveStackOperations(int numOperationsToAllocate)
 
 void PostGraphicsRenderer::desaturate()
 {
-	for (int y = 0; y < bd.height; y++)
-	{
-		for (int x = 0; x < bd.width; x++)
-		{
-			Pixel p(bd.getPixelPointer(x, y));
+	jassert(bd.pixelStride == 4);
 
-			auto sum = (*p.r / 3 + *p.g / 3 + *p.b / 3);
-			*p.r = sum;
-			*p.g = sum;
-			*p.b = sum;
-		}
-	}
+	processRows([this](int y)
+	{
+		PixelKernels::desaturate(bd.getLinePointer(y), bd.width);
+	});
 }
 
 void PostGraphicsRenderer::applyMask(const Path& path, bool invert /*= false*/, bool scale)
@@ -200,44 +349,34 @@ void PostGraphicsRenderer::applyMask(const Path& path, bool invert /*= false*/,
 
 	Image::BitmapData pathData(bf.pathImage, Image::BitmapData::readOnly);
 
-	for (int y = 0; y < bd.height; y++)
-	{
-		for (int x = 0; x < bd.width; x++)
-		{
-			Pixel p(bd.getPixelPointer(x, y));
-			auto ptr = pathData.getPixelPointer(x, y);
+	jassert(bd.pixelStride == 4 && pathData.pixelStride == 1);
 
-			float alpha = (float)*ptr / 255.0f;
-			if (invert)
-				alpha = 1.0f - alpha;
+	float alphaTable[256];
 
-			*p.r = (uint8)jlimit(0, 255, (int)((float)*p.r * alpha));
-			*p.g = (uint8)jlimit(0, 255, (int)((float)*p.g * alpha));
-			*p.b = (uint8)jlimit(0, 255, (int)((float)*p.b * alpha));
-			*p.a = (uint8)jlimit(0, 255, (int)((float)*p.a * alpha));
-		}
+	for (int i = 0; i < 256; i++)
+	{
+		float alpha = (float)i / 255.0f;
+		alphaTable[i] = invert ? 1.0f - alpha : alpha;
 	}
+
+	processRows([&](int y)
+	{
+		PixelKernels::applyMask(bd.getLinePointer(y), pathData.getLinePointer(y), bd.width, alphaTable);
+	});
 }
 
 void PostGraphicsRenderer::addNoise(float noiseAmount)
 {
-	Random r;
-
-	for (int y = 0; y < bd.height; y++)
-	{
-		for (int x = 0; x < bd.width; x++)
-		{
-			Pixel p(bd.getPixelPointer(x, y));
+	jassert(bd.pixelStride == 4);
 
-			auto thisNoiseDelta = (r.nextFloat()*2.0f - 1.0f) * noiseAmount;
+	// every row gets its own generator so that they can be processed in parallel
+	auto seed = Random().nextInt64();
 
-			auto delta = roundToInt(thisNoiseDelta * 128.0f);
-
-			*p.r = (uint8)jlimit(0, 255, (int)*p.r + delta);
-			*p.g = (uint8)jlimit(0, 255, (int)*p.g + delta);
-			*p.b = (uint8)jlimit(0, 255, (int)*p.b + delta);
-		}
-	}
+	processRows([&](int y)
+	{
+		Random r(PixelKernels::getRowSeed(seed, y));
+		PixelKernels::addNoise(bd.getLinePointer(y), bd.width, noiseAmount, r);
+	});
 }
 
 void PostGraphicsRenderer::gaussianBlur(int blur)
@@ -292,7 +431,7 @@ void PostGraphicsRenderer::stackBlur(int blur)
 	}
 	else
 	{
-		gin::applyStackBlur(img, blur);
+		gin::applyStackBlur(img, blur, getThreadPool());
 	}
 
 	
@@ -300,17 +439,17 @@ void PostGraphicsRenderer::stackBlur(int blur)
 
 void PostGraphicsRenderer::applyHSL(float h, float s, float l)
 {
-	gin::applyHueSaturationLightness(img, h, s, l);
+	gin::applyHueSaturationLightness(img, h, s, l, getThreadPool());
 }
 
 void PostGraphicsRenderer::applyGamma(float g)
 {
-	gin::applyGamma(img, g);
+	gin::applyGamma(img, g, getThreadPool());
 }
 
 void PostGraphicsRenderer::applyGradientMap(ColourGradient g)
 {
-	gin::applyGradientMap(img, g.getColour(0), g.getColour(1));
+	gin::applyGradientMap(img, g.getColour(0), g.getColour(1), getThreadPool());
 }
 
 void PostGraphicsRenderer::applySharpness(int delta)
@@ -318,18 +457,18 @@ void PostGraphicsRenderer::applySharpness(int delta)
 	if (delta > 0)
 	{
 		for (int i = 0; i < delta; i++)
-			gin::applySharpen(img);
+			gin::applySharpen(img, getThreadPool());
 	}
 	else
 	{
 		for (int i = 0; i < -delta; i++)
-			gin::applySoften(img);
+			gin::applySoften(img, getThreadPool());
 	}
 }
 
 void PostGraphicsRenderer::applySepia()
 {
-	gin::applySepia(img);
+	gin::applySepia(img, getThreadPool());
 }
 
 void PostGraphicsRenderer::applyVignette(float amount, float radius, float falloff)
@@ -355,6 +494,22 @@ hise::PostGraphicsRenderer::Data& PostGraphicsRenderer::getNextData()
 	}
 }
 
+ThreadPool* PostGraphicsRenderer::getThreadPool()
+{
+	if (stack.isEmpty())
+		stack.add(new Data());
+
+	return &stack.getFirst()->workerPool->getThreadPool();
+}
+
+void PostGraphicsRenderer::processRows(const std::function<void(int)>& f)
+{
+	// Use the same threshold as the gin image effects
+	auto useThreads = bd.width >= 256 || bd.height >= 256;
+
+	gin::multiThreadedFor(0, bd.height, 1, useThreads ? getThreadPool() : nullptr, f);
+}
+
 PostGraphicsRenderer::Pixel::Pixel(uint8* ptr) :
 	a(ptr + 3),
 	r(ptr + 2),
@@ -407,4 +562,388 @@ void ComponentWithPostGraphicsRenderer::setNumOperations(int numOperations)
 	numOps = numOperations;
 }
 
+#if HI_RUN_UNIT_TESTS
+
+/** Checks the SIMD / multithreaded pixel operations against the previous per-pixel code
+	and logs the timings of both versions for a few common panel sizes. */
+struct PostGraphicsRendererTests : public UnitTest
+{
+	PostGraphicsRendererTests() :
+		UnitTest("Testing post graphics renderer")
+	{};
+
+	struct Timer
+	{
+		void start() { startTicks = Time::getHighResolutionTicks(); }
+		void stop() { totalTicks += Time::getHighResolutionTicks() - startTicks; }
+		double getMilliseconds() const { return Time::highResolutionTicksToSeconds(totalTicks) * 1000.0; }
+
+		int64 startTicks = 0;
+		int64 totalTicks = 0;
+	};
+
+	static Image createTestImage(int width, int height, Random& r)
+	{
+		Image img(Image::ARGB, width, height, true);
+		Image::BitmapData bd(img, Image::BitmapData::writeOnly);
+
+		for (int y = 0; y < height; y++)
+		{
+			auto p = bd.getLinePointer(y);
+
+			for (int i = 0; i < width * 4; i++)
+				p[i] = (uint8)r.nextInt(256);
+		}
+
+		return img;
+	}
+
+	void expectSameImage(const Image& a, const Image& b, const String& operation)
+	{
+		Image::BitmapData ad(a, Image::BitmapData::readOnly);
+		Image::BitmapData bd(b, Image::BitmapData::readOnly);
+
+		for (int y = 0; y < ad.height; y++)
+		{
+			if (memcmp(ad.getLinePointer(y), bd.getLinePointer(y), ad.width * ad.pixelStride) != 0)
+			{
+				expect(false, operation + ": mismatch at line " + String(y));
+				return;
+			}
+		}
+	}
+
+	static void desaturateReference(Image& img)
+	{
+		Image::BitmapData bd(img, Image::BitmapData::readWrite);
+
+		for (int y = 0; y < bd.height; y++)
+		{
+			for (int x = 0; x < bd.width; x++)
+			{
+				PostGraphicsRenderer::Pixel p(bd.getPixelPointer(x, y));
+
+				auto sum = (*p.r / 3 + *p.g / 3 + *p.b / 3);
+				*p.r = sum;
+				*p.g = sum;
+				*p.b = sum;
+			}
+		}
+	}
+
+	static void maskReference(Image& img, const Path& path, bool invert)
+	{
+		Image pathImage(Image::SingleChannel, img.getWidth(), img.getHeight(), true);
+
+		{
+			Graphics g(pathImage);
+			g.setColour(Colours::white);
+			g.fillPath(path);
+		}
+
+		Image::BitmapData bd(img, Image::BitmapData::readWrite);
+		Image::BitmapData pathData(pathImage, Image::BitmapData::readOnly);
+
+		for (int y = 0; y < bd.height; y++)
+		{
+			for (int x = 0; x < bd.width; x++)
+			{
+				PostGraphicsRenderer::Pixel p(bd.getPixelPointer(x, y));
+				auto ptr = pathData.getPixelPointer(x, y);
+
+				float alpha = (float)*ptr / 255.0f;
+				if (invert)
+					alpha = 1.0f - alpha;
+
+				*p.r = (uint8)jlimit(0, 255, (int)((float)*p.r * alpha));
+				*p.g = (uint8)jlimit(0, 255, (int)((float)*p.g * alpha));
+				*p.b = (uint8)jlimit(0, 255, (int)((float)*p.b * alpha));
+				*p.a = (uint8)jlimit(0, 255, (int)((float)*p.a * alpha));
+			}
+		}
+	}
+
+	static void gammaReference(Image& img, float gamma)
+	{
+		Image::BitmapData bd(img, Image::BitmapData::readWrite);
+
+		for (int y = 0; y < bd.height; y++)
+		{
+			for (int x = 0; x < bd.width; x++)
+			{
+				PostGraphicsRenderer::Pixel p(bd.getPixelPointer(x, y));
+
+				*p.r = gin::toByte(std::pow(*p.r / 255.0, gamma) * 255.0 + 0.5);
+				*p.g = gin::toByte(std::pow(*p.g / 255.0, gamma) * 255.0 + 0.5);
+				*p.b = gin::toByte(std::pow(*p.b / 255.0, gamma) * 255.0 + 0.5);
+			}
+		}
+	}
+
+	/** The 3x3 kernels of applySharpen / applySoften with the clamped edge handling for every pixel. */
+	static Image convolveReference(const Image& img, bool sharpen)
+	{
+		const int w = img.getWidth();
+		const int h = img.getHeight();
+
+		Image dst(Image::ARGB, w, h, true);
+		Image::BitmapData srcData(img, Image::BitmapData::readOnly);
+		Image::BitmapData dstData(dst, Image::BitmapData::writeOnly);
+
+		for (int y = 0; y < h; y++)
+		{
+			for (int x = 0; x < w; x++)
+			{
+				auto get = [&](int cx, int cy, int channel)
+				{
+					return (int)srcData.getPixelPointer(jlimit(0, w - 1, cx), jlimit(0, h - 1, cy))[channel];
+				};
+
+				auto d = dstData.getPixelPointer(x, y);
+
+				for (int c = 0; c < 3; c++)
+				{
+					int v = 0;
+
+					if (sharpen)
+						v = get(x, y, c) * 5 - get(x, y - 1, c) - get(x - 1, y, c) - get(x + 1, y, c) - get(x, y + 1, c);
+					else
+					{
+						for (int m = -1; m <= 1; m++)
+							for (int n = -1; n <= 1; n++)
+								v += get(x + m, y + n, c);
+
+						v /= 9;
+					}
+
+					d[c] = gin::toByte(v);
+				}
+
+				d[3] = (uint8)get(x, y, 3);
+			}
+		}
+
+		return dst;
+	}
+
+	/** The original ARGB stack blur that processes one line after another without the thread pool. */
+	static void stackBlurReference(Image& img, unsigned int radius)
+	{
+		Image::BitmapData data(img, Image::BitmapData::readWrite);
+
+		radius = jlimit(2u, 254u, radius);
+
+		auto blurLine = [radius](uint8* p, int numPixels, int stride)
+		{
+			const unsigned int div = radius * 2 + 1;
+			const uint64 mulSum = gin::stackblur_mul[radius];
+			const unsigned char shrSum = gin::stackblur_shr[radius];
+			const unsigned int maxIndex = (unsigned int)numPixels - 1;
+
+			uint8 stack[254 * 2 + 1];
+
+			// the channels are independent, so we blur them one after another
+			for (int c = 0; c < 4; c++)
+			{
+				auto get = [&](unsigned int i) { return p[jmin(i, maxIndex) * stride + c]; };
+
+				uint64 sum = 0, sumIn = 0, sumOut = 0;
+
+				for (unsigned int i = 0; i <= radius; i++)
+				{
+					stack[i] = get(0);
+					sum += stack[i] * (i + 1);
+					sumOut += stack[i];
+				}
+
+				for (unsigned int i = 1; i <= radius; i++)
+				{
+					stack[i + radius] = get(i);
+					sum += stack[i + radius] * (radius + 1 - i);
+					sumIn += stack[i + radius];
+				}
+
+				unsigned int sp = radius;
+				unsigned int xp = jmin(radius, maxIndex);
+
+				for (int x = 0; x < numPixels; x++)
+				{
+					p[x * stride + c] = (uint8)((sum * mulSum) >> shrSum);
+
+					sum -= sumOut;
+
+					auto stackStart = sp + div - radius;
+
+					if (stackStart >= div)
+						stackStart -= div;
+
+					sumOut -= stack[stackStart];
+
+					if (xp < maxIndex)
+						++xp;
+
+					stack[stackStart] = get(xp);
+					sumIn += stack[stackStart];
+					sum += sumIn;
+
+					if (++sp >= div)
+						sp = 0;
+
+					sumOut += stack[sp];
+					sumIn -= stack[sp];
+				}
+			}
+		};
+
+		for (int y = 0; y < data.height; y++)
+			blurLine(data.getLinePointer(y), data.width, data.pixelStride);
+
+		for (int x = 0; x < data.width; x++)
+			blurLine(data.getPixelPointer(x, 0), data.height, data.lineStride);
+	}
+
+	/** Checks that the noise of a row doesn't depend on the noise of the previous row. */
+	void testNoiseRowCorrelation(PostGraphicsRenderer::DataStack& stack)
+	{
+		beginTest("Testing row correlation of the noise");
+
+		static constexpr int Width = 256;
+		static constexpr int Height = 512;
+
+		Image img(Image::ARGB, Width, Height, true);
+		img.clear(img.getBounds(), Colour(0xFF808080));
+
+		PostGraphicsRenderer(stack, img).addNoise(0.5f);
+
+		Image::BitmapData bd(img, Image::BitmapData::readOnly);
+
+		auto getDelta = [&](int x, int y) { return (double)bd.getPixelPointer(x, y)[0] - 128.0; };
+
+		// With correlated generators every column forms a regular pattern, so the
+		// correlation of neighbouring rows in a column would be far away from zero
+		double sumOfCorrelations = 0.0;
+
+		for (int x = 0; x < Width; x++)
+		{
+			double sa = 0.0, sb = 0.0, saa = 0.0, sbb = 0.0, sab = 0.0;
+			const double n = (double)(Height - 1);
+
+			for (int y = 0; y < Height - 1; y++)
+			{
+				auto a = getDelta(x, y);
+				auto b = getDelta(x, y + 1);
+
+				sa += a; sb += b;
+				saa += a * a; sbb += b * b;
+				sab += a * b;
+			}
+
+			auto cov = sab / n - (sa / n) * (sb / n);
+			auto va = saa / n - (sa / n) * (sa / n);
+			auto vb = sbb / n - (sb / n) * (sb / n);
+
+			if (va > 0.0 && vb > 0.0)
+				sumOfCorrelations += std::abs(cov / std::sqrt(va * vb));
+		}
+
+		auto meanCorrelation = sumOfCorrelations / (double)Width;
+
+		logMessage("Mean row correlation: " + String(meanCorrelation, 4));
+		expect(meanCorrelation < 0.1, "noise rows are correlated: " + String(meanCorrelation, 4));
+	}
+
+	void runTest() override
+	{
+		beginTest("Testing pixel operations against the per-pixel code");
+
+		Random r(12345);
+		PostGraphicsRenderer::DataStack stack;
+		SharedResourcePointer<SharedWorkerPool> workerPool;
+
+		// common panel sizes at 1x and 2x scale
+		const Rectangle<int> sizes[] = { { 0, 0, 128, 48 }, { 0, 0, 300, 200 }, { 0, 0, 600, 400 }, { 0, 0, 1200, 800 } };
+
+		for (auto s : sizes)
+		{
+			auto w = s.getWidth();
+			auto h = s.getHeight();
+
+			auto source = createTestImage(w, h, r);
+			String timings;
+
+			auto measure = [&](const String& name, const std::function<void(Image&)>& referenceFunction, const std::function<void(Image&)>& newFunction)
+			{
+				Timer referenceTimer, newTimer;
+
+				static constexpr int NumRepetitions = 4;
+
+				for (int i = 0; i < NumRepetitions; i++)
+				{
+					auto expected = source.createCopy();
+					auto actual = source.createCopy();
+
+					referenceTimer.start();
+					referenceFunction(expected);
+					referenceTimer.stop();
+
+					newTimer.start();
+					newFunction(actual);
+					newTimer.stop();
+
+					expectSameImage(expected, actual, name);
+				}
+
+				timings << name << ": " << String(referenceTimer.getMilliseconds() / NumRepetitions, 3) << "ms -> " << String(newTimer.getMilliseconds() / NumRepetitions, 3) << "ms, ";
+			};
+
+			Path p;
+			p.addEllipse(s.toFloat().reduced(4.0f));
+
+			measure("desaturate", desaturateReference, [&](Image& img) { PostGraphicsRenderer(stack, img).desaturate(); });
+			measure("mask", [&](Image& img) { maskReference(img, p, false); }, [&](Image& img) { PostGraphicsRenderer(stack, img).applyMask(p, false); });
+			measure("inverted mask", [&](Image& img) { maskReference(img, p, true); }, [&](Image& img) { PostGraphicsRenderer(stack, img).applyMask(p, true); });
+			measure("gamma", [](Image& img) { gammaReference(img, 0.7f); }, [&](Image& img) { PostGraphicsRenderer(stack, img).applyGamma(0.7f); });
+			measure("sharpen", [](Image& img) { img = convolveReference(img, true); }, [&](Image& img) { gin::applySharpen(img, &workerPool->getThreadPool()); });
+			measure("soften", [](Image& img) { img = convolveReference(img, false); }, [&](Image& img) { gin::applySoften(img, &workerPool->getThreadPool()); });
+			measure("blur", [](Image& img) { stackBlurReference(img, 12); }, [&](Image& img) { PostGraphicsRenderer(stack, img).stackBlur(12); });
+
+			logMessage(String(w) + "x" + String(h) + ": " + timings.upToLastOccurrenceOf(",", false, false));
+
+			auto noiseImage = source.createCopy();
+			PostGraphicsRenderer(stack, noiseImage).addNoise(0.0f);
+			expectSameImage(source, noiseImage, "zero noise");
+
+			PostGraphicsRenderer(stack, noiseImage).addNoise(0.1f);
+
+			Image::BitmapData sd(source, Image::BitmapData::readOnly);
+			Image::BitmapData nd(noiseImage, Image::BitmapData::readOnly);
+
+			int maxDelta = 0;
+			bool alphaChanged = false;
+
+			for (int y = 0; y < h; y++)
+			{
+				for (int x = 0; x < w * 4; x++)
+				{
+					auto delta = std::abs((int)sd.getLinePointer(y)[x] - (int)nd.getLinePointer(y)[x]);
+
+					if (x % 4 == 3)
+						alphaChanged |= delta != 0;
+					else
+						maxDelta = jmax(maxDelta, delta);
+				}
+			}
+
+			expect(!alphaChanged, "noise changes alpha");
+			expect(maxDelta <= 13, "noise exceeds amount: " + String(maxDelta));
+		}
+
+		testNoiseRowCorrelation(stack);
+	}
+};
+
+static PostGraphicsRendererTests postGraphicsRendererTests;
+
+#endif
+
 }
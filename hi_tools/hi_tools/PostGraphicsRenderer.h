@@ -50,6 +50,9 @@ using namespace juce;
 	Since some of these operations will involve using buffers, it uses an internal
 	stack system that fetches the correct internal data for each required operation
 	to avoid reallocating.
+
+	The pixel operations use SSE2 (or NEON through sse2neon) and split the rows of
+	large images across a thread pool that is shared by all renderers.
 */
 struct PostGraphicsRenderer
 {
@@ -87,6 +90,7 @@ struct PostGraphicsRenderer
 		Image pathImage;
 
 		HeapBlock<uint8> withoutAlpha;
+		SharedResourcePointer<SharedWorkerPool> workerPool;
 		int numPixels;
 		void* pSpec = nullptr;
 
@@ -144,6 +148,12 @@ private:
 
 	Data& getNextData();
 
+	/** Returns the shared thread pool or nullptr if the image is too small to benefit from multithreading. */
+	ThreadPool* getThreadPool();
+
+	/** Calls the function for each row of the image, possibly on multiple threads. */
+	void processRows(const std::function<void(int)>& f);
+
 	DataStack& stack;
 	int stackIndex = 0;
 	Image::BitmapData bd;
@@ -170,6 +170,13 @@ public:
 		print("");
 		print("run_unit_tests");
 		print("Runs the unit tests. In order for this to work, HISE must be built with the CI configuration");
+		print("");
+		print("replay -p:PATH -l:LOG_FILE [-o:CSV_FILE] [-from:BLOCK] [-to:BLOCK] [-offline]");
+		print("Loads the given project file and replays the render input log (*.hiserec) that was recorded");
+		print("with the debug logger. It prints the average and peak load and the slowest blocks.");
+		print("-o:CSV_FILE writes the render time of each block to the given file.");
+		print("-from / -to restricts the measurement to the given block range in order to bisect a CPU spike.");
+		print("-offline renders in non-realtime mode without waiting between the blocks.");
 
 		exit(0);
 	}
@@ -331,6 +338,53 @@ public:
 		return 0;
 	}
 
+	static int replayRenderInput(const String& commandLine)
+	{
+		auto args = getCommandLineArgs(commandLine);
+
+		auto logFile = File(getArgument(args, "-l:"));
+		auto csvFile = getArgument(args, "-o:");
+
+		RenderInputPlayer::Options options;
+
+		if (args.contains("-offline"))
+		{
+			options.renderOffline = true;
+			options.paceInRealtime = false;
+		}
+
+		auto from = getArgument(args, "-from:");
+		auto to = getArgument(args, "-to:");
+
+		if (from.isNotEmpty())
+			options.firstBlock = from.getIntValue();
+
+		if (to.isNotEmpty())
+			options.lastBlock = to.getIntValue();
+
+		if (!logFile.existsAsFile())
+			throwErrorAndQuit("`" + logFile.getFullPathName() + "` is not a valid log file");
+
+		return loadPresetFile(commandLine, [&](BackendProcessor* bp)
+		{
+			RenderInputPlayer player(bp);
+
+			print("Replaying " + logFile.getFileName() + "...");
+
+			auto ok = player.replay(logFile, options);
+
+			if (ok.failed())
+				return ok;
+
+			print(player.createReport());
+
+			if (csvFile.isNotEmpty())
+				return player.writeTimingsToFile(File(csvFile));
+
+			return Result::ok();
+		});
+	}
+
 	static void compileNetworks(const String& commandLine)
 	{
 		auto args = getCommandLineArgs(commandLine);
@@ -723,6 +777,19 @@ public:
 			}
 				
 
+			quit();
+			return;
+		}
+		else if (commandLine.startsWith("replay"))
+		{
+			auto ok = CommandLineActions::replayRenderInput(commandLine);
+
+			if (ok != 0)
+			{
+				exit(ok);
+				return;
+			}
+
 			quit();
 			return;
 		}
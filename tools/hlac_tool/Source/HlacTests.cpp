@@ -847,6 +847,9 @@ public:
 
 		testArchiver();
 
+		testParallelMonolithWrite(1);
+		testParallelMonolithWrite(2);
+
 		testFixedSampleBuffer();
 
 		runFormatTestWithOption(HlacEncoder::CompressorOptions::Presets::WholeBlock);
@@ -1110,6 +1113,92 @@ public:
 	}
 	
 
+	/** Encodes the buffers with separate writers on multiple threads and appends them to a single writer
+		like the monolith exporter. The result must be identical to writing them one after another. */
+	void testParallelMonolithWrite(int numChannels)
+	{
+		beginTest("Testing parallel monolith encoding with " + String(numChannels) + " channels");
+
+		Array<AudioSampleBuffer> buffers;
+
+		const int sizes[5] = { 44100, 1000, COMPRESSION_BLOCK_SIZE, 30001, 9000 };
+
+		for (auto s : sizes)
+			buffers.add(createTestBuffer(numChannels, s));
+
+		auto options = HlacEncoder::CompressorOptions::getPreset(HlacEncoder::CompressorOptions::Presets::Diff);
+		options.applyDithering = false;
+		options.normalisationMode = 2;
+
+		// The checksums are random, so both outputs need the same value in order to be comparable
+		options.fixedChecksum = CompressionHelpers::Misc::createChecksum();
+
+		currentOption = options;
+		auto serialData = writeIntoMemory(buffers);
+
+		// The writer keeps a pointer to the block offset table of its format, so every job needs its own format
+		struct Job
+		{
+			HiseLosslessAudioFormat format;
+			ScopedPointer<HiseLosslessAudioFormatWriter> writer;
+		};
+
+		OwnedArray<Job> jobs;
+		StringPairArray empty;
+
+		{
+			ThreadPool pool(4);
+
+			for (auto& b : buffers)
+			{
+				auto job = jobs.add(new Job());
+
+				pool.addJob([job, &b, &options, &empty, numChannels]()
+				{
+					job->writer = dynamic_cast<HiseLosslessAudioFormatWriter*>(job->format.createWriterFor(new MemoryOutputStream(), 44100.0, numChannels, 0, empty, 0));
+					job->writer->setOptions(options);
+					job->writer->preallocateMemory(b.getNumSamples(), numChannels);
+					job->writer->writeFromAudioSampleBuffer(b, 0, b.getNumSamples());
+				});
+			}
+
+			while (pool.getNumJobs() > 0)
+				Thread::sleep(5);
+		}
+
+		HiseLosslessAudioFormat hlac;
+		MemoryOutputStream* mos = new MemoryOutputStream();
+
+		ScopedPointer<HiseLosslessAudioFormatWriter> writer = dynamic_cast<HiseLosslessAudioFormatWriter*>(hlac.createWriterFor(mos, 44100.0, numChannels, 0, empty, 0));
+		writer->setOptions(options);
+
+		for (auto j : jobs)
+			expect(writer->appendDataFrom(*j->writer), "append data");
+
+		writer->flush();
+
+		MemoryBlock parallelData(mos->getData(), mos->getDataSize());
+
+		expectEquals<int>((int)parallelData.getSize(), (int)serialData.getSize(), "Size");
+		expect(parallelData == serialData, "Output is not identical");
+
+		// Make sure that the data can be read back
+		auto b = readIntoAudioBuffer(parallelData, true);
+		int offset = 0;
+
+		for (auto& original : buffers)
+		{
+			AudioSampleBuffer part(numChannels, original.getNumSamples());
+
+			for (int c = 0; c < numChannels; c++)
+				part.copyFrom(c, 0, b, c, offset, original.getNumSamples());
+
+			expectEquals<int>((int)CompressionHelpers::checkBuffersEqual(part, original), 0, "buffers equal");
+
+			offset += CompressionHelpers::getPaddedSampleSize(original.getNumSamples());
+		}
+	}
+
 	void testPadding(int numChannels)
 	{
 		beginTest("Testing zero padding with " + String(numChannels) + " channels");
@@ -38,6 +38,7 @@ void printHelp()
 	Logger::writeToLog("");
 	Logger::writeToLog("modes: 'encode' / 'decode'");
 	Logger::writeToLog("test-modes: 'unit_test' / 'test_directory', 'memory_map_directory'");
+	Logger::writeToLog("benchmark: 'benchmark_extraction' [ARCHIVE] [OUTPUT_DIR] (compares single / multi core extraction)");
 	Logger::writeToLog("(put '_' before filename to skip samples)");
 	Logger::setCurrentLogger(nullptr);
 }
@@ -97,6 +98,95 @@ void testMemoryMapPerformance(Array<File>& files)
 	}
 }
 
+/** Extracts a sample archive with a given number of decoder threads and measures the time. */
+class ExtractionBenchmark : public Thread,
+							public HlacArchiver::Listener
+{
+public:
+
+	ExtractionBenchmark(const File& archive_, const File& targetDirectory_, int numThreads_) :
+		Thread("Extraction Benchmark"),
+		archive(archive_),
+		targetDirectory(targetDirectory_),
+		numThreads(numThreads_)
+	{}
+
+	void run() override
+	{
+		HlacArchiver decompressor(this);
+		decompressor.setListener(this);
+
+		HlacArchiver::DecompressData data;
+		data.option = HlacArchiver::OverwriteOption::ForceOverwrite;
+		data.sourceFile = archive;
+		data.targetDirectory = targetDirectory;
+		data.progress = &progress;
+		data.partProgress = &partProgress;
+		data.totalProgress = &totalProgress;
+		data.numThreads = numThreads;
+
+		auto start = Time::getMillisecondCounterHiRes();
+		ok = decompressor.extractSampleData(data);
+		seconds = (Time::getMillisecondCounterHiRes() - start) * 0.001;
+	}
+
+	void logStatusMessage(const String& ) override {}
+	void logVerboseMessage(const String& ) override {}
+
+	void criticalErrorOccured(const String& message) override
+	{
+		Logger::writeToLog("Error: " + message);
+	}
+
+	const File archive;
+	const File targetDirectory;
+	const int numThreads;
+
+	double progress = 0.0;
+	double partProgress = 0.0;
+	double totalProgress = 0.0;
+
+	bool ok = false;
+	double seconds = 0.0;
+};
+
+int benchmarkExtraction(File archive, File targetDirectory)
+{
+	if (!archive.existsAsFile())
+	{
+		ABORT_WITH_MESSAGE("Archive " + archive.getFullPathName() + " does not exist");
+	}
+
+	targetDirectory.createDirectory();
+
+	Array<int> threadCounts = { 1, jmax(1, SystemStats::getNumCpus() - 1) };
+
+	double singleCoreTime = 0.0;
+
+	for (auto numThreads : threadCounts)
+	{
+		ExtractionBenchmark b(archive, targetDirectory, numThreads);
+
+		b.startThread();
+
+		while (b.isThreadRunning())
+			Thread::sleep(50);
+
+		if (!b.ok)
+		{
+			ABORT_WITH_MESSAGE("Extraction failed");
+		}
+
+		if (numThreads == 1)
+			singleCoreTime = b.seconds;
+
+		Logger::writeToLog(String(numThreads) + " decoder thread(s): " + String(b.seconds, 2) + "s (Speedup: " + String(singleCoreTime / b.seconds, 2) + "x)");
+	}
+
+	Logger::setCurrentLogger(nullptr);
+	return 0;
+}
+
 int decode(File input, File output)
 {
 
@@ -245,6 +335,17 @@ int main(int argc, char **argv)
 	}
 
 
+	if (mode == "benchmark_extraction")
+	{
+		if (argc < 4)
+		{
+			printHelp();
+			return 1;
+		}
+
+		return benchmarkExtraction(File(argv[2]), File(argv[3]));
+	}
+
 	if (mode == "memory_map_directory")
 	{
 		File root(argv[2]);